@@ -11,6 +11,7 @@ target_compile_features(${NAME} INTERFACE cxx_std_20)
 target_compile_definitions(
     ${NAME}
     INTERFACE $<$<BOOL:${DESBORDANTE_SAFE_VERTICAL_HASHING}>:DESBORDANTE_SAFE_VERTICAL_HASHING>
+              $<$<BOOL:${DESBORDANTE_METRICS}>:DESBORDANTE_METRICS>
 )
 
 #[=[
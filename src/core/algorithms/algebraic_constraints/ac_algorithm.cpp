@@ -1,18 +1,69 @@
 #include "core/algorithms/algebraic_constraints/ac_algorithm.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
-#include <functional>
 #include <iostream>
+#include <numeric>
+#include <optional>
 #include <random>
+#include <variant>
 
+#include "core/algorithms/algebraic_constraints/typed_kernels.h"
 #include "core/config/exceptions.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/types/create_type.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace algos {
 
+using algebraic_constraints::Compare;
+using algebraic_constraints::Dist;
+
+struct ACAlgorithm::NumericColumn {
+    std::variant<std::monostate, std::vector<model::Int>, std::vector<model::Double>> values;
+    std::vector<char> has_value;
+};
+
+namespace {
+
+std::vector<char> GetHasValue(model::TypedColumnData const& column) {
+    size_t const num_rows = column.GetNumRows();
+    if (column.GetNumNulls() == 0 && column.GetNumEmpties() == 0) {
+        return std::vector<char>(num_rows, true);
+    }
+    std::vector<char> has_value(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        has_value[i] = !column.IsNullOrEmpty(i);
+    }
+    return has_value;
+}
+
+template <typename T>
+std::vector<T> GetValues(model::TypedColumnData const& column,
+                         std::vector<char> const& has_value) {
+    std::vector<std::byte const*> const& data = column.GetData();
+    std::vector<T> values(data.size(), 0);
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (has_value[i]) {
+            values[i] = model::Type::GetValue<T>(data[i]);
+        }
+    }
+    return values;
+}
+
+template <typename T>
+std::unique_ptr<std::byte[]> MakeValue(T value) {
+    auto res = std::make_unique<std::byte[]>(sizeof(T));
+    model::Type::GetValue<T>(res.get()) = value;
+    return res;
+}
+
+}  // namespace
+
 ACAlgorithm::ACAlgorithm() : Algorithm() {
     RegisterOptions();
     MakeOptionsAvailable({config::kTableOpt.GetName()});
@@ -24,19 +75,12 @@ void ACAlgorithm::RegisterOptions() {
     using namespace config::descriptions;
     using config::Option;
 
-    auto check_and_set_binop = [this](Binop bin_operation) {
+    auto check_binop = [](Binop bin_operation) {
         switch (bin_operation) {
             case +Binop::Addition:
-                binop_pointer_ = &model::INumericType::Add;
-                break;
             case +Binop::Subtraction:
-                binop_pointer_ = &model::INumericType::Sub;
-                break;
             case +Binop::Multiplication:
-                binop_pointer_ = &model::INumericType::Mul;
-                break;
             case +Binop::Division:
-                binop_pointer_ = &model::INumericType::Div;
                 break;
             default:
                 throw config::ConfigurationError(
@@ -64,7 +108,7 @@ void ACAlgorithm::RegisterOptions() {
 
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(Option{&bin_operation_, kBinaryOperation, kDBinaryOperation}.SetValueCheck(
-            check_and_set_binop));
+            check_binop));
     RegisterOption(Option{&fuzziness_, kFuzziness, kDFuzziness}.SetValueCheck(check_fuzziness));
     RegisterOption(Option{&p_fuzz_, kFuzzinessProbability, kDFuzzinessProbability}.SetValueCheck(
             check_p_fuzz));
@@ -74,6 +118,7 @@ void ACAlgorithm::RegisterOptions() {
     RegisterOption(Option{&iterations_limit_, kIterationsLimit, kDIterationsLimit}.SetValueCheck(
             check_positive));
     RegisterOption(Option{&seed_, kACSeed, kDACSeed});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void ACAlgorithm::LoadDataInternal() {
@@ -84,7 +129,7 @@ void ACAlgorithm::LoadDataInternal() {
 void ACAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
     MakeOptionsAvailable({kFuzziness, kFuzzinessProbability, kWeight, kBumpsLimit, kIterationsLimit,
-                          kACSeed, kBinaryOperation});
+                          kACSeed, kBinaryOperation, config::kThreadNumberOpt.GetName()});
 }
 
 void ACAlgorithm::ResetState() {
@@ -126,74 +171,61 @@ size_t ACAlgorithm::CalculateSampleSize(size_t k_bumps) const {
     return sample_size > num_rows ? num_rows : sample_size;
 }
 
-std::vector<std::byte const*> ACAlgorithm::Sampling(std::vector<model::TypedColumnData> const& data,
-                                                    size_t lhs_i, size_t rhs_i) {
-    ACPairs ac_pairs;
-    std::vector<std::byte const*> ranges;
+template <typename T>
+std::vector<size_t> ACAlgorithm::Sampling(std::vector<T> const& results,
+                                          std::vector<char> const& has_result,
+                                          std::vector<size_t>& sample,
+                                          std::vector<T>& sample_results) const {
+    std::vector<size_t> ranges;
     size_t k_bumps = 1;
     size_t i = 0;
     size_t sample_size = CalculateSampleSize(k_bumps);
     size_t new_k_bumps = 1;
-    size_t n_rows = data.at(lhs_i).GetData().size();
+    size_t n_rows = results.size();
     while (i < iterations_limit_ &&
            (ranges.empty() || sample_size < CalculateSampleSize(new_k_bumps))) {
         k_bumps = new_k_bumps;
         sample_size = CalculateSampleSize(k_bumps);
         double probability = sample_size / static_cast<double>(n_rows);
-        ranges = SamplingIteration(data, lhs_i, rhs_i, probability, ac_pairs);
+        ranges = SamplingIteration(results, has_result, probability, sample, sample_results);
         new_k_bumps = ranges.size() / 2;
         if (new_k_bumps == 0) {
             new_k_bumps = k_bumps + 1;
         }
         ++i;
     }
-    RestrictRangesAmount(ranges);
-    ac_pairs_.emplace_back(ACPairsCollection(
-            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true),
-            std::move(ac_pairs), lhs_i, rhs_i));
+    RestrictRangesAmount(sample_results, ranges);
     return ranges;
 }
 
-std::vector<std::byte const*> ACAlgorithm::SamplingIteration(
-        std::vector<model::TypedColumnData> const& data, size_t lhs_i, size_t rhs_i,
-        double probability, ACPairs& ac_pairs) {
-    std::vector<std::byte const*> const& lhs = data.at(lhs_i).GetData();
-    std::vector<std::byte const*> const& rhs = data.at(rhs_i).GetData();
-    ac_pairs.clear();
+template <typename T>
+std::vector<size_t> ACAlgorithm::SamplingIteration(std::vector<T> const& results,
+                                                   std::vector<char> const& has_result,
+                                                   double probability, std::vector<size_t>& sample,
+                                                   std::vector<T>& sample_results) const {
+    sample.clear();
     std::mt19937 gen(seed_);
 
     std::bernoulli_distribution d(probability);
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        if (d(gen)) {
-            std::byte const* l = lhs.at(i);
-            std::byte const* r = rhs.at(i);
-            if (data[lhs_i].IsNullOrEmpty(i) || data[rhs_i].IsNullOrEmpty(i)) {
-                continue;
-            }
-            auto res = std::unique_ptr<std::byte[]>(num_type_->Allocate());
-            num_type_->ValueFromStr(res.get(), "0");
-            if (bin_operation_ == +Binop::Division &&
-                num_type_->Compare(r, res.get()) == model::CompareResult::kEqual) {
-                continue;
-            }
-            InvokeBinop(l, r, res.get());
-            auto ac = std::make_unique<ACPair>(ACPair::ColumnValueIndex{lhs_i, i},
-                                               ACPair::ColumnValueIndex{rhs_i, i}, l, r,
-                                               std::move(res));
-            ac_pairs.emplace_back(std::move(ac));
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (d(gen) && has_result[i]) {
+            sample.push_back(i);
         }
     }
 
-    std::sort(ac_pairs.begin(), ac_pairs.end(),
-              [this](std::unique_ptr<ACPair> const& a, std::unique_ptr<ACPair> const& b) {
-                  return model::CompareResult::kLess ==
-                         this->num_type_->Compare(a->GetRes(), b->GetRes());
-              });
+    std::sort(sample.begin(), sample.end(), [&results](size_t a, size_t b) {
+        return model::CompareResult::kLess == Compare(results[a], results[b]);
+    });
+    sample_results.resize(sample.size());
+    std::transform(sample.begin(), sample.end(), sample_results.begin(),
+                   [&results](size_t row) { return results[row]; });
 
-    return ConstructDisjunctiveRanges(ac_pairs);
+    return ConstructDisjunctiveRanges(sample_results);
 }
 
-void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) const {
+template <typename T>
+void ACAlgorithm::RestrictRangesAmount(std::vector<T> const& results,
+                                       std::vector<size_t>& ranges) const {
     if (bumps_limit_ == 0) {
         return;
     }
@@ -208,7 +240,7 @@ void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) co
         double min_dist = -1;
         size_t min_index = 1;
         for (size_t i = min_index; i < bumps * 2 - 1; i += 2) {
-            double dist = num_type_->Dist(ranges.at(i), ranges.at(i + 1));
+            double dist = Dist(results[ranges.at(i)], results[ranges.at(i + 1)]);
             if (min_dist == -1 || dist < min_dist) {
                 min_dist = dist;
                 min_index = i;
@@ -266,39 +298,37 @@ void ACAlgorithm::PrintRanges(std::vector<model::TypedColumnData> const& data) c
     }
 }
 
-std::vector<std::byte const*> ACAlgorithm::ConstructDisjunctiveRanges(
-        ACPairs const& ac_pairs) const {
-    std::vector<std::byte const*> ranges;
-    if (ac_pairs.size() < 2) {
-        ranges = std::vector<std::byte const*>();
+template <typename T>
+std::vector<size_t> ACAlgorithm::ConstructDisjunctiveRanges(std::vector<T> const& results) const {
+    std::vector<size_t> ranges;
+    if (results.size() < 2) {
         return ranges;
     }
 
-    ACPair const* l_border = ac_pairs.front().get();
-    ACPair const* r_border = nullptr;
+    size_t l_border = 0;
+    std::optional<size_t> r_border;
 
     if (weight_ < 1) {
-        double delta = num_type_->Dist(ac_pairs.front()->GetRes(), ac_pairs.back()->GetRes()) *
-                       (weight_ / (1 - weight_));
+        double delta = Dist(results.front(), results.back()) * (weight_ / (1 - weight_));
 
-        for (size_t i = 0; i < ac_pairs.size() - 1; ++i) {
-            if (num_type_->Dist(ac_pairs[i]->GetRes(), ac_pairs[i + 1]->GetRes()) <= delta) {
-                r_border = ac_pairs[i + 1].get();
+        for (size_t i = 0; i < results.size() - 1; ++i) {
+            if (Dist(results[i], results[i + 1]) <= delta) {
+                r_border = i + 1;
             } else {
-                ranges.emplace_back(l_border->GetRes());
-                ranges.emplace_back(ac_pairs[i]->GetRes());
-                l_border = ac_pairs[i + 1].get();
-                r_border = ac_pairs[i + 1].get();
+                ranges.emplace_back(l_border);
+                ranges.emplace_back(i);
+                l_border = i + 1;
+                r_border = i + 1;
             }
         }
     } else {
         assert(weight_ == 1);
-        r_border = ac_pairs.back().get();
+        r_border = results.size() - 1;
     }
 
-    if (r_border == ac_pairs.back().get()) {
-        ranges.emplace_back(l_border->GetRes());
-        ranges.emplace_back(r_border->GetRes());
+    if (r_border == results.size() - 1) {
+        ranges.emplace_back(l_border);
+        ranges.emplace_back(*r_border);
     }
 
     return ranges;
@@ -309,12 +339,87 @@ RangesCollection ACAlgorithm::ReconstructRangesByColumns(size_t lhs_i, size_t rh
     SetOption(config::names::kWeight, weight);
     ACPairsCollection const& constraints_collection = GetACPairsByColumns(lhs_i, rhs_i);
     ACPairs const& ac_pairs = constraints_collection.ac_pairs;
-    std::vector<std::byte const*> ranges = ConstructDisjunctiveRanges(ac_pairs);
     model::TypeId type_id = constraints_collection.col_pair.num_type->GetTypeId();
+    auto construct_ranges = [&]<typename T>() {
+        std::vector<T> results;
+        results.reserve(ac_pairs.size());
+        for (auto const& ac_pair : ac_pairs) {
+            results.push_back(model::Type::GetValue<T>(ac_pair->GetRes()));
+        }
+        return ConstructDisjunctiveRanges(results);
+    };
+    std::vector<size_t> const positions = type_id == +model::TypeId::kInt
+                                                  ? construct_ranges.operator()<model::Int>()
+                                                  : construct_ranges.operator()<model::Double>();
+    std::vector<std::byte const*> ranges;
+    ranges.reserve(positions.size());
+    for (size_t position : positions) {
+        ranges.push_back(ac_pairs[position]->GetRes());
+    }
     return RangesCollection{model::CreateSpecificType<model::INumericType>(type_id, true),
                             std::move(ranges), lhs_i, rhs_i};
 }
 
+template <typename T>
+ACAlgorithm::ColumnPairResult ACAlgorithm::ProcessColumnPair(NumericColumn const& lhs,
+                                                             NumericColumn const& rhs,
+                                                             size_t lhs_i, size_t rhs_i) const {
+    std::vector<T> const& lhs_values = std::get<std::vector<T>>(lhs.values);
+    std::vector<T> const& rhs_values = std::get<std::vector<T>>(rhs.values);
+    size_t const n_rows = lhs_values.size();
+
+    std::vector<T> results(n_rows);
+    algebraic_constraints::ApplyBinop(bin_operation_, lhs_values, rhs_values, results);
+    std::vector<char> has_result(n_rows);
+    for (size_t i = 0; i < n_rows; ++i) {
+        has_result[i] = lhs.has_value[i] && rhs.has_value[i] &&
+                        !(bin_operation_ == +Binop::Division &&
+                          Compare(rhs_values[i], T{0}) == model::CompareResult::kEqual);
+    }
+
+    std::vector<size_t> sample;
+    std::vector<T> sample_results;
+    std::vector<size_t> const positions = Sampling(results, has_result, sample, sample_results);
+
+    ColumnPairResult pair_result;
+    std::vector<model::TypedColumnData> const& data = typed_relation_->GetColumnData();
+    std::vector<std::byte const*> const& lhs_data = data[lhs_i].GetData();
+    std::vector<std::byte const*> const& rhs_data = data[rhs_i].GetData();
+    pair_result.ac_pairs.reserve(sample.size());
+    for (size_t i = 0; i < sample.size(); ++i) {
+        size_t const row = sample[i];
+        pair_result.ac_pairs.emplace_back(std::make_unique<ACPair>(
+                ACPair::ColumnValueIndex{lhs_i, row}, ACPair::ColumnValueIndex{rhs_i, row},
+                lhs_data[row], rhs_data[row], MakeValue(sample_results[i])));
+    }
+
+    std::vector<T> range_borders;
+    range_borders.reserve(positions.size());
+    for (size_t position : positions) {
+        pair_result.ranges.push_back(pair_result.ac_pairs[position]->GetRes());
+        range_borders.push_back(sample_results[position]);
+    }
+
+    /* Exceptions are found while the results are at hand */
+    for (size_t i = 0; i < n_rows; ++i) {
+        if (has_result[i] &&
+            !algebraic_constraints::ValueBelongsToRanges(range_borders, results[i])) {
+            pair_result.exception_rows.push_back(i);
+        }
+    }
+    return pair_result;
+}
+
+ACAlgorithm::ColumnPairResult ACAlgorithm::ProcessColumnPair(
+        std::vector<NumericColumn> const& columns, size_t lhs_i, size_t rhs_i) const {
+    NumericColumn const& lhs = columns[lhs_i];
+    NumericColumn const& rhs = columns[rhs_i];
+    if (std::holds_alternative<std::vector<model::Int>>(lhs.values)) {
+        return ProcessColumnPair<model::Int>(lhs, rhs, lhs_i, rhs_i);
+    }
+    return ProcessColumnPair<model::Double>(lhs, rhs, lhs_i, rhs_i);
+}
+
 unsigned long long ACAlgorithm::ExecuteInternal() {
     std::vector<model::TypedColumnData> const& data = typed_relation_->GetColumnData();
     if (data.empty()) {
@@ -322,29 +427,54 @@ unsigned long long ACAlgorithm::ExecuteInternal() {
     }
     auto start_time = std::chrono::system_clock::now();
 
-    for (size_t col_i = 0; col_i < data.size() - 1; ++col_i) {
-        if (!data.at(col_i).GetType().IsNumeric()) continue;
-        num_type_ =
-                model::CreateSpecificType<model::INumericType>(data.at(col_i).GetTypeId(), true);
+    std::vector<NumericColumn> columns(data.size());
+    std::vector<std::pair<size_t, size_t>> col_pairs;
+    for (size_t col_i = 0; col_i < data.size(); ++col_i) {
+        model::TypedColumnData const& column = data[col_i];
+        if (!column.GetType().IsNumeric()) continue;
+        columns[col_i].has_value = GetHasValue(column);
+        if (column.GetTypeId() == +model::TypeId::kInt) {
+            columns[col_i].values = GetValues<model::Int>(column, columns[col_i].has_value);
+        } else {
+            columns[col_i].values = GetValues<model::Double>(column, columns[col_i].has_value);
+        }
+
         for (size_t col_k = col_i + 1; col_k < data.size(); ++col_k) {
-            if (data.at(col_i).GetTypeId() == data.at(col_k).GetTypeId()) {
-                ranges_.emplace_back(
-                        RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                 data.at(col_i).GetTypeId(), true),
-                                         Sampling(data, col_i, col_k), col_i, col_k});
+            if (column.GetTypeId() == data[col_k].GetTypeId()) {
+                col_pairs.emplace_back(col_i, col_k);
                 /* Because of asymmetry and division by 0, we need to rediscover ranges.
                  * We don't need to do that for minus: (column1 - column2) lies in *some ranges*
                  * there we can express one column through another without possible problems */
                 if (bin_operation_ == +Binop::Division) {
-                    ranges_.emplace_back(
-                            RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                     data.at(col_i).GetTypeId(), true),
-                                             Sampling(data, col_k, col_i), col_k, col_i});
+                    col_pairs.emplace_back(col_k, col_i);
                 }
             }
         }
     }
 
+    /* Column pairs are independent, their results are stored in the order of the pairs */
+    std::vector<ColumnPairResult> results(col_pairs.size());
+    std::atomic<size_t> next_pair = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (size_t i = next_pair++; i < col_pairs.size(); i = next_pair++) {
+            results[i] = ProcessColumnPair(columns, col_pairs[i].first, col_pairs[i].second);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    for (size_t i = 0; i < col_pairs.size(); ++i) {
+        auto const [lhs_i, rhs_i] = col_pairs[i];
+        model::TypeId const type_id = data[lhs_i].GetTypeId();
+        ac_pairs_.emplace_back(model::CreateSpecificType<model::INumericType>(type_id, true),
+                               std::move(results[i].ac_pairs), lhs_i, rhs_i);
+        ranges_.emplace_back(model::CreateSpecificType<model::INumericType>(type_id, true),
+                             std::move(results[i].ranges), lhs_i, rhs_i);
+        ac_exception_finder_->AddColumnPairExceptions(col_pairs[i],
+                                                      std::move(results[i].exception_rows));
+    }
+
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     PrintRanges(data);
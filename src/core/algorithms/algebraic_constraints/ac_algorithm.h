@@ -1,6 +1,5 @@
 #pragma once
 
-#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +12,7 @@
 #include "core/algorithms/algebraic_constraints/typed_column_pair.h"
 #include "core/algorithms/algorithm.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 #include "core/model/types/types.h"
 #include "core/util/better_enum_with_visibility.h"
@@ -54,38 +54,57 @@ private:
     std::unique_ptr<TypedRelation> typed_relation_;
     std::unique_ptr<algebraic_constraints::ACExceptionFinder> ac_exception_finder_;
     double seed_;
+    config::ThreadNumType threads_num_ = 1;
     std::vector<ACPairsCollection> ac_pairs_;
     std::vector<RangesCollection> ranges_;
-    model::INumericType::NumericBinop binop_pointer_ = nullptr;
-    std::unique_ptr<model::INumericType> num_type_;
 
-    /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
-     * Value pairs (by which ranges constructed) fall into sample selection with chosen probability.
+    /* Values of a numeric column, nulls and empty values are replaced with zeros */
+    struct NumericColumn;
+
+    /* Sample of value pairs, ranges and exceptions discovered for a column pair */
+    struct ColumnPairResult {
+        ACPairs ac_pairs;
+        std::vector<std::byte const*> ranges;
+        std::vector<size_t> exception_rows;
+    };
+
+    ColumnPairResult ProcessColumnPair(std::vector<NumericColumn> const& columns, size_t lhs_i,
+                                       size_t rhs_i) const;
+    /* Applies the binary operation to the whole columns, then constructs the ranges and finds
+     * the exceptions using the results */
+    template <typename T>
+    ColumnPairResult ProcessColumnPair(NumericColumn const& lhs, NumericColumn const& rhs,
+                                       size_t lhs_i, size_t rhs_i) const;
+    /* Fills sample with rows, which value pairs fall into sample selection with chosen
+     * probability, and sample_results with the results of binary operation for them, in
+     * ascending order. Returns positions of ranges boundaries in sample_results.
      */
-    std::vector<std::byte const*> SamplingIteration(std::vector<model::TypedColumnData> const& data,
-                                                    size_t lhs_i, size_t rhs_i, double probability,
-                                                    ACPairs& ac_pairs);
-    /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
-     * These ranges are part of AC for that column pair (as in AC definition). Uses iterative
-     * algorithm that uses SamplingIteration method. In the vast majority of cases there is less
-     *  than 4 iterations.  */
-    std::vector<std::byte const*> Sampling(std::vector<model::TypedColumnData> const& data,
-                                           size_t lhs_i, size_t rhs_i);
-    /* Returns vector with ranges boundaries. Ranges constructed by grouping results of binary
-     * operation between values in ac_pairs. */
-    std::vector<std::byte const*> ConstructDisjunctiveRanges(ACPairs const& ac_pairs) const;
+    template <typename T>
+    std::vector<size_t> SamplingIteration(std::vector<T> const& results,
+                                          std::vector<char> const& has_result,
+                                          double probability, std::vector<size_t>& sample,
+                                          std::vector<T>& sample_results) const;
+    /* Returns positions of ranges boundaries in sample_results. These ranges are part of AC for
+     * the column pair (as in AC definition). Uses iterative algorithm that uses
+     * SamplingIteration method. In the vast majority of cases there is less than 4 iterations.
+     */
+    template <typename T>
+    std::vector<size_t> Sampling(std::vector<T> const& results,
+                                 std::vector<char> const& has_result, std::vector<size_t>& sample,
+                                 std::vector<T>& sample_results) const;
+    /* Returns positions of ranges boundaries in sorted results. Ranges constructed by grouping
+     * results of binary operation. */
+    template <typename T>
+    std::vector<size_t> ConstructDisjunctiveRanges(std::vector<T> const& results) const;
     /* Greedily combines ranges if there is more than bumps_limit_ */
-    void RestrictRangesAmount(std::vector<std::byte const*>& ranges) const;
+    template <typename T>
+    void RestrictRangesAmount(std::vector<T> const& results, std::vector<size_t>& ranges) const;
     void RegisterOptions();
     void LoadDataInternal() override;
     void MakeExecuteOptsAvailable() override;
     void ResetState() override;
 
 public:
-    void InvokeBinop(std::byte const* l, std::byte const* r, std::byte* res) const {
-        std::invoke(binop_pointer_, num_type_, l, r, res);
-    }
-
     size_t CalculateSampleSize(size_t k_bumps) const;
     /* Returns ranges reconstructed with new weight for pair of columns */
     RangesCollection ReconstructRangesByColumns(size_t lhs_i, size_t rhs_i, double weight);
@@ -112,7 +131,7 @@ public:
     void PrintRanges(std::vector<model::TypedColumnData> const& data) const;
 
     void CollectACExceptions() const {
-        ac_exception_finder_->CollectExceptions(this);
+        ac_exception_finder_->CollectExceptions();
     }
 
     unsigned long long ExecuteInternal() override;
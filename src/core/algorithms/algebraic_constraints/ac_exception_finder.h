@@ -1,32 +1,27 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "core/algorithms/algebraic_constraints/ac_exception.h"
-#include "core/algorithms/algebraic_constraints/ranges_collection.h"
-#include "core/model/table/column_layout_typed_relation_data.h"
-
-namespace algos {
-class ACAlgorithm;
-}  // namespace algos
 
 namespace algos::algebraic_constraints {
 
 class ACExceptionFinder {
 private:
+    /* Rows with exceptions of every column pair, in the order of discovery of the ranges */
+    std::vector<std::pair<std::pair<size_t, size_t>, std::vector<size_t>>> column_pair_exceptions_;
     std::vector<ACException> exceptions_;
-    ACAlgorithm const* ac_alg_;
-    static bool ValueBelongsToRanges(RangesCollection const& ranges_collection,
-                                     std::byte const* val);
-    /* Creates new ACException and adds it to exceptions_ or adds col_pair to existing one */
-    void AddException(size_t row_i, std::pair<size_t, size_t> const& col_pair);
-    void CollectColumnPairExceptions(std::vector<model::TypedColumnData> const& data,
-                                     RangesCollection const& ranges_collection);
 
 public:
-    void CollectExceptions(ACAlgorithm const* ac_alg);
+    /* Exceptions are found together with the ranges of a column pair */
+    void AddColumnPairExceptions(std::pair<size_t, size_t> const& col_pair,
+                                 std::vector<size_t> rows);
+    /* Groups the exceptions of all column pairs by rows */
+    void CollectExceptions();
 
     void ResetState() {
+        column_pair_exceptions_.clear();
         exceptions_.clear();
     }
 
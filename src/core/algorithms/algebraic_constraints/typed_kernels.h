@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "core/algorithms/algebraic_constraints/bin_operation_enum.h"
+#include "core/model/types/double_type.h"
+#include "core/model/types/type.h"
+
+namespace algos::algebraic_constraints {
+
+/* Typed versions of the INumericType operations AC discovery is made of. T is model::Int or
+ * model::Double. They are applied to whole columns, so there are no virtual calls per value
+ * and the compiler vectorizes the loops. Results are the same as the ones of INumericType */
+
+template <typename T>
+model::CompareResult Compare(T l, T r) {
+    if constexpr (std::is_same_v<T, model::Double>) {
+        return model::DoubleType::CompareEPS(reinterpret_cast<std::byte const*>(&l),
+                                             reinterpret_cast<std::byte const*>(&r),
+                                             model::DoubleType::kDefaultEpsCount);
+    } else {
+        if (l == r) {
+            return model::CompareResult::kEqual;
+        }
+        return l < r ? model::CompareResult::kLess : model::CompareResult::kGreater;
+    }
+}
+
+template <typename T>
+double Dist(T l, T r) {
+    return std::abs(l - r);
+}
+
+/* res[i] = lhs[i] op rhs[i]. For integers, results of division by zero are zeros */
+template <typename T>
+void ApplyBinop(Binop bin_operation, std::vector<T> const& lhs, std::vector<T> const& rhs,
+                std::vector<T>& res) {
+    size_t const size = res.size();
+    T const* l = lhs.data();
+    T const* r = rhs.data();
+    T* out = res.data();
+    switch (bin_operation) {
+        case +Binop::Addition:
+            for (size_t i = 0; i < size; ++i) out[i] = l[i] + r[i];
+            break;
+        case +Binop::Subtraction:
+            for (size_t i = 0; i < size; ++i) out[i] = l[i] - r[i];
+            break;
+        case +Binop::Multiplication:
+            for (size_t i = 0; i < size; ++i) out[i] = l[i] * r[i];
+            break;
+        case +Binop::Division:
+            if constexpr (std::is_integral_v<T>) {
+                for (size_t i = 0; i < size; ++i) out[i] = r[i] == 0 ? 0 : l[i] / r[i];
+            } else {
+                for (size_t i = 0; i < size; ++i) out[i] = l[i] / r[i];
+            }
+            break;
+    }
+}
+
+/* Checks if val lies in one of the ranges, ranges[2k] and ranges[2k + 1] are the borders of
+ * the k-th range. A value lies in a range if it is equal to a border or strictly between them,
+ * so the cheap check of the latter is done first */
+template <typename T>
+bool ValueBelongsToRanges(std::vector<T> const& ranges, T val) {
+    for (size_t i = 0; i + 1 < ranges.size(); i += 2) {
+        if (ranges[i] < val && val < ranges[i + 1]) {
+            return true;
+        }
+    }
+    for (size_t i = 0; i + 1 < ranges.size(); i += 2) {
+        if (Compare(ranges[i], val) == model::CompareResult::kEqual ||
+            Compare(val, ranges[i + 1]) == model::CompareResult::kEqual) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace algos::algebraic_constraints
@@ -76,7 +76,12 @@ bool Algorithm::AllRequiredOptionsAreSet() const noexcept {
 void Algorithm::LoadData() {
     if (!AllRequiredOptionsAreSet())
         throw std::logic_error("All options need to be set before starting processing.");
-    LoadDataInternal();
+    metrics_.Reset();
+    util::metrics::MetricsScope metrics_scope{&metrics_};
+    {
+        DESBORDANTE_METRICS_PHASE("load_data");
+        LoadDataInternal();
+    }
     ExecutePrepare();
 }
 
@@ -87,7 +92,13 @@ unsigned long long Algorithm::Execute() {
     if (!AllRequiredOptionsAreSet())
         throw std::logic_error("All options need to be set before execution.");
     ResetState();
-    auto time_ms = ExecuteInternal();
+    util::metrics::MetricsScope metrics_scope{&metrics_};
+    unsigned long long time_ms;
+    {
+        DESBORDANTE_METRICS_PHASE("execute");
+        time_ms = ExecuteInternal();
+    }
+    FlushResults();
     for (auto const& opt_name : available_options_) {
         possible_options_.at(opt_name)->Unset();
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <ostream>
 #include <string_view>
 #include <typeindex>
 #include <unordered_map>
@@ -14,6 +15,7 @@
 #include "core/config/option.h"
 #include "core/model/table/idataset_stream.h"
 #include "core/parser/csv_parser/csv_parser.h"
+#include "core/util/metrics.h"
 
 namespace algos {
 
@@ -28,6 +30,8 @@ private:
 
     bool data_loaded_ = false;
 
+    util::metrics::MetricsRegistry metrics_;
+
     // Clear the necessary fields for Execute to run repeatedly with different
     // configuration parameters on the same dataset.
     virtual void ResetState() = 0;
@@ -36,6 +40,8 @@ private:
     void ClearOptions() noexcept;
     virtual void LoadDataInternal() = 0;
     virtual unsigned long long ExecuteInternal() = 0;
+    // Hand the results over to the sinks set by the user, if the algorithm supports them
+    virtual void FlushResults() {}
     bool AllRequiredOptionsAreSet() const noexcept;
 
 protected:
@@ -93,6 +99,26 @@ public:
 
     [[nodiscard]] bool OptionIsSet(std::string_view option_name) const;
 
+    // Counters, histograms and phase timings reported during the last LoadData and all Execute
+    // calls since then. Empty if Desbordante is built without DESBORDANTE_METRICS.
+    [[nodiscard]] util::metrics::Metrics GetMetrics() const {
+        return metrics_.Snapshot();
+    }
+
+    void ResetMetrics() {
+        metrics_.Reset();
+    }
+
+    // Keep every phase for WriteTrace
+    void SetTracing(bool enabled) {
+        metrics_.SetTracing(enabled);
+    }
+
+    // Write traced phases and counters in Chrome trace event format
+    void WriteTrace(std::ostream& out) const {
+        metrics_.WriteChromeTrace(out);
+    }
+
     std::unordered_map<std::string_view, config::OptValue> GetOptValues() const {
         std::unordered_map<std::string_view, config::OptValue> opt_values;
         for (auto const& [name, option] : possible_options_) {
@@ -8,7 +8,6 @@
 #include "core/algorithms/association_rules/ar_algorithm.h"
 #include "core/algorithms/association_rules/candidate_hash_tree.h"
 #include "core/algorithms/association_rules/node.h"
-#include "core/model/transaction/itemset.h"
 
 namespace algos {
 
@@ -2,7 +2,6 @@
 
 #include <list>
 
-#include "core/model/transaction/itemset.h"
 #include "core/model/transaction/transactional_data.h"
 
 namespace model {
@@ -6,6 +6,7 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
 
 namespace algos {
@@ -13,7 +14,7 @@ namespace algos {
 ARAlgorithm::ARAlgorithm() : Algorithm() {
     using namespace config::names;
     RegisterOptions();
-    MakeOptionsAvailable({kTable, kInputFormat});
+    MakeOptionsAvailable({kTable, kInputFormat, kThreads});
 }
 
 void ARAlgorithm::RegisterOptions() {
@@ -30,6 +31,7 @@ void ARAlgorithm::RegisterOptions() {
     RegisterOption(Option{&tid_column_index_, kTIdColumnIndex, kDTIdColumnIndex, 0u});
     RegisterOption(Option{&input_format_, kInputFormat, kDInputFormat}.SetConditionalOpts(
             {{sing_eq, {kTIdColumnIndex, kItemColumnIndex}}, {tab_eq, {kFirstColumnTId}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void ARAlgorithm::ResetState() {
@@ -46,11 +48,12 @@ void ARAlgorithm::LoadDataInternal() {
     switch (input_format_) {
         case InputFormat::singular:
             transactional_data_ = model::TransactionalData::CreateFromSingular(
-                    *input_table_, tid_column_index_, item_column_index_);
+                    *input_table_, tid_column_index_, item_column_index_, threads_num_);
             break;
         case InputFormat::tabular:
             transactional_data_ =
-                    model::TransactionalData::CreateFromTabular(*input_table_, first_column_tid_);
+                    model::TransactionalData::CreateFromTabular(*input_table_, first_column_tid_,
+                                                                threads_num_);
             break;
         default:
             assert(0);
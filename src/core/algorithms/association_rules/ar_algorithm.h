@@ -11,6 +11,7 @@
 #include "core/algorithms/association_rules/ar.h"
 #include "core/algorithms/association_rules/ar_algorithm_enums.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/transaction/transactional_data.h"
 
 namespace algos {
@@ -51,6 +52,7 @@ private:
 protected:
     std::shared_ptr<model::TransactionalData> transactional_data_;
     double minsup_;
+    config::ThreadNumType threads_num_ = 1;
 
     void GenerateRulesFrom(std::vector<unsigned> const& frequent_itemset, double support);
 
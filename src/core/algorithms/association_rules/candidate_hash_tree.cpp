@@ -55,9 +55,8 @@ unsigned CandidateHashTree::HashFunction(LeafRow const& node_row, unsigned level
 }
 
 void CandidateHashTree::FindAndVisitLeaves(HashTreeNode& subtree_root,
-                                           std::vector<unsigned>::const_iterator start,
-                                           std::vector<unsigned> const& transaction_items,
-                                           int tid) {
+                                           std::span<unsigned const>::iterator start,
+                                           std::span<unsigned const> transaction_items, int tid) {
     unsigned const next_branch_number = ItemHash(*start);
     auto& next_node = subtree_root.children[next_branch_number];
     if (next_node.children.empty()) {
@@ -70,8 +69,8 @@ void CandidateHashTree::FindAndVisitLeaves(HashTreeNode& subtree_root,
     }
 }
 
-void CandidateHashTree::VisitLeaf(HashTreeNode& leaf,
-                                  std::vector<unsigned> const& transaction_items, int tid) {
+void CandidateHashTree::VisitLeaf(HashTreeNode& leaf, std::span<unsigned const> transaction_items,
+                                  int tid) {
     if (leaf.last_visited_transaction_id == tid) {
         return;
     }
@@ -88,9 +87,8 @@ void CandidateHashTree::VisitLeaf(HashTreeNode& leaf,
 }
 
 void CandidateHashTree::PerformCounting() {
-    for (auto const& transaction : transactional_data_->GetTransactions()) {
-        auto const& items = transaction.second.GetItemsIDs();
-        auto const tid = transaction.first;
+    for (size_t tid = 0; tid < transactional_data_->GetNumTransactions(); ++tid) {
+        std::span<unsigned const> const items = transactional_data_->GetTransaction(tid);
         if (root_.children.empty()) {
             // if the root is a leaf itself
             VisitLeaf(root_, items, tid);
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <list>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
 #include "core/algorithms/association_rules/node.h"
 #include "core/model/transaction/transactional_data.h"
 
@@ -49,10 +54,9 @@ private:
 
     void AppendRow(LeafRow row, HashTreeNode& subtree_root);
     void AddLevel(HashTreeNode& leaf_node);
-    void FindAndVisitLeaves(HashTreeNode& subtree_root, std::vector<unsigned>::const_iterator start,
-                            std::vector<unsigned> const& transaction_items, int tid);
-    static void VisitLeaf(HashTreeNode& leaf, std::vector<unsigned> const& transaction_items,
-                          int tid);
+    void FindAndVisitLeaves(HashTreeNode& subtree_root, std::span<unsigned const>::iterator start,
+                            std::span<unsigned const> transaction_items, int tid);
+    static void VisitLeaf(HashTreeNode& leaf, std::span<unsigned const> transaction_items, int tid);
     void Prune(double minsup, HashTreeNode& subtree_root);
     void AddCandidates();
 
@@ -0,0 +1,151 @@
+#include "core/algorithms/association_rules/eclat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+
+#include "core/util/logger.h"
+#include "core/util/parallel_for.h"
+
+namespace algos {
+
+void Eclat::ResetStateAr() {
+    root_ = Node();
+}
+
+std::vector<eclat::TidSet> Eclat::CreateFirstLevel() {
+    std::size_t const num_transactions = transactional_data_->GetNumTransactions();
+    std::vector<std::vector<unsigned>> tid_lists = transactional_data_->GetTidLists();
+
+    std::vector<eclat::TidSet> tid_sets;
+    for (unsigned item_id = 0; item_id < tid_lists.size(); ++item_id) {
+        double const support = static_cast<double>(tid_lists[item_id].size()) / num_transactions;
+        if (support < minsup_) {
+            continue;
+        }
+        root_.children.emplace_back(item_id).support = support;
+        tid_sets.emplace_back(std::move(tid_lists[item_id]), num_transactions);
+    }
+    return tid_sets;
+}
+
+void Eclat::ExtendPrefix(std::vector<Node>& nodes, std::vector<eclat::TidSet> const& tid_sets,
+                         std::size_t prefix_index) const {
+    std::size_t const num_transactions = transactional_data_->GetNumTransactions();
+    Node& prefix = nodes[prefix_index];
+    std::vector<eclat::TidSet> child_tid_sets;
+    for (std::size_t i = prefix_index + 1; i < nodes.size(); ++i) {
+        eclat::TidSet tid_set = tid_sets[prefix_index].Intersect(tid_sets[i]);
+        double const support = static_cast<double>(tid_set.Size()) / num_transactions;
+        if (support < minsup_) {
+            continue;
+        }
+        std::vector<unsigned> items = prefix.items;
+        items.push_back(nodes[i].items.back());
+        prefix.children.emplace_back(std::move(items)).support = support;
+        child_tid_sets.push_back(std::move(tid_set));
+    }
+    ExtendClass(prefix.children, child_tid_sets);
+}
+
+void Eclat::ExtendClass(std::vector<Node>& nodes,
+                        std::vector<eclat::TidSet> const& tid_sets) const {
+    for (std::size_t i = 0; i + 1 < nodes.size(); ++i) {
+        ExtendPrefix(nodes, tid_sets, i);
+    }
+}
+
+unsigned long long Eclat::FindFrequent() {
+    auto start_time = std::chrono::system_clock::now();
+
+    std::vector<eclat::TidSet> const tid_sets = CreateFirstLevel();
+    std::vector<Node>& items = root_.children;
+    // Every worker only appends to the children of the items it takes, so the tree is filled
+    // without synchronization and does not depend on the number of threads.
+    std::atomic<std::size_t> next_item = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (std::size_t i = next_item++; i + 1 < items.size(); i = next_item++) {
+            ExtendPrefix(items, tid_sets, i);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+void Eclat::UpdatePath(std::queue<Node const*>& path, std::vector<Node> const& vertices) {
+    for (auto const& vertex : vertices) {
+        path.push(&vertex);
+    }
+}
+
+unsigned long long Eclat::GenerateAllRules() {
+    auto start_time = std::chrono::system_clock::now();
+
+    std::queue<Node const*> path;
+    UpdatePath(path, root_.children);
+    unsigned long long frequent_count = 0;
+
+    while (!path.empty()) {
+        auto curr_node = path.front();
+        path.pop();
+
+        ++frequent_count;
+        if (curr_node->items.size() >= 2) {
+            GenerateRulesFrom(curr_node->items, curr_node->support);
+        }
+        UpdatePath(path, curr_node->children);
+    }
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+
+    LOG_INFO("> Count of frequent itemsets: {}", frequent_count);
+    return elapsed_milliseconds.count();
+}
+
+std::list<std::set<std::string>> Eclat::GetFrequentList() const {
+    std::list<std::set<std::string>> frequent_itemsets;
+
+    std::queue<Node const*> path;
+    UpdatePath(path, root_.children);
+
+    while (!path.empty()) {
+        auto const curr_node = path.front();
+        path.pop();
+
+        std::set<std::string> item_names;
+        for (unsigned int item : curr_node->items) {
+            item_names.insert(transactional_data_->GetItemUniverse()[item]);
+        }
+
+        frequent_itemsets.push_back(std::move(item_names));
+        UpdatePath(path, curr_node->children);
+    }
+
+    return frequent_itemsets;
+}
+
+double Eclat::GetSupport(std::vector<unsigned> const& frequent_itemset) const {
+    std::vector<Node> const* nodes = &root_.children;
+    for (std::size_t i = 0; i < frequent_itemset.size(); ++i) {
+        auto node = std::ranges::lower_bound(
+                *nodes, frequent_itemset[i], {},
+                [](Node const& node) { return node.items.back(); });
+        if (node == nodes->end() || node->items.back() != frequent_itemset[i]) {
+            break;
+        }
+        if (i == frequent_itemset.size() - 1) {
+            return node->support;
+        }
+        nodes = &node->children;
+    }
+    return -1;
+}
+
+}  // namespace algos
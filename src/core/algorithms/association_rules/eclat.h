@@ -0,0 +1,41 @@
+#pragma once
+
+#include <list>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/algorithms/association_rules/ar_algorithm.h"
+#include "core/algorithms/association_rules/node.h"
+#include "core/algorithms/association_rules/tid_set.h"
+
+namespace algos {
+
+// Frequent itemsets are mined depth-first over the vertical layout of the data: every itemset has
+// the set of ids of the transactions containing it, and the tid set of an extension of a prefix
+// is the intersection of the tid sets of two itemsets of the prefix's equivalence class. The
+// classes of the single items are independent, so they are processed in parallel. The itemsets
+// are stored in the same prefix tree Apriori builds, hence the results of the two are the same.
+class Eclat : public ARAlgorithm {
+private:
+    Node root_;
+
+    std::vector<eclat::TidSet> CreateFirstLevel();
+    void ExtendClass(std::vector<Node>& nodes, std::vector<eclat::TidSet> const& tid_sets) const;
+    void ExtendPrefix(std::vector<Node>& nodes, std::vector<eclat::TidSet> const& tid_sets,
+                      std::size_t prefix_index) const;
+
+    static void UpdatePath(std::queue<Node const*>& path, std::vector<Node> const& vertices);
+
+    double GetSupport(std::vector<unsigned> const& frequent_itemset) const override;
+    unsigned long long GenerateAllRules() override;
+    unsigned long long FindFrequent() override;
+
+    void ResetStateAr() final;
+
+public:
+    std::list<std::set<std::string>> GetFrequentList() const override;
+};
+
+}  // namespace algos
@@ -1,3 +1,4 @@
 #pragma once
 
 #include "core/algorithms/association_rules/apriori.h"
+#include "core/algorithms/association_rules/eclat.h"
@@ -0,0 +1,53 @@
+#include "core/algorithms/association_rules/tid_set.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace algos::eclat {
+
+TidSet::TidSet(std::vector<unsigned> sorted_ids, std::size_t num_transactions)
+    : num_transactions_(num_transactions), size_(sorted_ids.size()), ids_(std::move(sorted_ids)) {
+    Optimize();
+}
+
+void TidSet::Optimize() {
+    if (ShouldBeBitmap() && !IsBitmap()) {
+        bits_.resize(num_transactions_);
+        for (unsigned id : ids_) {
+            bits_.set(id);
+        }
+        ids_ = {};
+    } else if (!ShouldBeBitmap() && IsBitmap()) {
+        ids_.reserve(size_);
+        for (std::size_t id = bits_.find_first(); id != boost::dynamic_bitset<>::npos;
+             id = bits_.find_next(id)) {
+            ids_.push_back(id);
+        }
+        bits_ = {};
+    }
+}
+
+TidSet TidSet::Intersect(TidSet const& other) const {
+    assert(num_transactions_ == other.num_transactions_);
+    TidSet result;
+    result.num_transactions_ = num_transactions_;
+    if (IsBitmap() && other.IsBitmap()) {
+        result.bits_ = bits_ & other.bits_;
+        result.size_ = result.bits_.count();
+        result.Optimize();
+    } else if (IsBitmap() || other.IsBitmap()) {
+        TidSet const& array = IsBitmap() ? other : *this;
+        boost::dynamic_bitset<> const& bitmap = IsBitmap() ? bits_ : other.bits_;
+        std::ranges::copy_if(array.ids_, std::back_inserter(result.ids_),
+                             [&bitmap](unsigned id) { return bitmap.test(id); });
+        result.size_ = result.ids_.size();
+    } else {
+        result.ids_.reserve(std::min(size_, other.size_));
+        std::ranges::set_intersection(ids_, other.ids_, std::back_inserter(result.ids_));
+        result.size_ = result.ids_.size();
+    }
+    return result;
+}
+
+}  // namespace algos::eclat
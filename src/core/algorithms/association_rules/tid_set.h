@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+namespace algos::eclat {
+
+// Set of (dense) transaction ids. Like a container of a roaring bitmap, it is stored either as a
+// sorted array of ids or as a bitmap over all the transactions, whichever takes less memory, so
+// that sparse tid-lists stay small and intersections of dense ones are word-wise ANDs.
+class TidSet {
+private:
+    std::size_t num_transactions_ = 0;
+    std::size_t size_ = 0;
+    std::vector<unsigned> ids_;
+    boost::dynamic_bitset<> bits_;
+
+    bool ShouldBeBitmap() const noexcept {
+        return size_ * 32 >= num_transactions_;
+    }
+
+    void Optimize();
+
+public:
+    TidSet() = default;
+    TidSet(std::vector<unsigned> sorted_ids, std::size_t num_transactions);
+
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool IsBitmap() const noexcept {
+        return bits_.size() != 0;
+    }
+
+    TidSet Intersect(TidSet const& other) const;
+};
+
+}  // namespace algos::eclat
@@ -1,6 +1,7 @@
 #include "core/algorithms/cfd/fd_first_algorithm.h"
 
 #include <iterator>
+#include <numeric>
 
 #include <boost/unordered_map.hpp>
 
@@ -12,6 +13,7 @@
 #include "core/config/exceptions.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
 
 // see algorithms/cfd/LICENSE
@@ -30,6 +32,7 @@ void FDFirstAlgorithm::RegisterOptions() {
     RegisterOption(Option{&min_conf_, kCfdMinimumConfidence, kDCfdMinimumConfidence, 0.0});
     RegisterOption(Option{&max_lhs_, kCfdMaximumLhs, kDCfdMaximumLhs, 0u});
     RegisterOption(Option{&substrategy_, kCfdSubstrategy, kDCfdSubstrategy, default_val});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void FDFirstAlgorithm::ResetStateCFD() {
@@ -45,7 +48,9 @@ unsigned long long FDFirstAlgorithm::ExecuteInternal() {
     max_cfd_size_ = max_lhs_ + 1;
     CheckForIncorrectInput();
     auto start_time = std::chrono::system_clock::now();
+    if (threads_num_ > 1) pool_.emplace(threads_num_);
     FdsFirstDFS();
+    pool_.reset();
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     unsigned long long apriori_millis = elapsed_milliseconds.count();
@@ -93,31 +98,64 @@ void FDFirstAlgorithm::CheckForIncorrectInput() const {
 void FDFirstAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
 
-    MakeOptionsAvailable(
-            {kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs, kCfdSubstrategy});
+    MakeOptionsAvailable({kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs,
+                          kCfdSubstrategy, config::kThreadNumberOpt.GetName()});
 }
 
-bool FDFirstAlgorithm::Precedes(Itemset const& a, Itemset const& b) {
-    if (a.size() > b.size() || a == b) return false;
+// Calls func(i) for every i in [0, size), in parallel if the algorithm has a thread pool
+template <typename Func>
+void FDFirstAlgorithm::ForEachIndex(std::size_t size, Func func) {
+    if (pool_ && size > 1) {
+        pool_->ExecIndex(std::move(func), size);
+        return;
+    }
+    for (std::size_t i = 0; i < size; i++) {
+        func(i);
+    }
+}
+
+// Returns the items placed at the positions of their attributes
+Itemset FDFirstAlgorithm::GetPattern(Itemset const& items) const {
     Itemset pattern(relation_->GetAttrsNumber());
-    for (int v : b) {
+    for (int v : items) {
         if (v > 0) {
             pattern[relation_->GetAttrIndex(v)] = v;
         } else {
             pattern[-1 - v] = v;
         }
     }
+    return pattern;
+}
+
+bool FDFirstAlgorithm::Precedes(Itemset const& a, Itemset const& b,
+                                Itemset const& b_pattern) const {
+    if (a.size() > b.size() || a == b) return false;
     for (int i : a) {
         if (i > 0) {
-            if (pattern[relation_->GetAttrIndex(i)] != i) return false;
-        } else if (pattern[-1 - i] == 0) {
+            if (b_pattern[relation_->GetAttrIndex(i)] != i) return false;
+        } else if (b_pattern[-1 - i] == 0) {
             return false;
         }
     }
     return true;
 }
 
-bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) {
+// Checks whether an exact rule with the same RHS and a more general LHS is already found
+bool FDFirstAlgorithm::HasPrecedingRule(int rhs, Itemset const& lhs,
+                                        bool variable_rules_only) const {
+    auto const rhs_rules = rules_.find(rhs);
+    if (rhs_rules == rules_.end()) return false;
+    Itemset const lhs_pattern = GetPattern(lhs);
+    for (auto const& sub_rule : rhs_rules->second) {
+        if (variable_rules_only &&
+            !std::any_of(sub_rule.begin(), sub_rule.end(), [](int si) -> bool { return si < 0; }))
+            continue;
+        if (Precedes(sub_rule, lhs, lhs_pattern)) return true;
+    }
+    return false;
+}
+
+bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) const {
     int rhs_value;
     bool first = true;
     for (size_t pos_index = 0; pos_index <= items.tids.size(); pos_index++) {
@@ -136,35 +174,28 @@ bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) {
     return true;
 }
 
-void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset const& lhs,
-                              int rhs) {
-    if (inode.tids.sets_number == 1 || IsConstRule(inode.tids, -1 - rhs)) return;
+// Returns nothing if the node does not make lhs -> rhs a candidate FD
+std::optional<double> FDFirstAlgorithm::CalculateFDConfidence(
+        MinerNode<PartitionTIdList> const& inode, Itemset const& lhs, int rhs) const {
+    if (inode.tids.sets_number == 1 || IsConstRule(inode.tids, -1 - rhs)) return std::nullopt;
     auto const stored_sub = store_.find(lhs);
     if (stored_sub == store_.end()) {
-        return;
-    }
-    bool lhs_gen = true;
-    if (free_itemsets_.find(lhs) == free_itemsets_.end()) {
-        lhs_gen = false;
-    }
-    if (rules_.find(rhs) != rules_.end()) {
-        for (auto const& sub_rule : rules_[rhs]) {
-            if (!std::any_of(sub_rule.begin(), sub_rule.end(),
-                             [](int si) -> bool { return si < 0; }))
-                continue;
-            if (Precedes(sub_rule, lhs)) {
-                lhs_gen = false;
-            }
-        }
+        return std::nullopt;
     }
+    // Here the confidence computing method from the paper is used
+    double e = stored_sub->second.PartitionError(inode.tids);
+    return 1 - (e / TIdUtil::Support(stored_sub->second));
+}
+
+void FDFirstAlgorithm::MineFD(Itemset const& lhs, int rhs, std::optional<double> conf) {
+    if (!conf) return;
+    bool const lhs_gen = free_itemsets_.find(lhs) != free_itemsets_.end() &&
+                         !HasPrecedingRule(rhs, lhs, true);
     if (lhs_gen) {
-        // Here the confidence computing method from the paper is used
-        double e = stored_sub->second.PartitionError(inode.tids);
-        double conf = 1 - (e / TIdUtil::Support(stored_sub->second));
-        if (conf >= min_conf_) {
+        if (*conf >= min_conf_) {
             cfd_list_.emplace_back(lhs, rhs);
         }
-        if (conf >= 1) {
+        if (*conf >= 1) {
             rules_[rhs].push_back(lhs);
         }
     }
@@ -226,15 +257,26 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
         MinerNode<PartitionTIdList> const& inode = items[ix];
         Itemset const iset = Join(prefix, inode.item);
         auto const insect = ConstructIntersection(iset, inode.candidates);
-        for (int out : insect) {
+        // FD confidences and tuple partitions are calculated for every RHS in parallel, the
+        // rules are then mined in order, because earlier rules prune the later ones
+        std::vector<std::optional<double>> fd_confidences(insect.size());
+        std::vector<PatternPartitions> pattern_partitions(insect.size());
+        ForEachIndex(insect.size(), [&](std::size_t i) {
+            Itemset const sub = ConstructSubset(iset, insect[i]);
+            fd_confidences[i] = CalculateFDConfidence(inode, sub, insect[i]);
+            pattern_partitions[i] = CollectPatternPartitions(sub, insect[i], inode.tids);
+        });
+        for (std::size_t i = 0; i < insect.size(); i++) {
+            int const out = insect[i];
             Itemset const sub = ConstructSubset(iset, out);
-            MineFD(inode, sub, out);
+            MineFD(sub, out, fd_confidences[i]);
 
             if (ss == +Substrategy::dfs) {
-                MinePatternsDFS(sub, out, inode.tids);
+                MinePatternsDFS(sub, out, pattern_partitions[i]);
             } else if (ss == +Substrategy::bfs) {
-                MinePatternsBFS(sub, out, inode.tids);
+                MinePatternsBFS(sub, out, pattern_partitions[i]);
             }
+            pattern_partitions[i] = PatternPartitions();
         }
 
         if (inode.candidates.empty()) continue;
@@ -244,7 +286,12 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
 
         auto const [expands, tmp_suffix] = ExpandMiningFd(inode, ix, iset, items);
 
-        auto const exps = PartitionTIdListUtil::ConstructIntersection(items[ix].tids, expands);
+        auto const lookup = PartitionTIdListUtil::ConstructClassLookup(items[ix].tids);
+        std::vector<PartitionTIdList> exps(expands.size());
+        ForEachIndex(expands.size(), [&](std::size_t e) {
+            exps[e] = PartitionTIdListUtil::ConstructIntersection(items[ix].tids, lookup,
+                                                                  *expands[e]);
+        });
         PIdListMiners suffix;
         for (size_t e = 0; e < exps.size(); e++) {
             bool gen = true;
@@ -252,7 +299,7 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
             auto const sp = std::make_pair(TIdUtil::Support(exps[e]), exps[e].sets_number);
             auto const free_map_elem = free_map_.find(sp);
             if (free_map_elem != free_map_.end()) {
-                auto const free_cands = free_map_elem->second;
+                auto const& free_cands = free_map_elem->second;
                 for (auto const& sub_cand : free_cands) {
                     if (IsSubsetOf(sub_cand, new_set)) {
                         gen = false;
@@ -312,20 +359,7 @@ void FDFirstAlgorithm::FillMinePatternsVars(PartitionList& partitions, RhsesPair
 void FDFirstAlgorithm::AddCFDToCFDList(std::vector<int> const& sub, int out,
                                        MinerNode<SimpleTIdList> const& inode,
                                        PartitionList const& partitions) {
-    bool lhs_gen = true;
-
-    if (rules_.find(out) != rules_.end()) {
-        for (auto const& sub_rule : rules_[out]) {
-            if (out < 0 &&
-                !std::any_of(
-                        sub_rule.begin(), sub_rule.end(), [](int si) -> bool { return si < 0; }))
-                continue;
-            if (Precedes(sub_rule, sub)) {
-                lhs_gen = false;
-            }
-        }
-    }
-    if (lhs_gen) {
+    if (!HasPrecedingRule(out, sub, out < 0)) {
         unsigned e = PartitionUtil::GetPartitionError(inode.tids, partitions);
         double conf = 1.0 - (static_cast<double>(e) / static_cast<double>(inode.node_supp));
         if (conf >= min_conf_) {
@@ -341,7 +375,6 @@ void FDFirstAlgorithm::AddCFDToCFDList(std::vector<int> const& sub, int out,
 }
 
 void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const& item,
-                                             PartitionList const& partitions,
                                              std::vector<unsigned> const& p_supps,
                                              TIdListMiners& items, Itemset const& lhs) {
     unsigned p_supp = PartitionUtil::GetPartitionSupport(item.second, p_supps);
@@ -350,15 +383,12 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
     }
     Itemset const ns = Join(Itemset{item.first},
                             ConstructSubset(lhs, -1 - relation_->GetAttrIndex(item.first)));
-    std::set<Itemset> nr_parts;
-    for (int pid : item.second) {
-        nr_parts.insert(partitions[pid].first);
-    }
+    // Partitions have distinct LHS constants, so the pids are the distinct LHS patterns
     bool gen = true;
-    auto const sp = std::make_pair(p_supp, nr_parts.size());
+    auto const sp = std::make_pair(p_supp, item.second.size());
     auto const free_map_pair = free_map_.find(sp);
     if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
+        auto const& free_cands = free_map_pair->second;
         for (auto const& sub_cand : free_cands) {
             if (IsSubsetOf(sub_cand, ns)) {
                 gen = false;
@@ -373,9 +403,8 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
     items.emplace_back(item.first, item.second, p_supp);
 }
 
-bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, Itemset const& lhs,
-                                              Itemset const& new_set, SimpleTIdList const& ij_tids,
-                                              unsigned ij_supp) {
+bool FDFirstAlgorithm::FillFreeMapAndItemsets(Itemset const& lhs, Itemset const& new_set,
+                                              SimpleTIdList const& ij_tids, unsigned ij_supp) {
     if (ij_supp < min_supp_) {
         return false;
     }
@@ -383,14 +412,11 @@ bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, I
     bool gen = true;
     auto const nas = relation_->GetAttrVectorItems(new_set);
     Itemset const ns = Join(new_set, SetDiff(lhs, nas));
-    std::set<Itemset> nr_parts;
-    for (int pid : ij_tids) {
-        nr_parts.insert(partitions[pid].first);
-    }
-    auto const sp = std::make_pair(ij_supp, nr_parts.size());
+    // Partitions have distinct LHS constants, so the pids are the distinct LHS patterns
+    auto const sp = std::make_pair(ij_supp, ij_tids.size());
     auto const free_map_pair = free_map_.find(sp);
     if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
+        auto const& free_cands = free_map_pair->second;
         for (auto const& sub_cand : free_cands) {
             if (IsSubsetOf(sub_cand, ns)) {
                 gen = false;
@@ -405,28 +431,31 @@ bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, I
     return true;
 }
 
-void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
-    std::map<int, SimpleTIdList> pid_lists;
-    PartitionList partitions;
-    RhsesPair2DList rhses_pairs;
+FDFirstAlgorithm::PatternPartitions FDFirstAlgorithm::CollectPatternPartitions(
+        Itemset const& lhs, int rhs, PartitionTIdList const& all_tids) const {
+    PatternPartitions res;
     RuleIxs rule_ixs;
     std::vector<int> rhses;
-    FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
-    TIdListMiners items;
-    std::vector<unsigned> p_supps(partitions.size());
+    FillMinePatternsVars(res.partitions, res.rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
+    res.p_supps.resize(res.partitions.size());
     int ri = 0;
-    for (auto const& rule : partitions) {
+    for (auto const& rule : res.partitions) {
         for (int i : rule.first) {
-            pid_lists[i].push_back(ri);
+            res.pid_lists[i].push_back(ri);
         }
         unsigned s = std::accumulate(rule.second.begin(), rule.second.end(), 0u);
-        p_supps[ri] = s;
+        res.p_supps[ri] = s;
         ri++;
     }
+    return res;
+}
 
+void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
+                                       PatternPartitions& pattern_partitions) {
+    auto& [partitions, rhses_pairs, p_supps, pid_lists] = pattern_partitions;
+    TIdListMiners items;
     for (auto const& item : pid_lists) {
-        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs);
+        AnalyzeCFDFromPIdList(item, p_supps, items, lhs);
     }
 
     while (!items.empty()) {
@@ -453,7 +482,7 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
                 Itemset new_set = Join(jset, inode.item);
                 SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
                 unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, p_supps);
-                bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
+                bool result = FillFreeMapAndItemsets(lhs, new_set, ij_tids, ij_supp);
                 if (!result) continue;
                 int jtem = new_set.back();
                 new_set.pop_back();
@@ -465,27 +494,11 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
 }
 
 void FDFirstAlgorithm::MinePatternsDFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
-    std::map<int, SimpleTIdList> pid_lists;
-    PartitionList partitions;
-    RhsesPair2DList rhses_pairs;
-    RuleIxs rule_ixs;
-    std::vector<int> rhses;
-    FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
+                                       PatternPartitions& pattern_partitions) {
+    auto& [partitions, rhses_pairs, p_supps, pid_lists] = pattern_partitions;
     TIdListMiners items;
-    std::vector<unsigned> p_supps(partitions.size());
-    int ri = 0;
-    for (auto const& rule : partitions) {
-        for (int i : rule.first) {
-            pid_lists[i].push_back(ri);
-        }
-        unsigned s = std::accumulate(rule.second.begin(), rule.second.end(), 0u);
-        p_supps[ri] = s;
-        ri++;
-    }
-
     for (auto const& item : pid_lists) {
-        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs);
+        AnalyzeCFDFromPIdList(item, p_supps, items, lhs);
     }
 
     MinePatternsDFS(Itemset(), items, lhs, rhs, rhses_pairs, partitions, p_supps);
@@ -517,7 +530,7 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
             SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
             unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, psupps);
 
-            bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
+            bool result = FillFreeMapAndItemsets(lhs, new_set, ij_tids, ij_supp);
             if (!result) continue;
             suffix.emplace_back(jnode.item, ij_tids, ij_supp);
         }
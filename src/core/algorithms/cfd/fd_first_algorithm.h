@@ -1,10 +1,21 @@
 #pragma once
 
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
 #include "core/algorithms/cfd/cfd_discovery.h"
 #include "core/algorithms/cfd/enums.h"
 #include "core/algorithms/cfd/miner_node.h"
 #include "core/algorithms/cfd/model/partition_tidlist.h"
 #include "core/algorithms/cfd/util/prefix_tree.h"
+#include "core/config/thread_number/type.h"
+#include "core/util/worker_thread_pool.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -14,18 +25,32 @@ class FDFirstAlgorithm : public algos::cfd::CFDDiscovery {
     using PIdListMiners = std::vector<MinerNode<PartitionTIdList>>;
     using TIdListMiners = std::vector<MinerNode<SimpleTIdList>>;
 
+    // Tuples of a node partitioned by the values of the LHS attributes, the input of pattern
+    // mining for one rule LHS -> RHS
+    struct PatternPartitions {
+        PartitionList partitions;
+        RhsesPair2DList rhses_pairs;
+        std::vector<unsigned> p_supps;
+        // Ids of the partitions every item occurs in
+        std::map<int, SimpleTIdList> pid_lists;
+    };
+
 private:
     unsigned min_supp_;
     unsigned max_cfd_size_;
     unsigned max_lhs_;
     double min_conf_;
     Substrategy substrategy_ = Substrategy::dfs;
+    config::ThreadNumType threads_num_ = 1;
 
-    std::map<Itemset, PartitionTIdList> store_;
+    // Only exists while the algorithm is executed with more than one thread
+    std::optional<util::WorkerThreadPool> pool_;
+
+    boost::unordered_map<Itemset, PartitionTIdList> store_;
     PrefixTree<Itemset, Itemset> cand_store_;
     Itemset all_attrs_;
-    std::map<std::pair<int, int>, std::vector<Itemset>> free_map_;
-    std::set<Itemset> free_itemsets_;
+    boost::unordered_map<std::pair<int, int>, std::vector<Itemset>> free_map_;
+    boost::unordered_set<Itemset> free_itemsets_;
     std::unordered_map<int, std::vector<Itemset>> rules_;
 
     void ResetStateCFD() final;
@@ -34,16 +59,25 @@ private:
     void FdsFirstDFS();
     void FdsFirstDFS(Itemset const &, std::vector<MinerNode<PartitionTIdList>> const &,
                      Substrategy = Substrategy::dfs);
-    void MinePatternsBFS(Itemset const &lhs, int rhs, PartitionTIdList const &all_tids);
-    void MinePatternsDFS(Itemset const &lhs, int rhs, PartitionTIdList const &all_tids);
+    template <typename Func>
+    void ForEachIndex(std::size_t size, Func func);
+
+    PatternPartitions CollectPatternPartitions(Itemset const &lhs, int rhs,
+                                               PartitionTIdList const &all_tids) const;
+    void MinePatternsBFS(Itemset const &lhs, int rhs, PatternPartitions &pattern_partitions);
+    void MinePatternsDFS(Itemset const &lhs, int rhs, PatternPartitions &pattern_partitions);
     void MinePatternsDFS(Itemset const &, std::vector<MinerNode<SimpleTIdList>> &, Itemset const &,
                          int, RhsesPair2DList &, PartitionList &, std::vector<unsigned> &);
     std::vector<MinerNode<PartitionTIdList>> GetPartitionSingletons();
 
-    bool Precedes(Itemset const &a, Itemset const &b);
-    bool IsConstRule(PartitionTIdList const &items, int rhs_a);
+    Itemset GetPattern(Itemset const &items) const;
+    bool Precedes(Itemset const &a, Itemset const &b, Itemset const &b_pattern) const;
+    bool HasPrecedingRule(int rhs, Itemset const &lhs, bool variable_rules_only) const;
+    bool IsConstRule(PartitionTIdList const &items, int rhs_a) const;
 
-    void MineFD(MinerNode<PartitionTIdList> const &inode, Itemset const &lhs, int rhs);
+    std::optional<double> CalculateFDConfidence(MinerNode<PartitionTIdList> const &inode,
+                                                Itemset const &lhs, int rhs) const;
+    void MineFD(Itemset const &lhs, int rhs, std::optional<double> conf);
     std::pair<std::vector<PartitionTIdList const *>, std::vector<MinerNode<PartitionTIdList>>>
     ExpandMiningFd(MinerNode<PartitionTIdList> const &inode, int ix, Itemset const &iset,
                    std::vector<MinerNode<PartitionTIdList>> const &items) const;
@@ -54,12 +88,12 @@ private:
     void AddCFDToCFDList(std::vector<int> const &sub, int out,
                          MinerNode<SimpleTIdList> const &inode, PartitionList const &partitions);
 
-    void AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const &, PartitionList const &,
+    void AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const &,
                                std::vector<unsigned> const &,
                                std::vector<MinerNode<SimpleTIdList>> &, Itemset const &);
 
-    bool FillFreeMapAndItemsets(PartitionList const &partitions, Itemset const &lhs,
-                                Itemset const &new_set, SimpleTIdList const &ij_tids, unsigned);
+    bool FillFreeMapAndItemsets(Itemset const &lhs, Itemset const &new_set,
+                                SimpleTIdList const &ij_tids, unsigned);
 
 protected:
     void RegisterOptions();
@@ -1,5 +1,8 @@
 #include "core/algorithms/cfd/model/partition_tidlist.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace algos::cfd {
 
 int const PartitionTIdList::kSep = -1;
@@ -70,11 +73,16 @@ PartitionTIdList PartitionTIdList::Intersection(PartitionTIdList const& rhs) con
 int PartitionTIdList::PartitionError(PartitionTIdList const& xa) const {
     int e = 0;
 
-    std::map<int, int> bigt;
+    // Size of every xa class, stored at the last tid of the class
+    int max_tid = -1;
+    for (int t : xa.tids) {
+        max_tid = std::max(max_tid, t);
+    }
+    std::vector<int> bigt(max_tid + 1, 0);
     int count = 0;
     for (unsigned pi = 0; pi <= xa.tids.size(); pi++) {
         if (pi == xa.tids.size() || xa.tids[pi] == PartitionTIdList::kSep) {
-            bigt[xa.tids[pi - 1]] = count;
+            if (pi != 0) bigt[xa.tids[pi - 1]] = count;
             count = 0;
         } else {
             count++;
@@ -91,7 +99,7 @@ int PartitionTIdList::PartitionError(PartitionTIdList const& xa) const {
         } else {
             count++;
             int t = this->tids[cix];
-            if (bigt.count(t) && bigt[t] > m) {
+            if (t < static_cast<int>(bigt.size()) && bigt[t] > m) {
                 m = bigt[t];
             }
         }
@@ -1,53 +1,75 @@
 #include "core/algorithms/cfd/util/partition_tidlist_util.h"
 
-#include "core/algorithms/cfd/util/tidlist_util.h"
+#include <algorithm>
 
 namespace algos::cfd {
 
-// Computes intersection
-std::vector<PartitionTIdList> PartitionTIdListUtil::ConstructIntersection(
-        PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses) {
-    std::unordered_map<int, int> eq_indices(TIdUtil::Support(lhs.tids));
-    std::vector<std::vector<int> > eq_classes(lhs.sets_number);
-    // Construct a lookup from tid to equivalence class
-    int eix = 0;
-    int count = 0;
-    for (unsigned ix = 0; ix <= lhs.tids.size(); ix++) {
-        count++;
-        if (ix == lhs.tids.size() || lhs.tids[ix] == PartitionTIdList::kSep) {
-            eq_classes[eix++].reserve(count);
-            count = 0;
+std::vector<unsigned> PartitionTIdListUtil::ConstructClassLookup(
+        PartitionTIdList const& partition) {
+    int max_tid = -1;
+    for (int tid : partition.tids) {
+        max_tid = std::max(max_tid, tid);
+    }
+    std::vector<unsigned> lookup(max_tid + 1, 0);
+    unsigned eix = 1;
+    for (int tid : partition.tids) {
+        if (tid == PartitionTIdList::kSep) {
+            eix++;
         } else {
-            eq_indices[lhs.tids[ix]] = eix + 1;
+            lookup[tid] = eix;
         }
     }
-    std::vector<PartitionTIdList> res;
-    for (PartitionTIdList const* rhs : rhses) {
-        PartitionTIdList p_tid_list = PartitionTIdList();
-        p_tid_list.sets_number = 0;
-        p_tid_list.tids.reserve(lhs.tids.size());
-        for (unsigned ix = 0; ix <= rhs->tids.size(); ix++) {
-            if (ix == rhs->tids.size() || rhs->tids[ix] == PartitionTIdList::kSep) {
-                for (auto& eqcl : eq_classes) {
-                    if (!eqcl.empty()) {
-                        p_tid_list.tids.insert(p_tid_list.tids.end(), eqcl.begin(), eqcl.end());
-                        p_tid_list.tids.push_back(PartitionTIdList::kSep);
-                        p_tid_list.sets_number++;
-                        eqcl.clear();
-                    }
-                }
-            } else {
-                int jt = rhs->tids[ix];
-                if (eq_indices.count(jt)) {
-                    eq_classes[eq_indices[jt] - 1].push_back(jt);
+    return lookup;
+}
+
+// Computes intersection. Classes of the result are ordered by the rhs class first and by the lhs
+// class second, tids in a class keep their order in rhs.
+PartitionTIdList PartitionTIdListUtil::ConstructIntersection(
+        PartitionTIdList const& lhs, std::vector<unsigned> const& lhs_lookup,
+        PartitionTIdList const& rhs) {
+    std::vector<std::vector<int>> eq_classes(lhs.sets_number);
+    // lhs classes that got tids of the current rhs class
+    std::vector<unsigned> touched;
+
+    PartitionTIdList p_tid_list = PartitionTIdList();
+    p_tid_list.sets_number = 0;
+    p_tid_list.tids.reserve(lhs.tids.size());
+    for (unsigned ix = 0; ix <= rhs.tids.size(); ix++) {
+        if (ix == rhs.tids.size() || rhs.tids[ix] == PartitionTIdList::kSep) {
+            std::sort(touched.begin(), touched.end());
+            for (unsigned eix : touched) {
+                auto& eqcl = eq_classes[eix];
+                p_tid_list.tids.insert(p_tid_list.tids.end(), eqcl.begin(), eqcl.end());
+                p_tid_list.tids.push_back(PartitionTIdList::kSep);
+                p_tid_list.sets_number++;
+                eqcl.clear();
+            }
+            touched.clear();
+        } else {
+            auto const jt = static_cast<unsigned>(rhs.tids[ix]);
+            if (jt < lhs_lookup.size() && lhs_lookup[jt] != 0) {
+                auto& eqcl = eq_classes[lhs_lookup[jt] - 1];
+                if (eqcl.empty()) {
+                    touched.push_back(lhs_lookup[jt] - 1);
                 }
+                eqcl.push_back(static_cast<int>(jt));
             }
         }
+    }
 
-        if (!p_tid_list.tids.empty() && p_tid_list.tids.back() == PartitionTIdList::kSep) {
-            p_tid_list.tids.pop_back();
-        }
-        res.push_back(p_tid_list);
+    if (!p_tid_list.tids.empty() && p_tid_list.tids.back() == PartitionTIdList::kSep) {
+        p_tid_list.tids.pop_back();
+    }
+    return p_tid_list;
+}
+
+std::vector<PartitionTIdList> PartitionTIdListUtil::ConstructIntersection(
+        PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses) {
+    std::vector<unsigned> const lhs_lookup = ConstructClassLookup(lhs);
+    std::vector<PartitionTIdList> res;
+    res.reserve(rhses.size());
+    for (PartitionTIdList const* rhs : rhses) {
+        res.push_back(ConstructIntersection(lhs, lhs_lookup, *rhs));
     }
     return res;
 }
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <vector>
+
 #include "core/algorithms/cfd/model/partition_tidlist.h"
 
 namespace algos::cfd {
 
 class PartitionTIdListUtil {
 public:
+    // Maps every tid of the partition to its equivalence class number, counted from 1.
+    // Tids that are not in the partition are mapped to 0.
+    static std::vector<unsigned> ConstructClassLookup(PartitionTIdList const& partition);
+
+    static PartitionTIdList ConstructIntersection(PartitionTIdList const& lhs,
+                                                  std::vector<unsigned> const& lhs_lookup,
+                                                  PartitionTIdList const& rhs);
+
     static std::vector<PartitionTIdList> ConstructIntersection(
             PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses);
 };
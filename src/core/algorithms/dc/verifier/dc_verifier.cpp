@@ -1,12 +1,15 @@
 #include "core/algorithms/dc/verifier/dc_verifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -23,19 +26,22 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/typed_column_data.h"
 #include "core/util/get_preallocated_vector.h"
 #include "core/util/kdtree.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
+#include "core/util/static_kdtree.h"
 
 namespace algos {
 
 namespace mo = model;
 
 using Point = dc::Point<dc::Component>;
-using Tree = util::KDTree<Point>;
+using Tree = util::StaticKDTree<Point>;
 
 DCVerifier::DCVerifier() : Algorithm() {
     using namespace config::names;
@@ -51,11 +57,13 @@ void DCVerifier::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(Option<bool>(&do_collect_violations_, kDoCollectViolations,
                                 kDDoCollectViolations, false));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void DCVerifier::MakeExecuteOptsAvailable() {
     MakeOptionsAvailable({config::names::kDenialConstraint});
     MakeOptionsAvailable({config::names::kDoCollectViolations});
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void DCVerifier::LoadDataInternal() {
@@ -79,6 +87,7 @@ unsigned long long int DCVerifier::ExecuteInternal() {
     boost::regex re("[0-9]+");
     bool has_header = !boost::regex_match(col_name, re);
     index_offset_ = 1 + static_cast<size_t>(has_header);
+    violations_.clear();
     result_ = Verify(dc);
 
     auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -124,9 +133,39 @@ bool DCVerifier::Verify(dc::DC dc) {
         if (!do_collect_violations_ and !res) return false;
     }
 
+    NormalizeViolations();
     return violations_.empty();
 }
 
+void DCVerifier::NormalizeViolations() {
+    std::sort(violations_.begin(), violations_.end());
+    violations_.erase(std::unique(violations_.begin(), violations_.end()), violations_.end());
+}
+
+bool DCVerifier::ProbeRows(
+        std::function<bool(size_t, std::vector<std::pair<size_t, size_t>>&)> const& probe) {
+    size_t const num_rows = data_.front().GetNumRows();
+    std::atomic<size_t> next_row = 0;
+    std::atomic<bool> stopped = false;
+
+    auto worker = [this, &probe, num_rows, &next_row, &stopped](config::ThreadNumType) {
+        std::vector<std::pair<size_t, size_t>> local_violations;
+        size_t i;
+        while (!stopped.load(std::memory_order_relaxed) &&
+               (i = next_row.fetch_add(1, std::memory_order_relaxed)) < num_rows) {
+            if (!probe(i, local_violations)) stopped.store(true, std::memory_order_relaxed);
+        }
+
+        std::scoped_lock lock(violations_mutex_);
+        violations_.insert(violations_.end(), local_violations.begin(), local_violations.end());
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    return !stopped.load();
+}
+
 dc::DC DCVerifier::GetDC(std::vector<dc::Predicate> const& no_diseq_preds,
                          std::vector<dc::Predicate> const& diseq_preds, size_t cur_signs) {
     size_t diseq_preds_count = diseq_preds.size();
@@ -169,50 +208,50 @@ bool DCVerifier::VerifyMixed(dc::DC const& dc) {
         }
     }
 
-    util::KDTree<Point> s_tree, t_tree;
     std::vector<mo::ColumnIndex> all_cols = dc.GetColumnIndices();
-    std::vector<dc::Predicate> var_preds =
-            dc.GetPredicates([](dc::Predicate const& pred) { return pred.IsVariable(); });
+    dc::DC var_dc = dc.GetPredicates([](dc::Predicate const& pred) { return pred.IsVariable(); });
 
+    std::vector<Point> s_points, t_points;
     for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
-        std::unordered_set<Point, Point::Hasher> res_points;
         if (ContainsNullOrEmpty(all_cols, i)) continue;
-        auto process =
-                std::bind(&DCVerifier::ProcessMixed, this, std::placeholders::_1,
-                          std::placeholders::_2, var_preds, all_cols, i, std::ref(res_points));
-
-        std::optional<Point> t_point = process(s_tree, t_predicates);
-        std::optional<Point> s_point = process(t_tree, s_predicates);
 
-        if (do_collect_violations_ == true) {
-            AddHighlights(res_points.begin(), res_points.end(), i + index_offset_);
-        } else if (!res_points.empty()) {
-            return false;
-        }
-
-        if (t_point.has_value()) t_tree.Insert(t_point.value());
-        if (s_point.has_value()) s_tree.Insert(s_point.value());
+        std::vector<std::byte const*> row = GetRow(i);
+        size_t cur_ind = i + index_offset_;
+        if (Eval(row, s_predicates)) s_points.push_back(MakePoint(row, all_cols, cur_ind));
+        if (Eval(row, t_predicates)) t_points.push_back(MakePoint(row, all_cols, cur_ind));
     }
+    Tree const s_tree(std::move(s_points)), t_tree(std::move(t_points));
 
-    return violations_.empty();
-}
+    // A row satisfying t_predicates is checked against the preceding rows satisfying
+    // s_predicates and vice versa, the same pairs are reported as when the rows were added to
+    // the trees one at a time.
+    auto probe = [&](size_t i, std::vector<std::pair<size_t, size_t>>& local_violations) {
+        if (ContainsNullOrEmpty(all_cols, i)) return true;
 
-std::optional<Point> DCVerifier::ProcessMixed(
-        Tree const& search_tree, std::vector<dc::Predicate> const& const_preds,
-        dc::DC const& two_tuple_dc, std::vector<mo::ColumnIndex> const& all_cols, size_t i,
-        std::unordered_set<Point, Point::Hasher>& res_points) {
-    std::vector<std::byte const*> row = GetRow(i);
-    auto [box, inv_box] = SearchRanges(all_cols, two_tuple_dc, row);
-
-    std::optional<Point> insert_point;
-    if (Eval(row, const_preds)) {
-        std::vector<Point> search_res = search_tree.QuerySearch(box);
-        res_points.insert(search_res.begin(), search_res.end());
+        std::vector<std::byte const*> row = GetRow(i);
+        bool const is_t = Eval(row, t_predicates);
+        bool const is_s = Eval(row, s_predicates);
+        if (!is_t && !is_s) return true;
 
         size_t cur_ind = i + index_offset_;
-        insert_point = MakePoint(row, all_cols, cur_ind);
-    }
-    return insert_point;
+        util::Rect<Point> box = SearchRanges(all_cols, var_dc, row).first;
+        std::vector<size_t> found;
+        auto collect = [this, cur_ind, &found](Point const& point) {
+            if (point.GetIndex() >= cur_ind) return true;
+            found.push_back(point.GetIndex());
+            return do_collect_violations_;
+        };
+
+        if (is_t && !s_tree.Search(box, collect)) return false;
+        if (is_s && !t_tree.Search(box, collect)) return false;
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        for (size_t ind : found) local_violations.emplace_back(ind, cur_ind);
+        return true;
+    };
+
+    return ProbeRows(probe) && violations_.empty();
 }
 
 bool DCVerifier::VerifyOneTuple(dc::DC const& dc) {
@@ -224,7 +263,7 @@ bool DCVerifier::VerifyOneTuple(dc::DC const& dc) {
             size_t cur_ind = i + index_offset_;
 
             if (do_collect_violations_) {
-                violations_.emplace(cur_ind, cur_ind);
+                violations_.emplace_back(cur_ind, cur_ind);
             } else {
                 return false;
             }
@@ -241,38 +280,56 @@ bool DCVerifier::VerifyTwoTuples(dc::DC const& dc) {
     std::vector<mo::ColumnIndex> ineq_cols = dc.GetColumnIndicesWithOperator(
             [](dc::Operator op) { return op.GetType() != dc::OperatorType::kEqual; });
 
-    std::vector<Point> points;
-    std::unordered_map<Point, util::KDTree<Point>, Point::Hasher> hash;
     std::vector<dc::Predicate> ineq_preds = dc.GetPredicates([](dc::Predicate pred) {
         return pred.GetOperator().GetType() != dc::OperatorType::kEqual;
     });
 
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    size_t const num_rows = data_.front().GetNumRows();
+    constexpr size_t kNoGroup = std::numeric_limits<size_t>::max();
+    std::unordered_map<Point, size_t, Point::Hasher> group_ids;
+    std::vector<std::vector<Point>> groups;
+    std::vector<size_t> row_group(num_rows, kNoGroup);
+    for (size_t i = 0; i < num_rows; ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
 
         std::vector<std::byte const*> row = GetRow(i);
-        Point point = MakePoint(row, eq_cols);
-        Tree& tree = hash[point];
-        auto [box, inv_box] = SearchRanges(ineq_cols, ineq_preds, row);
+        auto [it, inserted] = group_ids.try_emplace(MakePoint(row, eq_cols), groups.size());
+        if (inserted) groups.emplace_back();
+        groups[it->second].push_back(MakePoint(row, ineq_cols, i + index_offset_));
+        row_group[i] = it->second;
+    }
 
-        std::unordered_set<Point, Point::Hasher> res_points;
-        std::vector<Point> search_res = tree.QuerySearch(box);
-        std::vector<Point> inv_search_res = tree.QuerySearch(inv_box);
+    std::vector<Tree> trees(groups.size());
+    std::atomic<size_t> next_group = 0;
+    auto build = [&groups, &trees, &next_group](config::ThreadNumType) {
+        size_t g;
+        while ((g = next_group.fetch_add(1, std::memory_order_relaxed)) < groups.size()) {
+            trees[g] = Tree(std::move(groups[g]));
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, build);
 
-        res_points.insert(search_res.begin(), search_res.end());
-        res_points.insert(inv_search_res.begin(), inv_search_res.end());
+    // A row violates the DC together with an earlier row if one of them is in the search box
+    // of the other, so probing every row with its box against the whole group finds each
+    // violating pair at least once.
+    auto probe = [&](size_t i, std::vector<std::pair<size_t, size_t>>& local_violations) {
+        if (row_group[i] == kNoGroup) return true;
 
+        std::vector<std::byte const*> row = GetRow(i);
         size_t cur_ind = i + index_offset_;
-        if (do_collect_violations_ == true) {
-            AddHighlights(res_points.begin(), res_points.end(), cur_ind);
-        } else if (!res_points.empty()) {
-            return false;
-        }
-
-        tree.Insert(MakePoint(row, ineq_cols, cur_ind));
-    }
+        util::Rect<Point> box = SearchRanges(ineq_cols, ineq_preds, row).first;
+        return trees[row_group[i]].Search(box, [&](Point const& point) {
+            size_t ind = point.GetIndex();
+            if (ind == cur_ind) return true;
+            if (!do_collect_violations_) return false;
+            local_violations.emplace_back(std::min(ind, cur_ind), std::max(ind, cur_ind));
+            return true;
+        });
+    };
 
-    return violations_.empty();
+    return ProbeRows(probe) && violations_.empty();
 }
 
 bool DCVerifier::VerifyAllEquality(dc::DC const& dc) {
@@ -290,7 +347,7 @@ bool DCVerifier::VerifyAllEquality(dc::DC const& dc) {
 
             std::vector<size_t> viol_indexes = res_tuples[point];
             for (auto ind : viol_indexes) {
-                violations_.emplace(cur_ind, ind);
+                violations_.emplace_back(cur_ind, ind);
             }
             res_tuples[point].push_back(cur_ind);
         } else {
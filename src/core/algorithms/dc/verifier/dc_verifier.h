@@ -3,7 +3,9 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <frozen/unordered_map.h>
@@ -13,22 +15,13 @@
 #include "core/algorithms/dc/model/point.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/typed_column_data.h"
 #include "core/util/kdtree.h"
 
 namespace algos {
 
-namespace dc {
-struct SetComparator {
-    bool operator()(std::pair<size_t, size_t> const& lhs,
-                    std::pair<size_t, size_t> const& rhs) const {
-        return (lhs.first != rhs.first) ? (lhs.first < rhs.first) : (lhs.second < rhs.second);
-    }
-};
-
-}  // namespace dc
-
 class DCVerifier final : public Algorithm {
 private:
     // @brief Represents violating tuples of a given table
@@ -39,11 +32,16 @@ private:
     // If a certain pair contains equal left and right record number
     // it means that that DC is a one-tuple one and it sufficient
     // for a single tuple to violate it. e.g. {{2, 2}}
-    std::set<std::pair<size_t, size_t>, dc::SetComparator> violations_;
+    //
+    // Pairs are appended by the verification methods and sorted and deduplicated once
+    // verification is finished.
+    std::vector<std::pair<size_t, size_t>> violations_;
+    std::mutex violations_mutex_;
     std::unique_ptr<ColumnLayoutRelationData> relation_;
     std::vector<model::TypedColumnData> data_;
     config::InputTable input_table_;
     bool do_collect_violations_;
+    config::ThreadNumType threads_num_;
     std::string dc_string_;
     size_t index_offset_;
     bool result_;
@@ -74,15 +72,12 @@ private:
     SearchRanges(std::vector<Column::IndexType> const& all_cols, dc::DC const& ineq_dc,
                  std::vector<std::byte const*> const& tuple) const;
 
-    util::Rect<dc::Point<dc::Component>> SearchMixedRange(dc::DC const& dc, dc::DC const& mixed_dc,
-                                                          std::vector<std::byte const*> row);
-
-    std::optional<dc::Point<dc::Component>> ProcessMixed(
-            util::KDTree<dc::Point<dc::Component>> const& search_tree,
-            std::vector<dc::Predicate> const& const_preds, dc::DC const& two_tuple_dc,
-            std::vector<Column::IndexType> const& all_cols, size_t i,
-            std::unordered_set<dc::Point<dc::Component>, dc::Point<dc::Component>::Hasher>&
-                    res_points);
+    // Calls `probe(i, local_violations)` for every row `i` in parallel. `probe` returns false
+    // when it has found a violation and violations are not collected, then all threads stop.
+    // Violations found by a thread are merged into `violations_` once it is done.
+    // Returns false if the probing was stopped.
+    bool ProbeRows(std::function<bool(size_t, std::vector<std::pair<size_t, size_t>>&)> const&
+                           probe);
 
     dc::Point<dc::Component> MakePoint(std::vector<std::byte const*> const& vec,
                                        std::vector<Column::IndexType> const& indices,
@@ -100,12 +95,7 @@ private:
                     {dc::DCType::kTwoTuples, &DCVerifier::VerifyTwoTuples},
                     {dc::DCType::kMixed, &DCVerifier::VerifyMixed}};
 
-    template <typename InputIt>
-    void AddHighlights(InputIt first, InputIt last, size_t cur_index) {
-        for (; first != last; ++first) {
-            violations_.emplace(first->GetIndex(), cur_index);
-        }
-    }
+    void NormalizeViolations();
 
 public:
     DCVerifier();
@@ -115,7 +105,7 @@ public:
     }
 
     std::vector<std::pair<size_t, size_t>> GetViolations() {
-        return {violations_.begin(), violations_.end()};
+        return violations_;
     }
 
     void ResetState() final {
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "core/algorithms/dd/split/model/distance_position_list_index.h"
+
+namespace algos::dd {
+
+// Distances between the clusters of a column. The matrix is symmetric, so only its upper
+// triangle (diagonal included) is stored, row by row, in one contiguous array.
+class ClusterDistanceMatrix {
+private:
+    std::vector<double> distances_;
+    // row_offsets_[i] + j is the position of the distance between clusters i and j, i <= j
+    std::vector<std::size_t> row_offsets_;
+
+public:
+    ClusterDistanceMatrix() = default;
+
+    explicit ClusterDistanceMatrix(std::size_t num_clusters) : row_offsets_(num_clusters) {
+        distances_.reserve(num_clusters * (num_clusters + 1) / 2);
+        std::size_t row_start = 0;
+        for (ClusterIndex i = 0; i < num_clusters; i++) {
+            row_offsets_[i] = row_start - i;
+            row_start += num_clusters - i;
+        }
+    }
+
+    // Distances must be appended in the order they are stored in
+    void Append(double distance) {
+        distances_.push_back(distance);
+    }
+
+    double Get(ClusterIndex first_cluster, ClusterIndex second_cluster) const {
+        assert(first_cluster <= second_cluster);
+        return distances_[row_offsets_[first_cluster] + second_cluster];
+    }
+};
+
+}  // namespace algos::dd
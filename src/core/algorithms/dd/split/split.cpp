@@ -1,11 +1,13 @@
 #include "core/algorithms/dd/split/split.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
 #include <limits>
 #include <list>
+#include <map>
 #include <numeric>
 #include <ranges>
 #include <set>
@@ -21,16 +23,27 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_index.h"
 #include "core/model/types/numeric_type.h"
 #include "core/util/levenshtein_distance.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace algos::dd {
 
+namespace {
+// Tuple pairs are filtered in blocks of rows, several blocks per thread balance the load
+constexpr std::size_t kBlocksPerThread = 8;
+
+bool IsSameConstraint(DFConstraint const& first, DFConstraint const& second) {
+    return first.lower_bound == second.lower_bound && first.upper_bound == second.upper_bound;
+}
+}  // namespace
+
 Split::Split() : Algorithm() {
     RegisterOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void Split::RegisterOptions() {
@@ -39,6 +52,7 @@ void Split::RegisterOptions() {
     config::InputTable default_table;
 
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
     RegisterOption(Option{&difference_table_, kDifferenceTable, kDDifferenceTable, default_table});
     RegisterOption(Option{&num_rows_, kNumRows, kDNumRows, 0U});
     RegisterOption(Option{&num_columns_, kNumColumns, kDNumColumns, 0U});
@@ -176,12 +190,6 @@ unsigned Split::ReduceDDs(auto const& start_time) {
     std::vector<DF> search, dfs_y;
     std::list<DD> reduced;
 
-    std::vector<std::size_t> tuple_pair_indices;
-    if (reduce_method_ == +Reduce::IEHybrid) {
-        tuple_pair_indices.resize(tuple_pair_num_);
-        std::iota(tuple_pair_indices.begin(), tuple_pair_indices.end(), 0);
-    }
-
     for (model::ColumnIndex index = 0; index < num_columns_; index++) {
         std::vector<model::ColumnIndex> indices;
         for (model::ColumnIndex j = 0; j < num_columns_; j++) {
@@ -210,7 +218,8 @@ unsigned Split::ReduceDDs(auto const& start_time) {
                         reduced = HybridPruningReduce(df_y, search, cnt);
                         break;
                     case +Reduce::IEHybrid:
-                        reduced = InstanceExclusionReduce(tuple_pair_indices, search, df_y, cnt);
+                        reduced = InstanceExclusionReduce(~GetSatisfyingTuplePairs(df_y), search,
+                                                          df_y, cnt);
                         break;
                     default:
                         break;
@@ -259,37 +268,43 @@ unsigned Split::RemoveRedundantDDs() {
     return num_cycles;
 }
 
+// A dependency is transitive if there are dependencies dd1 and dd2 such that dd1 has the same lhs,
+// dd2 has the same rhs and the lhs of dd2 subsumes the rhs of dd1. Removing a dependency never
+// makes another one transitive, so removing the transitive ones in one pass over the collection
+// gives the same result as restarting the search after each removal. Every pass of the latter is
+// counted as a cycle.
 unsigned Split::RemoveTransitiveDDs() {
-    unsigned num_cycles = 0;
-    std::list<DD> results_copy;
-
-    while (true) {
-        num_cycles++;
-        results_copy.clear();
-        bool is_removable = false;
-        for (auto& dd3 : dd_collection_) {
-            bool remove = false;
-            for (auto& dd1 : dd_collection_) {
-                for (auto& dd2 : dd_collection_) {
-                    if (Subsume(dd2.lhs, dd1.rhs) && dd1.lhs == dd3.lhs && dd2.rhs == dd3.rhs) {
-                        if (!is_removable) remove = true;
-                        is_removable = true;
-                        break;
-                    }
-                }
-                if (is_removable) break;
-            }
-            if (!remove) results_copy.push_back(dd3);
+    std::vector<std::list<DD>::iterator> dds;
+    std::map<DF, std::vector<std::size_t>> lhs_index;
+    std::map<DF, std::vector<std::size_t>> rhs_index;
+    for (auto it = dd_collection_.begin(); it != dd_collection_.end(); ++it) {
+        lhs_index[it->lhs].push_back(dds.size());
+        rhs_index[it->rhs].push_back(dds.size());
+        dds.push_back(it);
+    }
+
+    unsigned num_cycles = 1;
+    std::vector<bool> is_removed(dds.size(), false);
+    for (std::size_t dd3 = 0; dd3 < dds.size(); dd3++) {
+        std::vector<std::size_t> const& same_lhs = lhs_index.at(dds[dd3]->lhs);
+        std::vector<std::size_t> const& same_rhs = rhs_index.at(dds[dd3]->rhs);
+        bool const is_transitive = std::ranges::any_of(same_lhs, [&](std::size_t dd1) {
+            return !is_removed[dd1] && std::ranges::any_of(same_rhs, [&](std::size_t dd2) {
+                return !is_removed[dd2] && Subsume(dds[dd2]->lhs, dds[dd1]->rhs);
+            });
+        });
+        if (is_transitive) {
+            is_removed[dd3] = true;
+            dd_collection_.erase(dds[dd3]);
+            num_cycles++;
         }
-        if (results_copy.size() == dd_collection_.size()) break;
-        dd_collection_ = results_copy;
     }
     return num_cycles;
 }
 
 void Split::CalculateIndexSearchSpaces() {
     std::vector<DFConstraint> new_min_max_dif;
-    std::vector<std::vector<std::vector<double>>> new_distances;
+    std::vector<ClusterDistanceMatrix> new_distances;
     std::vector<DistancePositionListIndex> new_plis;
     new_min_max_dif.reserve(num_columns_);
     new_distances.reserve(num_columns_);
@@ -311,30 +326,93 @@ void Split::CalculateIndexSearchSpaces() {
 }
 
 void Split::CalculateTuplePairs() {
+    using PairBitset = boost::dynamic_bitset<>;
+    using TuplePair = std::pair<std::size_t, std::size_t>;
+
     std::size_t const df_search_space_num = std::accumulate(
             index_search_spaces_.begin(), index_search_spaces_.end(), 0,
             [](std::size_t acc, auto const& search_space) { return acc + search_space.size(); });
 
-    std::unordered_set<boost::dynamic_bitset<>> tuple_pair_set;
-    for (std::size_t first_index = 0; first_index < num_rows_; first_index++) {
-        for (std::size_t second_index = first_index + 1; second_index < num_rows_; second_index++) {
-            boost::dynamic_bitset<> pair_bitset(df_search_space_num);
-            std::size_t df_index = 0;
-
-            for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
-                for (auto const& df_constraint : index_search_spaces_[column_index]) {
-                    pair_bitset.set(df_index, CheckDFConstraint(df_constraint, column_index,
-                                                                {first_index, second_index}));
-                    df_index++;
+    // Pairs that satisfy the same constraints of the search spaces are indistinguishable, only the
+    // first one of them in the row-major order is kept. Blocks of rows with about the same number
+    // of pairs are filtered in parallel, each block keeps its distinct bitsets in the order of
+    // their first pairs, so merging the blocks in order gives the sequential result.
+    std::size_t const num_rows = num_rows_;
+    std::size_t const total_pairs = num_rows * (num_rows - 1) / 2;
+    std::size_t const num_blocks = threads_num_ == 1 ? 1 : threads_num_ * kBlocksPerThread;
+    std::vector<std::size_t> block_starts{0};
+    std::size_t block_pairs = 0;
+    for (std::size_t first_index = 0; first_index + 1 < num_rows; first_index++) {
+        block_pairs += num_rows - 1 - first_index;
+        if (block_pairs * num_blocks >= total_pairs && first_index + 2 < num_rows) {
+            block_starts.push_back(first_index + 1);
+            block_pairs = 0;
+        }
+    }
+    block_starts.push_back(num_rows);
+
+    std::vector<std::vector<std::pair<PairBitset, TuplePair>>> block_bitsets(block_starts.size() -
+                                                                             1);
+    std::atomic<std::size_t> next_block = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (std::size_t block = next_block++; block < block_bitsets.size(); block = next_block++) {
+            std::unordered_set<PairBitset> block_set;
+            PairBitset pair_bitset(df_search_space_num);
+            for (std::size_t first_index = block_starts[block];
+                 first_index < block_starts[block + 1]; first_index++) {
+                for (std::size_t second_index = first_index + 1; second_index < num_rows;
+                     second_index++) {
+                    std::size_t df_index = 0;
+
+                    for (model::ColumnIndex column_index = 0; column_index < num_columns_;
+                         column_index++) {
+                        double const dif = GetDistance(column_index, {first_index, second_index});
+                        for (auto const& df_constraint : index_search_spaces_[column_index]) {
+                            pair_bitset.set(df_index,
+                                            CheckDFConstraint(df_constraint, column_index, dif));
+                            df_index++;
+                        }
+                    }
+                    if (!block_set.contains(pair_bitset)) {
+                        block_set.insert(pair_bitset);
+                        block_bitsets[block].emplace_back(pair_bitset,
+                                                          TuplePair{first_index, second_index});
+                    }
                 }
             }
-            auto const [it, is_new] = tuple_pair_set.insert(std::move(pair_bitset));
-            if (is_new) {
-                tuple_pairs_.emplace_back(first_index, second_index);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    std::unordered_set<PairBitset> tuple_pair_set;
+    std::vector<PairBitset> pair_bitsets;
+    for (auto& bitsets : block_bitsets) {
+        for (auto& [pair_bitset, tuple_pair] : bitsets) {
+            if (tuple_pair_set.insert(pair_bitset).second) {
+                tuple_pairs_.push_back(tuple_pair);
+                pair_bitsets.push_back(std::move(pair_bitset));
             }
         }
+        bitsets = {};
     }
     tuple_pair_num_ = tuple_pairs_.size();
+
+    constraint_tuple_pairs_.resize(num_columns_);
+    for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
+        constraint_tuple_pairs_[column_index].assign(index_search_spaces_[column_index].size(),
+                                                     TuplePairSet(tuple_pair_num_));
+    }
+    for (std::size_t pair_index = 0; pair_index < tuple_pair_num_; pair_index++) {
+        std::size_t df_index = 0;
+        for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
+            for (TuplePairSet& constraint_pairs : constraint_tuple_pairs_[column_index]) {
+                constraint_pairs[pair_index] = pair_bitsets[pair_index][df_index];
+                df_index++;
+            }
+        }
+    }
 }
 
 double Split::CalculateDistance(model::ColumnIndex column_index,
@@ -352,16 +430,19 @@ double Split::CalculateDistance(model::ColumnIndex column_index,
 }
 
 // must be inline for optimization (gcc 11.4.0)
-inline bool Split::CheckDFConstraint(DFConstraint const& dif_constraint,
-                                     model::ColumnIndex column_index,
-                                     std::pair<std::size_t, std::size_t> tuple_pair) {
+inline double Split::GetDistance(model::ColumnIndex column_index,
+                                 std::pair<std::size_t, std::size_t> tuple_pair) const {
     std::vector<ClusterIndex> const& cur_index = plis_[column_index].GetInvertedIndex();
     ClusterIndex const first_cluster = cur_index[tuple_pair.first];
     ClusterIndex const second_cluster = cur_index[tuple_pair.second];
     ClusterIndex const min_cluster = std::min(first_cluster, second_cluster);
     ClusterIndex const max_cluster = std::max(first_cluster, second_cluster);
-    double const dif = distances_[column_index][min_cluster][max_cluster - min_cluster];
+    return distances_[column_index].Get(min_cluster, max_cluster);
+}
 
+// must be inline for optimization (gcc 11.4.0)
+inline bool Split::CheckDFConstraint(DFConstraint const& dif_constraint,
+                                     model::ColumnIndex column_index, double dif) const {
     if (type_ids_[column_index] == +model::TypeId::kDouble) {
         return dif_constraint.Contains(dif);
     }
@@ -370,17 +451,46 @@ inline bool Split::CheckDFConstraint(DFConstraint const& dif_constraint,
 }
 
 // must be inline for optimization (gcc 11.4.0)
-inline bool Split::CheckDF(DF const& dif_func, std::pair<std::size_t, std::size_t> tuple_pair) {
-    return std::ranges::all_of(
-            std::views::iota(0U, num_columns_), [&](model::ColumnIndex column_index) {
-                return CheckDFConstraint(dif_func[column_index], column_index, tuple_pair);
+inline bool Split::CheckDFConstraint(DFConstraint const& dif_constraint,
+                                     model::ColumnIndex column_index,
+                                     std::pair<std::size_t, std::size_t> tuple_pair) const {
+    return CheckDFConstraint(dif_constraint, column_index, GetDistance(column_index, tuple_pair));
+}
+
+// The differential functions of the search spaces consist of the constraints of
+// index_search_spaces_ and of min_max_dif_, which all tuple pairs satisfy, so their sets of tuple
+// pairs are intersections of the precomputed ones. Other constraints are checked pair by pair.
+Split::TuplePairSet Split::GetSatisfyingTuplePairs(DF const& dif_func) {
+    TuplePairSet satisfying_pairs(tuple_pairs_.size());
+    satisfying_pairs.set();
+    for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
+        DFConstraint const& constraint = dif_func[column_index];
+        if (IsSameConstraint(constraint, min_max_dif_[column_index])) continue;
+
+        if (!constraint_tuple_pairs_.empty()) {
+            std::vector<DFConstraint> const& search_space = index_search_spaces_[column_index];
+            auto const it = std::ranges::find_if(search_space, [&](DFConstraint const& other) {
+                return IsSameConstraint(constraint, other);
             });
+            if (it != search_space.end()) {
+                satisfying_pairs &=
+                        constraint_tuple_pairs_[column_index][it - search_space.begin()];
+                continue;
+            }
+        }
+        for (std::size_t pair_index = satisfying_pairs.find_first();
+             pair_index != TuplePairSet::npos;
+             pair_index = satisfying_pairs.find_next(pair_index)) {
+            if (!CheckDFConstraint(constraint, column_index, tuple_pairs_[pair_index])) {
+                satisfying_pairs.reset(pair_index);
+            }
+        }
+    }
+    return satisfying_pairs;
 }
 
 bool Split::VerifyDD(DF const& lhs, DF const& rhs) {
-    return std::ranges::all_of(tuple_pairs_, [this, &lhs, &rhs](auto const& pair) {
-        return !CheckDF(lhs, pair) || CheckDF(rhs, pair);
-    });
+    return GetSatisfyingTuplePairs(lhs).is_subset_of(GetSatisfyingTuplePairs(rhs));
 }
 
 void Split::CalculateAllDistances() {
@@ -392,21 +502,18 @@ void Split::CalculateAllDistances() {
         DistancePositionListIndex pli(typed_relation_->GetColumnData(column_index), num_rows_);
         std::vector<ClusterInfo> const& clusters = pli.GetClusters();
         std::size_t const num_clusters = clusters.size();
-        std::vector<std::vector<double>> cur_column_distances;
-        cur_column_distances.reserve(num_clusters);
+        ClusterDistanceMatrix cur_column_distances(num_clusters);
 
         double max_dif = 0, min_dif = std::numeric_limits<double>::max();
         for (ClusterIndex i = 0; i < num_clusters; i++) {
-            cur_column_distances.emplace_back();
-            cur_column_distances[i].reserve(num_clusters - i);
-            cur_column_distances[i].push_back(0);
+            cur_column_distances.Append(0);
             for (ClusterIndex j = i + 1; j < num_clusters; j++) {
                 std::size_t const first_index = clusters[i].first_tuple_index;
                 std::size_t const second_index = clusters[j].first_tuple_index;
                 double const dif = CalculateDistance(column_index, {first_index, second_index});
                 max_dif = std::max(max_dif, dif);
                 min_dif = std::min(min_dif, dif);
-                cur_column_distances[i].push_back(dif);
+                cur_column_distances.Append(dif);
             }
             if (clusters[i].size > 1) min_dif = 0;
         }
@@ -417,8 +524,7 @@ void Split::CalculateAllDistances() {
 }
 
 bool Split::IsFeasible(DF const& d) {
-    return std::ranges::any_of(tuple_pairs_,
-                               [this, &d](auto const& pair) { return CheckDF(d, pair); });
+    return GetSatisfyingTuplePairs(d).any();
 }
 
 std::vector<DFConstraint> Split::IndexSearchSpace(model::ColumnIndex index) {
@@ -659,7 +765,8 @@ std::list<DD> Split::HybridPruningReduce(DF const& rhs, std::vector<DF> const& s
     return dds;
 }
 
-std::list<DD> Split::InstanceExclusionReduce(std::vector<std::size_t> const& tuple_pair_indices,
+// violating_pairs are the tuple pairs that do not satisfy rhs and that are not excluded yet
+std::list<DD> Split::InstanceExclusionReduce(TuplePairSet const& violating_pairs,
                                              std::vector<DF> const& search, DF const& rhs,
                                              unsigned& cnt) {
     if (search.empty()) return {};
@@ -667,44 +774,31 @@ std::list<DD> Split::InstanceExclusionReduce(std::vector<std::size_t> const& tup
     std::list<DD> dds;
     DF const first_df = search.front();
     DF const last_df = search.back();
-    std::vector<std::size_t> remaining_tuple_pair_indices;
 
     cnt++;
-    bool last_dd_holds = true;
-    bool no_pairs_left = true;
-    for (auto index : tuple_pair_indices) {
-        auto const& pair = tuple_pairs_[index];
-        if (!CheckDF(rhs, pair)) {
-            if (CheckDF(first_df, pair)) {
-                remaining_tuple_pair_indices.push_back(index);
-                no_pairs_left = false;
-            }
-            if (last_dd_holds && CheckDF(last_df, pair)) last_dd_holds = false;
-            if (!no_pairs_left && !last_dd_holds) break;
-        }
-    }
+    TuplePairSet const remaining_violating_pairs =
+            violating_pairs & GetSatisfyingTuplePairs(first_df);
 
-    if (no_pairs_left) {
+    if (remaining_violating_pairs.none()) {
         if (IsFeasible(first_df)) dds.emplace_back(first_df, rhs);
         std::vector<DF> remainder = DoPositivePruning(search, first_df);
-        std::list<DD> remaining_dds =
-                InstanceExclusionReduce(tuple_pair_indices, remainder, rhs, cnt);
+        std::list<DD> remaining_dds = InstanceExclusionReduce(violating_pairs, remainder, rhs, cnt);
         dds.splice(dds.end(), std::move(remaining_dds));
         return dds;
     }
 
     cnt++;
 
-    if (!last_dd_holds) {
+    if (violating_pairs.intersects(GetSatisfyingTuplePairs(last_df))) {
         std::vector<DF> remainder = DoNegativePruning(search, last_df);
-        return InstanceExclusionReduce(tuple_pair_indices, remainder, rhs, cnt);
+        return InstanceExclusionReduce(violating_pairs, remainder, rhs, cnt);
     }
 
     auto const [prune, remainder] = PositiveSplit(search, first_df);
 
-    dds = InstanceExclusionReduce(tuple_pair_indices, remainder, rhs, cnt);
+    dds = InstanceExclusionReduce(violating_pairs, remainder, rhs, cnt);
     std::list<DD> const pruning_dds =
-            InstanceExclusionReduce(remaining_tuple_pair_indices, prune, rhs, cnt);
+            InstanceExclusionReduce(remaining_violating_pairs, prune, rhs, cnt);
 
     std::list<DD> merged_dds = MergeReducedResults(dds, pruning_dds);
     dds.splice(dds.end(), std::move(merged_dds));
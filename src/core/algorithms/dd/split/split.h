@@ -7,11 +7,15 @@
 #include <utility>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/dd/dd.h"
 #include "core/algorithms/dd/split/enums.h"
+#include "core/algorithms/dd/split/model/cluster_distance_matrix.h"
 #include "core/algorithms/dd/split/model/distance_position_list_index.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
@@ -25,7 +29,11 @@ using DFConstraint = model::DFConstraint;
 
 class Split : public Algorithm {
 private:
+    // A set of tuple pairs, bit i stands for tuple_pairs_[i]
+    using TuplePairSet = boost::dynamic_bitset<>;
+
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_ = 1;
 
     std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     unsigned num_rows_;
@@ -43,9 +51,11 @@ private:
 
     std::vector<DistancePositionListIndex> plis_;
     std::vector<DFConstraint> min_max_dif_;
-    std::vector<std::vector<std::vector<double>>> distances_;
+    std::vector<ClusterDistanceMatrix> distances_;
     std::vector<std::pair<std::size_t, std::size_t>> tuple_pairs_;
     std::vector<std::vector<DFConstraint>> index_search_spaces_;
+    // constraint_tuple_pairs_[i][j] is the set of tuple pairs satisfying index_search_spaces_[i][j]
+    std::vector<std::vector<TuplePairSet>> constraint_tuple_pairs_;
     std::list<DD> dd_collection_;
 
     void RegisterOptions();
@@ -56,6 +66,7 @@ private:
     void ResetState() final {
         dd_collection_.clear();
         tuple_pairs_.clear();
+        constraint_tuple_pairs_.clear();
         non_empty_cols_.clear();
         index_search_spaces_.clear();
         distances_.clear();
@@ -65,11 +76,15 @@ private:
                              std::pair<std::size_t, std::size_t> tuple_pair);
     void InsertDistance(model::ColumnIndex column_index, std::size_t first_index,
                         std::size_t second_index, double& min_dif, double& max_dif);
+    [[gnu::always_inline, gnu::hot]] double GetDistance(
+            model::ColumnIndex column_index, std::pair<std::size_t, std::size_t> tuple_pair) const;
+    [[gnu::always_inline, gnu::hot]] bool CheckDFConstraint(DFConstraint const& dif_constraint,
+                                                            model::ColumnIndex column_index,
+                                                            double dif) const;
     [[gnu::always_inline, gnu::hot]] bool CheckDFConstraint(
             DFConstraint const& dif_constraint, model::ColumnIndex column_index,
-            std::pair<std::size_t, std::size_t> tuple_pair);
-    [[gnu::always_inline, gnu::hot]] bool CheckDF(DF const& dep,
-                                                  std::pair<std::size_t, std::size_t> tuple_pair);
+            std::pair<std::size_t, std::size_t> tuple_pair) const;
+    TuplePairSet GetSatisfyingTuplePairs(DF const& dif_func);
     bool VerifyDD(DF const& lhs, DF const& rhs);
     void CalculateIndexSearchSpaces();
     void CalculateTuplePairs();
@@ -90,7 +105,7 @@ private:
     std::list<DD> NegativePruningReduce(DF const& rhs, std::vector<DF> const& search,
                                         unsigned& cnt);
     std::list<DD> HybridPruningReduce(DF const& rhs, std::vector<DF> const& search, unsigned& cnt);
-    std::list<DD> InstanceExclusionReduce(std::vector<std::size_t> const& tuple_pair_indices,
+    std::list<DD> InstanceExclusionReduce(TuplePairSet const& tuple_pairs,
                                           std::vector<DF> const& search, DF const& rhs,
                                           unsigned& cnt);
     unsigned ReduceDDs(auto const& start_time);
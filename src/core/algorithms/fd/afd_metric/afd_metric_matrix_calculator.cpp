@@ -0,0 +1,144 @@
+#include "afd_metric_matrix_calculator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+
+#include "core/algorithms/fd/afd_metric/afd_metric_calculator.h"
+#include "core/config/error/type.h"
+#include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+#include "core/util/parallel_for.h"
+#include "core/util/timed_invoke.h"
+
+namespace algos::afd_metric_calculator {
+
+using Cluster = model::PositionListIndex::Cluster;
+
+AFDMetricMatrixCalculator::AFDMetricMatrixCalculator() : Algorithm() {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kThreadNumberOpt.GetName()});
+}
+
+void AFDMetricMatrixCalculator::RegisterOptions() {
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void AFDMetricMatrixCalculator::LoadDataInternal() {
+    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+
+    if (relation_->GetColumnData().empty()) {
+        throw std::runtime_error("Got an empty dataset: AFD metric calculation is meaningless.");
+    }
+}
+
+unsigned long long AFDMetricMatrixCalculator::ExecuteInternal() {
+    size_t const elapsed_milliseconds =
+            util::TimedInvoke(&AFDMetricMatrixCalculator::CalculateMatrices, this);
+
+    return elapsed_milliseconds;
+}
+
+void AFDMetricMatrixCalculator::CalculateMatrices() {
+    size_t const num_rows = relation_->GetNumRows();
+    if (num_rows <= 0) throw std::invalid_argument("received unpositive number of rows");
+
+    size_t const num_columns = relation_->GetNumColumns();
+    matrices_.assign(AFDMetric::_size(),
+                     Matrix(num_columns, std::vector<long double>(num_columns)));
+
+    std::vector<long double> rhs_pdep_self(num_columns);
+    for (size_t rhs = 0; rhs < num_columns; ++rhs) {
+        rhs_pdep_self[rhs] = AFDMetricCalculator::CalculatePdepSelf(
+                relation_->GetColumnData(rhs).GetPLWSIndex());
+    }
+
+    // Each LHS column fills its own row of every matrix
+    std::atomic<size_t> next_lhs = 0;
+    auto worker = [&](config::ThreadNumType) {
+        // Indexed by the probing table value of an RHS row
+        std::vector<size_t> value_counts(num_rows + 1);
+        std::vector<int> touched_values;
+        for (size_t lhs = next_lhs++; lhs < num_columns; lhs = next_lhs++) {
+            CalculateRow(lhs, rhs_pdep_self, value_counts, touched_values);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+}
+
+void AFDMetricMatrixCalculator::CalculateRow(size_t lhs,
+                                             std::vector<long double> const& rhs_pdep_self,
+                                             std::vector<size_t>& value_counts,
+                                             std::vector<int>& touched_values) {
+    size_t const num_rows = relation_->GetNumRows();
+    size_t const num_columns = relation_->GetNumColumns();
+    model::PLIWS const* lhs_pli = relation_->GetColumnData(lhs).GetPLWSIndex();
+    std::deque<Cluster> const& lhs_clusters = lhs_pli->GetIndex();
+    size_t const lhs_domain = lhs_pli->GetNumNonSingletonCluster() + lhs_pli->GetSngltnSize();
+
+    for (size_t rhs = 0; rhs < num_columns; ++rhs) {
+        model::PLIWS const* rhs_pli = relation_->GetColumnData(rhs).GetPLWSIndex();
+        std::vector<int> const& rhs_pt = relation_->GetColumnData(rhs).GetProbingTable();
+
+        long double num_error_rows = 0.L;
+        // Each LHS singleton is its own cluster of the joint PLI, so it adds 1 to the pdep sum
+        config::ErrorType pdep_sum = num_rows - lhs_pli->GetSize();
+        long double conditional_entropy = 0.L;
+
+        for (Cluster const& cluster : lhs_clusters) {
+            size_t rhs_singletons = 0;
+            for (int const tuple_index : cluster) {
+                int const value = rhs_pt[tuple_index];
+                if (value == model::PLI::kSingletonValueId) {
+                    ++rhs_singletons;
+                } else if (value_counts[value]++ == 0) {
+                    touched_values.push_back(value);
+                }
+            }
+
+            auto const size = static_cast<config::ErrorType>(cluster.size());
+            auto const log_x = std::log(cluster.size());
+            if (rhs_singletons != 0 || touched_values.size() != 1) num_error_rows += cluster.size();
+            pdep_sum += rhs_singletons / size;
+            conditional_entropy += rhs_singletons * log_x;
+            for (int const value : touched_values) {
+                auto const count = static_cast<config::ErrorType>(value_counts[value]);
+                pdep_sum += count * count / size;
+                conditional_entropy -= count * (std::log((long double)count) - log_x);
+                value_counts[value] = 0;
+            }
+            touched_values.clear();
+        }
+
+        long double const p1 = rhs_pdep_self[rhs];
+        long double const p2 = pdep_sum / static_cast<config::ErrorType>(num_rows);
+
+        matrices_[AFDMetric::g2][lhs][rhs] = num_error_rows / num_rows;
+
+        matrices_[AFDMetric::tau][lhs][rhs] = p1 == 1 ? 1 : (p2 - p1) / (1 - p1);
+
+        long double mu_plus = 1;
+        if (rhs_pli->GetNumCluster() >= 2 && num_rows != lhs_domain && p1 != 1) {
+            long double mu = 1 - (1 - p2) / (1 - p1) * (num_rows - 1) / (num_rows - lhs_domain);
+            mu_plus = std::max(mu, 0.L);
+        }
+        matrices_[AFDMetric::mu_plus][lhs][rhs] = mu_plus;
+
+        long double fi = 0.L;
+        if (rhs_pli->GetNumCluster() >= 2) {
+            auto entropy = rhs_pli->GetEntropy();
+            conditional_entropy /= num_rows;
+            fi = (entropy - conditional_entropy) / entropy;
+        }
+        matrices_[AFDMetric::fi][lhs][rhs] = fi;
+    }
+}
+
+}  // namespace algos::afd_metric_calculator
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/algorithms/algorithm.h"
+#include "core/algorithms/fd/afd_metric/afd_metric.h"
+#include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
+#include "core/model/table/column_layout_relation_data.h"
+
+namespace algos::afd_metric_calculator {
+
+// Calculates every AFD metric for every ordered pair of columns. Single-column PLIs and their
+// probing tables are built once, and all metrics of a pair are derived from one pass over the
+// LHS clusters. The results match AFDMetricCalculator run on the same single-column pair.
+class AFDMetricMatrixCalculator : public Algorithm {
+public:
+    // matrix[lhs][rhs] is the value of the metric for the AFD lhs -> rhs
+    using Matrix = std::vector<std::vector<long double>>;
+
+private:
+    config::InputTable input_table_;
+    config::ThreadNumType threads_num_ = 1;
+
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
+
+    // Indexed by AFDMetric
+    std::vector<Matrix> matrices_;
+
+    void CalculateMatrices();
+    void CalculateRow(std::size_t lhs, std::vector<long double> const& rhs_pdep_self,
+                      std::vector<std::size_t>& value_counts, std::vector<int>& touched_values);
+
+    void RegisterOptions();
+
+    void ResetState() final {
+        matrices_.clear();
+    }
+
+protected:
+    void LoadDataInternal() override;
+    unsigned long long ExecuteInternal() override;
+
+public:
+    Matrix const& GetMatrix(AFDMetric metric) const {
+        return matrices_.at(metric._to_index());
+    }
+
+    AFDMetricMatrixCalculator();
+};
+
+}  // namespace algos::afd_metric_calculator
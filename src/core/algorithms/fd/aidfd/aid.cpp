@@ -1,6 +1,11 @@
 #include "core/algorithms/fd/aidfd/aid.h"
 
+#include <mutex>
+#include <numeric>
+
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/util/parallel_for.h"
 
 namespace algos {
 
@@ -11,6 +16,11 @@ Aid::Aid() : FDAlgorithm() {
 
 void Aid::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Aid::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Aid::LoadDataInternal() {
@@ -104,10 +114,29 @@ bool Aid::IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio) {
 }
 
 void Aid::CreateNegativeCover() {
+    // Every thread samples its own contiguous range of tuples. The negative cover is a set, so the
+    // result of an iteration does not depend on the number of threads or merge order.
+    size_t const chunks_num =
+            std::max<size_t>(1, std::min<size_t>(threads_num_, number_of_tuples_));
+    size_t const chunk_size = (number_of_tuples_ + chunks_num - 1) / chunks_num;
+    std::vector<size_t> chunks(chunks_num);
+    std::iota(chunks.begin(), chunks.end(), 0);
+    std::mutex neg_cover_mutex;
+
     size_t prev_neg_cover_size = 0;
     for (size_t index = 1;; ++index) {
-        for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            HandleTuple(tuple_num, index);
+        if (chunks_num == 1) {
+            SampleTuples(0, number_of_tuples_, index, neg_cover_);
+        } else {
+            util::ParallelForeach(chunks.begin(), chunks.end(), threads_num_, [&](size_t chunk) {
+                std::unordered_set<boost::dynamic_bitset<>> agree_sets;
+                size_t const first_tuple = std::min(chunk * chunk_size, number_of_tuples_);
+                size_t const last_tuple = std::min(first_tuple + chunk_size, number_of_tuples_);
+                SampleTuples(first_tuple, last_tuple, index, agree_sets);
+
+                std::lock_guard const lock(neg_cover_mutex);
+                neg_cover_.merge(agree_sets);
+            });
         }
 
         size_t curr_neg_cover_size = neg_cover_.size();
@@ -127,7 +156,15 @@ void Aid::CreateNegativeCover() {
     }
 }
 
-void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
+void Aid::SampleTuples(size_t first_tuple, size_t last_tuple, size_t iteration_num,
+                       std::unordered_set<boost::dynamic_bitset<>>& agree_sets) const {
+    for (size_t tuple_num = first_tuple; tuple_num < last_tuple; ++tuple_num) {
+        HandleTuple(tuple_num, iteration_num, agree_sets);
+    }
+}
+
+void Aid::HandleTuple(size_t tuple_num, size_t iteration_num,
+                      std::unordered_set<boost::dynamic_bitset<>>& agree_sets) const {
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
         size_t value = tuples_[tuple_num][attr_num];
         Cluster const& cluster = clusters_[attr_num].at(value);
@@ -136,13 +173,12 @@ void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
             size_t another_index_in_cluster =
                     GenerateSecondClusterIndex(index_in_cluster, iteration_num);
             size_t another_tuple_num = cluster[another_index_in_cluster];
-            auto tuples_agree_set = BuildAgreeSet(tuple_num, another_tuple_num);
-            neg_cover_.insert(tuples_agree_set);
+            agree_sets.insert(BuildAgreeSet(tuple_num, another_tuple_num));
         }
     }
 }
 
-boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) {
+boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) const {
     boost::dynamic_bitset<> equal_attr(number_of_attributes_);
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
         if (tuples_[t1][attr_num] == tuples_[t2][attr_num]) {
@@ -166,7 +202,7 @@ void Aid::HandleConstantColumns(boost::dynamic_bitset<>& attributes) {
 }
 
 void Aid::HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
-                          size_t rhs) {
+                          size_t rhs) const {
     std::vector<boost::dynamic_bitset<>> subsets;
     pos_cover_tree.ForEachSubset(neg_cover_el, [&subsets](boost::dynamic_bitset<> const& subset) {
         subsets.push_back(subset);
@@ -216,29 +252,43 @@ void Aid::InvertNegativeCover() {
         neg_cover_el = ChangeAttributesOrder(neg_cover_el, inv_attr_indices);
     }
 
+    // Positive covers of different right-hand sides are independent, so they are built in
+    // parallel and registered afterwards in the order of right-hand sides.
+    std::vector<std::vector<boost::dynamic_bitset<>>> pos_covers(number_of_attributes_);
+    std::vector<size_t> rhs_indices(number_of_attributes_);
+    std::iota(rhs_indices.begin(), rhs_indices.end(), 0);
+    util::ParallelForeach(rhs_indices.begin(), rhs_indices.end(), threads_num_, [&](size_t rhs) {
+        if (!constant_columns_[rhs]) {
+            pos_covers[rhs] =
+                    InvertNegativeCoverForRhs(rhs, neg_cover_vector, attributes, attr_indices);
+        }
+    });
+
     for (size_t rhs = 0; rhs < number_of_attributes_; ++rhs) {
         if (constant_columns_[rhs]) {
             continue;
         }
+        RegisterFDs(attr_indices[rhs], pos_covers[rhs]);
+    }
+}
 
-        attributes[rhs] = false;
-        SearchTree pos_cover_tree(attributes);
-        for (auto const& neg_cover_el : neg_cover_vector) {
-            if (!neg_cover_el[rhs]) {
-                HandleInvalidFd(neg_cover_el, pos_cover_tree, rhs);
-            }
+std::vector<boost::dynamic_bitset<>> Aid::InvertNegativeCoverForRhs(
+        size_t rhs, std::vector<boost::dynamic_bitset<>> const& neg_cover_vector,
+        boost::dynamic_bitset<> attributes, std::vector<size_t> const& attr_indices) const {
+    attributes[rhs] = false;
+    SearchTree pos_cover_tree(attributes);
+    for (auto const& neg_cover_el : neg_cover_vector) {
+        if (!neg_cover_el[rhs]) {
+            HandleInvalidFd(neg_cover_el, pos_cover_tree, rhs);
         }
-
-        size_t real_rhs = attr_indices[rhs];
-        std::vector<boost::dynamic_bitset<>> pos_cover_vector;
-        pos_cover_tree.ForEach(
-                [&pos_cover_vector, &attr_indices](boost::dynamic_bitset<> const& pos_cover_el) {
-                    pos_cover_vector.push_back(ChangeAttributesOrder(pos_cover_el, attr_indices));
-                });
-
-        RegisterFDs(real_rhs, pos_cover_vector);
-        attributes[rhs] = true;
     }
+
+    std::vector<boost::dynamic_bitset<>> pos_cover_vector;
+    pos_cover_tree.ForEach(
+            [&pos_cover_vector, &attr_indices](boost::dynamic_bitset<> const& pos_cover_el) {
+                pos_cover_vector.push_back(ChangeAttributesOrder(pos_cover_el, attr_indices));
+            });
+    return pos_cover_vector;
 }
 
 void Aid::RegisterFDs(size_t rhs_attribute,
@@ -9,6 +9,7 @@
 #include "core/algorithms/fd/aidfd/search_tree.h"
 #include "core/algorithms/fd/fd_algorithm.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/table/vertical.h"
@@ -20,6 +21,7 @@ private:
     using Cluster = std::vector<size_t>;
 
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_;
 
     std::shared_ptr<RelationalSchema> schema_{};
     std::vector<std::vector<size_t>> tuples_;
@@ -42,6 +44,7 @@ private:
     boost::dynamic_bitset<> constant_columns_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final;
 
@@ -52,9 +55,17 @@ private:
     void CreateNegativeCover();
     void InvertNegativeCover();
 
-    void HandleTuple(size_t tuple_num, size_t index);
+    // Sampling pairs of tuples from the range [first_tuple, last_tuple) on the given iteration.
+    // Agree sets are collected into `agree_sets`, so every thread can deduplicate them locally.
+    void SampleTuples(size_t first_tuple, size_t last_tuple, size_t iteration_num,
+                      std::unordered_set<boost::dynamic_bitset<>>& agree_sets) const;
+    void HandleTuple(size_t tuple_num, size_t index,
+                     std::unordered_set<boost::dynamic_bitset<>>& agree_sets) const;
     void HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
-                         size_t rhs);
+                         size_t rhs) const;
+    std::vector<boost::dynamic_bitset<>> InvertNegativeCoverForRhs(
+            size_t rhs, std::vector<boost::dynamic_bitset<>> const& neg_cover_vector,
+            boost::dynamic_bitset<> attributes, std::vector<size_t> const& attr_indices) const;
     size_t GenerateSecondClusterIndex(size_t index_in_cluster, size_t iteration_num) const;
     bool IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio);
 
@@ -66,7 +77,7 @@ private:
     std::vector<size_t> GetAttributesSortedByFrequency(
             std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const;
 
-    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2);
+    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2) const;
 
 public:
     Aid();
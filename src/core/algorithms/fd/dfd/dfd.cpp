@@ -9,6 +9,7 @@
 #include "core/model/table/position_list_index.h"
 #include "core/model/table/relational_schema.h"
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace algos {
 
@@ -49,7 +50,7 @@ unsigned long long DFD::ExecuteInternal() {
     boost::asio::thread_pool search_space_pool(number_of_threads_);
 
     for (auto& rhs : schema->GetColumns()) {
-        boost::asio::post(search_space_pool, [this, &rhs, schema, &partition_storage]() {
+        auto find_lhss = [this, &rhs, schema, &partition_storage]() {
             ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
             model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
 
@@ -69,7 +70,8 @@ unsigned long long DFD::ExecuteInternal() {
             for (auto const& minimal_dependency_lhs : minimal_deps) {
                 RegisterFd(minimal_dependency_lhs, *rhs, relation_->GetSharedPtrSchema());
             }
-        });
+        };
+        boost::asio::post(search_space_pool, util::metrics::BindCurrentRegistry(find_lhss));
     }
 
     search_space_pool.join();
@@ -0,0 +1,460 @@
+#include "core/algorithms/fd/dynfd/dynfd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+#include "core/config/exceptions.h"
+#include "core/config/names.h"
+#include "core/config/tabular_data/crud_operations/operations.h"
+#include "core/config/tabular_data/input_table/option.h"
+#include "core/util/logger.h"
+
+namespace algos::dynfd {
+
+DynFD::DynFD() : FDAlgorithm() {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName()});
+}
+
+void DynFD::RegisterOptions() {
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        if (insert_batch == nullptr || !insert_batch->HasNextRow()) return;
+        if (insert_batch->GetNumberOfColumns() != num_columns_) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: insert statements must have the same number of columns as "
+                    "the input table");
+        }
+        for (std::size_t i = 0; i < num_columns_; ++i) {
+            if (insert_batch->GetColumnName(i) != schema_->GetColumn(i)->GetName()) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: insert statements' column names must match the input "
+                        "table");
+            }
+        }
+    };
+
+    auto check_deletes = [this](std::unordered_set<std::size_t> const& delete_batch) {
+        for (std::size_t id : delete_batch) {
+            if (!IsLive(id)) {
+                throw config::ConfigurationError("Attempt to delete a non-existing row");
+            }
+        }
+    };
+
+    auto check_updates = [this](config::InputTable const& update_batch) {
+        if (update_batch == nullptr || !update_batch->HasNextRow()) return;
+        if (update_batch->GetNumberOfColumns() != num_columns_ + 1) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: update statements must have the number of columns one more "
+                    "than the input table");
+        }
+        for (std::size_t i = 0; i < num_columns_; ++i) {
+            if (update_batch->GetColumnName(i + 1) != schema_->GetColumn(i)->GetName()) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: update statements column names, except of first one, "
+                        "must match the input table");
+            }
+        }
+        std::unordered_set<std::size_t> rows_to_update;
+        while (update_batch->HasNextRow()) {
+            auto row = update_batch->GetNextRow();
+            std::size_t id = std::stoull(row.front());
+            if (!IsLive(id)) {
+                throw config::ConfigurationError("Attempt to update a non-existing row");
+            }
+            if (!rows_to_update.emplace(id).second) {
+                throw config::ConfigurationError("Update statements have duplicates");
+            }
+        }
+        update_batch->Reset();
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+    RegisterOption(
+            config::kDeleteStatementsOpt(&delete_statement_indices_).SetValueCheck(check_deletes));
+    RegisterOption(
+            config::kUpdateStatementsOpt(&update_statements_table_).SetValueCheck(check_updates));
+}
+
+void DynFD::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable(kCrudOptions);
+}
+
+std::vector<DynFD::ValueId> DynFD::EncodeRow(model::IDatasetStream::Row::iterator row_begin) {
+    std::vector<ValueId> record(num_columns_);
+    for (std::size_t i = 0; i < num_columns_; ++i) {
+        auto& dictionary = dictionaries_[i];
+        auto [it, _] = dictionary.try_emplace(std::move(*(row_begin + i)),
+                                              static_cast<ValueId>(dictionary.size()));
+        record[i] = it->second;
+    }
+    return record;
+}
+
+void DynFD::LoadDataInternal() {
+    num_columns_ = input_table_->GetNumberOfColumns();
+    if (num_columns_ == 0) {
+        throw std::runtime_error("Got an empty dataset: FD mining is meaningless.");
+    }
+    schema_ = std::make_shared<RelationalSchema>(input_table_->GetRelationName());
+    for (std::size_t i = 0; i < num_columns_; ++i) {
+        schema_->AppendColumn(input_table_->GetColumnName(i));
+    }
+
+    dictionaries_.assign(num_columns_, {});
+    records_.clear();
+    while (input_table_->HasNextRow()) {
+        model::IDatasetStream::Row row = input_table_->GetNextRow();
+        if (row.size() != num_columns_) {
+            LOG_WARN("Received row with size {}, but expected {}", row.size(), num_columns_);
+            continue;
+        }
+        records_.push_back(EncodeRow(row.begin()));
+    }
+    num_live_records_ = records_.size();
+
+    plis_.clear();
+    std::vector<model::DynPLI::ClusterValue> column_values(records_.size());
+    for (std::size_t column = 0; column < num_columns_; ++column) {
+        for (RecordId record = 0; record < records_.size(); ++record) {
+            column_values[record] = {records_[record][column]};
+        }
+        plis_.push_back(model::DynPLI::CreateFor(column_values));
+    }
+
+    DiscoverFromScratch();
+}
+
+model::DynPLI::Cluster const* DynFD::FindCluster(std::size_t column, ValueId value) const {
+    auto const& clusters = plis_[column]->GetClusters();
+    auto it = clusters.find({value});
+    return it == clusters.end() ? nullptr : &it->second;
+}
+
+DynFD::AttributeSet DynFD::GetAgreeSet(Witness const& witness) const {
+    auto const& first = records_[witness.first];
+    auto const& second = records_[witness.second];
+    AttributeSet agree_set(num_columns_);
+    for (std::size_t i = 0; i < num_columns_; ++i) {
+        if (first[i] == second[i]) agree_set.set(i);
+    }
+    return agree_set;
+}
+
+std::vector<DynFD::Witness> DynFD::CollectViolations(AttributeSet const& lhs, std::size_t rhs,
+                                                     std::size_t max_witnesses) const {
+    std::vector<Witness> witnesses;
+    if (lhs.none()) {
+        auto const& rhs_clusters = plis_[rhs]->GetClusters();
+        if (rhs_clusters.size() > 1) {
+            auto it = rhs_clusters.begin();
+            RecordId first = it->second.front();
+            witnesses.emplace_back(first, (++it)->second.front());
+        }
+        return witnesses;
+    }
+
+    // The attribute with the most clusters splits the rows into the smallest groups
+    std::size_t pivot = lhs.find_first();
+    for (std::size_t attr = lhs.find_next(pivot); attr != AttributeSet::npos;
+         attr = lhs.find_next(attr)) {
+        if (plis_[attr]->GetNumCluster() > plis_[pivot]->GetNumCluster()) pivot = attr;
+    }
+    AttributeSet rest = lhs;
+    rest.reset(pivot);
+
+    std::unordered_map<std::vector<ValueId>, RecordId> groups;
+    std::vector<ValueId> key;
+    for (auto const& [_, cluster] : plis_[pivot]->GetClusters()) {
+        if (cluster.size() < 2) continue;
+        groups.clear();
+        for (RecordId record : cluster) {
+            auto const& values = records_[record];
+            key.clear();
+            for (std::size_t attr = rest.find_first(); attr != AttributeSet::npos;
+                 attr = rest.find_next(attr)) {
+                key.push_back(values[attr]);
+            }
+            auto [it, is_new] = groups.try_emplace(key, record);
+            if (!is_new && records_[it->second][rhs] != values[rhs]) {
+                witnesses.emplace_back(it->second, record);
+                break;
+            }
+        }
+        if (witnesses.size() >= max_witnesses) break;
+    }
+    return witnesses;
+}
+
+std::optional<DynFD::Witness> DynFD::FindViolation(AttributeSet const& lhs,
+                                                   std::size_t rhs) const {
+    std::vector<Witness> witnesses = CollectViolations(lhs, rhs, 1);
+    if (witnesses.empty()) return std::nullopt;
+    return witnesses.front();
+}
+
+std::optional<DynFD::Witness> DynFD::FindViolation(AttributeSet const& lhs, std::size_t rhs,
+                                                   std::vector<RecordId> const& records) const {
+    for (RecordId record : records) {
+        if (!IsLive(record)) continue;
+        auto const& values = records_[record];
+
+        if (lhs.none()) {
+            for (auto const& [rhs_value, cluster] : plis_[rhs]->GetClusters()) {
+                if (rhs_value.front() != values[rhs]) return Witness{record, cluster.front()};
+            }
+            continue;
+        }
+
+        // Only rows from the smallest of the clusters the row belongs to can agree with it on lhs
+        model::DynPLI::Cluster const* smallest = nullptr;
+        for (std::size_t attr = lhs.find_first(); attr != AttributeSet::npos;
+             attr = lhs.find_next(attr)) {
+            model::DynPLI::Cluster const* cluster = FindCluster(attr, values[attr]);
+            if (smallest == nullptr || cluster->size() < smallest->size()) smallest = cluster;
+        }
+        for (RecordId other : *smallest) {
+            auto const& other_values = records_[other];
+            if (other_values[rhs] == values[rhs]) continue;
+            bool agrees = true;
+            for (std::size_t attr = lhs.find_first(); attr != AttributeSet::npos && agrees;
+                 attr = lhs.find_next(attr)) {
+                agrees = other_values[attr] == values[attr];
+            }
+            if (agrees) return Witness{record, other};
+        }
+    }
+    return std::nullopt;
+}
+
+bool DynFD::AddNonFd(std::size_t rhs, AttributeSet const& lhs, Witness const& witness) {
+    std::vector<NonFd>& cover = negative_cover_[rhs];
+    if (std::ranges::any_of(cover,
+                            [&lhs](NonFd const& non_fd) { return lhs.is_subset_of(non_fd.lhs); })) {
+        return false;
+    }
+    std::erase_if(cover, [&lhs](NonFd const& non_fd) { return non_fd.lhs.is_subset_of(lhs); });
+    cover.push_back({lhs, witness});
+    return true;
+}
+
+void DynFD::Specialize(std::size_t rhs, AttributeSet const& non_fd_lhs,
+                       CandidateQueue& candidates) {
+    std::vector<AttributeSet>& cover = positive_cover_[rhs];
+    auto invalid_begin = std::partition(cover.begin(), cover.end(), [&](AttributeSet const& lhs) {
+        return !lhs.is_subset_of(non_fd_lhs);
+    });
+    std::vector<AttributeSet> invalid(std::make_move_iterator(invalid_begin),
+                                      std::make_move_iterator(cover.end()));
+    cover.erase(invalid_begin, cover.end());
+
+    for (AttributeSet const& lhs : invalid) {
+        for (std::size_t attr = 0; attr < num_columns_; ++attr) {
+            if (attr == rhs || non_fd_lhs.test(attr)) continue;
+            AttributeSet specialized = lhs;
+            specialized.set(attr);
+            if (std::ranges::any_of(cover, [&specialized](AttributeSet const& fd_lhs) {
+                    return fd_lhs.is_subset_of(specialized);
+                })) {
+                continue;
+            }
+            cover.push_back(specialized);
+            candidates.emplace_back(rhs, std::move(specialized));
+        }
+    }
+}
+
+void DynFD::AddAgreeSet(Witness const& witness, CandidateQueue& candidates) {
+    AttributeSet const agree_set = GetAgreeSet(witness);
+    for (std::size_t rhs = 0; rhs < num_columns_; ++rhs) {
+        if (agree_set.test(rhs)) continue;
+        if (AddNonFd(rhs, agree_set, witness)) {
+            Specialize(rhs, agree_set, candidates);
+        }
+    }
+}
+
+bool DynFD::IsInPositiveCover(std::size_t rhs, AttributeSet const& lhs) const {
+    return std::ranges::find(positive_cover_[rhs], lhs) != positive_cover_[rhs].end();
+}
+
+void DynFD::InvertNegativeCover(std::size_t rhs) {
+    CandidateQueue unused;
+    positive_cover_[rhs] = {AttributeSet(num_columns_)};
+    for (NonFd const& non_fd : negative_cover_[rhs]) {
+        Specialize(rhs, non_fd.lhs, unused);
+    }
+}
+
+void DynFD::DiscoverFromScratch() {
+    positive_cover_.assign(num_columns_, {AttributeSet(num_columns_)});
+    negative_cover_.assign(num_columns_, {});
+
+    CandidateQueue candidates;
+    for (std::size_t rhs = 0; rhs < num_columns_; ++rhs) {
+        candidates.emplace_back(rhs, AttributeSet(num_columns_));
+    }
+    while (!candidates.empty()) {
+        auto [rhs, lhs] = std::move(candidates.front());
+        candidates.pop_front();
+        if (!IsInPositiveCover(rhs, lhs)) continue;
+        for (Witness const& witness :
+             CollectViolations(lhs, rhs, std::numeric_limits<std::size_t>::max())) {
+            AddAgreeSet(witness, candidates);
+        }
+    }
+}
+
+void DynFD::ProcessDeletions(std::unordered_set<RecordId> const& deleted) {
+    auto is_affected = [&deleted](Witness const& witness) {
+        return deleted.contains(witness.first) || deleted.contains(witness.second);
+    };
+
+    for (std::size_t rhs = 0; rhs < num_columns_; ++rhs) {
+        std::vector<NonFd>& cover = negative_cover_[rhs];
+        std::vector<AttributeSet> now_valid;
+        std::erase_if(cover, [&](NonFd& non_fd) {
+            if (!is_affected(non_fd.witness)) return false;
+            std::optional<Witness> witness = FindViolation(non_fd.lhs, rhs);
+            if (witness.has_value()) {
+                non_fd.witness = *witness;
+                return false;
+            }
+            now_valid.push_back(std::move(non_fd.lhs));
+            return true;
+        });
+        if (now_valid.empty()) continue;
+
+        // Maximal non-FDs may now be found among the subsets of the non-FDs that became valid
+        std::set<AttributeSet> visited;
+        std::vector<AttributeSet> to_check;
+        auto push_subsets = [&to_check](AttributeSet const& lhs) {
+            for (std::size_t attr = lhs.find_first(); attr != AttributeSet::npos;
+                 attr = lhs.find_next(attr)) {
+                to_check.push_back(lhs);
+                to_check.back().reset(attr);
+            }
+        };
+        for (AttributeSet const& lhs : now_valid) push_subsets(lhs);
+        while (!to_check.empty()) {
+            AttributeSet lhs = std::move(to_check.back());
+            to_check.pop_back();
+            if (!visited.insert(lhs).second) continue;
+            if (std::ranges::any_of(cover, [&lhs](NonFd const& non_fd) {
+                    return lhs.is_subset_of(non_fd.lhs);
+                })) {
+                continue;
+            }
+            if (std::optional<Witness> witness = FindViolation(lhs, rhs); witness.has_value()) {
+                AddNonFd(rhs, lhs, *witness);
+            } else {
+                push_subsets(lhs);
+            }
+        }
+
+        InvertNegativeCover(rhs);
+    }
+}
+
+void DynFD::ProcessInsertions(std::vector<RecordId> const& inserted) {
+    CandidateQueue candidates;
+    for (std::size_t rhs = 0; rhs < num_columns_; ++rhs) {
+        for (AttributeSet const& lhs : positive_cover_[rhs]) {
+            candidates.emplace_back(rhs, lhs);
+        }
+    }
+    while (!candidates.empty()) {
+        auto [rhs, lhs] = std::move(candidates.front());
+        candidates.pop_front();
+        if (!IsInPositiveCover(rhs, lhs)) continue;
+        if (std::optional<Witness> witness = FindViolation(lhs, rhs, inserted);
+            witness.has_value()) {
+            AddAgreeSet(*witness, candidates);
+        }
+    }
+}
+
+void DynFD::RegisterFds() {
+    for (std::size_t rhs = 0; rhs < num_columns_; ++rhs) {
+        for (AttributeSet const& lhs : positive_cover_[rhs]) {
+            RegisterFd(Vertical(schema_.get(), lhs), *schema_->GetColumn(rhs), schema_);
+        }
+    }
+}
+
+unsigned long long DynFD::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    std::vector<std::pair<RecordId, model::IDatasetStream::Row>> updates;
+    if (update_statements_table_ != nullptr) {
+        while (update_statements_table_->HasNextRow()) {
+            model::IDatasetStream::Row row = update_statements_table_->GetNextRow();
+            if (row.size() != num_columns_ + 1) {
+                LOG_WARN("Received row with size {}, but expected {}", row.size(),
+                         num_columns_ + 1);
+                continue;
+            }
+            RecordId id = std::stoull(row.front());
+            if (delete_statement_indices_.contains(id)) {
+                throw config::ConfigurationError(
+                        "Attempt to update a deleted row during processing of update operations");
+            }
+            updates.emplace_back(id, std::move(row));
+        }
+        update_statements_table_->Reset();
+    }
+
+    std::unordered_set<RecordId> deleted{delete_statement_indices_};
+    std::vector<RecordId> inserted;
+    std::vector<std::vector<std::pair<std::optional<std::size_t>, model::DynPLI::ClusterValue>>>
+            pli_inserts(num_columns_);
+    auto add_to_plis = [&pli_inserts, this](std::optional<std::size_t> id, RecordId record) {
+        for (std::size_t i = 0; i < num_columns_; ++i) {
+            pli_inserts[i].emplace_back(id, model::DynPLI::ClusterValue{records_[record][i]});
+        }
+    };
+
+    for (RecordId id : delete_statement_indices_) {
+        records_[id].clear();
+    }
+    num_live_records_ -= delete_statement_indices_.size();
+    if (insert_statements_table_ != nullptr) {
+        while (insert_statements_table_->HasNextRow()) {
+            model::IDatasetStream::Row row = insert_statements_table_->GetNextRow();
+            if (row.size() != num_columns_) {
+                LOG_WARN("Received row with size {}, but expected {}", row.size(), num_columns_);
+                continue;
+            }
+            inserted.push_back(records_.size());
+            records_.push_back(EncodeRow(row.begin()));
+            add_to_plis(std::nullopt, inserted.back());
+            ++num_live_records_;
+        }
+        insert_statements_table_->Reset();
+    }
+    for (auto& [id, row] : updates) {
+        records_[id] = EncodeRow(row.begin() + 1);
+        add_to_plis(id, id);
+        deleted.insert(id);
+        inserted.push_back(id);
+    }
+
+    for (std::size_t i = 0; i < num_columns_; ++i) {
+        plis_[i]->UpdateWith(pli_inserts[i], deleted);
+    }
+
+    if (!deleted.empty()) ProcessDeletions(deleted);
+    if (!inserted.empty()) ProcessInsertions(inserted);
+    RegisterFds();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+}  // namespace algos::dynfd
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/algorithms/fd/fd_algorithm.h"
+#include "core/config/tabular_data/input_table_type.h"
+#include "core/model/table/dynamic_position_list_index.h"
+#include "core/model/table/relational_schema.h"
+
+namespace algos::dynfd {
+
+/* Incremental FD discovery over a table changed by batches of insert, update and delete
+ * statements, in the spirit of DynFD (Schirmer et al., EDBT 2019).
+ *
+ * The algorithm keeps dynamic PLIs of all columns together with the positive cover (minimal FDs)
+ * and the negative cover (maximal non-FDs, each with a pair of rows witnessing the violation).
+ * Inserted rows can only invalidate FDs, so only FDs of the positive cover are checked against
+ * them, and only pairs that involve an inserted row are compared. Deleted rows can only make
+ * non-FDs valid, so only non-FDs whose witness was deleted are re-validated. After every
+ * Execute() the result is the same as that of a from-scratch run on the current table.
+ * Updates are handled as a deletion of the old row followed by an insertion of the new one. */
+class DynFD final : public FDAlgorithm {
+public:
+    DynFD();
+
+    /* Number of rows currently in the table */
+    std::size_t GetNumRows() const noexcept {
+        return num_live_records_;
+    }
+
+private:
+    using AttributeSet = boost::dynamic_bitset<>;
+    using RecordId = std::size_t;
+    using ValueId = int;
+    using Witness = std::pair<RecordId, RecordId>;
+    using CandidateQueue = std::deque<std::pair<std::size_t, AttributeSet>>;
+
+    struct NonFd {
+        AttributeSet lhs;
+        Witness witness;
+    };
+
+    config::InputTable input_table_;
+    config::InputTable insert_statements_table_ = nullptr;
+    config::InputTable update_statements_table_ = nullptr;
+    std::unordered_set<std::size_t> delete_statement_indices_;
+
+    std::shared_ptr<RelationalSchema> schema_;
+    std::size_t num_columns_ = 0;
+    std::vector<std::unordered_map<std::string, ValueId>> dictionaries_;
+    // Dictionary-encoded rows; rows of deleted records are empty
+    std::vector<std::vector<ValueId>> records_;
+    std::vector<std::unique_ptr<model::DynPLI>> plis_;
+    std::size_t num_live_records_ = 0;
+
+    // For every RHS attribute: minimal LHSs of valid FDs
+    std::vector<std::vector<AttributeSet>> positive_cover_;
+    // For every RHS attribute: maximal LHSs of non-FDs
+    std::vector<std::vector<NonFd>> negative_cover_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
+    void LoadDataInternal() final;
+    void ResetStateFd() final {}
+    unsigned long long ExecuteInternal() final;
+
+    std::vector<ValueId> EncodeRow(model::IDatasetStream::Row::iterator row_begin);
+    bool IsLive(RecordId record) const {
+        return record < records_.size() && !records_[record].empty();
+    }
+    model::DynPLI::Cluster const* FindCluster(std::size_t column, ValueId value) const;
+    AttributeSet GetAgreeSet(Witness const& witness) const;
+
+    /* Pairs of live rows that agree on lhs and differ on rhs, at most one per cluster of the most
+     * selective LHS attribute and at most max_witnesses in total */
+    std::vector<Witness> CollectViolations(AttributeSet const& lhs, std::size_t rhs,
+                                           std::size_t max_witnesses) const;
+    std::optional<Witness> FindViolation(AttributeSet const& lhs, std::size_t rhs) const;
+    /* Same as FindViolation, but only pairs that contain one of the given rows are checked */
+    std::optional<Witness> FindViolation(AttributeSet const& lhs, std::size_t rhs,
+                                         std::vector<RecordId> const& records) const;
+
+    bool AddNonFd(std::size_t rhs, AttributeSet const& lhs, Witness const& witness);
+    void Specialize(std::size_t rhs, AttributeSet const& non_fd_lhs, CandidateQueue& candidates);
+    void AddAgreeSet(Witness const& witness, CandidateQueue& candidates);
+    bool IsInPositiveCover(std::size_t rhs, AttributeSet const& lhs) const;
+    void InvertNegativeCover(std::size_t rhs);
+
+    void DiscoverFromScratch();
+    void ProcessDeletions(std::unordered_set<RecordId> const& deleted);
+    void ProcessInsertions(std::vector<RecordId> const& inserted);
+    void RegisterFds();
+};
+
+}  // namespace algos::dynfd
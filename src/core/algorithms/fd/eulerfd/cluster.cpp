@@ -27,14 +27,23 @@ double Cluster::GetAverage() const {
     return sum / kInitialWindow;
 }
 
-double Cluster::Sample(RegisterTuplesFunction const& handle_tuples) {
-    new_tuples_pairs_ = new_non_fds_ = 0;
-    window_++;
-
-    int64_t barrier = static_cast<int64_t>(cluster_data_.size()) - static_cast<int64_t>(window_);
+void Cluster::ForEachNextPair(TuplesConsumer const& consume) const {
+    size_t const window = window_ + 1;
+    int64_t barrier = static_cast<int64_t>(cluster_data_.size()) - static_cast<int64_t>(window);
     for (int64_t i = 0; i < barrier; i++) {
-        new_non_fds_ += handle_tuples(cluster_data_[i], cluster_data_[i + window_]);
+        consume(cluster_data_[i], cluster_data_[i + window]);
     }
+}
+
+double Cluster::Sample(RegisterTuplesFunction const& handle_tuples) {
+    size_t new_non_fds = 0;
+    ForEachNextPair([&](size_t t1, size_t t2) { new_non_fds += handle_tuples(t1, t2); });
+    return RegisterSample(new_non_fds);
+}
+
+double Cluster::RegisterSample(size_t new_non_fds) {
+    window_++;
+    new_non_fds_ = new_non_fds;
     new_tuples_pairs_ = cluster_data_.size() - window_;
 
     double cur_eff =
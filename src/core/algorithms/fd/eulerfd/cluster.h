@@ -9,6 +9,7 @@ namespace algos {
 class Cluster {
 public:
     using RegisterTuplesFunction = std::function<size_t(size_t, size_t)>;
+    using TuplesConsumer = std::function<void(size_t, size_t)>;
     using RandomStrategy = std::function<int()>;
 
 private:
@@ -35,5 +36,17 @@ public:
 
     double Sample(RegisterTuplesFunction const &handle_tuples);
     double GetAverage() const;
+
+    // Passes the pairs of tuples the next call of Sample will handle. Doesn't change the state of
+    // the cluster, so the next sample may be computed ahead of time, e.g. by another thread.
+    void ForEachNextPair(TuplesConsumer const &consume) const;
+    // Finishes a sample computed ahead of time, new_non_fds is the number of new non-FDs the
+    // sampled pairs have produced. Equivalent to Sample with a handler returning the same total.
+    double RegisterSample(size_t new_non_fds);
+
+    // Number of samples taken so far. Identifies the pairs ForEachNextPair passes.
+    size_t GetSampleNumber() const {
+        return sample_number_;
+    }
 };
 }  // namespace algos
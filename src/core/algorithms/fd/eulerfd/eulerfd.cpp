@@ -1,5 +1,8 @@
 #include "core/algorithms/fd/eulerfd/eulerfd.h"
 
+#include "core/config/thread_number/option.h"
+#include "core/util/parallel_for.h"
+
 namespace algos {
 
 EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
@@ -10,13 +13,15 @@ EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
     // Set configuration options
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
     MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
 
     max_lhs_ = std::numeric_limits<unsigned int>::max();
 }
 
 void EulerFD::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kCustomRandomFlagOpt.GetName()});
+    MakeOptionsAvailable(
+            {config::kCustomRandomFlagOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void EulerFD::LoadDataInternal() {
@@ -69,6 +74,7 @@ void EulerFD::ResetStateFd() {
     mlfq_.Clear();
     effective_threshold_ = kInitialEffectiveThreshold;
 
+    speculative_samples_.clear();
     invalids_.clear();
     new_invalids_.clear();
     fd_num_ = old_invalid_size_ = 0;
@@ -172,6 +178,10 @@ EulerFD::Bitset EulerFD::BuildAgreeSet(size_t t1, size_t t2) const {
 }
 
 double EulerFD::SamplingInCluster(Cluster* cluster) {
+    if (threads_num_ > 1) {
+        return ApplySpeculativeSample(cluster);
+    }
+
     return cluster->Sample([this](size_t t1, size_t t2) -> size_t {
         Bitset agree_set = BuildAgreeSet(t1, t2);
         auto&& [_, result] = invalids_.insert(agree_set);
@@ -186,15 +196,78 @@ double EulerFD::SamplingInCluster(Cluster* cluster) {
     });
 }
 
+double EulerFD::ApplySpeculativeSample(Cluster* cluster) {
+    auto it = speculative_samples_.find(cluster);
+    if (it == speculative_samples_.end() ||
+        it->second.sample_number != cluster->GetSampleNumber()) {
+        // The cluster was not predicted or was sampled again since then. Sample it together with
+        // the clusters MLFQ will give next.
+        std::vector<Cluster*> clusters{cluster};
+        for (Cluster* upcoming : mlfq_.GetUpcoming(threads_num_ * kSpeculationDepth)) {
+            if (upcoming != cluster) clusters.push_back(upcoming);
+        }
+        SpeculateSamples(clusters);
+        it = speculative_samples_.find(cluster);
+    }
+
+    size_t new_non_fds = 0;
+    for (Bitset& agree_set : it->second.agree_sets) {
+        auto&& [_, result] = invalids_.insert(agree_set);
+
+        // Check that this is a new FD
+        if (result) {
+            new_non_fds += agree_set.size() - agree_set.count();
+            new_invalids_.insert(std::move(agree_set));
+        }
+    }
+    speculative_samples_.erase(it);
+    return cluster->RegisterSample(new_non_fds);
+}
+
+void EulerFD::SpeculateSamples(std::vector<Cluster*> const& clusters) {
+    std::vector<std::vector<Bitset>> samples(clusters.size());
+    std::vector<size_t> indices(clusters.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // invalids_ is only read here, it is modified after all threads finish
+    util::ParallelForeach(indices.begin(), indices.end(), threads_num_, [&](size_t index) {
+        std::unordered_set<Bitset> seen;
+        std::vector<Bitset>& sample = samples[index];
+        clusters[index]->ForEachNextPair([&](size_t t1, size_t t2) {
+            Bitset agree_set = BuildAgreeSet(t1, t2);
+            if (!invalids_.contains(agree_set) && seen.insert(agree_set).second) {
+                sample.push_back(std::move(agree_set));
+            }
+        });
+    });
+
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        SpeculativeSample sample{clusters[i]->GetSampleNumber(), std::move(samples[i])};
+        speculative_samples_.insert_or_assign(clusters[i], std::move(sample));
+    }
+}
+
 void EulerFD::Sampling() {
     if (is_first_sample_) {
         // In first sampling mlfq is empty, we fill it.
         // We put all clusters in mlfq, even if effective coefficient was 0
         is_first_sample_ = false;
 
-        for (auto& cluster : clusters_) {
-            double eff = SamplingInCluster(&cluster);
-            mlfq_.Add(&cluster, eff, true);
+        size_t const batch_size = threads_num_ * kSpeculationDepth;
+        for (size_t batch_begin = 0; batch_begin < clusters_.size(); batch_begin += batch_size) {
+            size_t const batch_end = std::min(batch_begin + batch_size, clusters_.size());
+            if (threads_num_ > 1) {
+                std::vector<Cluster*> batch;
+                for (size_t i = batch_begin; i < batch_end; ++i) {
+                    batch.push_back(&clusters_[i]);
+                }
+                SpeculateSamples(batch);
+            }
+            for (size_t i = batch_begin; i < batch_end; ++i) {
+                Cluster& cluster = clusters_[i];
+                double eff = SamplingInCluster(&cluster);
+                mlfq_.Add(&cluster, eff, true);
+            }
         }
 
         if (mlfq_.GetLastQueueSize() > 0) {
@@ -222,6 +295,8 @@ void EulerFD::Sampling() {
         SamplingInCluster(cluster);
         mlfq_.AddAtLast(cluster);
     }
+
+    speculative_samples_.clear();
 }
 
 bool EulerFD::IsNCoverGrowthSmall() const {
@@ -354,11 +429,14 @@ size_t EulerFD::GenerateResults() {
     std::sort(neg_cover_vector.begin(), neg_cover_vector.end(),
               [](Bitset const& left, Bitset const& right) { return left.count() > right.count(); });
 
-    // Creating ncover and pcover trees for each rhs
-    size_t fd_num = 0;
-    for (size_t rhs = 0; rhs < number_of_attributes_; rhs++) {
+    // Creating ncover and pcover trees for each rhs. Trees of different rhs are independent,
+    // so they are processed in parallel
+    std::vector<size_t> rhs_fd_nums(number_of_attributes_, 0);
+    std::vector<size_t> rhs_indices(number_of_attributes_);
+    std::iota(rhs_indices.begin(), rhs_indices.end(), 0);
+    util::ParallelForeach(rhs_indices.begin(), rhs_indices.end(), threads_num_, [&](size_t rhs) {
         if (constant_columns_[rhs]) {
-            continue;
+            return;
         }
 
         size_t real_rhs = inv_indexes[rhs];
@@ -367,9 +445,9 @@ size_t EulerFD::GenerateResults() {
         std::sort(neg.begin(), neg.end(), [](Bitset const& left, Bitset const& right) {
             return left.count() > right.count();
         });
-        fd_num += Invert(real_rhs, neg);
-    }
-    return fd_num;
+        rhs_fd_nums[rhs] = Invert(real_rhs, neg);
+    });
+    return std::accumulate(rhs_fd_nums.begin(), rhs_fd_nums.end(), size_t{0});
 }
 
 unsigned long long EulerFD::ExecuteInternal() {
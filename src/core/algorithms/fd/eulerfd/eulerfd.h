@@ -21,6 +21,7 @@
 #include "core/config/custom_random_seed/type.h"
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/table/vertical.h"
@@ -46,6 +47,7 @@ class EulerFD : public FDAlgorithm {
     std::vector<std::vector<size_t>> tuples_;
 
     config::EqNullsType is_null_equal_null_{};
+    config::ThreadNumType threads_num_{};
 
     // Thresholds to checking criterion of EulerFD cycles
     constexpr static double kPosCoverGrowthThreshold = 0.01;
@@ -65,6 +67,19 @@ class EulerFD : public FDAlgorithm {
     constexpr static double kInitialEffectiveThreshold = 0.01;
     double effective_threshold_ = kInitialEffectiveThreshold;
 
+    // Samples of clusters computed ahead of time by worker threads. Agree sets of a sample are
+    // deduplicated and filtered against invalids_, their order is the order of sampled pairs.
+    // Samples are applied in the same order the sequential algorithm takes clusters, so the
+    // result doesn't depend on the number of threads.
+    struct SpeculativeSample {
+        size_t sample_number;
+        std::vector<Bitset> agree_sets;
+    };
+
+    // Number of clusters sampled ahead of time per thread
+    constexpr static size_t kSpeculationDepth = 4;
+    std::unordered_map<Cluster const *, SpeculativeSample> speculative_samples_;
+
     // Invalid fds storages
     std::unordered_set<Bitset> invalids_;
     std::unordered_set<Bitset> new_invalids_;
@@ -90,6 +105,8 @@ class EulerFD : public FDAlgorithm {
     void BuildPartition();
 
     double SamplingInCluster(Cluster *cluster);
+    double ApplySpeculativeSample(Cluster *cluster);
+    void SpeculateSamples(std::vector<Cluster *> const &clusters);
     void Sampling();
     size_t GenerateResults();
 
@@ -28,7 +28,7 @@ void MLFQ::Add(Cluster *cluster, double priority, bool add_if_zero) {
         int queue = static_cast<int>(std::floor(std::log10(priority))) + 3;
         queue = queue > 4 ? 4 : queue;
         actual_queue_ = std::max(actual_queue_, queue);
-        queues_[queue].first.push(cluster);
+        queues_[queue].first.push_back(cluster);
         effective_size_++;
     }
 }
@@ -42,7 +42,7 @@ void MLFQ::AddAtLast(Cluster *cluster) {
 Cluster *MLFQ::Get() {
     if (actual_queue_ >= 0) {
         Cluster *save = queues_[actual_queue_].first.front();
-        queues_[actual_queue_].first.pop();
+        queues_[actual_queue_].first.pop_front();
         effective_size_--;
         while (actual_queue_ >= 0 && queues_[actual_queue_].first.empty()) {
             actual_queue_--;
@@ -54,6 +54,23 @@ Cluster *MLFQ::Get() {
     return cluster;
 }
 
+std::vector<Cluster *> MLFQ::GetUpcoming(size_t limit) const {
+    std::vector<Cluster *> upcoming;
+    for (int queue = actual_queue_; queue >= 0 && upcoming.size() < limit; queue--) {
+        auto const &clusters = queues_[queue].first;
+        size_t const count = std::min(clusters.size(), limit - upcoming.size());
+        upcoming.insert(upcoming.end(), clusters.begin(), clusters.begin() + count);
+    }
+    if (upcoming.size() < limit) {
+        auto last_queue = last_queue_;
+        while (!last_queue.empty() && upcoming.size() < limit) {
+            upcoming.push_back(last_queue.top().cluster);
+            last_queue.pop();
+        }
+    }
+    return upcoming;
+}
+
 size_t MLFQ::GetEffectiveSize() const {
     return effective_size_;
 }
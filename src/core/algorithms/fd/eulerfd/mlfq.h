@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -11,7 +12,7 @@ namespace algos {
 
 class MLFQ {
 private:
-    using Queue = std::pair<std::queue<Cluster *>, double>;
+    using Queue = std::pair<std::deque<Cluster *>, double>;
 
     constexpr static double kLastQueueRangeBarrier = 0.001;
 
@@ -33,6 +34,9 @@ public:
     void Add(Cluster *cluster, double priority, bool add_if_zero = false);
     void AddAtLast(Cluster *cluster);
     [[nodiscard]] Cluster *Get();
+    // Returns at most `limit` clusters in the order successive calls of Get would return them if
+    // nothing was added in between.
+    [[nodiscard]] std::vector<Cluster *> GetUpcoming(size_t limit) const;
 
     [[nodiscard]] size_t GetEffectiveSize() const;
     [[nodiscard]] size_t GetLastQueueSize() const;
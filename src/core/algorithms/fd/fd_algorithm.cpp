@@ -41,7 +41,12 @@ std::list<FD>& FDAlgorithm::SortedFdList() {
 }
 
 std::string FDAlgorithm::GetJsonFDs() const {
-    return FDsToJson(FdList());
+    std::vector<std::string> discovered_fd_strings;
+    discovered_fd_strings.reserve(fd_collection_.Size());
+    fd_collection_.ForEach([&discovered_fd_strings](FD const& fd) {
+        discovered_fd_strings.push_back(fd.ToJSONString());
+    });
+    return FDStringsToJson(std::move(discovered_fd_strings));
 }
 
 unsigned int FDAlgorithm::Fletcher16() {
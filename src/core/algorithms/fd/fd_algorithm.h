@@ -10,6 +10,7 @@
 #include "core/algorithms/fd/fd.h"
 #include "core/config/max_lhs/type.h"
 #include "core/util/primitive_collection.h"
+#include "core/util/primitive_sink.h"
 
 namespace model {
 class AgreeSetFactory;
@@ -27,6 +28,9 @@ private:
     void RegisterOptions();
 
     void ResetState() final;
+    void FlushResults() final {
+        fd_collection_.Flush();
+    }
     virtual void MakeExecuteOptsAvailableFDInternal() {};
     void MakeExecuteOptsAvailable() override;
     virtual void ResetStateFd() = 0;
@@ -58,14 +62,21 @@ public:
     explicit FDAlgorithm();
 
     /* Returns the list of discovered FDs */
-    std::list<FD> const& FdList() const noexcept {
+    std::list<FD> const& FdList() const {
         return fd_collection_.AsList();
     }
 
-    std::list<FD>& FdList() noexcept {
+    std::list<FD>& FdList() {
         return fd_collection_.AsList();
     }
 
+    /* Discovered FDs are passed to the sink as soon as they are registered instead of being
+     * collected in FdList. nullptr returns to the default behaviour
+     */
+    void SetFdSink(std::shared_ptr<util::PrimitiveSink<FD>> sink) {
+        fd_collection_.SetSink(std::move(sink));
+    }
+
     std::list<FD>& SortedFdList();
 
     /* возвращает набор ФЗ в виде JSON-а. По сути, это просто представление фиксированного формата
@@ -81,11 +92,15 @@ public:
 
     template <typename Container>
     static std::string FDsToJson(Container const& fds) {
-        std::string result = "{\"fds\": [";
         std::vector<std::string> discovered_fd_strings;
         for (FD const& fd : fds) {
             discovered_fd_strings.push_back(fd.ToJSONString());
         }
+        return FDStringsToJson(std::move(discovered_fd_strings));
+    }
+
+    static std::string FDStringsToJson(std::vector<std::string> discovered_fd_strings) {
+        std::string result = "{\"fds\": [";
         std::sort(discovered_fd_strings.begin(), discovered_fd_strings.end());
         for (std::string const& fd : discovered_fd_strings) {
             result += fd + ",";
@@ -246,13 +246,15 @@ void FDTreeElement::PrintDependencies(model::Bitset<FDTreeElement::kMaxAttrNum>&
 }
 
 void FDTreeElement::FillFdCollection(std::shared_ptr<RelationalSchema> const& scheme,
-                                     std::list<FD>& fd_collection, unsigned int max_lhs) const {
+                                     util::PrimitiveCollection<FD>& fd_collection,
+                                     unsigned int max_lhs) const {
     model::Bitset<kMaxAttrNum> active_path;
     this->TransformTreeFdCollection(active_path, fd_collection, scheme, max_lhs);
 }
 
 void FDTreeElement::TransformTreeFdCollection(
-        model::Bitset<FDTreeElement::kMaxAttrNum>& active_path, std::list<FD>& fd_collection,
+        model::Bitset<FDTreeElement::kMaxAttrNum>& active_path,
+        util::PrimitiveCollection<FD>& fd_collection,
         std::shared_ptr<RelationalSchema> const& scheme, unsigned int max_lhs) const {
     if (active_path.count() > max_lhs) return;
 
@@ -267,7 +269,7 @@ void FDTreeElement::TransformTreeFdCollection(
             }
             Vertical lhs(scheme.get(), lhs_bitset);
             Column rhs(scheme.get(), scheme->GetColumn(attr - 1)->GetName(), attr - 1);
-            fd_collection.emplace_back(FD{lhs, rhs, scheme});
+            fd_collection.Register(std::move(lhs), std::move(rhs), scheme);
         }
     }
 
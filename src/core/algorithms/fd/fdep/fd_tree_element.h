@@ -1,6 +1,5 @@
 #pragma once
 
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -11,6 +10,7 @@
 #include "core/algorithms/fd/fd.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/types/bitset.h"
+#include "core/util/primitive_collection.h"
 
 class FDTreeElement {
 public:
@@ -45,7 +45,7 @@ public:
     void PrintDep(std::string const& file, std::vector<std::string>& column_names) const;
 
     void FillFdCollection(std::shared_ptr<RelationalSchema> const& scheme,
-                          std::list<FD>& fd_collection,
+                          util::PrimitiveCollection<FD>& fd_collection,
                           unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 
 private:
@@ -75,7 +75,7 @@ private:
                            std::vector<std::string>& column_names) const;
 
     void TransformTreeFdCollection(
-            model::Bitset<kMaxAttrNum>& active_path, std::list<FD>& fd_collection,
+            model::Bitset<kMaxAttrNum>& active_path, util::PrimitiveCollection<FD>& fd_collection,
             std::shared_ptr<RelationalSchema> const& scheme,
             unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 };
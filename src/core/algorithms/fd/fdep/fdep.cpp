@@ -1,11 +1,19 @@
 #include "core/algorithms/fd/fdep/fdep.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
 
 #include "core/config/equal_nulls/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/types/bitset.h"
+#include "core/util/parallel_for.h"
 
 // #ifndef PRINT_FDS
 // #define PRINT_FDS
@@ -20,6 +28,12 @@ FDep::FDep() : FDAlgorithm() {
 
 void FDep::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
+}
+
+void FDep::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void FDep::LoadDataInternal() {
@@ -36,15 +50,22 @@ void FDep::LoadDataInternal() {
         schema_->AppendColumn(column_names_[i]);
     }
 
+    packed_tuples_.clear();
+    number_tuples_ = 0;
+    std::vector<std::unordered_map<std::string, ValueId>> dictionaries(number_attributes_);
     std::vector<std::string> next_line;
     while (input_table_->HasNextRow()) {
         next_line = input_table_->GetNextRow();
         if (next_line.empty()) break;
-        tuples_.emplace_back(std::vector<size_t>(number_attributes_));
         for (size_t i = 0; i < number_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
+            auto& dictionary = dictionaries[i];
+            auto const [it, _] = dictionary.try_emplace(std::move(next_line[i]),
+                                                        static_cast<ValueId>(dictionary.size()));
+            packed_tuples_.push_back(it->second);
         }
+        ++number_tuples_;
     }
+    packed_tuples_.shrink_to_fit();
 }
 
 void FDep::ResetStateFd() {
@@ -58,15 +79,13 @@ unsigned long long FDep::ExecuteInternal() {
 
     BuildNegativeCover();
 
-    this->tuples_.shrink_to_fit();
-
     this->pos_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
     this->pos_cover_tree_->AddMostGeneralDependencies();
 
     model::Bitset<FDTreeElement::kMaxAttrNum> active_path;
     CalculatePositiveCover(*this->neg_cover_tree_, active_path);
 
-    pos_cover_tree_->FillFdCollection(this->schema_, FdList(), max_lhs_);
+    pos_cover_tree_->FillFdCollection(this->schema_, fd_collection_, max_lhs_);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -80,23 +99,69 @@ unsigned long long FDep::ExecuteInternal() {
 
 void FDep::BuildNegativeCover() {
     this->neg_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
-        for (auto j = i + 1; j != this->tuples_.end(); ++j) AddViolatedFDs(*i, *j);
-    }
+
+    size_t const number_tiles = (number_tuples_ + kTileRows - 1) / kTileRows;
+    size_t const buffer_capacity = std::max<size_t>(
+            1, (static_cast<size_t>(mem_limit_mb_) << 20) / (threads_num_ * kBufferedSetBytes));
+    std::atomic<size_t> next_tile_row = 0;
+    std::mutex neg_cover_mutex;
+
+    auto merge = [this, &neg_cover_mutex](std::unordered_set<AttrSet>& diff_sets) {
+        std::lock_guard const lock(neg_cover_mutex);
+        for (AttrSet const& diff_attr : diff_sets) {
+            AddViolatedFDs(diff_attr);
+        }
+        diff_sets.clear();
+    };
+
+    // Rows of tiles are taken in order of decreasing length, so the dynamic scheduling keeps the
+    // threads balanced.
+    auto worker = [&](config::ThreadNumType) {
+        std::unordered_set<AttrSet> diff_sets;
+        size_t tile_row;
+        while ((tile_row = next_tile_row.fetch_add(1, std::memory_order_relaxed)) < number_tiles) {
+            for (size_t tile_col = tile_row; tile_col < number_tiles; ++tile_col) {
+                CollectTileDiffSets(tile_row, tile_col, diff_sets);
+                if (diff_sets.size() >= buffer_capacity) merge(diff_sets);
+            }
+        }
+        merge(diff_sets);
+    };
+
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
 
     this->neg_cover_tree_->FilterSpecializations();
 }
 
-void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2) {
-    model::Bitset<FDTreeElement::kMaxAttrNum> equal_attr((2 << this->number_attributes_) - 1);
-    equal_attr.reset(0);
-    model::Bitset<FDTreeElement::kMaxAttrNum> diff_attr;
+void FDep::CollectTileDiffSets(size_t tile_row, size_t tile_col,
+                               std::unordered_set<AttrSet>& diff_sets) const {
+    size_t const first_begin = tile_row * kTileRows;
+    size_t const first_end = std::min(first_begin + kTileRows, number_tuples_);
+    size_t const second_begin = tile_col * kTileRows;
+    size_t const second_end = std::min(second_begin + kTileRows, number_tuples_);
+
+    for (size_t i = first_begin; i < first_end; ++i) {
+        ValueId const* t1 = packed_tuples_.data() + i * number_attributes_;
+        for (size_t j = std::max(i + 1, second_begin); j < second_end; ++j) {
+            ValueId const* t2 = packed_tuples_.data() + j * number_attributes_;
+            AttrSet diff_attr;
+            for (size_t attr = 0; attr < number_attributes_; ++attr) {
+                diff_attr[attr + 1] = (t1[attr] != t2[attr]);
+            }
+            // Equal tuples violate nothing.
+            if (diff_attr.any()) diff_sets.insert(diff_attr);
+        }
+    }
+}
 
-    for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
-        diff_attr[attr + 1] = (t1[attr] != t2[attr]);
+void FDep::AddViolatedFDs(AttrSet const& diff_attr) {
+    AttrSet equal_attr;
+    for (size_t attr = 1; attr <= this->number_attributes_; ++attr) {
+        equal_attr[attr] = !diff_attr[attr];
     }
 
-    equal_attr &= (~diff_attr);
     for (size_t attr = diff_attr._Find_first(); attr != FDTreeElement::kMaxAttrNum;
          attr = diff_attr._Find_next(attr)) {
         this->neg_cover_tree_->AddFunctionalDependency(equal_attr, attr);
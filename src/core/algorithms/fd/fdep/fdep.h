@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "core/algorithms/fd/fd_algorithm.h"
 #include "core/algorithms/fd/fdep/fd_tree_element.h"
 #include "core/config/equal_nulls/type.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/relation_data.h"
 #include "core/model/table/relational_schema.h"
 #include "core/model/types/bitset.h"
@@ -20,7 +25,18 @@ public:
     ~FDep() override = default;
 
 private:
+    using AttrSet = model::Bitset<FDTreeElement::kMaxAttrNum>;
+    using ValueId = std::uint32_t;
+
+    // Number of rows in one side of a tile of the tuple pair matrix. Two tiles of packed rows
+    // should fit into L1 cache for reasonable numbers of attributes.
+    static constexpr std::size_t kTileRows = 128;
+    // Approximate memory footprint of one buffered difference set in a hash set node.
+    static constexpr std::size_t kBufferedSetBytes = sizeof(AttrSet) + 4 * sizeof(void*);
+
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_;
+    config::MemLimitMBType mem_limit_mb_;
 
     std::shared_ptr<RelationalSchema> schema_{};
 
@@ -30,21 +46,33 @@ private:
     std::unique_ptr<FDTreeElement> neg_cover_tree_{};
     std::unique_ptr<FDTreeElement> pos_cover_tree_{};
 
-    std::vector<std::vector<size_t>> tuples_;
+    // Dictionary-encoded tuples stored row by row in one contiguous buffer: value of attribute
+    // `a` of tuple `t` is packed_tuples_[t * number_attributes_ + a].
+    std::vector<ValueId> packed_tuples_;
+    size_t number_tuples_{};
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void LoadDataInternal() final;
 
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
-    // Building negative cover via violated dependencies
+    // Building negative cover via violated dependencies.
+    // The upper triangle of the tuple pair matrix is split into square tiles, rows of tiles are
+    // distributed between threads. Every thread deduplicates difference sets locally and merges
+    // them into the negative cover tree once its buffer exceeds its share of the memory limit.
     void BuildNegativeCover();
 
-    // Iterating over all pairs t1 and t2 of the relation
-    // Adding violated FDs to negative cover tree.
-    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2);
+    // Collecting difference sets of all pairs (t1, t2), t1 < t2, where t1 belongs to the
+    // `tile_row`-th tile and t2 belongs to the `tile_col`-th tile.
+    void CollectTileDiffSets(size_t tile_row, size_t tile_col,
+                             std::unordered_set<AttrSet>& diff_sets) const;
+
+    // Adding FDs violated by a pair of tuples that differ exactly on `diff_attr` to negative
+    // cover tree.
+    void AddViolatedFDs(AttrSet const& diff_attr);
 
     // Converting negative cover tree into positive cover tree
     void CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
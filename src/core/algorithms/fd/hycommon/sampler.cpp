@@ -11,6 +11,7 @@
 
 #include "core/algorithms/fd/hycommon/efficiency.h"
 #include "core/algorithms/fd/hycommon/util/pli_util.h"
+#include "core/util/metrics.h"
 
 namespace {
 
@@ -99,6 +100,7 @@ void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex con
         }
     }
 
+    DESBORDANTE_METRICS_COUNT("sampled_pairs", comparisons);
     size_t const num_new_violations = agree_sets_->Count() - prev_num_agree_sets;
 
     efficiency.SetViolations(num_new_violations);
@@ -125,6 +127,7 @@ void Sampler::RunWindow(Efficiency& efficiency, model::PositionListIndex const&
 void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions) {
     size_t const num_attributes = plis_->size();
 
+    DESBORDANTE_METRICS_COUNT("sampled_pairs", comparison_suggestions.size());
     for (auto [first_id, second_id] : comparison_suggestions) {
         boost::dynamic_bitset<> equal_attrs(num_attributes);
         Match(equal_attrs, first_id, second_id);
@@ -179,10 +182,10 @@ void Sampler::InitializeEfficiencyQueueParallel() {
     using EfficiencyAndMatches = std::pair<Efficiency, std::vector<boost::dynamic_bitset<>>>;
     std::vector<boost::unique_future<EfficiencyAndMatches>> futures;
     for (size_t attr = 0; attr < plis_->size(); ++attr) {
-        auto run_window = [attr, this]() {
+        auto run_window = util::metrics::BindCurrentRegistry([attr, this]() {
             Efficiency efficiency(attr);
             return std::make_pair(efficiency, RunWindowRet(efficiency, *(*plis_)[attr]));
-        };
+        });
         boost::packaged_task<EfficiencyAndMatches> task(std::move(run_window));
         futures.push_back(task.get_future());
         boost::asio::post(*pool_, std::move(task));
@@ -244,6 +247,7 @@ void Sampler::InitializeEfficiencyQueue() {
 }
 
 ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestions) {
+    DESBORDANTE_METRICS_PHASE("sampling");
     ProcessComparisonSuggestions(comparison_suggestions);
 
     if (efficiency_queue_.empty()) {
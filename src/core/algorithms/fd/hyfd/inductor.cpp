@@ -2,9 +2,12 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "core/util/metrics.h"
+
 namespace algos::hyfd {
 
 void Inductor::UpdateFdTree(NonFDList&& non_fds) {
+    DESBORDANTE_METRICS_PHASE("induction");
     unsigned const max_level = non_fds.GetDepth();
 
     for (unsigned level = max_level; level != 0; level--) {
@@ -12,6 +12,7 @@
 #include "core/algorithms/fd/hycommon/util/pli_util.h"
 #include "core/algorithms/fd/hycommon/validator_helpers.h"
 #include "core/algorithms/fd/hyfd/hyfd_config.h"
+#include "core/util/metrics.h"
 
 namespace {
 
@@ -273,6 +274,7 @@ Validator::FDValidations Validator::ValidateAndExtendPar(std::vector<LhsPair> co
 }
 
 algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
+    DESBORDANTE_METRICS_PHASE("validation");
     size_t const num_attributes = plis_->size();
 
     std::vector<LhsPair> cur_level_vertices;
@@ -292,6 +294,9 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
         } else {
             result = ValidateAndExtendSeq(cur_level_vertices);
         }
+        DESBORDANTE_METRICS_COUNT("fd_validations", result.CountValidations());
+        DESBORDANTE_METRICS_COUNT("invalid_fds", result.InvalidInstances().size());
+        DESBORDANTE_METRICS_COUNT("validation_intersections", result.CountIntersections());
 
         comparison_suggestions.insert(comparison_suggestions.end(),
                                       result.ComparisonSuggestions().begin(),
@@ -11,6 +11,7 @@
 #include "core/config/option_using.h"
 #include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace algos {
 
@@ -77,9 +78,6 @@ unsigned long long Pyro::ExecuteInternal() {
                                                   .count();
 
     start_time = std::chrono::system_clock::now();
-    unsigned int total_error_calc_count = 0;
-    unsigned long long total_ascension = 0;
-    unsigned long long total_trickle = 0;
 
     auto const work_on_search_space = [](std::list<std::unique_ptr<SearchSpace>>& search_spaces,
                                          ProfilingContext* profiling_context,
@@ -103,8 +101,8 @@ unsigned long long Pyro::ExecuteInternal() {
 
     std::vector<std::thread> threads;
     for (int i = 0; i < parameters_.parallelism; i++) {
-        threads.emplace_back(work_on_search_space, std::ref(search_spaces_),
-                             profiling_context.get(), i);
+        threads.emplace_back(util::metrics::BindCurrentRegistry(work_on_search_space),
+                             std::ref(search_spaces_), profiling_context.get(), i);
     }
 
     for (int i = 0; i < parameters_.parallelism; i++) {
@@ -114,13 +112,8 @@ unsigned long long Pyro::ExecuteInternal() {
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
 
-    LOG_INFO("FdG1 error calculation: {} ms", (FdG1Strategy::nanos_ / 1000000));
     LOG_INFO("Init time: {} ms", init_time_millis);
     LOG_INFO("Time: {} milliseconds", elapsed_milliseconds.count());
-    LOG_INFO("Error calculation count: {}", total_error_calc_count);
-    LOG_INFO("Total ascension time: {} ms", total_ascension);
-    LOG_INFO("Total trickle time: {} ms", total_trickle);
-    LOG_INFO("Total intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
     LOG_INFO("HASH: {}", PliBasedFDAlgorithm::Fletcher16());
     return elapsed_milliseconds.count();
 }
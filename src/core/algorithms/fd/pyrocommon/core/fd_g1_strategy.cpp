@@ -5,8 +5,7 @@
 #include "core/algorithms/fd/pyrocommon/core/search_space.h"
 #include "core/algorithms/fd/pyrocommon/model/pli_cache.h"
 #include "core/util/logger.h"
-
-unsigned long long FdG1Strategy::nanos_ = 0;
+#include "core/util/metrics.h"
 
 double FdG1Strategy::CalculateG1(model::PositionListIndex* lhs_pli) const {
     unsigned long long num_violations = 0;
@@ -60,6 +59,7 @@ void FdG1Strategy::EnsureInitialized(SearchSpace* search_space) const {
 }
 
 double FdG1Strategy::CalculateError(Vertical const& lhs) const {
+    DESBORDANTE_METRICS_PHASE("error_calculation");
     double error = 0;
     if (lhs.GetArity() == 0) {
         auto rhs_pli = context_->GetPliCache()->Get(static_cast<Vertical>(*rhs_));
@@ -4,6 +4,7 @@
 
 #include "core/algorithms/fd/pyrocommon/core/search_space.h"
 #include "core/algorithms/fd/pyrocommon/model/pli_cache.h"
+#include "core/util/metrics.h"
 
 double KeyG1Strategy::CalculateKeyError(model::PositionListIndex* pli) const {
     return CalculateKeyError(pli->GetNepAsLong());
@@ -30,6 +31,7 @@ void KeyG1Strategy::EnsureInitialized(SearchSpace* search_space) const {
 }
 
 double KeyG1Strategy::CalculateError(Vertical const& key_candidate) const {
+    DESBORDANTE_METRICS_PHASE("error_calculation");
     auto pli = context_->GetPliCache()->GetOrCreateFor(key_candidate, context_);
     auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
                                ? std::get<model::PositionListIndex*>(pli)
@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 // TODO: extra careful with const& -> shared_ptr conversions via make_shared-smart pointer may
 // delete the object - pass empty deleter [](*) {}
@@ -154,6 +155,7 @@ void SearchSpace::ReturnLaunchPad(DependencyCandidate const& launch_pad, bool is
 }
 
 bool SearchSpace::Ascend(DependencyCandidate const& launch_pad) {
+    DESBORDANTE_METRICS_PHASE("ascend");
     auto now = std::chrono::system_clock::now();
 
     LOG_DEBUG("===== Ascending from {} ======", strategy_->Format(launch_pad.vertical_));
@@ -300,6 +302,7 @@ void SearchSpace::CheckEstimate([[maybe_unused]] DependencyStrategy* strategy,
 }
 
 void SearchSpace::TrickleDown(Vertical const& main_peak, double main_peak_error) {
+    DESBORDANTE_METRICS_PHASE("trickle_down");
     LOG_DEBUG("====== Trickling down from {} ======", main_peak.ToString());
 
     std::unordered_set<Vertical> maximal_non_deps;
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "core/algorithms/fd/pyrocommon/model/agree_set_sample.h"
+#include "core/util/metrics.h"
 
 namespace model {
 
@@ -15,6 +16,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData con
                                                     unsigned int sample_size,
                                                     CustomRandom& random) {
     static_assert(std::is_base_of<AgreeSetSample, T>::value);
+    DESBORDANTE_METRICS_PHASE("agree_set_sampling");
     // std::random_device rd;
     // std::mt19937 gen(rd());
     // std::uniform_real_distribution<> random_double;
@@ -120,6 +122,7 @@ std::unique_ptr<T> AgreeSetSample::CreateFocusedFor(ColumnLayoutRelationData con
     LOG_DEBUG << boost::format {"Created sample focused on %1%: %2%"} %
     restriction_vertical->ToString() % agreeSetCountersStr;
     */
+    DESBORDANTE_METRICS_COUNT("sampled_pairs", sample_size);
     return std::make_unique<T>(relation, restriction_vertical, sample_size, restriction_nep,
                                std::move(agree_set_counters));
 }
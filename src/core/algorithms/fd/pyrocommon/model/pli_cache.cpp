@@ -4,6 +4,7 @@
 
 #include "core/model/table/vertical_map.h"
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace model {
 
@@ -53,10 +54,12 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     PositionListIndex* pli = Get(vertical);
     if (pli != nullptr) {
         pli->IncFreq();
+        DESBORDANTE_METRICS_COUNT("pli_cache_hits", 1);
         LOG_DEBUG("Served from PLI cache.");
         // addToUsageCounter
         return pli;
     }
+    DESBORDANTE_METRICS_COUNT("pli_cache_misses", 1);
     // look for cached PLIs to construct the requested one
     auto subset_entries = index_->GetSubsetEntries(vertical);
     boost::optional<PositionListIndexRank> smallest_pli_rank;
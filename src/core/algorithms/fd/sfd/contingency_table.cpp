@@ -1,5 +1,7 @@
 #include "core/algorithms/fd/sfd/contingency_table.h"
 
+#include <algorithm>
+
 #include <boost/math/distributions/chi_squared.hpp>
 
 #include "core/algorithms/fd/sfd/frequency_handler.h"
@@ -10,29 +12,33 @@ ContingencyTable::ContingencyTable(model::ColumnIndex col_i, model::ColumnIndex
                                    std::vector<size_t> const &domains_)
     : col_i_(col_i),
       col_k_(col_k),
-      n_i_j_(domains_[col_i], std::vector<long double>(domains_[col_k], 0)),
+      domain_k_(domains_[col_k]),
+      n_i_j_(domains_[col_i] * domains_[col_k], 0),
       n_i_(domains_[col_i], 0),
       n_j_(domains_[col_k], 0) {}
 
-[[nodiscard]] size_t ContingencyTable::Category(model::ColumnIndex col_ind, std::string const &val,
-                                                size_t domain, bool skew,
-                                                FrequencyHandler const &handler) {
-    if (skew) {
-        return handler.GetValueOrdinalNumberAtColumn(val, col_ind);
+std::vector<size_t> ContingencyTable::CalculateCategories(model::ColumnIndex col_ind,
+                                                          size_t domain, bool skew,
+                                                          FrequencyHandler const &handler) {
+    std::vector<size_t> categories(handler.GetColumnCardinality(col_ind));
+    for (FrequencyHandler::ValueCode code = 0; code < categories.size(); code++) {
+        // Values that are not frequent are filtered out of the samples of skewed columns
+        categories[code] = skew ? handler.GetOrdinalNumber(col_ind, code)
+                                : handler.GetValueHash(col_ind, code) % domain;
     }
-    return std::hash<std::string>{}(val) % domain;
+    return categories;
 }
 
-void ContingencyTable::FillTable(Sample const &smp, std::vector<model::TypedColumnData> const &data,
-                                 FrequencyHandler const &handler,
-                                 std::vector<bool> const &is_skewed_,
-                                 std::vector<size_t> const &domains_) {
+void ContingencyTable::FillTable(Sample const &smp, FrequencyHandler const &handler,
+                                 std::vector<std::vector<size_t>> const &categories) {
+    std::vector<FrequencyHandler::ValueCode> const &codes_i = handler.GetValueCodes(col_i_);
+    std::vector<FrequencyHandler::ValueCode> const &codes_k = handler.GetValueCodes(col_k_);
+    std::vector<size_t> const &categories_i = categories[col_i_];
+    std::vector<size_t> const &categories_k = categories[col_k_];
     for (model::TupleIndex row_ind : smp.GetRowIndices()) {
-        size_t i = Category(col_i_, data[col_i_].GetDataAsString(row_ind), domains_[col_i_],
-                            is_skewed_[col_i_], handler);
-        size_t j = Category(col_k_, data[col_k_].GetDataAsString(row_ind), domains_[col_k_],
-                            is_skewed_[col_k_], handler);
-        n_i_j_[i][j]++;
+        size_t i = categories_i[codes_i[row_ind]];
+        size_t j = categories_k[codes_k[row_ind]];
+        n_i_j_[i * domain_k_ + j]++;
         n_i_[i]++;
         n_j_[j]++;
     }
@@ -47,9 +53,9 @@ long double ContingencyTable::CalculateChiSquared(long double sample_size,
     long double chi_squared = 0;
     for (size_t i = 0; i < domains[col_i_]; i++) {
         for (size_t j = 0; j < domains[col_k_]; j++) {
-            if (n_i_[i] * n_j_[j] == 0) return 0;
-            long double actual = n_i_j_[i][j];
-            long double expected = n_i_[i] * n_j_[j] / sample_size;
+            if (n_i_[i] == 0 || n_j_[j] == 0) return 0;
+            long double actual = n_i_j_[i * domain_k_ + j];
+            long double expected = static_cast<long double>(n_i_[i]) * n_j_[j] / sample_size;
             chi_squared += (actual - expected) * (actual - expected) / (expected);
         }
     }
@@ -70,11 +76,7 @@ bool ContingencyTable::ChiSquaredTest(Sample const &smp, std::vector<size_t> con
 
 bool ContingencyTable::TooMuchStructuralZeroes(std::vector<size_t> const &domains,
                                                long double min_structural_zeroes_proportion) const {
-    long double zeros_sum = 0;
-    for (size_t i = 0; i < domains[col_i_]; i++) {
-        zeros_sum += std::count_if(n_i_j_[i].begin(), n_i_j_[i].end(),
-                                   [](long double val) { return val == 0; });
-    }
+    long double zeros_sum = std::count(n_i_j_.begin(), n_i_j_.end(), 0);
     return zeros_sum > min_structural_zeroes_proportion * domains[col_i_] * domains[col_k_];
 }
 
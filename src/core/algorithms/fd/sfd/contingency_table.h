@@ -9,23 +9,28 @@ class ContingencyTable {
 private:
     model::ColumnIndex col_i_;
     model::ColumnIndex col_k_;
-    std::vector<std::vector<long double>> n_i_j_;
-    std::vector<long double> n_i_;
-    std::vector<long double> n_j_;
+    size_t domain_k_;
+    // n_i_j_[i * domain_k_ + j] is the number of sampled rows with categories i and j
+    std::vector<size_t> n_i_j_;
+    std::vector<size_t> n_i_;
+    std::vector<size_t> n_j_;
 
-    [[nodiscard]] static size_t Category(model::ColumnIndex col_ind, std::string const &val,
-                                         size_t domain, bool skew, FrequencyHandler const &handler);
     [[nodiscard]] long double CalculateChiSquared(long double sample_size,
                                                   std::vector<size_t> const &domains) const;
 
 public:
+    /* Categories of the values of the column by their codes. Values of a skewed column are
+       categorized by their ordinal numbers, values of other columns are hashed into the domain */
+    [[nodiscard]] static std::vector<size_t> CalculateCategories(model::ColumnIndex col_ind,
+                                                                 size_t domain, bool skew,
+                                                                 FrequencyHandler const &handler);
+
     bool ChiSquaredTest(Sample const &smp, std::vector<size_t> const &domains,
                         long double max_false_positive_probability) const;
     ContingencyTable(model::ColumnIndex col_i, model::ColumnIndex col_k,
                      std::vector<size_t> const &domains);
-    void FillTable(Sample const &smp, std::vector<model::TypedColumnData> const &data,
-                   FrequencyHandler const &handler, std::vector<bool> const &is_skewed_,
-                   std::vector<size_t> const &domains_);
+    void FillTable(Sample const &smp, FrequencyHandler const &handler,
+                   std::vector<std::vector<size_t>> const &categories);
 
     [[nodiscard]] bool TooMuchStructuralZeroes(std::vector<size_t> const &domains_,
                                                long double min_structural_zeroes_proportion) const;
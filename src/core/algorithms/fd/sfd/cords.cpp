@@ -1,6 +1,8 @@
 #include "core/algorithms/fd/sfd/cords.h"
 
+#include <atomic>
 #include <chrono>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -12,13 +14,16 @@
 #include "core/config/option.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/typed_column_data.h"
+#include "core/util/parallel_for.h"
 
 namespace algos {
 Cords::Cords() : FDAlgorithm() {
     RegisterOptions();
-    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName(),
+                          config::kThreadNumberOpt.GetName()});
 }
 
 void Cords::RegisterOptions() {
@@ -44,6 +49,7 @@ void Cords::RegisterOptions() {
 
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 
     RegisterOption(Option{&only_sfd_, kOnlySFD, kDOnlySFD});
     RegisterOption(Option{&minimum_cardinality_, kMinCard, kDMinCard}.SetValueCheck(check_param));
@@ -82,6 +88,7 @@ void Cords::MakeExecuteOptsAvailableFDInternal() {
 void Cords::ResetStateFd() {
     is_skewed_.clear();
     domains_.clear();
+    categories_.clear();
     soft_keys_.clear();
     trivial_columns_.clear();
     correlations_collection_.Clear();
@@ -92,23 +99,28 @@ void Cords::LoadDataInternal() {
             model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
 }
 
-bool Cords::DetectSFD(Sample const& smp) {
+bool Cords::DetectSFD(Sample const& smp) const {
     return smp.GetConcatCardinality() <= max_diff_vals_proportion_ * smp.GetRowIndices().size() &&
            (smp.GetLhsCardinality() >=
             (1 - min_sfd_strength_measure_) * smp.GetConcatCardinality());
 }
 
-void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                         std::vector<model::TypedColumnData> const& data, Sample& smp) {
+void Cords::InitCategories(model::ColumnIndex col_ind, size_t row_count) {
+    if (handler_.GetColumnFrequencySum(col_ind) >= (1 - min_skew_threshold_) * row_count) {
+        is_skewed_[col_ind] = true;
+        domains_[col_ind] = handler_.ColumnFrequencyMapSize(col_ind);
+    } else {
+        domains_[col_ind] =
+                std::min(handler_.GetColumnCardinality(col_ind), max_amount_of_categories_);
+    }
+    categories_[col_ind] = ContingencyTable::CalculateCategories(col_ind, domains_[col_ind],
+                                                                 is_skewed_[col_ind], handler_);
+}
+
+void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample& smp) const {
     for (model::ColumnIndex col_ind : {col_i, col_k}) {
-        if (handler_.GetColumnFrequencySum(col_ind) >=
-            (1 - min_skew_threshold_) * data[col_ind].GetNumRows()) {
-            is_skewed_[col_ind] = true;
-            domains_[col_ind] = handler_.ColumnFrequencyMapSize(col_ind);
-            smp.Filter(handler_, data, col_ind);
-        } else {
-            domains_[col_ind] =
-                    std::min(handler_.GetColumnCardinality(col_ind), max_amount_of_categories_);
+        if (is_skewed_[col_ind]) {
+            smp.Filter(handler_, col_ind);
         }
     }
 }
@@ -116,6 +128,7 @@ void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
 void Cords::Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const& data) {
     is_skewed_.resize(columns, false);
     domains_.resize(columns, 0);
+    categories_.resize(columns);
     handler_.InitFrequencyHandler(data, columns, max_amount_of_categories_);
 }
 
@@ -129,11 +142,11 @@ void Cords::RegisterCorrelation(model::ColumnIndex lhs_ind, model::ColumnIndex r
 }
 
 bool Cords::CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                             std::vector<model::TypedColumnData> const& data, Sample& smp) {
-    SkewHandling(col_i, col_k, data, smp);
+                             Sample& smp) const {
+    SkewHandling(col_i, col_k, smp);
 
     ContingencyTable cont_table(col_i, col_k, domains_);
-    cont_table.FillTable(smp, data, handler_, is_skewed_, domains_);
+    cont_table.FillTable(smp, handler_, categories_);
 
     return cont_table.TooMuchStructuralZeroes(domains_, min_structural_zeroes_proportion_) ||
            cont_table.ChiSquaredTest(smp, domains_, max_false_positive_probability_);
@@ -169,6 +182,12 @@ unsigned long long Cords::ExecuteInternal() {
     for (model::ColumnIndex col_ind = 0; col_ind != column_count; ++col_ind)
         is_soft_or_trivial[col_ind] = IsSoftOrTrivial(col_ind, row_count);
 
+    if (!only_sfd_) {
+        for (model::ColumnIndex col_ind = 0; col_ind != column_count; ++col_ind) {
+            if (!is_soft_or_trivial[col_ind]) InitCategories(col_ind, row_count);
+        }
+    }
+
     auto sort_indices_by_cardinality =
             [this](model::ColumnIndex ind1,
                    model::ColumnIndex ind2) -> std::pair<model::ColumnIndex, model::ColumnIndex> {
@@ -178,6 +197,14 @@ unsigned long long Cords::ExecuteInternal() {
         return {ind1, ind2};
     };
 
+    struct PairResult {
+        model::ColumnIndex col_i;
+        model::ColumnIndex col_k;
+        bool sfd_detected = false;
+        bool correlation_detected = false;
+    };
+
+    std::vector<PairResult> results;
     for (model::ColumnIndex ind1 = 0; ind1 < column_count - 1; ind1++) {
         if (is_soft_or_trivial[ind1]) continue;
 
@@ -185,28 +212,45 @@ unsigned long long Cords::ExecuteInternal() {
             if (is_soft_or_trivial[ind2]) continue;
 
             auto [col_i, col_k] = sort_indices_by_cardinality(ind1, ind2);
+            results.push_back({col_i, col_k});
+        }
+    }
 
+    // Column pairs are tested in parallel, dependencies are registered in the order of the pairs
+    std::atomic<size_t> next_pair = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (size_t pair_ind = next_pair++; pair_ind < results.size(); pair_ind = next_pair++) {
+            PairResult& result = results[pair_ind];
             unsigned long long sample_size = Sample::CalculateSampleSize(
-                    handler_.GetColumnCardinality(col_i), handler_.GetColumnCardinality(col_k),
-                    max_false_positive_probability_, delta_);
+                    handler_.GetColumnCardinality(result.col_i),
+                    handler_.GetColumnCardinality(result.col_k), max_false_positive_probability_,
+                    delta_);
 
-            Sample smp(fixed_sample_, sample_size, row_count, col_i, col_k, data,
+            Sample smp(fixed_sample_, sample_size, row_count, result.col_i, result.col_k, handler_,
                        typed_relation_->GetSchema());
 
-            bool sfd_detected = DetectSFD(smp);
-
-            if (sfd_detected) {
-                RegisterFd(smp.GetLhsVertical(), smp.GetRhsColumn(),
-                           typed_relation_->GetSharedPtrSchema());
-            }
+            result.sfd_detected = DetectSFD(smp);
 
-            if (sfd_detected || only_sfd_) {
+            if (result.sfd_detected || only_sfd_) {
                 continue;
             }
 
-            if (CheckCorrelation(col_i, col_k, data, smp)) {
-                RegisterCorrelation(col_i, col_k);
-            }
+            result.correlation_detected = CheckCorrelation(result.col_i, result.col_k, smp);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    RelationalSchema const* schema = typed_relation_->GetSchema();
+    for (PairResult const& result : results) {
+        if (result.sfd_detected) {
+            Column lhs_col(schema, schema->GetColumn(result.col_i)->GetName(), result.col_i);
+            Column rhs_col(schema, schema->GetColumn(result.col_k)->GetName(), result.col_k);
+            RegisterFd(Vertical(lhs_col), rhs_col, typed_relation_->GetSharedPtrSchema());
+        }
+        if (result.correlation_detected) {
+            RegisterCorrelation(result.col_i, result.col_k);
         }
     }
 
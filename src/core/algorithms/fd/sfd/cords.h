@@ -12,6 +12,7 @@
 #include "core/algorithms/fd/sfd/sample.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
@@ -27,6 +28,7 @@ private:
 
     bool only_sfd_;
     bool fixed_sample_ = false;
+    config::ThreadNumType threads_num_ = 1;
 
     long double minimum_cardinality_;
     long double max_diff_vals_proportion_;
@@ -39,6 +41,8 @@ private:
 
     std::vector<bool> is_skewed_;
     std::vector<size_t> domains_;
+    // categories_[col_ind][code] is the category of the value in the contingency tables
+    std::vector<std::vector<size_t>> categories_;
 
     CorrelationCollection correlations_collection_;
     FrequencyHandler handler_;
@@ -54,17 +58,17 @@ private:
 
     void Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const& data);
 
-    bool DetectSFD(Sample const& smp);
+    bool DetectSFD(Sample const& smp) const;
 
     // bool DetectAndRegisterSFD(Sample const &smp);
 
-    void SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                      std::vector<model::TypedColumnData> const& data, Sample& smp);
+    void InitCategories(model::ColumnIndex col_ind, size_t row_count);
+
+    void SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample& smp) const;
 
     bool IsSoftOrTrivial(model::ColumnIndex col_ind, size_t row_count);
 
-    bool CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                          std::vector<model::TypedColumnData> const& data, Sample& smp);
+    bool CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample& smp) const;
 
     void RegisterCorrelation(model::ColumnIndex lhs_ind, model::ColumnIndex rhs_ind);
 
@@ -77,7 +81,7 @@ public:
         return trivial_columns_;
     }
 
-    std::list<Correlation> const& GetCorrelations() const noexcept {
+    std::list<Correlation> const& GetCorrelations() const {
         return correlations_collection_.AsList();
     }
 
@@ -2,6 +2,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -18,33 +21,52 @@ void FrequencyHandler::InitFrequencyHandler(std::vector<model::TypedColumnData>
     cardinality_.resize(columns, 0);
     frequency_maps_.resize(columns);
     freq_sums_.resize(columns, 0);
+    value_codes_.resize(columns);
+    ordinal_numbers_.resize(columns);
+    value_hashes_.resize(columns);
     for (model::ColumnIndex col_ind = 0; col_ind < data.size(); col_ind++) {
-        std::unordered_map<std::string, size_t> value_frequency_counter;
+        std::unordered_map<std::string, ValueCode> value_codes;
+        std::vector<size_t> frequencies;
         auto const &col_data = data[col_ind];
+        std::vector<ValueCode> &codes = value_codes_[col_ind];
+        codes.reserve(col_data.GetNumRows());
         for (model::TupleIndex row_ind = 0; row_ind < col_data.GetNumRows(); row_ind++) {
-            auto &freq = value_frequency_counter[col_data.GetDataAsString(row_ind)];
-            if (freq == 0) cardinality_[col_ind]++;
-            ++freq;
+            auto const [it, is_new] = value_codes.try_emplace(col_data.GetDataAsString(row_ind),
+                                                              frequencies.size());
+            if (is_new) frequencies.push_back(0);
+            ++frequencies[it->second];
+            codes.push_back(it->second);
         }
-        std::vector<std::pair<std::string, size_t>> values_ordered_by_frequencies(
-                value_frequency_counter.begin(), value_frequency_counter.end());
+        cardinality_[col_ind] = frequencies.size();
 
-        auto cmp = [](std::pair<std::string, size_t> const &left,
-                      std::pair<std::string, size_t> const &right) {
+        std::vector<std::string const *> values(frequencies.size());
+        std::vector<size_t> &hashes = value_hashes_[col_ind];
+        hashes.resize(frequencies.size());
+        for (auto const &[value, code] : value_codes) {
+            values[code] = &value;
+            hashes[code] = std::hash<std::string>{}(value);
+        }
+
+        std::vector<ValueCode> codes_ordered_by_frequencies(frequencies.size());
+        std::iota(codes_ordered_by_frequencies.begin(), codes_ordered_by_frequencies.end(), 0);
+
+        auto cmp = [&frequencies, &values](ValueCode left, ValueCode right) {
             // Compare frequencies.
             // If frequencies are equal, compare values lexicographically.
-            return std::tie(left.second, left.first) > std::tie(right.second, right.first);
+            return std::tie(frequencies[left], *values[left]) >
+                   std::tie(frequencies[right], *values[right]);
         };
 
-        std::sort(values_ordered_by_frequencies.begin(), values_ordered_by_frequencies.end(), cmp);
+        std::sort(codes_ordered_by_frequencies.begin(), codes_ordered_by_frequencies.end(), cmp);
 
+        ordinal_numbers_[col_ind].assign(frequencies.size(), kNotFrequent);
         for (size_t ordinal_number = 0;
-             ordinal_number <
-             std::min(max_amount_of_categories, values_ordered_by_frequencies.size());
+             ordinal_number < std::min(max_amount_of_categories, frequencies.size());
              ordinal_number++) {
-            auto const &[value, freq] = values_ordered_by_frequencies[ordinal_number];
-            frequency_maps_[col_ind][value] = ordinal_number;
-            freq_sums_[col_ind] += freq;
+            ValueCode const code = codes_ordered_by_frequencies[ordinal_number];
+            frequency_maps_[col_ind][*values[code]] = ordinal_number;
+            ordinal_numbers_[col_ind][code] = ordinal_number;
+            freq_sums_[col_ind] += frequencies[code];
         }
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -8,11 +11,23 @@
 
 namespace algos {
 
+/* Dictionary-encodes the columns: values of a column get codes in the order of their first
+   occurrence, so the rest of CORDS works with integers instead of strings. */
 class FrequencyHandler {
+public:
+    using ValueCode = std::uint32_t;
+    static constexpr size_t kNotFrequent = std::numeric_limits<size_t>::max();
+
 private:
     std::vector<size_t> cardinality_;
     std::vector<size_t> freq_sums_;
     std::vector<std::unordered_map<std::string, size_t>> frequency_maps_;
+    // value_codes_[col_ind][row_ind] is the code of the value in the row
+    std::vector<std::vector<ValueCode>> value_codes_;
+    // ordinal numbers of the values by their codes, kNotFrequent for the values that are not
+    // among the most frequent ones
+    std::vector<std::vector<size_t>> ordinal_numbers_;
+    std::vector<std::vector<size_t>> value_hashes_;
 
 public:
     void InitFrequencyHandler(std::vector<model::TypedColumnData> const &data,
@@ -36,6 +51,20 @@ public:
         return frequency_maps_[col_ind].find(val) != frequency_maps_[col_ind].end();
     }
 
+    [[nodiscard]] std::vector<ValueCode> const &GetValueCodes(model::ColumnIndex col_ind) const {
+        return value_codes_[col_ind];
+    }
+
+    // kNotFrequent if the value is not among the most frequent ones
+    [[nodiscard]] size_t GetOrdinalNumber(model::ColumnIndex col_ind, ValueCode code) const {
+        return ordinal_numbers_[col_ind][code];
+    }
+
+    // std::hash of the string representation of the value
+    [[nodiscard]] size_t GetValueHash(model::ColumnIndex col_ind, ValueCode code) const {
+        return value_hashes_[col_ind][code];
+    }
+
     [[nodiscard]] size_t Size() const {
         return frequency_maps_.size();
     }
@@ -48,6 +77,9 @@ public:
         cardinality_.clear();
         frequency_maps_.clear();
         freq_sums_.clear();
+        value_codes_.clear();
+        ordinal_numbers_.clear();
+        value_hashes_.clear();
     }
 };
 }  // namespace algos
@@ -1,8 +1,8 @@
 #include "core/algorithms/fd/sfd/sample.h"
 
 #include <chrono>
+#include <cstdint>
 #include <random>
-#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -11,25 +11,30 @@
 
 namespace algos {
 Sample::Sample(bool fixed_sample, unsigned long long sample_size, model::TupleIndex rows,
-               model::ColumnIndex lhs, model::ColumnIndex rhs,
-               std::vector<model::TypedColumnData> const &data, RelationalSchema const *rel_schema_)
+               model::ColumnIndex lhs, model::ColumnIndex rhs, FrequencyHandler const &handler,
+               RelationalSchema const *rel_schema_)
     : lhs_col_(rel_schema_, rel_schema_->GetColumn(lhs)->GetName(), lhs),
       rhs_col_(rel_schema_, rel_schema_->GetColumn(rhs)->GetName(), rhs) {
+    using ValueCode = FrequencyHandler::ValueCode;
+
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     std::mt19937 gen(seed);
     std::uniform_int_distribution<model::TupleIndex> distribution(0, rows - 1);
 
-    std::unordered_set<std::string> map_lhs;
-    std::unordered_set<std::string> map_rhs;
-    std::unordered_set<std::string> map_cardinality;
+    std::vector<ValueCode> const &lhs_codes = handler.GetValueCodes(lhs);
+    std::vector<ValueCode> const &rhs_codes = handler.GetValueCodes(rhs);
+    std::unordered_set<ValueCode> map_lhs;
+    std::unordered_set<ValueCode> map_rhs;
+    std::unordered_set<std::uint64_t> map_cardinality;
 
+    row_indices_.reserve(sample_size);
     for (model::ColumnIndex i = 0; i < sample_size; i++) {
         model::TupleIndex row = (fixed_sample) ? i % rows : distribution(gen);
 
         row_indices_.push_back(row);
-        map_lhs.insert(data[lhs].GetDataAsString(row));
-        map_rhs.insert(data[rhs].GetDataAsString(row));
-        map_cardinality.insert(data[lhs].GetDataAsString(row) + data[rhs].GetDataAsString(row));
+        map_lhs.insert(lhs_codes[row]);
+        map_rhs.insert(rhs_codes[row]);
+        map_cardinality.insert(static_cast<std::uint64_t>(lhs_codes[row]) << 32 | rhs_codes[row]);
     }
     lhs_cardinality_ = map_lhs.size();
     rhs_cardinality_ = map_rhs.size();
@@ -48,10 +53,10 @@ unsigned long long Sample::CalculateSampleSize(size_t lhs_cardinality, size_t rh
     return static_cast<long long>((numerator / denominator) * (v2 / 1.69));
 }
 
-void Sample::Filter(FrequencyHandler const &handler,
-                    std::vector<model::TypedColumnData> const &data, model::ColumnIndex col_ind) {
-    std::erase_if(row_indices_, [&handler, &data, col_ind](model::TupleIndex row_id) {
-        return !handler.ContainsValAtColumn(data[col_ind].GetDataAsString(row_id), col_ind);
+void Sample::Filter(FrequencyHandler const &handler, model::ColumnIndex col_ind) {
+    std::vector<FrequencyHandler::ValueCode> const &codes = handler.GetValueCodes(col_ind);
+    std::erase_if(row_indices_, [&handler, &codes, col_ind](model::TupleIndex row_id) {
+        return handler.GetOrdinalNumber(col_ind, codes[row_id]) == FrequencyHandler::kNotFrequent;
     });
 }
 }  // namespace algos
@@ -26,10 +26,10 @@ private:
 
 public:
     Sample(bool fixed_sample, unsigned long long sample_size, size_t rows, model::ColumnIndex lhs,
-           model::ColumnIndex rhs, std::vector<model::TypedColumnData> const &data,
+           model::ColumnIndex rhs, FrequencyHandler const &handler,
            RelationalSchema const *rel_schema_);
-    void Filter(FrequencyHandler const &handler, std::vector<model::TypedColumnData> const &data,
-                model::ColumnIndex col_ind);
+    // Leaves the rows whose values in the column are among the most frequent ones
+    void Filter(FrequencyHandler const &handler, model::ColumnIndex col_ind);
 
     /* Formulae (2) from "CORDS: Automatic Discovery of Correlations and Soft Functional
        Dependencies."*/
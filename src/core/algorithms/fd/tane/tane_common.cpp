@@ -238,8 +238,6 @@ unsigned long long TaneCommon::ExecuteInternal() {
     apriori_millis += elapsed_milliseconds.count();
 
     LOG_DEBUG("Time: {} milliseconds", apriori_millis);
-    LOG_DEBUG("Intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
-    LOG_DEBUG("Total intersections: {}", model::PositionListIndex::intersection_count_);
     LOG_DEBUG("Total FD count: {}", fd_collection_.Size());
     LOG_DEBUG("HASH: {}", Fletcher16());
     return apriori_millis;
@@ -2,12 +2,19 @@
 #include "gspan.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <span>
 
 #include <boost/functional/hash.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 #include "graph_parser.h"
 #include "sparse_triangular_matrix.h"
@@ -17,79 +24,98 @@ namespace algos {
 
 namespace {
 
-// Get all vertex descriptors having a given label
-std::vector<vertex_t> FindAllWithLabel(int target_label, graph_t const& graph) {
-    return graph[boost::graph_bundle].label_to_vertices.at(target_label);
+using Extensions = std::unordered_map<ExtendedEdge, Projection, ExtendedEdge::Hash>;
+
+vertex_t GetNeighbor(edge_t edge, vertex_t vertex, graph_t const& graph) {
+    vertex_t const source = boost::source(edge, graph);
+    return source == vertex ? boost::target(edge, graph) : source;
 }
 
-// Find all isomorphisms between graph described by DFSCode and boost::graph, each
-// isomorphism is represented by a map
-std::vector<std::unordered_map<int, vertex_t>> SubgraphIsomorphisms(DFSCode const& code,
-                                                                    graph_t const& graph) {
-    LOG_TRACE("Finding subgraph isomorphisms: pattern size={}, target vertices={}, edges={}",
-              code.Size(), boost::num_vertices(graph), boost::num_edges(graph));
-    std::vector<std::unordered_map<int, vertex_t>> isoms;
-
-    // Initial isomorphisms by finding all vertices with same label as vertex 0 in code
-    int start_label = code.GetExtendedEdges()[0].vertex1.label;
-    for (vertex_t vertex : FindAllWithLabel(start_label, graph)) {
-        std::unordered_map<int, vertex_t> map;
-        map[0] = vertex;
-        isoms.push_back(std::move(map));
+// Collect the embeddings of all one-edge DFS codes into a graph.
+// The vertex 0 of a code gets the smaller label, so an edge with equal labels is embedded both
+// ways.
+void CollectEdges(int graph_id, graph_t const& graph, Extensions& extensions) {
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        int vertex_label = graph[vertex].label;
+        for (auto edge : boost::make_iterator_range(boost::out_edges(vertex, graph))) {
+            vertex_t neighbor = GetNeighbor(edge, vertex, graph);
+            int neighbor_label = graph[neighbor].label;
+            if (neighbor == vertex || vertex_label > neighbor_label) continue;
+
+            ExtendedEdge ee(Vertex(0, vertex_label), Vertex(1, neighbor_label), graph[edge].label);
+            extensions[ee].Add(graph_id, std::array{vertex, neighbor});
+        }
+    }
+}
+
+// Extend every embedding of a non-empty code by one edge growing from the rightmost path and
+// group the extended embeddings by the added edge. Unlike matching the extended codes from
+// scratch, this only looks at the neighbors of the already mapped vertices.
+template <class GetGraph>
+void ExtendRightMostPath(DFSCode const& code, Projection const& projection, GetGraph get_graph,
+                         Extensions& extensions) {
+    LOG_TRACE("Extending {} embeddings: pattern size={}", projection.Size(), code.Size());
+    int rightmost = code.GetRightMost();
+
+    // Backward edges go from the rightmost vertex to the vertices of the rightmost path, apart
+    // from its parent and the vertices it is already connected to
+    std::vector<bool> backward_targets(rightmost + 1);
+    for (int vertex = 0; vertex < rightmost; ++vertex) {
+        backward_targets[vertex] = code.OnRightMostPath(vertex) && code.NotPreOfRM(vertex) &&
+                                   !code.ContainEdge(rightmost, vertex);
     }
-    LOG_TRACE("Initial candidate mappings: {}", isoms.size());
-
-    // Each extended edge will update partial isomorphisms.
-    // For forward edge, each isomorphism will be either extended or discarded.
-    // For backward edge, each isomorphism will be either unchanged or discarded.
-    for (ExtendedEdge const& ee : code.GetExtendedEdges()) {
-        int v1 = ee.vertex1.id;
-        int v2 = ee.vertex2.id;
-        int v2_label = ee.vertex2.label;
-        int edge_label = ee.label;
-
-        std::vector<std::unordered_map<int, vertex_t>> update_isoms;
-        for (auto& iso : isoms) {
-            auto mapped_v1 = iso[v1];
-
-            // If it is a forward edge extension
-            if (v1 < v2) {
-                auto n = boost::num_vertices(graph);
-                std::vector<int> inv(n, -1);
-                for (auto& [dfs_id, graph_vertex] : iso) {
-                    inv[graph_vertex] = dfs_id;
-                }
 
-                // For each neighbor of the vertex corresponding to v1
-                for (auto edge : boost::make_iterator_range(boost::out_edges(mapped_v1, graph))) {
-                    vertex_t mapped_v2 = (boost::source(edge, graph) == mapped_v1)
-                                                 ? boost::target(edge, graph)
-                                                 : boost::source(edge, graph);
-                    auto& mapped_edge = graph[edge];
+    for (size_t i = 0; i < projection.Size(); ++i) {
+        int graph_id = projection.GetGraphId(i);
+        graph_t const& graph = get_graph(graph_id);
+        std::span<vertex_t const> row = projection.GetRow(i);
+        auto find_in_row = [&row](vertex_t vertex) {
+            return static_cast<int>(std::ranges::find(row, vertex) - row.begin());
+        };
+
+        // Backward extensions from rightmost child
+        vertex_t mapped_rightmost = row[rightmost];
+        int mapped_rightmost_label = graph[mapped_rightmost].label;
+        for (auto edge : boost::make_iterator_range(boost::out_edges(mapped_rightmost, graph))) {
+            vertex_t neighbor = GetNeighbor(edge, mapped_rightmost, graph);
+            int inverted = find_in_row(neighbor);
+            if (inverted == static_cast<int>(row.size()) || !backward_targets[inverted]) {
+                continue;
+            }
 
-                    if (v2_label == graph[mapped_v2].label && (inv[mapped_v2] == -1) &&
-                        (edge_label == mapped_edge.label)) {
-                        std::unordered_map<int, vertex_t> temp_map(iso);
-                        temp_map[v2] = mapped_v2;
+            ExtendedEdge ee(Vertex(rightmost, mapped_rightmost_label),
+                            Vertex(inverted, graph[neighbor].label), graph[edge].label);
+            extensions[ee].Add(graph_id, row);
+        }
 
-                        update_isoms.push_back(std::move(temp_map));
-                    }
-                }
-            } else {
-                // If it is a backward edge extension.
-                // V2 has been visited, only require mappedV1 and mappedV2 are connected in graph.
-                auto mapped_v2 = iso[v2];
-                auto [mapped_edge, is_neighbors] = boost::edge(mapped_v1, mapped_v2, graph);
-                if (is_neighbors && edge_label == graph[mapped_edge].label) {
-                    update_isoms.push_back(iso);
-                }
+        // Forward extensions from nodes on rightmost path
+        for (int vertex : code.GetRightMostPath()) {
+            vertex_t mapped_vertex = row[vertex];
+            int mapped_vertex_label = graph[mapped_vertex].label;
+            for (auto edge : boost::make_iterator_range(boost::out_edges(mapped_vertex, graph))) {
+                vertex_t neighbor = GetNeighbor(edge, mapped_vertex, graph);
+                if (find_in_row(neighbor) != static_cast<int>(row.size())) continue;
+
+                ExtendedEdge ee(Vertex(vertex, mapped_vertex_label),
+                                Vertex(rightmost + 1, graph[neighbor].label), graph[edge].label);
+                extensions[ee].Add(graph_id, row, neighbor);
             }
         }
-        isoms = update_isoms;
     }
+}
 
-    LOG_TRACE("Found {} valid isomorphisms", isoms.size());
-    return isoms;
+// Order extensions by the DFS lexicographic order, which is total on the extensions of one code,
+// so the search does not depend on the hash table layout
+std::vector<std::pair<ExtendedEdge, Projection>> SortExtensions(Extensions&& extensions) {
+    std::vector<std::pair<ExtendedEdge, Projection>> sorted;
+    sorted.reserve(extensions.size());
+    for (auto& [ee, projection] : extensions) {
+        sorted.emplace_back(ee, std::move(projection));
+    }
+    std::ranges::sort(sorted, [](auto const& lhs, auto const& rhs) {
+        return lhs.first.SmallerThan(rhs.first);
+    });
+    return sorted;
 }
 
 // Precalculate the list of vertices having each label
@@ -134,7 +160,8 @@ graph_t CreateGraphFromDFSCode(DFSCode const& code) {
     return result;
 }
 
-std::unordered_set<int> TranslateToOriginalIds(std::unordered_set<int> const& internal_ids,
+template <class Ids>
+std::unordered_set<int> TranslateToOriginalIds(Ids const& internal_ids,
                                                std::vector<graph_t> const& graph_db) {
     std::unordered_set<int> original_ids;
     original_ids.reserve(internal_ids.size());
@@ -144,13 +171,50 @@ std::unordered_set<int> TranslateToOriginalIds(std::unordered_set<int> const& in
     return original_ids;
 }
 
+// The code is canonical if it is the minimum DFS code of its own graph. The minimum code is
+// built edge by edge, each time taking the smallest extension of the already built prefix.
+bool IsCanonical(DFSCode const& code) {
+    LOG_TRACE("Checking canonicity: pattern size={}", code.Size());
+    graph_t canon_graph = CreateGraphFromDFSCode(code);
+    auto get_graph = [&canon_graph](int) -> graph_t const& { return canon_graph; };
+
+    DFSCode canon;
+    Extensions extensions;
+    CollectEdges(0, canon_graph, extensions);
+    for (size_t i = 0; i < code.Size(); i++) {
+        if (extensions.empty()) {
+            return false;
+        }
+
+        auto min_it = extensions.begin();
+        for (auto it = extensions.begin(); it != extensions.end(); ++it) {
+            if (it->first.SmallerThan(min_it->first)) min_it = it;
+        }
+
+        if (min_it->first.SmallerThan(code[i])) {
+            LOG_TRACE("Non-canonical at edge {}", i);
+            return false;
+        }
+
+        canon.Add(min_it->first);
+        Projection projection = std::move(min_it->second);
+        extensions.clear();
+        if (i + 1 < code.Size()) {
+            ExtendRightMostPath(canon, projection, get_graph, extensions);
+        }
+    }
+
+    LOG_TRACE("Pattern is canonical");
+    return true;
+}
+
 }  // namespace
 
 GSpan::GSpan() : Algorithm() {
     RegisterOptions();
     MakeOptionsAvailable({config::names::kGraphDatabase, config::names::kGSpanMinimumSupport,
                           config::names::kOutputSingleVertices, config::names::kMaxNumberOfEdges,
-                          config::names::kGSpanOutputPath});
+                          config::names::kGSpanOutputPath, config::names::kThreads});
 }
 
 void GSpan::MakeExecuteOptsAvailable() {
@@ -187,6 +251,7 @@ void GSpan::RegisterOptions() {
 
     RegisterOption(config::Option{&output_path_, kGSpanOutputPath, kDGSpanOutputPath,
                                   std::filesystem::path{}});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void GSpan::LoadDataInternal() {
@@ -228,24 +293,61 @@ void GSpan::MineSubgraphs() {
     RemoveInfrequentVertexPairs();
     LOG_DEBUG("Pruning complete");
 
-    // Set with all the graph ids
+    // Collect the embeddings of all the edges of non-empty graphs
     LOG_DEBUG("Building active graph set");
-    std::unordered_set<int> graph_ids;
+    Extensions edges;
+    size_t active_graphs = 0;
     for (size_t i = 0; i < graph_database_.size(); i++) {
         graph_t& graph = graph_database_[i];
         if (boost::num_vertices(graph) != 0) {
-            graph_ids.insert(i);
+            active_graphs++;
             PrecalculateLabelsToVertices(graph);
+            CollectEdges(i, graph, edges);
         } else {
             empty_graphs_removed_++;
         }
     }
-    LOG_DEBUG("Active graphs: {}, empty graphs removed: {}", graph_ids.size(),
+    LOG_DEBUG("Active graphs: {}, empty graphs removed: {}", active_graphs,
               empty_graphs_removed_);
 
     if (frequent_vertex_labels_.size() != 0) {
-        LOG_DEBUG("Starting DFS search with {} graphs", graph_ids.size());
-        GSpanDFS(DFSCode(), std::move(graph_ids));
+        // Every frequent edge is the root of an independent branch of the search. Branches are
+        // mined in parallel and their results are appended in the order of the roots, so the
+        // output does not depend on the number of threads.
+        std::vector<std::pair<ExtendedEdge, Projection>> roots;
+        for (auto& [edge, projection] : SortExtensions(std::move(edges))) {
+            if (projection.CountSupport() >= min_sup_) {
+                roots.emplace_back(edge, std::move(projection));
+            }
+        }
+        LOG_DEBUG("Starting DFS search from {} frequent edges", roots.size());
+
+        std::vector<std::vector<FrequentSubgraph>> branches(roots.size());
+        std::atomic<size_t> next_root = 0;
+        auto worker = [&](config::ThreadNumType) {
+            for (size_t i = next_root++; i < roots.size(); i = next_root++) {
+                auto const& [edge, projection] = roots[i];
+                DFSCode code;
+                code.Add(edge);
+                if (!IsCanonical(code)) continue;
+
+                std::vector<int> support_set = projection.GetSupportSet();
+                branches[i].emplace_back(0, code,
+                                         TranslateToOriginalIds(support_set, graph_database_),
+                                         static_cast<int>(support_set.size()));
+                GSpanDFS(code, projection, branches[i]);
+            }
+        };
+        std::vector<config::ThreadNumType> workers(threads_num_);
+        std::iota(workers.begin(), workers.end(), 0);
+        util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+        for (auto& branch : branches) {
+            for (FrequentSubgraph& subgraph : branch) {
+                subgraph.id = frequent_subgraphs_.size();
+                frequent_subgraphs_.push_back(std::move(subgraph));
+            }
+        }
     }
 
     LOG_INFO("GSpan complete: {} frequent subgraphs found", frequent_subgraphs_.size());
@@ -340,9 +442,9 @@ void GSpan::RemoveInfrequentVertexPairs() {
     }
 }
 
-void GSpan::GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_ids) {
-    LOG_TRACE("DFS step: pattern size={}, candidate graphs={}, patterns found={}", code.Size(),
-              graph_ids.size(), frequent_subgraphs_.size());
+void GSpan::GSpanDFS(gspan::DFSCode const& code, gspan::Projection const& projection,
+                     std::vector<gspan::FrequentSubgraph>& subgraphs) const {
+    LOG_TRACE("DFS step: pattern size={}, embeddings={}", code.Size(), projection.Size());
 
     // If we have reached the maximum size, we do not need to extend this graph
     if (code.Size() == static_cast<size_t>(max_number_of_edges_)) {
@@ -350,15 +452,16 @@ void GSpan::GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_i
         return;
     }
 
-    // Find all the extensions of this graph, with their support values.
-    // They are stored in a map where the key is an extended edge, and the value
-    // is the list of graph ids where this edge extends the current subgraph.
-    std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash> extensions =
-            RightMostPathExtensions(code, std::move(graph_ids));
+    // Find all the extensions of this graph together with their embeddings
+    Extensions extensions;
+    ExtendRightMostPath(
+            code, projection,
+            [this](int graph_id) -> graph_t const& { return graph_database_[graph_id]; },
+            extensions);
     LOG_TRACE("Found {} candidate extensions", extensions.size());
 
-    for (auto& [extension, new_graph_ids] : extensions) {
-        int sup = new_graph_ids.size();
+    for (auto const& [extension, new_projection] : SortExtensions(std::move(extensions))) {
+        int sup = new_projection.CountSupport();
 
         // If the support is enough
         if (sup >= min_sup_) {
@@ -369,154 +472,23 @@ void GSpan::GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_i
             // If the resulting graph is canonical (it means that the graph is non redundant)
             if (IsCanonical(new_code)) {
                 LOG_TRACE("New frequent subgraph: size={}, support={}", new_code.Size(), sup);
-                frequent_subgraphs_.emplace_back(
-                        frequent_subgraphs_.size(), new_code,
-                        TranslateToOriginalIds(new_graph_ids, graph_database_), sup);
-                GSpanDFS(new_code, std::move(new_graph_ids));
-            }
-        }
-    }
-}
-
-template <class Emit>
-void EnumerateRightMostExtensions(DFSCode const& code, graph_t const& graph, Emit&& emit) {
-    LOG_TRACE("Computing sgraph extensions: pattern size={}, vertices={}", code.Size(),
-              boost::num_vertices(graph));
-    if (code.Empty()) {
-        // If we have an empty subgraph that we want to extend,
-        // find all distinct label tuples
-        LOG_TRACE("Empty pattern, collecting initial edges");
-        for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
-            for (auto edge : boost::make_iterator_range(boost::out_edges(vertex, graph))) {
-                int vertex_label = graph[vertex].label;
-                auto neighbor = boost::target(edge, graph) == vertex ? boost::source(edge, graph)
-                                                                     : boost::target(edge, graph);
-                int neighbor_label = graph[neighbor].label;
-                ExtendedEdge ee =
-                        (vertex_label < neighbor_label)
-                                ? ExtendedEdge(Vertex(0, vertex_label), Vertex(1, neighbor_label),
-                                               graph[edge].label)
-                                : ExtendedEdge(Vertex(0, neighbor_label), Vertex(1, vertex_label),
-                                               graph[edge].label);
-                emit(ee);
-            }
-        }
-    } else {
-        // If we want to extend a subgraph
-        auto rightmost = code.GetRightMost();
-        std::vector<std::unordered_map<int, vertex_t>> isoms = SubgraphIsomorphisms(code, graph);
-        LOG_TRACE("Found {} embeddings for extension", isoms.size());
-        for (auto& isom : isoms) {
-            // Backward extensions from rightmost child
-            auto n = boost::num_vertices(graph);
-            std::vector<int> inverted_isom(n, -1);
-            for (auto& [dfs_id, graph_vertex] : isom) {
-                inverted_isom[graph_vertex] = dfs_id;
-            }
-
-            auto mapped_rightmost = isom[rightmost];
-            int mapped_rightmost_label = graph[mapped_rightmost].label;
-            for (auto edge :
-                 boost::make_iterator_range(boost::out_edges(mapped_rightmost, graph))) {
-                vertex_t neighbor = (boost::source(edge, graph) == mapped_rightmost)
-                                            ? boost::target(edge, graph)
-                                            : boost::source(edge, graph);
-                if (inverted_isom[neighbor] == -1) {
-                    continue;
-                }
-
-                auto inverted = inverted_isom[neighbor];
-                if (code.OnRightMostPath(inverted) && code.NotPreOfRM(inverted) &&
-                    !code.ContainEdge(rightmost, inverted)) {
-                    // Rightmost and inverted both have correspondings in graph, so label of
-                    // vertices and edge all can be found by correspondings
-                    int edge_label = graph[edge].label;
-                    ExtendedEdge ee(Vertex(rightmost, mapped_rightmost_label),
-                                    Vertex(inverted, graph[neighbor].label), edge_label);
-                    emit(ee);
-                }
-            }
-
-            // Forward extensions from nodes on rightmost path
-            for (auto vertex : code.GetRightMostPath()) {
-                auto mapped_vertex = isom[vertex];
-                int mapped_vertex_label = graph[mapped_vertex].label;
-                for (auto edge :
-                     boost::make_iterator_range(boost::out_edges(mapped_vertex, graph))) {
-                    vertex_t neighbor = (boost::source(edge, graph) == mapped_vertex)
-                                                ? boost::target(edge, graph)
-                                                : boost::source(edge, graph);
-                    if (inverted_isom[neighbor] == -1) {
-                        int edge_label = graph[edge].label;
-                        ExtendedEdge ee(Vertex(vertex, mapped_vertex_label),
-                                        Vertex(rightmost + 1, graph[neighbor].label), edge_label);
-                        emit(ee);
-                    }
-                }
+                subgraphs.emplace_back(
+                        0, new_code,
+                        TranslateToOriginalIds(new_projection.GetSupportSet(), graph_database_),
+                        sup);
+                GSpanDFS(new_code, new_projection, subgraphs);
             }
         }
     }
 }
 
-std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash>
-GSpan::RightMostPathExtensions(DFSCode const& code, std::unordered_set<int> graph_ids) {
-    std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash> out;
-
-    for (int graph_id : graph_ids) {
-        auto const& graph = graph_database_[graph_id];
-
-        EnumerateRightMostExtensions(code, graph,
-                                     [&](ExtendedEdge const& ee) { out[ee].insert(graph_id); });
-    }
-
-    return out;
-}
-
-std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> GSpan::RightMostPathExtensionsFromSingle(
-        DFSCode const& code, graph_t const& graph) {
-    std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> out;
-
-    EnumerateRightMostExtensions(code, graph, [&](ExtendedEdge const& ee) { out.insert(ee); });
-
-    return out;
-}
-
-bool GSpan::IsCanonical(DFSCode const& code) {
-    LOG_TRACE("Checking canonicity: pattern size={}", code.Size());
-    DFSCode canon;
-    graph_t canon_graph = CreateGraphFromDFSCode(code);
-    for (size_t i = 0; i < code.Size(); i++) {
-        std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> extensions =
-                RightMostPathExtensionsFromSingle(canon, canon_graph);
-
-        if (extensions.empty()) {
-            return false;
-        }
-
-        ExtendedEdge min_ee = *extensions.begin();
-        for (auto const& ee : extensions) {
-            if (ee.SmallerThan(min_ee)) min_ee = ee;
-        }
-
-        if (min_ee.SmallerThan(code[i])) {
-            LOG_TRACE("Non-canonical at edge {}", i);
-            return false;
-        }
-
-        canon.Add(min_ee);
-    }
-
-    LOG_TRACE("Pattern is canonical");
-    return true;
-}
-
 // This method finds all frequent vertex labels from a graph database.
 void GSpan::FindAllOnlyOneVertex() {
     LOG_DEBUG("Collecting vertex label statistics");
 
     // Create a map (key = vertex label, value = graph ids)
     // to count the support of each vertex
-    std::unordered_map<int, std::unordered_set<int>> label_map;
+    std::map<int, std::unordered_set<int>> label_map;
 
     for (size_t i = 0; i < graph_database_.size(); i++) {
         auto const& graph = graph_database_[i];
@@ -5,8 +5,10 @@
 
 #include "core/algorithms/algorithm.h"
 #include "core/config/names_and_descriptions.h"
+#include "core/config/thread_number/type.h"
 #include "frequent_subgraph.h"
 #include "graph.h"
+#include "projection.h"
 
 namespace algos {
 class GSpan : public Algorithm {
@@ -34,18 +36,15 @@ protected:
     std::filesystem::path output_path_;
     std::vector<gspan::graph_t> graph_database_;
 
+    config::ThreadNumType threads_num_ = 1;
+
     void FindAllOnlyOneVertex();
     void RemoveInfrequentLabel(gspan::graph_t& graph, int label);
     void RemoveInfrequentVertexPairs();
-    void GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_ids);
-
-    std::unordered_map<gspan::ExtendedEdge, std::unordered_set<int>, gspan::ExtendedEdge::Hash>
-    RightMostPathExtensions(gspan::DFSCode const& code, std::unordered_set<int> graph_ids);
-
-    std::unordered_set<gspan::ExtendedEdge, gspan::ExtendedEdge::Hash>
-    RightMostPathExtensionsFromSingle(gspan::DFSCode const& code, gspan::graph_t const& graph);
 
-    bool IsCanonical(gspan::DFSCode const& code);
+    // Appends the frequent canonical descendants of `code` to `subgraphs` in DFS order
+    void GSpanDFS(gspan::DFSCode const& code, gspan::Projection const& projection,
+                  std::vector<gspan::FrequentSubgraph>& subgraphs) const;
 
     unsigned long long ExecuteInternal();
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "graph.h"
+
+namespace gspan {
+
+// The Projection is the list of all the embeddings of a DFS code into the graph database.
+// Vertices of a DFS code are numbered in the order of discovery, so an embedding is stored as
+// a row whose j-th element is the vertex the code vertex j is mapped to. Rows are stored one
+// after another in a single array. Embeddings must be added in nondecreasing order of their
+// graph ids, so the support is computed without a set.
+class Projection {
+    std::size_t width_ = 0;
+    std::vector<int> graph_ids_;
+    std::vector<vertex_t> rows_;
+
+public:
+    std::size_t Size() const noexcept {
+        return graph_ids_.size();
+    }
+
+    int GetGraphId(std::size_t i) const noexcept {
+        return graph_ids_[i];
+    }
+
+    std::span<vertex_t const> GetRow(std::size_t i) const noexcept {
+        return {rows_.data() + i * width_, width_};
+    }
+
+    void Add(int graph_id, std::span<vertex_t const> row) {
+        width_ = row.size();
+        graph_ids_.push_back(graph_id);
+        rows_.insert(rows_.end(), row.begin(), row.end());
+    }
+
+    // Adds the embedding `row` extended by a vertex mapped to `new_vertex`
+    void Add(int graph_id, std::span<vertex_t const> row, vertex_t new_vertex) {
+        width_ = row.size() + 1;
+        graph_ids_.push_back(graph_id);
+        rows_.insert(rows_.end(), row.begin(), row.end());
+        rows_.push_back(new_vertex);
+    }
+
+    // Number of distinct graphs having an embedding
+    int CountSupport() const noexcept {
+        int support = 0;
+        for (std::size_t i = 0; i < graph_ids_.size(); ++i) {
+            if (i == 0 || graph_ids_[i] != graph_ids_[i - 1]) ++support;
+        }
+        return support;
+    }
+
+    // Sorted ids of the graphs having an embedding
+    std::vector<int> GetSupportSet() const {
+        std::vector<int> support_set;
+        std::ranges::unique_copy(graph_ids_, std::back_inserter(support_set));
+        return support_set;
+    }
+};
+
+}  // namespace gspan
@@ -0,0 +1,124 @@
+#include "core/algorithms/gfd/csr_graph.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <boost/graph/iteration_macros.hpp>
+
+namespace model {
+
+StringInterner::Id StringInterner::Intern(std::string const& string) {
+    auto [it, inserted] = ids_.try_emplace(string, static_cast<Id>(strings_.size()));
+    if (inserted) {
+        strings_.push_back(&it->first);
+    }
+    return it->second;
+}
+
+CsrGraph::CsrGraph(graph_t const& graph) {
+    BuildAttributes(graph);
+    BuildAdjacency(graph);
+    BuildLabelIndex();
+}
+
+void CsrGraph::BuildAttributes(graph_t const& graph) {
+    std::size_t const num_vertices = boost::num_vertices(graph);
+    for (vertex_t v = 0; v < num_vertices; ++v) {
+        for (auto const& [name, value] : graph[v].attributes) {
+            Id const name_id = attribute_names_.Intern(name);
+            if (name_id == attribute_columns_.size()) {
+                attribute_columns_.emplace_back(num_vertices, kNoId);
+            }
+            attribute_columns_[name_id][v] = values_.Intern(value);
+        }
+    }
+    label_attribute_ = attribute_names_.Find("label");
+}
+
+void CsrGraph::BuildAdjacency(graph_t const& graph) {
+    std::size_t const num_vertices = boost::num_vertices(graph);
+    offsets_.assign(num_vertices + 1, 0);
+    BGL_FORALL_EDGES_T(e, graph, graph_t) {
+        vertex_t const source = boost::source(e, graph);
+        vertex_t const target = boost::target(e, graph);
+        ++offsets_[source + 1];
+        if (source != target) ++offsets_[target + 1];
+    }
+    for (std::size_t v = 0; v < num_vertices; ++v) {
+        offsets_[v + 1] += offsets_[v];
+    }
+
+    adjacency_.resize(offsets_.back());
+    std::vector<std::size_t> positions(offsets_.begin(), std::prev(offsets_.end()));
+    BGL_FORALL_EDGES_T(e, graph, graph_t) {
+        vertex_t const source = boost::source(e, graph);
+        vertex_t const target = boost::target(e, graph);
+        Id const label = edge_labels_.Intern(graph[e].label);
+        adjacency_[positions[source]++] = {label, target};
+        if (source != target) adjacency_[positions[target]++] = {label, source};
+    }
+    for (std::size_t v = 0; v < num_vertices; ++v) {
+        std::sort(adjacency_.begin() + offsets_[v], adjacency_.begin() + offsets_[v + 1]);
+    }
+}
+
+void CsrGraph::BuildLabelIndex() {
+    if (label_attribute_ == kNoId) return;
+
+    std::vector<Id> const& labels = attribute_columns_[label_attribute_];
+    label_offsets_.assign(values_.Size() + 1, 0);
+    for (Id label : labels) {
+        if (label != kNoId) ++label_offsets_[label + 1];
+    }
+    for (std::size_t i = 0; i < values_.Size(); ++i) {
+        label_offsets_[i + 1] += label_offsets_[i];
+    }
+
+    vertices_by_label_.resize(label_offsets_.back());
+    std::vector<std::size_t> positions(label_offsets_.begin(), std::prev(label_offsets_.end()));
+    for (vertex_t v = 0; v < labels.size(); ++v) {
+        if (labels[v] != kNoId) vertices_by_label_[positions[labels[v]]++] = v;
+    }
+}
+
+std::span<CsrGraph::Neighbour const> CsrGraph::GetNeighbours(vertex_t v, Id edge_label) const {
+    auto const [first, last] =
+            std::ranges::equal_range(GetNeighbours(v), edge_label, {}, &Neighbour::edge_label);
+    return {first, last};
+}
+
+bool CsrGraph::HasEdge(vertex_t u, vertex_t v, Id edge_label) const {
+    if (Degree(v) < Degree(u)) std::swap(u, v);
+    std::span<Neighbour const> neighbours = GetNeighbours(u);
+    return std::binary_search(neighbours.begin(), neighbours.end(), Neighbour{edge_label, v});
+}
+
+std::span<vertex_t const> CsrGraph::GetVerticesWithLabel(Id label) const noexcept {
+    if (label == kNoId || label + 1 >= label_offsets_.size()) return {};
+    return {vertices_by_label_.data() + label_offsets_[label],
+            vertices_by_label_.data() + label_offsets_[label + 1]};
+}
+
+CsrGraph::IndexedToken CsrGraph::IndexToken(Gfd::Token const& token) const {
+    auto const& [pattern_vertex, name] = token;
+    if (pattern_vertex == -1) return {-1, FindValue(name)};
+    return {pattern_vertex, FindAttributeName(name)};
+}
+
+CsrGraph::IndexedLiteral CsrGraph::IndexLiteral(Gfd::Literal const& literal) const {
+    auto const& [fst, snd] = literal;
+    return {IndexToken(fst), IndexToken(snd), fst.second == snd.second};
+}
+
+std::vector<CsrGraph::IndexedLiteral> CsrGraph::IndexLiterals(
+        std::vector<Gfd::Literal> const& literals) const {
+    std::vector<IndexedLiteral> result;
+    result.reserve(literals.size());
+    for (Gfd::Literal const& literal : literals) {
+        result.push_back(IndexLiteral(literal));
+    }
+    return result;
+}
+
+}  // namespace model
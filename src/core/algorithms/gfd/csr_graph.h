@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/algorithms/gfd/gfd.h"
+#include "core/algorithms/gfd/graph_descriptor.h"
+
+namespace model {
+
+// Maps distinct strings to dense ids in the order they are first met.
+class StringInterner {
+public:
+    using Id = std::uint32_t;
+
+    static constexpr Id kNoId = std::numeric_limits<Id>::max();
+
+private:
+    std::unordered_map<std::string, Id> ids_;
+    // Point to the keys of ids_, which are not moved on rehashing
+    std::vector<std::string const*> strings_;
+
+public:
+    Id Intern(std::string const& string);
+
+    // Returns kNoId if the string has not been interned
+    Id Find(std::string const& string) const {
+        auto it = ids_.find(string);
+        return it == ids_.end() ? kNoId : it->second;
+    }
+
+    std::string const& Get(Id id) const {
+        return *strings_[id];
+    }
+
+    std::size_t Size() const noexcept {
+        return strings_.size();
+    }
+};
+
+// Read-only compressed sparse row representation of a graph_t.
+// Vertex attribute names, attribute values and edge labels are interned into dense ids, so
+// labels and literals are compared as integers. Attribute values are stored column-wise, one
+// array per attribute name. Neighbours of a vertex are stored contiguously, sorted by edge
+// label and then by vertex, so the neighbours connected by edges with a given label form a
+// subrange. A self-loop is stored once. Vertex descriptors are the same as in the source graph.
+class CsrGraph {
+public:
+    using Id = StringInterner::Id;
+
+    static constexpr Id kNoId = StringInterner::kNoId;
+
+    struct Neighbour {
+        Id edge_label;
+        vertex_t vertex;
+
+        auto operator<=>(Neighbour const&) const = default;
+    };
+
+    // Gfd literal token with the attribute name (for a pattern vertex) or the constant (for
+    // pattern_vertex == -1) replaced by its id in this graph. A constant that does not occur in
+    // the graph gets kNoId and is not equal to any attribute value.
+    struct IndexedToken {
+        int pattern_vertex;
+        Id id;
+    };
+
+    struct IndexedLiteral {
+        IndexedToken fst;
+        IndexedToken snd;
+        // The result of comparing two constants
+        bool constants_equal;
+    };
+
+private:
+    StringInterner attribute_names_;
+    StringInterner values_;
+    StringInterner edge_labels_;
+    Id label_attribute_ = kNoId;
+
+    // attribute_columns_[name][v] is the value of the attribute of vertex v, kNoId if absent
+    std::vector<std::vector<Id>> attribute_columns_;
+
+    std::vector<std::size_t> offsets_ = {0};
+    std::vector<Neighbour> adjacency_;
+
+    // Vertices grouped by the value of their "label" attribute
+    std::vector<std::size_t> label_offsets_ = {0};
+    std::vector<vertex_t> vertices_by_label_;
+
+    void BuildAttributes(graph_t const& graph);
+    void BuildAdjacency(graph_t const& graph);
+    void BuildLabelIndex();
+
+    IndexedToken IndexToken(Gfd::Token const& token) const;
+
+public:
+    CsrGraph() = default;
+    explicit CsrGraph(graph_t const& graph);
+
+    std::size_t NumVertices() const noexcept {
+        return offsets_.size() - 1;
+    }
+
+    std::size_t Degree(vertex_t v) const noexcept {
+        return offsets_[v + 1] - offsets_[v];
+    }
+
+    std::span<Neighbour const> GetNeighbours(vertex_t v) const noexcept {
+        return {adjacency_.data() + offsets_[v], adjacency_.data() + offsets_[v + 1]};
+    }
+
+    std::span<Neighbour const> GetNeighbours(vertex_t v, Id edge_label) const;
+
+    bool HasEdge(vertex_t u, vertex_t v, Id edge_label) const;
+
+    Id FindAttributeName(std::string const& name) const {
+        return attribute_names_.Find(name);
+    }
+
+    Id FindValue(std::string const& value) const {
+        return values_.Find(value);
+    }
+
+    Id FindEdgeLabel(std::string const& label) const {
+        return edge_labels_.Find(label);
+    }
+
+    std::string const& GetValue(Id value) const {
+        return values_.Get(value);
+    }
+
+    std::string const& GetEdgeLabel(Id edge_label) const {
+        return edge_labels_.Get(edge_label);
+    }
+
+    // Returns kNoId if the vertex has no such attribute
+    Id GetAttribute(vertex_t v, Id attribute_name) const noexcept {
+        return attribute_name == kNoId ? kNoId : attribute_columns_[attribute_name][v];
+    }
+
+    Id GetLabel(vertex_t v) const noexcept {
+        return GetAttribute(v, label_attribute_);
+    }
+
+    std::span<vertex_t const> GetVerticesWithLabel(Id label) const noexcept;
+
+    IndexedLiteral IndexLiteral(Gfd::Literal const& literal) const;
+    std::vector<IndexedLiteral> IndexLiterals(std::vector<Gfd::Literal> const& literals) const;
+
+    // `mapping` maps a vertex index of the pattern to the vertex of this graph it is matched to.
+    template <typename Mapping>
+    bool Satisfies(IndexedLiteral const& literal, Mapping const& mapping) const {
+        auto get_value = [this, &mapping](IndexedToken const& token) {
+            if (token.pattern_vertex == -1) return token.id;
+            return GetAttribute(mapping(token.pattern_vertex), token.id);
+        };
+
+        if (literal.fst.pattern_vertex == -1 && literal.snd.pattern_vertex == -1) {
+            return literal.constants_equal;
+        }
+        Id const fst = get_value(literal.fst);
+        return fst != kNoId && fst == get_value(literal.snd);
+    }
+
+    template <typename Mapping>
+    bool Satisfies(std::vector<IndexedLiteral> const& literals, Mapping const& mapping) const {
+        for (IndexedLiteral const& literal : literals) {
+            if (!Satisfies(literal, mapping)) return false;
+        }
+        return true;
+    }
+};
+
+}  // namespace model
@@ -1,34 +1,42 @@
 #include "core/algorithms/gfd/gfd_miner/gfd_miner.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <iterator>
-#include <map>
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <boost/container_hash/hash.hpp>
 #include <boost/graph/copy.hpp>
-#include <boost/graph/isomorphism.hpp>
 #include <boost/graph/vf2_sub_graph_iso.hpp>
 
 #include "core/algorithms/gfd/comparator.h"
 #include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos {
 
 namespace {
 
+using gfd_miner::Embeddings;
+using gfd_miner::SatisfiedEmbeddings;
+
 // A mapping from a query to a subgraph of a larger graph
 using Embedding = std::unordered_map<model::vertex_t, model::vertex_t>;
-// A set of mappings
-using Embeddings = std::vector<Embedding>;
 
 // A construct that is considered to be satisfied
 // if all literals on the left-hand side determine
@@ -45,14 +53,29 @@ using Rules = std::vector<Rule>;
 // FieldName -> FieldValues
 using Info = std::unordered_map<std::string, std::set<std::string>>;
 
-// A data structure that has as its key a pattern vertex
-// and as its value a set of graph vertices
-// to which the vertex can be mapped
-using VertexImage = std::unordered_map<model::vertex_t, std::set<model::vertex_t>>;
-
-// A data structure that returns by literal a set of
-// indices of the embeddings on which the literal is satisfied
-using SatisfiedEmbeddings = std::map<model::Gfd::Literal, std::set<std::size_t>>;
+// Description of a pattern that is the same for all the patterns isomorphic to it
+using PatternCode = std::vector<model::CsrGraph::Id>;
+
+// A pattern of the next level obtained by extending a pattern of the current one
+struct Candidate {
+    model::graph_t pattern;
+    PatternCode code;
+    Embeddings embeddings;
+};
+
+// Calls `f` for every index in [0, size) using up to `threads` threads
+template <typename F>
+void ParallelForEachIndex(std::size_t size, config::ThreadNumType threads, F f) {
+    std::atomic<std::size_t> next = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (std::size_t i = next++; i < size; i = next++) {
+            f(i);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads, worker);
+}
 
 void NextSubset(std::vector<std::size_t>& indices, std::size_t const border) {
     if (indices.empty() || indices[0] == border - indices.size()) {
@@ -90,35 +113,34 @@ std::vector<std::vector<T>> GetSubsets(std::vector<T> const& elements, std::size
     return result;
 }
 
-std::size_t GetMinSize(VertexImage const& vertex_map, std::size_t fallback_size) {
-    if (vertex_map.empty()) return fallback_size;
-    auto get_image_size = [](auto const& map) {
-        auto const& [_, image] = map;
-        return image.size();
-    };
-    auto sizes = vertex_map | std::views::transform(get_image_size);
-    return std::ranges::min(sizes);
-}
-
-template <typename MapType, typename EmbeddingType>
-void PopulateVertexMap(MapType& vertex_map, model::graph_t const& pattern,
-                       EmbeddingType const& embedding) {
-    BGL_FORALL_VERTICES_T(v, pattern, model::graph_t) {
-        auto [it, emplaced] = vertex_map.try_emplace(v, std::set<model::vertex_t>{embedding.at(v)});
-        if (!emplaced) {
-            it->second.insert(embedding.at(v));
+// The support of a set of embeddings is the minimal number of distinct graph vertices
+// a pattern vertex is mapped to. `for_each_row` calls its argument for every embedding of the set.
+// An empty set gets `fallback_size`.
+template <typename ForEachRow>
+std::size_t Support(Embeddings const& embeddings, ForEachRow for_each_row,
+                    std::size_t fallback_size) {
+    std::size_t min_size = std::numeric_limits<std::size_t>::max();
+    std::vector<model::vertex_t> images;
+    for (std::size_t i = 0; i < embeddings.Width(); ++i) {
+        images.clear();
+        for_each_row([&images, i](std::span<model::vertex_t const> row) {
+            images.push_back(row[i]);
+        });
+        if (images.empty()) return fallback_size;
+        std::ranges::sort(images);
+        auto const distinct = std::unique(images.begin(), images.end()) - images.begin();
+        min_size = std::min(min_size, static_cast<std::size_t>(distinct));
+    }
+    return min_size;
+}
+
+std::size_t Support(model::graph_t const& graph, Embeddings const& embeddings) {
+    auto for_each_row = [&embeddings](auto&& f) {
+        for (std::size_t i = 0; i < embeddings.Size(); ++i) {
+            f(embeddings.GetRow(i));
         }
-    }
-}
-
-std::size_t Support(model::graph_t const& graph, Embeddings const& embeddings,
-                    model::graph_t const& pattern) {
-    VertexImage vertex_map;
-    for (Embedding const& embedding : embeddings) {
-        PopulateVertexMap(vertex_map, pattern, embedding);
-    }
-
-    return GetMinSize(vertex_map, boost::num_vertices(graph));
+    };
+    return Support(embeddings, for_each_row, boost::num_vertices(graph));
 }
 
 bool IsForbidden(Rules const& forbidden_rules, std::vector<model::Gfd::Literal> const& subset,
@@ -167,75 +189,103 @@ void UpdateRules(std::size_t index, model::graph_t const& existed, Embedding con
     }
 }
 
-void UpdateExisted(bool& isoExists, model::graph_t const& new_pattern,
-                   std::vector<model::graph_t> const& new_patterns,
-                   std::vector<Rules>& new_forbidden_rules_set, Rules const& forbidden_rules) {
-    std::size_t index = 0;
-    for (auto const& existed : new_patterns) {
-        auto vcompare = [&new_pattern, &existed](model::vertex_t const& fr,
-                                                 model::vertex_t const& to) {
-            return new_pattern[fr].attributes.at("label") == existed[to].attributes.at("label");
-        };
-        auto ecompare = [&new_pattern, &existed](model::edge_t const& fr, model::edge_t const& to) {
-            return new_pattern[fr].label == existed[to].label;
-        };
-        Embedding iso;
-        auto callback = [&new_pattern, &iso, &isoExists](auto f, auto) {
-            BGL_FORALL_VERTICES_T(u, new_pattern, model::graph_t) {
-                iso.emplace(u, boost::get(f, u));
+// Returns an isomorphism of new_pattern to an induced subgraph of existed, if there is one
+std::optional<Embedding> FindIsomorphism(model::graph_t const& new_pattern,
+                                         model::graph_t const& existed) {
+    auto vcompare = [&new_pattern, &existed](model::vertex_t const& fr, model::vertex_t const& to) {
+        return new_pattern[fr].attributes.at("label") == existed[to].attributes.at("label");
+    };
+    auto ecompare = [&new_pattern, &existed](model::edge_t const& fr, model::edge_t const& to) {
+        return new_pattern[fr].label == existed[to].label;
+    };
+    std::optional<Embedding> iso;
+    auto callback = [&new_pattern, &iso](auto f, auto) {
+        iso.emplace();
+        BGL_FORALL_VERTICES_T(u, new_pattern, model::graph_t) {
+            iso->emplace(u, boost::get(f, u));
+        }
+        return false;
+    };
+    using property_map_type = boost::property_map<model::graph_t, boost::vertex_index_t>::type;
+    property_map_type new_index_map = boost::get(boost::vertex_index, new_pattern);
+    property_map_type existed_index_map = boost::get(boost::vertex_index, existed);
+    std::vector<model::vertex_t> new_vertex_order = vertex_order_by_mult(new_pattern);
+    boost::vf2_subgraph_iso(new_pattern, existed, callback, new_index_map, existed_index_map,
+                            new_vertex_order, ecompare, vcompare);
+    return iso;
+}
+
+// Returns the lexicographically smallest description of the pattern over the orders of its
+// vertices. Only the orders that sort vertices by label and degree are tried, since these are
+// preserved by isomorphisms, so isomorphic patterns get the same code.
+PatternCode GetCanonicalCode(model::graph_t const& pattern, model::CsrGraph const& graph) {
+    using Id = model::CsrGraph::Id;
+    std::size_t const num_vertices = boost::num_vertices(pattern);
+
+    std::vector<std::pair<Id, std::size_t>> invariants(num_vertices);
+    BGL_FORALL_VERTICES_T(v, pattern, model::graph_t) {
+        invariants[v] = {graph.FindValue(pattern[v].attributes.at("label")),
+                         boost::degree(v, pattern)};
+    }
+    std::vector<model::vertex_t> order(num_vertices);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, {}, [&invariants](model::vertex_t v) { return invariants[v]; });
+
+    // Vertices with equal invariants may be reordered
+    std::vector<std::pair<std::size_t, std::size_t>> cells;
+    for (std::size_t begin = 0, end; begin < num_vertices; begin = end) {
+        end = begin + 1;
+        while (end < num_vertices && invariants[order[end]] == invariants[order[begin]]) ++end;
+        if (end - begin > 1) cells.emplace_back(begin, end);
+    }
+    auto next_order = [&order, &cells]() {
+        for (auto it = cells.rbegin(); it != cells.rend(); ++it) {
+            if (std::next_permutation(order.begin() + it->first, order.begin() + it->second)) {
+                return true;
             }
-            isoExists = true;
-            return false;
-        };
-        using property_map_type = boost::property_map<model::graph_t, boost::vertex_index_t>::type;
-        property_map_type new_index_map = boost::get(boost::vertex_index, new_pattern);
-        property_map_type existed_index_map = boost::get(boost::vertex_index, existed);
-        std::vector<model::vertex_t> new_vertex_order = vertex_order_by_mult(new_pattern);
-        boost::vf2_subgraph_iso(new_pattern, existed, callback, new_index_map, existed_index_map,
-                                new_vertex_order, ecompare, vcompare);
-        if (!isoExists) {
-            index++;
-            continue;
         }
-        UpdateRules(index, existed, iso, new_pattern, new_forbidden_rules_set, forbidden_rules);
-        break;
-    }
+        return false;
+    };
+
+    std::vector<std::size_t> positions(num_vertices);
+    std::vector<std::array<Id, 3>> code_edges;
+    PatternCode code;
+    PatternCode min_code;
+    do {
+        code.assign({static_cast<Id>(num_vertices)});
+        for (std::size_t i = 0; i < num_vertices; ++i) {
+            positions[order[i]] = i;
+            code.push_back(invariants[order[i]].first);
+        }
+        code_edges.clear();
+        BGL_FORALL_EDGES_T(e, pattern, model::graph_t) {
+            auto [u, v] = std::minmax(positions[boost::source(e, pattern)],
+                                      positions[boost::target(e, pattern)]);
+            code_edges.push_back({static_cast<Id>(u), static_cast<Id>(v),
+                                  graph.FindEdgeLabel(pattern[e].label)});
+        }
+        std::ranges::sort(code_edges);
+        for (auto const& edge : code_edges) {
+            code.insert(code.end(), edge.begin(), edge.end());
+        }
+        if (min_code.empty() || code < min_code) min_code = code;
+    } while (next_order());
+    return min_code;
 }
 
-template <typename ModifyPattern, typename EmbeddingTransform>
-void TryAddPattern(model::graph_t const& base_pattern, Embeddings const& embeddings,
-                   Rules const& forbidden_rules, std::vector<model::graph_t>& new_patterns,
-                   std::vector<Embeddings>& new_embeddings_set,
-                   std::vector<Rules>& new_forbidden_rules_set, ModifyPattern&& modify_pattern,
-                   EmbeddingTransform&& embedding_transform) {
+template <typename ModifyPattern>
+Candidate MakeCandidate(model::graph_t const& base_pattern, model::CsrGraph const& graph,
+                        Embeddings embeddings, ModifyPattern&& modify_pattern) {
     model::graph_t new_pattern;
     boost::copy_graph(base_pattern, new_pattern);
-
     modify_pattern(new_pattern);
-
-    bool iso_exists = false;
-    UpdateExisted(iso_exists, new_pattern, new_patterns, new_forbidden_rules_set, forbidden_rules);
-    if (iso_exists) return;
-
-    Embeddings new_embeddings;
-    for (auto embedding_vector : embeddings | std::views::transform(embedding_transform)) {
-        for (auto embedding : embedding_vector) {
-            new_embeddings.push_back(embedding);
-        }
-    }
-
-    if (!new_embeddings.empty()) {
-        new_forbidden_rules_set.push_back(forbidden_rules);
-        new_patterns.push_back(std::move(new_pattern));
-        new_embeddings_set.push_back(std::move(new_embeddings));
-    }
+    PatternCode code = GetCanonicalCode(new_pattern, graph);
+    return {std::move(new_pattern), std::move(code), std::move(embeddings)};
 }
 
 void AddEdge(std::set<std::string> const& edge_labels, model::graph_t const& graph,
-             model::graph_t const& pattern, Embeddings const& embeddings,
-             Rules const& forbidden_rules, std::vector<model::graph_t>& new_patterns,
-             std::vector<Embeddings>& new_embeddings_set,
-             std::vector<Rules>& new_forbidden_rules_set) {
+             model::CsrGraph const& csr_graph, model::graph_t const& pattern,
+             Embeddings const& embeddings, std::vector<Candidate>& candidates) {
     std::size_t num_vertices = boost::num_vertices(pattern);
     std::size_t max_edges = num_vertices * (num_vertices + 1) / 2 + num_vertices;
     if (boost::num_edges(pattern) == max_edges) {
@@ -249,88 +299,78 @@ void AddEdge(std::set<std::string> const& edge_labels, model::graph_t const& gra
         std::vector<std::size_t> element = {j, j};
         pairs.push_back(std::move(element));
     }
-    model::vertex_t origin, finish;
     auto exists_edge = [&pattern](auto const& pair) {
         model::vertex_t u = boost::vertex(pair[0], pattern);
         model::vertex_t v = boost::vertex(pair[1], pattern);
         return !boost::edge(u, v, pattern).second;
     };
     auto it = std::ranges::find_if(pairs, exists_edge);
-    if (it != pairs.end()) {
-        origin = boost::vertex(it->at(0), pattern);
-        finish = boost::vertex(it->at(1), pattern);
+    if (it == pairs.end()) {
+        return;
     }
+    model::vertex_t origin = boost::vertex(it->at(0), pattern);
+    model::vertex_t finish = boost::vertex(it->at(1), pattern);
 
-    auto embedding_transform = [&origin, &finish, &graph](Embedding const& embedding) {
-        bool edge_exists = boost::edge(embedding.at(origin), embedding.at(finish), graph).second;
-        return edge_exists ? std::vector<Embedding>{embedding} : std::vector<Embedding>{};
-    };
+    // The embeddings do not depend on the label of the new edge
+    Embeddings new_embeddings(embeddings.Width());
+    for (std::size_t i = 0; i < embeddings.Size(); ++i) {
+        std::span<model::vertex_t const> row = embeddings.GetRow(i);
+        if (boost::edge(row[origin], row[finish], graph).second) {
+            new_embeddings.Add(row);
+        }
+    }
 
     for (auto& label : edge_labels) {
         auto modify_pattern = [&origin, &finish, &label](model::graph_t& new_pattern) {
-            boost::add_edge(origin, finish, {std::move(label)}, new_pattern);
+            boost::add_edge(origin, finish, {label}, new_pattern);
         };
-        TryAddPattern(pattern, embeddings, forbidden_rules, new_patterns, new_embeddings_set,
-                      new_forbidden_rules_set, modify_pattern, embedding_transform);
+        candidates.push_back(MakeCandidate(pattern, csr_graph, new_embeddings, modify_pattern));
     }
 }
 
 void AddVertex(std::set<std::string> const& vertex_labels, std::set<std::string> const& edge_labels,
-               model::graph_t const& graph, model::graph_t const& pattern,
-               Embeddings const& embeddings, Rules const& forbidden_rules,
-               std::vector<model::graph_t>& new_patterns,
-               std::vector<Embeddings>& new_embeddings_set,
-               std::vector<Rules>& new_forbidden_rules_set) {
+               model::CsrGraph const& graph, model::graph_t const& pattern,
+               Embeddings const& embeddings, std::vector<Candidate>& candidates) {
     std::size_t num_pat_vertices = boost::num_vertices(pattern);
     for (auto const& edge_label : edge_labels) {
+        model::CsrGraph::Id const edge_label_id = graph.FindEdgeLabel(edge_label);
         for (auto const& vertex_label : vertex_labels) {
+            model::CsrGraph::Id const vertex_label_id = graph.FindValue(vertex_label);
             for (std::size_t j = 0; j < num_pat_vertices; ++j) {
                 model::vertex_t u = boost::vertex(j, pattern);
-                model::vertex_t curr_vertex;
-
-                auto embedding_transform = [&u, &graph, &pattern, &vertex_label, &edge_label,
-                                            &curr_vertex](Embedding const& embedding) {
-                    Embeddings res;
-                    model::vertex_t v = embedding.at(u);
-                    boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
-                            adjacency_end;
-                    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-                    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-                        boost::graph_traits<model::graph_t>::adjacency_iterator pat_adjacency_it,
-                                pat_adjacency_end;
-                        boost::tie(pat_adjacency_it, pat_adjacency_end) =
-                                boost::adjacent_vertices(u, pattern);
-                        auto super_exists = [&embedding, &adjacency_it](auto const& it) {
-                            return embedding.at(it) == *adjacency_it;
+                auto [pat_adjacency_it, pat_adjacency_end] = boost::adjacent_vertices(u, pattern);
+                std::vector<model::vertex_t> pat_adjacent(pat_adjacency_it, pat_adjacency_end);
+
+                Embeddings new_embeddings(num_pat_vertices + 1);
+                for (std::size_t i = 0; i < embeddings.Size(); ++i) {
+                    if (edge_label_id == model::CsrGraph::kNoId) {
+                        break;
+                    }
+                    std::span<model::vertex_t const> row = embeddings.GetRow(i);
+                    for (model::CsrGraph::Neighbour const& n :
+                         graph.GetNeighbours(row[u], edge_label_id)) {
+                        auto super_exists = [&row, &n](model::vertex_t w) {
+                            return row[w] == n.vertex;
                         };
-                        auto match_it =
-                                std::find_if(pat_adjacency_it, pat_adjacency_end, super_exists);
-                        bool matched = match_it != pat_adjacency_end;
-                        if (matched ||
-                            graph[*adjacency_it].attributes.at("label") != vertex_label ||
-                            graph[boost::edge(v, *adjacency_it, graph).first].label != edge_label) {
+                        bool matched = std::ranges::any_of(pat_adjacent, super_exists);
+                        if (matched || graph.GetLabel(n.vertex) != vertex_label_id) {
                             continue;
                         }
-                        Embedding new_embedding(embedding);
-                        new_embedding.emplace(curr_vertex, std::move(*adjacency_it));
-                        res.push_back(std::move(new_embedding));
+                        new_embeddings.Add(row, n.vertex);
                     }
-                    return res;
-                };
+                }
 
-                auto modify_pattern = [&u, &num_pat_vertices, &vertex_label, &edge_label,
-                                       &curr_vertex](model::graph_t& new_pattern) {
+                auto modify_pattern = [&u, &num_pat_vertices, &vertex_label,
+                                       &edge_label](model::graph_t& new_pattern) {
                     std::unordered_map<std::string, std::string> attributes = {
                             {"label", vertex_label}};
                     model::Vertex new_v =
                             model::Vertex{static_cast<int>(num_pat_vertices), attributes};
-                    curr_vertex = boost::add_vertex(new_v, new_pattern);
+                    model::vertex_t curr_vertex = boost::add_vertex(new_v, new_pattern);
                     boost::add_edge(u, curr_vertex, {edge_label}, new_pattern);
                 };
-
-                TryAddPattern(pattern, embeddings, forbidden_rules, new_patterns,
-                              new_embeddings_set, new_forbidden_rules_set, modify_pattern,
-                              embedding_transform);
+                candidates.push_back(
+                        MakeCandidate(pattern, graph, std::move(new_embeddings), modify_pattern));
             }
         }
     }
@@ -383,8 +423,8 @@ std::vector<std::size_t> get_rhs(std::size_t n, std::vector<std::size_t> const&
 
 GfdMiner::GfdMiner() : Algorithm() {
     RegisterOptions();
-    MakeOptionsAvailable(
-            {config::names::kGraphData, config::names::kGfdK, config::names::kGfdSigma});
+    MakeOptionsAvailable({config::names::kGraphData, config::names::kGfdK,
+                          config::names::kGfdSigma, config::names::kThreads});
 }
 
 void GfdMiner::RegisterOptions() {
@@ -393,11 +433,13 @@ void GfdMiner::RegisterOptions() {
     RegisterOption(config::Option{&graph_path_, kGraphData, kDGraphData});
     RegisterOption(config::Option{&k_, kGfdK, kDGfdK});
     RegisterOption(config::Option{&sigma_, kGfdSigma, kDGfdSigma});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void GfdMiner::LoadDataInternal() {
     std::ifstream f(graph_path_);
     graph_ = parser::graph_parser::ReadGraph(f);
+    csr_graph_ = model::CsrGraph(graph_);
 }
 
 void GfdMiner::ResetState() {}
@@ -408,33 +450,15 @@ unsigned long long GfdMiner::ExecuteInternal() {
     return elapsed_time;
 }
 
-bool GfdMiner::CheckToken(model::Gfd::Token const& token, std::string& tok,
-                          model::graph_t const& pattern, Embedding const& embedding) {
-    if (token.first == -1) {
-        tok = token.second;
-        return true;
-    } else {
-        model::vertex_t u = boost::vertex(token.first, pattern);
-        model::vertex_t v = embedding.at(u);
-        std::unordered_map<std::string, std::string> const& attrs = graph_[v].attributes;
-        auto it = attrs.find(token.second);
-        if (it != attrs.end()) {
-            tok = it->second;
-            return true;
-        }
-        return false;
-    }
-}
-
-void GfdMiner::AddCompacted(std::vector<SingleRule>& rules, model::graph_t& pattern,
-                            Rules& forbidden_rules) {
+void GfdMiner::AddCompacted(std::vector<SingleRule>& rules, model::graph_t const& pattern,
+                            Rules& forbidden_rules, std::vector<model::Gfd>& gfds) {
     if (rules.empty()) return;
     std::ranges::sort(rules);
     std::vector<model::Gfd::Literal> prev = rules.front().first;
     std::vector<model::Gfd::Literal> conclusion = {};
     for (auto const& [premises, l] : rules) {
         if (prev != premises) {
-            gfds_.emplace_back(pattern, prev, conclusion);
+            gfds.emplace_back(pattern, prev, conclusion);
             forbidden_rules.emplace_back(std::move(prev), std::move(conclusion));
             prev = premises;
             conclusion = {l};
@@ -442,61 +466,51 @@ void GfdMiner::AddCompacted(std::vector<SingleRule>& rules, model::graph_t& patt
             conclusion.push_back(l);
         }
     }
-    gfds_.emplace_back(pattern, prev, conclusion);
+    gfds.emplace_back(pattern, prev, conclusion);
     forbidden_rules.emplace_back(std::move(prev), std::move(conclusion));
 }
 
-bool GfdMiner::CheckFrequency(std::set<std::size_t> const& indices, Embeddings const& embeddings,
-                              model::graph_t const& pattern) {
-    VertexImage vertex_map;
-    for (std::size_t index : indices) {
-        PopulateVertexMap(vertex_map, pattern, embeddings[index]);
-    }
-    std::size_t min_size = GetMinSize(vertex_map, boost::num_vertices(graph_));
+bool GfdMiner::CheckFrequency(boost::dynamic_bitset<> const& indices,
+                              Embeddings const& embeddings) const {
+    auto for_each_row = [&indices, &embeddings](auto&& f) {
+        for (std::size_t i = indices.find_first(); i != boost::dynamic_bitset<>::npos;
+             i = indices.find_next(i)) {
+            f(embeddings.GetRow(i));
+        }
+    };
+    std::size_t min_size = Support(embeddings, for_each_row, boost::num_vertices(graph_));
     return min_size >= sigma_;
 }
 
-bool GfdMiner::Validate(std::vector<model::Gfd::Literal> const& lhs, model::Gfd::Literal const& rhs,
-                        model::graph_t& pattern, Embeddings const& embeddings,
-                        SatisfiedEmbeddings const& satisfied_embeddings) {
-    std::set<std::size_t> lhs_embeddings;
-    if (lhs.empty()) {
-        for (std::size_t i = 0; i < embeddings.size(); ++i) {
-            lhs_embeddings.insert(i);
-        }
+bool GfdMiner::Validate(std::vector<std::size_t> const& lhs_indices, std::size_t rhs_index,
+                        Embeddings const& embeddings,
+                        SatisfiedEmbeddings const& satisfied_embeddings) const {
+    boost::dynamic_bitset<> lhs_embeddings(embeddings.Size());
+    if (lhs_indices.empty()) {
+        lhs_embeddings.set();
     } else {
-        lhs_embeddings = satisfied_embeddings.at(lhs.at(0));
-        for (std::size_t i = 1; i < lhs.size(); i++) {
-            std::set<std::size_t> intersect;
-            std::set<std::size_t> current = satisfied_embeddings.at(lhs.at(i));
-            std::ranges::set_intersection(current, lhs_embeddings,
-                                          std::inserter(intersect, intersect.begin()));
-            lhs_embeddings = intersect;
+        lhs_embeddings = satisfied_embeddings[lhs_indices[0]];
+        for (std::size_t i = 1; i < lhs_indices.size(); i++) {
+            lhs_embeddings &= satisfied_embeddings[lhs_indices[i]];
         }
     }
-    std::set<std::size_t> rhs_embeddings = satisfied_embeddings.at(rhs);
-    return std::ranges::includes(rhs_embeddings, lhs_embeddings) &&
-           CheckFrequency(lhs_embeddings, embeddings, pattern);
-}
-
-bool GfdMiner::CheckFrequency(std::vector<model::Gfd::Literal> const& subset,
-                              SatisfiedEmbeddings const& satisfied_embeddings) {
-    if (subset.empty()) return true;
-    std::set<std::size_t> lhs = satisfied_embeddings.at(subset.at(0));
-    for (std::size_t i = 1; i < subset.size(); i++) {
-        std::set<std::size_t> intersect;
-        std::set<std::size_t> current = satisfied_embeddings.at(subset.at(i));
-        std::ranges::set_intersection(current, lhs, std::inserter(intersect, intersect.begin()));
-        lhs = intersect;
+    return lhs_embeddings.is_subset_of(satisfied_embeddings[rhs_index]) &&
+           CheckFrequency(lhs_embeddings, embeddings);
+}
+
+bool GfdMiner::CheckFrequency(std::vector<std::size_t> const& lhs_indices,
+                              SatisfiedEmbeddings const& satisfied_embeddings) const {
+    if (lhs_indices.empty()) return true;
+    boost::dynamic_bitset<> lhs = satisfied_embeddings[lhs_indices[0]];
+    for (std::size_t i = 1; i < lhs_indices.size(); i++) {
+        lhs &= satisfied_embeddings[lhs_indices[i]];
     }
-    return lhs.size() >= sigma_;
+    return lhs.count() >= sigma_;
 }
 
-std::vector<SingleRule> GfdMiner::GenerateRules(std::vector<model::Gfd::Literal> const& literals,
-                                                model::graph_t& pattern,
-                                                Embeddings const& embeddings,
-                                                Rules const& forbidden_rules,
-                                                SatisfiedEmbeddings const& satisfied_embeddings) {
+std::vector<SingleRule> GfdMiner::GenerateRules(
+        std::vector<model::Gfd::Literal> const& literals, Embeddings const& embeddings,
+        Rules const& forbidden_rules, SatisfiedEmbeddings const& satisfied_embeddings) const {
     std::vector<SingleRule> rules;
     std::unordered_map<std::size_t, std::vector<std::vector<std::size_t>>> reversed_rules;
     std::set<std::vector<std::size_t>> deadlocks;
@@ -513,7 +527,7 @@ std::vector<SingleRule> GfdMiner::GenerateRules(std::vector<model::Gfd::Literal>
                     continue;
                 }
 
-                if (Validate(lhs, rhs, pattern, embeddings, satisfied_embeddings)) {
+                if (Validate(lhs_indices, rhs_index, embeddings, satisfied_embeddings)) {
                     std::vector<std::size_t> deadlock(lhs_indices.begin(), lhs_indices.end());
                     deadlock.push_back(rhs_index);
                     std::sort(deadlock.begin(), deadlock.end());
@@ -538,8 +552,7 @@ std::vector<SingleRule> GfdMiner::GenerateRules(std::vector<model::Gfd::Literal>
                 if (!check_deadlocks(new_lhs_indices, deadlocks)) {
                     continue;
                 }
-                if (CheckFrequency(index_to_literal(literals, new_lhs_indices),
-                                   satisfied_embeddings)) {
+                if (CheckFrequency(new_lhs_indices, satisfied_embeddings)) {
                     new_lhs_indices_set.emplace(std::move(new_lhs_indices));
                 } else {
                     deadlocks.emplace(std::move(new_lhs_indices));
@@ -551,18 +564,9 @@ std::vector<SingleRule> GfdMiner::GenerateRules(std::vector<model::Gfd::Literal>
     return rules;
 }
 
-bool GfdMiner::LiteralSatisfied(model::Gfd::Literal const& l, Embedding const& embedding,
-                                model::graph_t const& pattern) {
-    auto const& [fst_token, snd_token] = l;
-    std::string fst, snd;
-    bool first_res = CheckToken(fst_token, fst, pattern, embedding);
-    bool second_res = CheckToken(snd_token, snd, pattern, embedding);
-    return first_res && second_res && (fst == snd);
-}
-
 std::vector<model::Gfd::Literal> GfdMiner::GenerateLiterals(
         model::graph_t const& pattern, std::unordered_map<std::string, Info> const& attrs_info,
-        Embeddings const& embeddings, SatisfiedEmbeddings& satisfied_embeddings_set) {
+        Embeddings const& embeddings, SatisfiedEmbeddings& satisfied_embeddings_set) const {
     std::vector<std::size_t> indices(boost::num_vertices(pattern));
     std::iota(indices.begin(), indices.end(), 0);
     std::vector<std::vector<std::size_t>> pairs = GetSubsets<std::size_t>(indices, 2);
@@ -570,21 +574,23 @@ std::vector<model::Gfd::Literal> GfdMiner::GenerateLiterals(
     std::vector<model::Gfd::Literal> result;
     result.reserve(pairs.size());
 
-    auto try_add_literal = [&embeddings, &pattern, this, &satisfied_embeddings_set, &result](
+    auto try_add_literal = [&embeddings, this, &satisfied_embeddings_set, &result](
                                    model::Gfd::Token const& fst_token,
                                    model::Gfd::Token const& snd_token) {
         model::Gfd::Literal l = {fst_token, snd_token};
-        std::set<std::size_t> satisfied_embeddings;
-        std::size_t i = 0;
-        for (Embedding const& embedding : embeddings) {
-            if (LiteralSatisfied(l, embedding, pattern)) {
-                satisfied_embeddings.insert(i);
+        model::CsrGraph::IndexedLiteral const indexed_l = csr_graph_.IndexLiteral(l);
+        boost::dynamic_bitset<> satisfied_embeddings(embeddings.Size());
+        for (std::size_t i = 0; i < embeddings.Size(); ++i) {
+            std::span<model::vertex_t const> row = embeddings.GetRow(i);
+            if (csr_graph_.Satisfies(indexed_l, [&row](int pattern_vertex) {
+                    return row[pattern_vertex];
+                })) {
+                satisfied_embeddings.set(i);
             }
-            i++;
         }
-        if (satisfied_embeddings.size() >= sigma_) {
-            satisfied_embeddings_set.try_emplace(l, std::move(satisfied_embeddings));
-            result.emplace_back(fst_token, std::move(snd_token));
+        if (satisfied_embeddings.count() >= sigma_) {
+            satisfied_embeddings_set.push_back(std::move(satisfied_embeddings));
+            result.push_back(std::move(l));
         }
     };
 
@@ -636,8 +642,10 @@ void GfdMiner::HorizontalSpawn(std::vector<model::graph_t> const& patterns,
                                std::vector<Embeddings> const& embeddings_set,
                                std::vector<Rules>& forbidden_rules_set,
                                std::unordered_map<std::string, Info> const& attrs_info) {
-    for (std::size_t i = 0; i < patterns.size(); ++i) {
-        auto pattern = patterns[i];
+    // Patterns are processed independently, their dependencies are added in the order of patterns
+    std::vector<std::vector<model::Gfd>> gfds_set(patterns.size());
+    ParallelForEachIndex(patterns.size(), threads_num_, [&](std::size_t i) {
+        auto const& pattern = patterns[i];
         auto const& embeddings = embeddings_set[i];
         auto& forbidden_rules = forbidden_rules_set[i];
 
@@ -646,17 +654,73 @@ void GfdMiner::HorizontalSpawn(std::vector<model::graph_t> const& patterns,
                 GenerateLiterals(pattern, attrs_info, embeddings, satisfied_embeddings);
 
         std::vector<SingleRule> rules =
-                GenerateRules(literals, pattern, embeddings, forbidden_rules, satisfied_embeddings);
+                GenerateRules(literals, embeddings, forbidden_rules, satisfied_embeddings);
+
+        AddCompacted(rules, pattern, forbidden_rules, gfds_set[i]);
+    });
+    for (std::vector<model::Gfd>& gfds : gfds_set) {
+        std::ranges::move(gfds, std::back_inserter(gfds_));
+    }
+}
 
-        AddCompacted(rules, pattern, forbidden_rules);
+void GfdMiner::VerticalSpawn(std::set<std::string> const& vertex_labels,
+                             std::set<std::string> const& edge_labels,
+                             std::vector<model::graph_t>& patterns,
+                             std::vector<Embeddings>& embeddings_set,
+                             std::vector<Rules>& forbidden_rules_set) {
+    std::vector<std::vector<Candidate>> candidates_set(patterns.size());
+    ParallelForEachIndex(patterns.size(), threads_num_, [&](std::size_t i) {
+        model::graph_t const& pattern = patterns[i];
+        Embeddings const& embeddings = embeddings_set[i];
+
+        AddEdge(edge_labels, graph_, csr_graph_, pattern, embeddings, candidates_set[i]);
+
+        std::size_t num_pat_vertices = boost::num_vertices(pattern);
+        if (num_pat_vertices >= k_ || num_pat_vertices >= boost::num_vertices(graph_)) {
+            return;
+        }
+
+        AddVertex(vertex_labels, edge_labels, csr_graph_, pattern, embeddings, candidates_set[i]);
+    });
+
+    // Candidates are merged in the order they were generated in, so the first of isomorphic
+    // candidates is kept and gets the forbidden rules of the others
+    std::vector<model::graph_t> new_patterns;
+    std::vector<Embeddings> new_embeddings_set;
+    std::vector<Rules> new_forbidden_rules_set;
+    std::unordered_map<PatternCode, std::size_t, boost::hash<PatternCode>> pattern_indices;
+    for (std::size_t i = 0; i < candidates_set.size(); ++i) {
+        Rules const& forbidden_rules = forbidden_rules_set.at(i);
+        for (Candidate& candidate : candidates_set[i]) {
+            auto it = pattern_indices.find(candidate.code);
+            if (it != pattern_indices.end()) {
+                std::size_t const index = it->second;
+                model::graph_t const& existed = new_patterns[index];
+                if (std::optional<Embedding> iso = FindIsomorphism(candidate.pattern, existed)) {
+                    UpdateRules(index, existed, *iso, candidate.pattern, new_forbidden_rules_set,
+                                forbidden_rules);
+                }
+                continue;
+            }
+            if (candidate.embeddings.Empty()) continue;
+
+            pattern_indices.emplace(std::move(candidate.code), new_patterns.size());
+            new_forbidden_rules_set.push_back(forbidden_rules);
+            new_patterns.push_back(std::move(candidate.pattern));
+            new_embeddings_set.push_back(std::move(candidate.embeddings));
+        }
+        candidates_set[i].clear();
     }
+    patterns = std::move(new_patterns);
+    embeddings_set = std::move(new_embeddings_set);
+    forbidden_rules_set = std::move(new_forbidden_rules_set);
 }
 
 void GfdMiner::FilterSupp(std::vector<model::graph_t>& patterns,
                           std::vector<Embeddings>& embeddings_set) {
     std::vector<std::size_t> del_indices = {};
     for (std::size_t i = 0; i < patterns.size(); ++i) {
-        if (Support(graph_, embeddings_set.at(i), patterns.at(i)) < sigma_) {
+        if (Support(graph_, embeddings_set.at(i)) < sigma_) {
             del_indices.push_back(i);
         }
     }
@@ -684,22 +748,17 @@ void GfdMiner::Initialize(std::set<std::string>& vertex_labels, std::set<std::st
         auto [all_labels_it, all_labels_emplaced] =
                 label_to_index.try_emplace(label, patterns.size());
 
-        if (!all_labels_emplaced) {
-            std::size_t index = all_labels_it->second;
-            Embedding embedding{{boost::vertex(0, patterns.at(index)), v}};
-            embeddings_set.at(index).push_back(std::move(embedding));
-        } else {
+        if (all_labels_emplaced) {
             model::graph_t pattern = {};
             std::unordered_map<std::string, std::string> attributes = {{"label", label}};
 
             boost::add_vertex(model::Vertex{0, attributes}, pattern);
             patterns.push_back(pattern);
-
-            Embedding embedding{{boost::vertex(0, pattern), v}};
-            embeddings_set.emplace_back(std::vector{embedding});
-
+            embeddings_set.emplace_back(1);
             forbidden_rules_set.emplace_back();
         }
+        embeddings_set.at(all_labels_it->second).Add(std::array{v});
+
         for (std::pair<std::string const, std::string> const& attr : graph_attributes) {
             if (attr.first == "label") {
                 continue;
@@ -739,30 +798,7 @@ void GfdMiner::MineGfds() {
 
     while (!patterns.empty()) {
         HorizontalSpawn(patterns, embeddings_set, forbidden_rules_set, attrs_info);
-
-        std::vector<model::graph_t> new_patterns;
-        std::vector<Embeddings> new_embeddings_set;
-        std::vector<Rules> new_forbidden_rules_set;
-
-        for (std::size_t i = 0; i < patterns.size(); ++i) {
-            model::graph_t pattern = patterns.at(i);
-            Embeddings embeddings = embeddings_set.at(i);
-            Rules forbidden_rules = forbidden_rules_set.at(i);
-
-            AddEdge(edge_labels, graph_, pattern, embeddings, forbidden_rules, new_patterns,
-                    new_embeddings_set, new_forbidden_rules_set);
-
-            std::size_t num_pat_vertices = boost::num_vertices(pattern);
-            if (num_pat_vertices >= k_ || num_pat_vertices >= boost::num_vertices(graph_)) {
-                continue;
-            }
-
-            AddVertex(vertex_labels, edge_labels, graph_, pattern, embeddings, forbidden_rules,
-                      new_patterns, new_embeddings_set, new_forbidden_rules_set);
-        }
-        patterns = std::move(new_patterns);
-        embeddings_set = std::move(new_embeddings_set);
-        forbidden_rules_set = std::move(new_forbidden_rules_set);
+        VerticalSpawn(vertex_labels, edge_labels, patterns, embeddings_set, forbidden_rules_set);
         FilterSupp(patterns, embeddings_set);
     }
 }
@@ -2,15 +2,63 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <span>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "core/algorithms/algorithm.h"
+#include "core/algorithms/gfd/csr_graph.h"
 #include "core/algorithms/gfd/gfd.h"
 #include "core/config/names_and_descriptions.h"
+#include "core/config/thread_number/type.h"
 #include "core/parser/graph_parser/graph_parser.h"
 
 namespace algos {
 
+namespace gfd_miner {
+
+// Embeddings of a pattern into the graph stored as rows of one flat array.
+// The i-th element of a row is the graph vertex the pattern vertex with index i is mapped to.
+class Embeddings {
+    std::size_t width_;
+    std::vector<model::vertex_t> rows_;
+
+public:
+    explicit Embeddings(std::size_t width) : width_(width) {}
+
+    std::size_t Size() const noexcept {
+        return width_ == 0 ? 0 : rows_.size() / width_;
+    }
+
+    bool Empty() const noexcept {
+        return rows_.empty();
+    }
+
+    std::size_t Width() const noexcept {
+        return width_;
+    }
+
+    std::span<model::vertex_t const> GetRow(std::size_t i) const noexcept {
+        return {rows_.data() + i * width_, width_};
+    }
+
+    void Add(std::span<model::vertex_t const> row) {
+        rows_.insert(rows_.end(), row.begin(), row.end());
+    }
+
+    // Adds `row` extended by the image of a new pattern vertex
+    void Add(std::span<model::vertex_t const> row, model::vertex_t new_vertex) {
+        Add(row);
+        rows_.push_back(new_vertex);
+    }
+};
+
+// satisfied[i] is the set of embeddings on which the i-th literal of a pattern is satisfied
+using SatisfiedEmbeddings = std::vector<boost::dynamic_bitset<>>;
+
+}  // namespace gfd_miner
+
 // An algorithm for mining GFD dependencies
 class GfdMiner : public Algorithm {
 protected:
@@ -18,11 +66,15 @@ protected:
 
     // Graph in which dependencies are mined
     model::graph_t graph_;
+    // Read-only index of graph_ used for neighbourhood and literal checks
+    model::CsrGraph csr_graph_;
     // Maximal number of vertices in the pattern of the mined dependency
     std::size_t k_;
     // Minimal frequency of the mined dependency
     std::size_t sigma_;
 
+    config::ThreadNumType threads_num_ = 1;
+
     std::vector<model::Gfd> gfds_;
 
     unsigned long long ExecuteInternal();
@@ -32,59 +84,42 @@ protected:
 
     void RegisterOptions();
 
-    /* Unwraps the token and writes the resulting value to the variable tok.
-     * Returns false if there is no value, true otherwise.
-     */
-    bool CheckToken(model::Gfd::Token const& token, std::string& tok, model::graph_t const& pattern,
-                    std::unordered_map<model::vertex_t, model::vertex_t> const& embedding);
-
-    /* Composes rules with the same left-hand side and adds the obtained
-     * graph dependencies to the result.
+    /* Composes rules with the same left-hand side and appends the obtained
+     * graph dependencies to gfds.
      */
-    void AddCompacted(
+    static void AddCompacted(
             std::vector<std::pair<std::vector<model::Gfd::Literal>, model::Gfd::Literal>>& rules,
-            model::graph_t& pattern,
+            model::graph_t const& pattern,
             std::vector<std::pair<std::vector<model::Gfd::Literal>,
-                                  std::vector<model::Gfd::Literal>>>& forbidden_rules);
+                                  std::vector<model::Gfd::Literal>>>& forbidden_rules,
+            std::vector<model::Gfd>& gfds);
 
     /* Checks whether the given dependency is satisfied on the graph
      * and whether it is frequent.
      */
-    bool Validate(
-            std::vector<model::Gfd::Literal> const& lhs, model::Gfd::Literal const& rhs,
-            model::graph_t& pattern,
-            std::vector<std::unordered_map<model::vertex_t, model::vertex_t>> const& embeddings,
-            std::map<model::Gfd::Literal, std::set<std::size_t>> const& satisfied_embeddings);
-
-    /* Checks whether the number of embeddings represented by the set of literals
-     * passed by indices is at least sigma.
+    bool Validate(std::vector<std::size_t> const& lhs_indices, std::size_t rhs_index,
+                  gfd_miner::Embeddings const& embeddings,
+                  gfd_miner::SatisfiedEmbeddings const& satisfied_embeddings) const;
+
+    /* Checks whether the number of embeddings passed as a set is at least sigma.
      */
-    bool CheckFrequency(
-            std::set<std::size_t> const& indices,
-            std::vector<std::unordered_map<model::vertex_t, model::vertex_t>> const& embeddings,
-            model::graph_t const& pattern);
+    bool CheckFrequency(boost::dynamic_bitset<> const& indices,
+                        gfd_miner::Embeddings const& embeddings) const;
 
     /* Checks whether the number of embeddings represented by
-     * the set of literals is at least sigma.
+     * the set of literals passed by indices is at least sigma.
      */
-    bool CheckFrequency(
-            std::vector<model::Gfd::Literal> const& subset,
-            std::map<model::Gfd::Literal, std::set<std::size_t>> const& satisfied_embeddings);
+    bool CheckFrequency(std::vector<std::size_t> const& lhs_indices,
+                        gfd_miner::SatisfiedEmbeddings const& satisfied_embeddings) const;
 
     /* Generates all the rules of the satisfied dependencies for a given pattern.
      */
     std::vector<std::pair<std::vector<model::Gfd::Literal>, model::Gfd::Literal>> GenerateRules(
-            std::vector<model::Gfd::Literal> const& literals, model::graph_t& pattern,
-            std::vector<std::unordered_map<model::vertex_t, model::vertex_t>> const& embeddings,
+            std::vector<model::Gfd::Literal> const& literals,
+            gfd_miner::Embeddings const& embeddings,
             std::vector<std::pair<std::vector<model::Gfd::Literal>,
                                   std::vector<model::Gfd::Literal>>> const& forbidden_rules,
-            std::map<model::Gfd::Literal, std::set<std::size_t>> const& satisfied_embeddings);
-
-    /* Checks if a literal is satisfied on the current embedding.
-     */
-    bool LiteralSatisfied(model::Gfd::Literal const& l,
-                          std::unordered_map<model::vertex_t, model::vertex_t> const& embedding,
-                          model::graph_t const& pattern);
+            gfd_miner::SatisfiedEmbeddings const& satisfied_embeddings) const;
 
     /* Generates all possible literal candidates that can be satisfied on the graph.
      */
@@ -93,16 +128,15 @@ protected:
             std::unordered_map<std::string,
                                std::unordered_map<std::string, std::set<std::string>>> const&
                     attrs_info,
-            std::vector<std::unordered_map<model::vertex_t, model::vertex_t>> const& embeddings,
-            std::map<model::Gfd::Literal, std::set<std::size_t>>& satisfied_embeddings_set);
+            gfd_miner::Embeddings const& embeddings,
+            gfd_miner::SatisfiedEmbeddings& satisfied_embeddings) const;
 
     /* Produces literal rules for each pattern, generates graph dependencies
      * and then checks their satisfiability.
      */
     void HorizontalSpawn(
             std::vector<model::graph_t> const& patterns,
-            std::vector<std::vector<std::unordered_map<model::vertex_t, model::vertex_t>>> const&
-                    embeddings_set,
+            std::vector<gfd_miner::Embeddings> const& embeddings_set,
             std::vector<std::vector<
                     std::pair<std::vector<model::Gfd::Literal>, std::vector<model::Gfd::Literal>>>>&
                     forbidden_rules_set,
@@ -110,12 +144,22 @@ protected:
                                std::unordered_map<std::string, std::set<std::string>>> const&
                     attrs_info);
 
+    /* Extends each pattern by an edge or by a vertex with an edge, and collects
+     * the distinct patterns of the next level together with their embeddings.
+     */
+    void VerticalSpawn(
+            std::set<std::string> const& vertex_labels, std::set<std::string> const& edge_labels,
+            std::vector<model::graph_t>& patterns,
+            std::vector<gfd_miner::Embeddings>& embeddings_set,
+            std::vector<std::vector<
+                    std::pair<std::vector<model::Gfd::Literal>, std::vector<model::Gfd::Literal>>>>&
+                    forbidden_rules_set);
+
     /* Filters those patterns whose frequency is less than
      * the input parameter sigma.
      */
     void FilterSupp(std::vector<model::graph_t>& patterns,
-                    std::vector<std::vector<std::unordered_map<model::vertex_t, model::vertex_t>>>&
-                            embeddings_set);
+                    std::vector<gfd_miner::Embeddings>& embeddings_set);
 
     /* Traverses the initial graph, remembers all the vertex and edge labels
      * present in it, all the embeddings of single-vertex patterns,
@@ -125,8 +169,7 @@ protected:
     void Initialize(
             std::set<std::string>& vertex_labels, std::set<std::string>& edge_labels,
             std::vector<model::graph_t>& patterns,
-            std::vector<std::vector<std::unordered_map<model::vertex_t, model::vertex_t>>>&
-                    embeddings_set,
+            std::vector<gfd_miner::Embeddings>& embeddings_set,
             std::vector<std::vector<
                     std::pair<std::vector<model::Gfd::Literal>, std::vector<model::Gfd::Literal>>>>&
                     forbidden_rules_set,
@@ -138,7 +181,7 @@ public:
 
     GfdMiner();
 
-    GfdMiner(model::graph_t graph_) : Algorithm(), graph_(graph_) {
+    GfdMiner(model::graph_t graph_) : Algorithm(), graph_(graph_), csr_graph_(this->graph_) {
         ExecutePrepare();
     }
 
@@ -1,1088 +1,581 @@
 #include "core/algorithms/gfd/gfd_validator/egfd_validator.h"
 
-#include <iostream>
-
-#include <boost/graph/vf2_sub_graph_iso.hpp>
-
-#include "core/config/equal_nulls/option.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "core/algorithms/gfd/csr_graph.h"
 #include "core/config/names_and_descriptions.h"
-#include "core/config/option_using.h"
-#include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace {
 
 using namespace algos;
 using namespace algos::egfd_validator;
-
-using Match = std::vector<
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>>;
-
-void FstStepForest(model::graph_t const& graph,
-                   std::map<model::vertex_t, std::set<model::vertex_t>>& rooted_subtree,
-                   std::map<model::vertex_t, model::vertex_t>& children_amount) {
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (boost::degree(*it, graph) != 1) {
-            continue;
-        }
-        typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it =
-                boost::adjacent_vertices(*it, graph).first;
-
-        if (rooted_subtree.find(*adjacency_it) != rooted_subtree.end()) {
-            rooted_subtree.at(*adjacency_it).insert(*it);
-            children_amount[*adjacency_it]++;
-        } else {
-            std::set<model::vertex_t> value = {*it};
-            rooted_subtree.emplace(*adjacency_it, value);
-            children_amount.emplace(*adjacency_it, 1);
+using model::CsrGraph;
+using Id = CsrGraph::Id;
+
+constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+// Pattern with vertex and edge labels replaced by their ids in the graph
+struct Query {
+    std::size_t size = 0;
+    std::vector<Id> labels;
+    // Distinct (edge label, vertex) pairs of every vertex, sorted
+    std::vector<std::vector<CsrGraph::Neighbour>> neighbours;
+    std::vector<std::size_t> max_neighbour_degrees;
+    // Numbers of distinct adjacent vertices with each label, sorted by label
+    std::vector<std::vector<std::pair<Id, std::size_t>>> label_degrees;
+
+    std::size_t Degree(model::vertex_t u) const noexcept {
+        return neighbours[u].size();
+    }
+};
+
+// BFS forest of the pattern
+struct Forest {
+    std::vector<model::vertex_t> order;
+    // kNone for the roots
+    std::vector<std::size_t> parents;
+    std::vector<Id> tree_labels;
+};
+
+// Order in which the pattern vertices are matched
+struct Plan {
+    std::vector<model::vertex_t> seq;
+    // Depth of the parent of seq[d] in the forest, kNone for the roots
+    std::vector<std::size_t> parent_depths;
+    // Edges from seq[d] to the vertices matched before it (or to itself) that are not tree edges
+    std::vector<std::vector<std::pair<std::size_t, Id>>> back_edges;
+    // Premises whose vertices are matched at depth d or earlier
+    std::vector<std::vector<CsrGraph::IndexedLiteral>> premises;
+    std::vector<CsrGraph::IndexedLiteral> conclusion;
+};
+
+// Returns false if some label of the pattern does not occur in the graph, so the pattern has no
+// embeddings.
+bool MakeQuery(CsrGraph const& graph, model::graph_t const& pattern, Query& query) {
+    CsrGraph const pattern_csr(pattern);
+    query.size = pattern_csr.NumVertices();
+    query.labels.resize(query.size);
+    query.neighbours.resize(query.size);
+    for (model::vertex_t u = 0; u < query.size; ++u) {
+        query.labels[u] = graph.FindValue(pattern[u].attributes.at("label"));
+        if (query.labels[u] == CsrGraph::kNoId) {
+            return false;
         }
-    }
-}
-
-void BuildForest(model::graph_t const& graph,
-                 std::map<model::vertex_t, std::set<model::vertex_t>>& rooted_subtree,
-                 std::map<model::vertex_t, model::vertex_t>& children_amount) {
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        std::map<model::vertex_t, std::set<model::vertex_t>> temp;
-        std::map<model::vertex_t, model::vertex_t> children_temp;
-        for (auto const& kv : rooted_subtree) {
-            auto desc = kv.first;
-            auto children = kv.second;
-
-            if (boost::degree(desc, graph) == (children_amount.at(desc) + 1)) {
-                changed = true;
-                typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
-                        adjacency_end;
-                boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(desc, graph);
-                for (; adjacency_it != adjacency_end; ++adjacency_it) {
-                    if (children.find(*adjacency_it) != children.end()) {
-                        continue;
-                    }
-                    if (temp.find(*adjacency_it) != temp.end()) {
-                        std::set<model::vertex_t> value = {};
-                        auto current = temp.at(*adjacency_it);
-                        std::set_union(children.begin(), children.end(), current.begin(),
-                                       current.end(), std::inserter(value, value.begin()));
-                        value.insert(desc);
-                        temp[*adjacency_it] = value;
-                        children_temp[*adjacency_it]++;
-                    } else {
-                        std::set<model::vertex_t> value = children;
-                        value.insert(desc);
-                        temp.emplace(*adjacency_it, value);
-                        children_temp.emplace(*adjacency_it, 1);
-                    }
-                    break;
-                }
-            } else {
-                temp.emplace(desc, children);
-                children_temp.emplace(desc, children_amount.at(desc));
+        std::vector<CsrGraph::Neighbour>& neighbours = query.neighbours[u];
+        for (CsrGraph::Neighbour const& n : pattern_csr.GetNeighbours(u)) {
+            Id const edge_label = graph.FindEdgeLabel(pattern_csr.GetEdgeLabel(n.edge_label));
+            if (edge_label == CsrGraph::kNoId) {
+                return false;
             }
+            neighbours.push_back({edge_label, n.vertex});
         }
-        rooted_subtree = temp;
-        children_amount = children_temp;
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
     }
-}
 
-void CfDecompose(model::graph_t const& graph, std::set<model::vertex_t>& core,
-                 std::vector<std::set<model::vertex_t>>& forest) {
-    if (boost::num_vertices(graph) == (boost::num_edges(graph) + 1)) {
-        typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-        for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-            core.insert(*it);
+    query.max_neighbour_degrees.assign(query.size, 0);
+    query.label_degrees.resize(query.size);
+    for (model::vertex_t u = 0; u < query.size; ++u) {
+        std::vector<model::vertex_t> adjacent;
+        for (CsrGraph::Neighbour const& n : query.neighbours[u]) {
+            adjacent.push_back(n.vertex);
         }
-        return;
-    }
-
-    std::map<model::vertex_t, std::set<model::vertex_t>> rooted_subtree;
-    std::map<model::vertex_t, model::vertex_t> children_amount;
-    FstStepForest(graph, rooted_subtree, children_amount);
-    BuildForest(graph, rooted_subtree, children_amount);
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
 
-    std::set<model::vertex_t> not_core_indices = {};
-    for (auto const& kv : rooted_subtree) {
-        for (int child : kv.second) {
-            not_core_indices.insert(child);
+        std::vector<Id> adjacent_labels;
+        for (model::vertex_t w : adjacent) {
+            query.max_neighbour_degrees[u] =
+                    std::max(query.max_neighbour_degrees[u], query.Degree(w));
+            adjacent_labels.push_back(query.labels[w]);
         }
-    }
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (not_core_indices.find(*it) == not_core_indices.end()) {
-            core.insert(*it);
+        std::sort(adjacent_labels.begin(), adjacent_labels.end());
+        for (Id label : adjacent_labels) {
+            std::vector<std::pair<Id, std::size_t>>& label_degrees = query.label_degrees[u];
+            if (label_degrees.empty() || label_degrees.back().first != label) {
+                label_degrees.emplace_back(label, 0);
+            }
+            ++label_degrees.back().second;
         }
     }
-
-    for (auto const& kv : rooted_subtree) {
-        std::set<model::vertex_t> indices(kv.second);
-        indices.insert(kv.first);
-        forest.push_back(indices);
-    }
+    return true;
 }
 
-int Mnd(model::graph_t const& graph, model::vertex_t const& v) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it, adjacency_end;
-    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-    std::size_t result = 0;
-    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-        if (result < boost::degree(*adjacency_it, graph)) {
-            result = boost::degree(*adjacency_it, graph);
+// Vertices left after repeatedly removing the vertices with at most one adjacent vertex
+std::vector<bool> GetCore(Query const& query) {
+    std::vector<std::size_t> degrees(query.size, 0);
+    for (model::vertex_t u = 0; u < query.size; ++u) {
+        model::vertex_t last = u;
+        for (CsrGraph::Neighbour const& n : query.neighbours[u]) {
+            if (n.vertex != u && n.vertex != last) ++degrees[u];
+            last = n.vertex;
         }
     }
-    return result;
-}
 
-void CountLabelDegrees(model::graph_t const& graph, model::vertex_t const& v,
-                       std::map<std::string, model::vertex_t>& result) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it, adjacency_end;
-    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-        if (result.find(graph[*adjacency_it].attributes.at("label")) != result.end()) {
-            result[graph[*adjacency_it].attributes.at("label")]++;
-        } else {
-            result.emplace(graph[*adjacency_it].attributes.at("label"), 1);
+    std::vector<bool> core(query.size, true);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (model::vertex_t u = 0; u < query.size; ++u) {
+            if (!core[u] || degrees[u] > 1) continue;
+            core[u] = false;
+            changed = true;
+            model::vertex_t last = u;
+            for (CsrGraph::Neighbour const& n : query.neighbours[u]) {
+                if (n.vertex != u && n.vertex != last) --degrees[n.vertex];
+                last = n.vertex;
+            }
         }
     }
+    return core;
 }
 
-bool CandVerify(model::graph_t const& graph, model::vertex_t const& v, model::graph_t const& query,
-                model::vertex_t const& u) {
-    if (Mnd(graph, v) < Mnd(query, u)) {
-        return false;
-    }
-    std::map<std::string, model::vertex_t> graph_label_degrees;
-    CountLabelDegrees(graph, v, graph_label_degrees);
-    std::map<std::string, model::vertex_t> query_label_degrees;
-    CountLabelDegrees(query, u, query_label_degrees);
+// Builds the CPI top-down along the BFS forest of the pattern and then refines it bottom-up
+class CpiBuilder {
+private:
+    CsrGraph const& graph_;
+    Query const& query_;
+    Forest& forest_;
+    CPI& cpi_;
+    std::vector<std::vector<bool>> is_candidate_;
+    // Positions of the vertices in forest_.order
+    std::vector<std::size_t> positions_;
+    std::vector<bool> seen_;
+    std::vector<std::size_t> counts_;
 
-    for (auto const& label_degree : query_label_degrees) {
-        std::string const& label = label_degree.first;
-        std::size_t const& degree = label_degree.second;
-        if (graph_label_degrees.find(label) == graph_label_degrees.end() ||
-            graph_label_degrees.at(label) < degree) {
+    // Checks necessary conditions for matching u to v: v has enough neighbours, enough adjacent
+    // vertices with each label and an adjacent vertex of a high enough degree
+    bool CandVerify(model::vertex_t v, model::vertex_t u) {
+        if (graph_.GetLabel(v) != query_.labels[u] || graph_.Degree(v) < query_.Degree(u)) {
             return false;
         }
-    }
-    return true;
-}
-
-void SortComplexity(std::vector<model::vertex_t>& order, model::graph_t const& graph,
-                    model::graph_t const& query,
-                    std::map<std::string, std::set<model::vertex_t>> const& label_classes) {
-    auto cmp_complexity = [&graph, &query, &label_classes](model::vertex_t const& a,
-                                                           model::vertex_t const& b) {
-        std::size_t a_degree = boost::degree(a, query);
-        int an = 0;
-        for (model::vertex_t const& e : label_classes.at(query[a].attributes.at("label"))) {
-            if (boost::degree(e, graph) >= a_degree) {
-                an++;
-            }
-        }
-
-        std::size_t b_degree = boost::degree(b, query);
-        int bn = 0;
-        for (model::vertex_t const& e : label_classes.at(query[b].attributes.at("label"))) {
-            if (boost::degree(e, graph) >= b_degree) {
-                bn++;
-            }
-        }
-        return an / a_degree < bn / b_degree;
-    };
-    std::sort(order.begin(), order.end(), cmp_complexity);
-}
 
-void SortAccurateComplexity(std::vector<model::vertex_t>& order, model::graph_t const& graph,
-                            model::graph_t const& query,
-                            std::map<std::string, std::set<model::vertex_t>> const& label_classes) {
-    int top = std::min(int(order.size()), 3);
-    auto cmp_accurate_complexity = [&graph, &query, &label_classes](model::vertex_t const& a,
-                                                                    model::vertex_t const& b) {
-        int a_degree = boost::degree(a, query);
-        int an = 0;
-        for (model::vertex_t const& e : label_classes.at(query[a].attributes.at("label"))) {
-            if (CandVerify(graph, e, query, a)) {
-                an++;
+        std::vector<std::pair<Id, std::size_t>> const& label_degrees = query_.label_degrees[u];
+        counts_.assign(label_degrees.size(), 0);
+        std::size_t max_neighbour_degree = 0;
+        for (CsrGraph::Neighbour const& n : graph_.GetNeighbours(v)) {
+            max_neighbour_degree = std::max(max_neighbour_degree, graph_.Degree(n.vertex));
+            Id const label = graph_.GetLabel(n.vertex);
+            auto it = std::ranges::lower_bound(label_degrees, label, {},
+                                               &std::pair<Id, std::size_t>::first);
+            if (it != label_degrees.end() && it->first == label) {
+                ++counts_[it - label_degrees.begin()];
             }
         }
-
-        int b_degree = boost::degree(b, query);
-        int bn = 0;
-        for (model::vertex_t const& e : label_classes.at(query[b].attributes.at("label"))) {
-            if (CandVerify(graph, e, query, b)) {
-                bn++;
-            }
+        if (max_neighbour_degree < query_.max_neighbour_degrees[u]) {
+            return false;
         }
-        return an / a_degree < bn / b_degree;
-    };
-    std::sort(order.begin(), std::next(order.begin(), top), cmp_accurate_complexity);
-}
-
-int GetRoot(model::graph_t const& graph, model::graph_t const& query,
-            std::set<model::vertex_t> const& core) {
-    std::map<std::string, std::set<model::vertex_t>> label_classes;
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (label_classes.find(graph[*it].attributes.at("label")) != label_classes.end()) {
-            label_classes[graph[*it].attributes.at("label")].insert(*it);
-        } else {
-            std::set<model::vertex_t> value = {*it};
-            label_classes.emplace(graph[*it].attributes.at("label"), value);
+        for (std::size_t i = 0; i < label_degrees.size(); ++i) {
+            if (counts_[i] < label_degrees[i].second) return false;
         }
+        return true;
     }
-    std::vector<model::vertex_t> order(core.begin(), core.end());
-
-    SortComplexity(order, graph, query, label_classes);
-    SortAccurateComplexity(order, graph, query, label_classes);
-    return *order.begin();
-}
 
-void MakeLevels(model::graph_t const& query, model::vertex_t const& root,
-                std::vector<std::set<model::vertex_t>>& levels,
-                std::map<model::vertex_t, model::vertex_t>& parent) {
-    std::set<model::vertex_t> current = {root};
-    std::set<model::vertex_t> marked = {root};
-    while (!current.empty()) {
-        levels.push_back(current);
-        std::set<model::vertex_t> next = {};
-        for (model::vertex_t const& vertex : current) {
-            typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
-                    adjacency_end;
-            boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(vertex, query);
-            for (; adjacency_it != adjacency_end; ++adjacency_it) {
-                if (marked.find(*adjacency_it) == marked.end()) {
-                    marked.insert(*adjacency_it);
-                    next.insert(*adjacency_it);
-                    parent.emplace(*adjacency_it, vertex);
-                }
-            }
+    std::vector<model::vertex_t> InitialCandidates(model::vertex_t u) {
+        std::vector<model::vertex_t> result;
+        for (model::vertex_t v : graph_.GetVerticesWithLabel(query_.labels[u])) {
+            if (CandVerify(v, u)) result.push_back(v);
         }
-        current = next;
+        return result;
     }
-}
 
-void MakeNte(model::graph_t const& query, std::vector<std::set<model::vertex_t>>& levels,
-             std::map<model::vertex_t, model::vertex_t>& parent, std::set<model::edge_t>& nte,
-             std::set<model::edge_t>& snte) {
-    typename boost::graph_traits<model::graph_t>::edge_iterator it_edge, end_edge;
-    for (boost::tie(it_edge, end_edge) = edges(query); it_edge != end_edge; ++it_edge) {
-        model::vertex_t origin = boost::source(*it_edge, query);
-        model::vertex_t finish = boost::target(*it_edge, query);
-        if ((parent.find(origin) != parent.end()) && (parent.find(finish) != parent.end()) &&
-            (parent.at(origin) != finish) && (parent.at(finish) != origin)) {
-            int origin_level = 0;
-            int finish_level = 0;
-            for (std::size_t i = 0; i < levels.size(); ++i) {
-                if (levels.at(i).find(origin) != levels.at(i).end()) {
-                    origin_level = i;
-                }
-                if (levels.at(i).find(finish) != levels.at(i).end()) {
-                    finish_level = i;
-                }
+    // Candidates of the child u reachable from the candidates of its parent
+    std::vector<model::vertex_t> ChildCandidates(model::vertex_t u) {
+        std::vector<model::vertex_t> reached;
+        for (model::vertex_t v : cpi_.candidates[forest_.parents[u]]) {
+            for (CsrGraph::Neighbour const& n : graph_.GetNeighbours(v, forest_.tree_labels[u])) {
+                if (seen_[n.vertex]) continue;
+                seen_[n.vertex] = true;
+                reached.push_back(n.vertex);
             }
-            if (origin_level == finish_level) {
-                snte.insert(*it_edge);
-            }
-            nte.insert(*it_edge);
         }
-    }
-}
-
-void BfsTree(model::graph_t const& query, model::vertex_t const& root,
-             std::vector<std::set<model::vertex_t>>& levels,
-             std::map<model::vertex_t, model::vertex_t>& parent, std::set<model::edge_t>& nte,
-             std::set<model::edge_t>& snte) {
-    MakeLevels(query, root, levels, parent);
-    MakeNte(query, levels, parent, nte, snte);
-}
 
-void DirectConstruction(std::set<model::vertex_t> const& lev, model::graph_t const& graph,
-                        model::graph_t const& query,
-                        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                        std::map<model::vertex_t, int>& cnts,
-                        std::map<model::vertex_t, std::set<model::vertex_t>>& unvisited_neighbours,
-                        std::set<model::edge_t> const& snte, std::set<model::vertex_t>& visited) {
-    for (model::vertex_t const& u : lev) {
-        int cnt = 0;
-        typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
-                adjacency_end;
-        boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(u, query);
-        for (; adjacency_it != adjacency_end; ++adjacency_it) {
-            if (visited.find(query[*adjacency_it].node_id) == visited.end() &&
-                snte.find(boost::edge(*adjacency_it, u, query).first) != snte.end()) {
-                if (unvisited_neighbours.find(u) != unvisited_neighbours.end()) {
-                    unvisited_neighbours.at(u).insert(*adjacency_it);
-                } else {
-                    std::set<model::vertex_t> value = {*adjacency_it};
-                    unvisited_neighbours.emplace(u, value);
-                }
-            } else if (visited.find(*adjacency_it) != visited.end()) {
-                for (model::vertex_t const& v : candidates.at(*adjacency_it)) {
-                    typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                            g_adj_end;
-                    boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(v, graph);
-                    for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                        if (graph[*g_adj_it].attributes.at("label") ==
-                                    query[u].attributes.at("label") &&
-                            boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                            if (cnts.find(*g_adj_it) == cnts.end()) {
-                                if (cnt == 0) {
-                                    cnts.emplace(*g_adj_it, 1);
-                                }
-                            } else {
-                                if (cnts.at(*g_adj_it) == cnt) {
-                                    cnts[*g_adj_it]++;
-                                }
-                            }
-                        }
-                    }
-                }
-                cnt++;
-            }
+        std::vector<model::vertex_t> result;
+        for (model::vertex_t v : reached) {
+            seen_[v] = false;
+            if (CandVerify(v, u)) result.push_back(v);
         }
-        typename boost::graph_traits<model::graph_t>::vertex_iterator g_it, g_end;
-        for (boost::tie(g_it, g_end) = vertices(graph); g_it != g_end; ++g_it) {
-            if (((cnts.find(*g_it) == cnts.end()) && (cnt == 0)) ||
-                ((cnts.find(*g_it) != cnts.end()) && (cnts.at(*g_it) == cnt))) {
-                if (CandVerify(graph, *g_it, query, u)) {
-                    candidates.at(u).insert(*g_it);
-                }
-            }
-        }
-        visited.insert(u);
-        cnts.clear();
+        std::sort(result.begin(), result.end());
+        return result;
     }
-}
 
-void ReverseConstruction(
-        std::set<model::vertex_t> const& lev, model::graph_t const& graph,
-        model::graph_t const& query,
-        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-        std::map<model::vertex_t, int>& cnts,
-        std::map<model::vertex_t, std::set<model::vertex_t>>& unvisited_neighbours) {
-    for (auto j = lev.rbegin(); j != lev.rend(); ++j) {
-        model::vertex_t u = *j;
-        int cnt = 0;
-        if (unvisited_neighbours.find(u) != unvisited_neighbours.end()) {
-            for (model::vertex_t const& un : unvisited_neighbours.at(u)) {
-                for (model::vertex_t const& v : candidates.at(un)) {
-                    typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                            g_adj_end;
-                    boost::tie(g_adj_it, g_adj_end) =
-                            boost::adjacent_vertices(boost::vertex(v, graph), graph);
-                    for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                        if (graph[*g_adj_it].attributes.at("label") ==
-                                    query[u].attributes.at("label") &&
-                            boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                            if (cnts.find(*g_adj_it) == cnts.end()) {
-                                if (cnt == 0) {
-                                    cnts.emplace(*g_adj_it, 1);
-                                }
-                            } else {
-                                if (cnts.at(*g_adj_it) == cnt) {
-                                    cnts[*g_adj_it]++;
-                                }
-                            }
-                        }
-                    }
-                }
-                cnt++;
-            }
+    void Assign(model::vertex_t u, std::vector<model::vertex_t> candidates) {
+        for (model::vertex_t v : cpi_.candidates[u]) {
+            is_candidate_[u][v] = false;
         }
-
-        std::set<model::vertex_t> to_delete = {};
-        for (model::vertex_t const& v : candidates.at(u)) {
-            if (!(((cnts.find(v) == cnts.end()) && (cnt == 0)) ||
-                  ((cnts.find(v) != cnts.end()) && (cnts.at(v) == cnt)))) {
-                to_delete.insert(v);
-            }
+        for (model::vertex_t v : candidates) {
+            is_candidate_[u][v] = true;
         }
-        for (model::vertex_t const& d : to_delete) {
-            candidates.at(u).erase(d);
-        }
-        cnts.clear();
+        cpi_.candidates[u] = std::move(candidates);
     }
-}
 
-void FinalConstruction(std::set<model::vertex_t> const& lev, CPI& cpi, model::graph_t const& graph,
-                       model::graph_t const& query,
-                       std::map<model::vertex_t, model::vertex_t> const& parent,
-                       std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    for (model::vertex_t const& u : lev) {
-        model::vertex_t up = parent.at(u);
-        for (model::vertex_t const& vp : candidates.at(up)) {
-            typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it, g_adj_end;
-            boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(vp, graph);
-            for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                if (graph[*g_adj_it].attributes.at("label") == query[u].attributes.at("label") &&
-                    boost::degree(*g_adj_it, graph) >= boost::degree(u, query) &&
-                    candidates.at(u).find(*g_adj_it) != candidates.at(u).end() &&
-                    query[boost::edge(up, u, query).first].label ==
-                            graph[boost::edge(vp, *g_adj_it, graph).first].label) {
-                    std::pair<model::vertex_t, model::vertex_t> cpi_edge(up, u);
-                    if (cpi.find(cpi_edge) != cpi.end()) {
-                        if (cpi.at(cpi_edge).find(vp) != cpi.at(cpi_edge).end()) {
-                            cpi.at(cpi_edge).at(vp).insert(*g_adj_it);
-                        } else {
-                            std::set<model::vertex_t> value = {*g_adj_it};
-                            cpi.at(cpi_edge).emplace(vp, value);
-                        }
-                    } else {
-                        std::map<model::vertex_t, std::set<model::vertex_t>> edge_map;
-                        std::set<model::vertex_t> value = {*g_adj_it};
-                        edge_map.emplace(vp, value);
-                        cpi.emplace(cpi_edge, edge_map);
-                    }
-                }
+    // Keeps the candidates of u that are adjacent to a candidate of w over an edge with the label
+    void Refine(model::vertex_t u, model::vertex_t w, Id edge_label) {
+        std::vector<bool> const& is_w_candidate = is_candidate_[w];
+        std::vector<model::vertex_t> refined;
+        for (model::vertex_t v : cpi_.candidates[u]) {
+            auto const neighbours = graph_.GetNeighbours(v, edge_label);
+            if (std::ranges::any_of(neighbours, [&is_w_candidate](CsrGraph::Neighbour const& n) {
+                    return is_w_candidate[n.vertex];
+                })) {
+                refined.push_back(v);
             }
         }
-    }
-}
-
-void TopDownConstruct(CPI& cpi, model::graph_t const& graph, model::graph_t const& query,
-                      std::vector<std::set<model::vertex_t>> const& levels,
-                      std::map<model::vertex_t, model::vertex_t> const& parent,
-                      std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                      std::set<model::edge_t> const& snte) {
-    model::vertex_t root = *levels.at(0).begin();
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(query); it != end; ++it) {
-        std::set<model::vertex_t> empty = {};
-        candidates.emplace(*it, empty);
-    }
-
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (graph[*it].attributes.at("label") == query[root].attributes.at("label") &&
-            boost::degree(*it, graph) >= boost::degree(root, query) &&
-            CandVerify(graph, *it, query, root)) {
-            candidates.at(root).insert(*it);
+        if (refined.size() != cpi_.candidates[u].size()) {
+            Assign(u, std::move(refined));
         }
     }
-    std::set<model::vertex_t> visited = {root};
-    std::map<model::vertex_t, std::set<model::vertex_t>> unvisited_neighbours;
-    std::map<model::vertex_t, int> cnts;
-
-    std::vector<std::set<model::vertex_t>>::const_iterator i = std::next(levels.cbegin());
-    for (; i != levels.cend(); ++i) {
-        std::set<model::vertex_t> lev = *i;
-        DirectConstruction(lev, graph, query, candidates, cnts, unvisited_neighbours, snte,
-                           visited);
-        ReverseConstruction(lev, graph, query, candidates, cnts, unvisited_neighbours);
-        FinalConstruction(lev, cpi, graph, query, parent, candidates);
-    }
-}
 
-void InitialRefinement(model::vertex_t const& u, model::graph_t const& graph,
-                       model::graph_t const& query,
-                       std::map<model::vertex_t, model::vertex_t> const& parent,
-                       std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                       std::map<model::vertex_t, int>& cnts, int& cnt) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator q_adj_it, q_adj_end;
-    boost::tie(q_adj_it, q_adj_end) = boost::adjacent_vertices(u, query);
-    for (; q_adj_it != q_adj_end; ++q_adj_it) {
-        if ((parent.find(*q_adj_it) != parent.end()) && (parent.at(*q_adj_it) == u)) {
-            for (model::vertex_t const& v : candidates.at(*q_adj_it)) {
-                typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                        g_adj_end;
-                boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(v, graph);
-                for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                    if (graph[*g_adj_it].attributes.at("label") ==
-                                query[u].attributes.at("label") &&
-                        boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                        if (cnts.find(*g_adj_it) == cnts.end()) {
-                            if (cnt == 0) {
-                                cnts.emplace(*g_adj_it, 1);
-                            }
-                        } else {
-                            if (cnts.at(*g_adj_it) == cnt) {
-                                cnts[*g_adj_it]++;
-                            }
-                        }
-                    }
-                }
-            }
-            cnt++;
-        }
+    bool IsTreeEdge(model::vertex_t u, CsrGraph::Neighbour const& n) const noexcept {
+        return forest_.parents[u] == n.vertex && forest_.tree_labels[u] == n.edge_label;
     }
-}
 
-void OddDeletion(model::vertex_t const& u, CPI& cpi,
-                 std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                 std::map<model::vertex_t, int>& cnts, int& cnt) {
-    std::set<model::vertex_t> to_delete = {};
-    for (model::vertex_t const& v : candidates.at(u)) {
-        if (!(((cnts.find(v) == cnts.end()) && (cnt == 0)) ||
-              ((cnts.find(v) != cnts.end()) && (cnts.at(v) == cnt)))) {
-            to_delete.insert(v);
+    // Picks the vertex with the fewest candidates per incident edge, preferring the vertices of
+    // the core of the pattern, and assigns its candidates
+    model::vertex_t SelectRoot(std::vector<bool> const& core) {
+        std::vector<model::vertex_t> eligible;
+        for (model::vertex_t u = 0; u < query_.size; ++u) {
+            if (positions_[u] == kNone && core[u]) eligible.push_back(u);
         }
-    }
-    for (model::vertex_t const& d : to_delete) {
-        candidates.at(u).erase(d);
-        for (auto const& e : cpi) {
-            if (e.second.find(d) != e.second.end()) {
-                cpi.at(e.first).erase(d);
+        if (eligible.empty()) {
+            for (model::vertex_t u = 0; u < query_.size; ++u) {
+                if (positions_[u] == kNone) eligible.push_back(u);
             }
         }
-    }
-    cnts.clear();
-}
 
-void FinalRefinement(model::vertex_t const& u, CPI& cpi, model::graph_t const& query,
-                     std::map<model::vertex_t, model::vertex_t> const& parent,
-                     std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    for (model::vertex_t const& v : candidates.at(u)) {
-        typename boost::graph_traits<model::graph_t>::adjacency_iterator q_adj_it, q_adj_end;
-        boost::tie(q_adj_it, q_adj_end) = boost::adjacent_vertices(u, query);
-        for (; q_adj_it != q_adj_end; ++q_adj_it) {
-            model::vertex_t u2 = *q_adj_it;
-            if ((parent.find(u2) != parent.end()) && (parent.at(u2) == u)) {
-                std::pair<model::vertex_t, model::vertex_t> cpi_edge(u, u2);
-                for (model::vertex_t const& v2 : cpi.at(cpi_edge).at(v)) {
-                    if (candidates.at(u2).find(v2) == candidates.at(u2).end()) {
-                        cpi.at(cpi_edge).at(v).erase(v2);
-                    }
-                }
+        model::vertex_t root = eligible.front();
+        std::vector<model::vertex_t> root_candidates;
+        double best_score = std::numeric_limits<double>::infinity();
+        for (model::vertex_t u : eligible) {
+            std::vector<model::vertex_t> candidates = InitialCandidates(u);
+            double const score = static_cast<double>(candidates.size()) /
+                                 static_cast<double>(std::max<std::size_t>(query_.Degree(u), 1));
+            if (score < best_score) {
+                best_score = score;
+                root = u;
+                root_candidates = std::move(candidates);
             }
         }
-    }
-}
-
-void BottomUpRefinement(CPI& cpi, model::graph_t const& graph, model::graph_t const& query,
-                        std::vector<std::set<model::vertex_t>> const& levels,
-                        std::map<model::vertex_t, model::vertex_t> const& parent,
-                        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    std::map<model::vertex_t, int> cnts;
-
-    std::vector<std::set<model::vertex_t>>::const_iterator lev_it;
-    for (lev_it = --levels.cend(); lev_it != std::next(levels.begin(), -1); --lev_it) {
-        for (model::vertex_t const& u : *lev_it) {
-            int cnt = 0;
-            InitialRefinement(u, graph, query, parent, candidates, cnts, cnt);
-            OddDeletion(u, cpi, candidates, cnts, cnt);
-            FinalRefinement(u, cpi, query, parent, candidates);
-        }
-    }
-}
-
-int NumOfEmbeddings(const CPI& cpi, std::vector<model::vertex_t> const& path,
-                    model::vertex_t const& origin) {
-    std::map<std::pair<model::vertex_t, model::vertex_t>, int> result;
-    std::pair<model::vertex_t, model::vertex_t> edge(*(std::next(path.end(), -2)),
-                                                     *(std::next(path.end(), -1)));
-    for (auto& vert_cans : cpi.at(edge)) {
-        for (model::vertex_t const& can : vert_cans.second) {
-            std::pair<model::vertex_t, model::vertex_t> key(*(std::next(path.end(), -1)), can);
-            result.emplace(key, 1);
+        Assign(root, std::move(root_candidates));
+        return root;
+    }
+
+    void AddTree(model::vertex_t root) {
+        std::size_t const begin = forest_.order.size();
+        positions_[root] = begin;
+        forest_.order.push_back(root);
+        for (std::size_t i = begin; i < forest_.order.size(); ++i) {
+            model::vertex_t u = forest_.order[i];
+            for (CsrGraph::Neighbour const& n : query_.neighbours[u]) {
+                if (positions_[n.vertex] != kNone) continue;
+                positions_[n.vertex] = forest_.order.size();
+                forest_.order.push_back(n.vertex);
+                forest_.parents[n.vertex] = u;
+                forest_.tree_labels[n.vertex] = n.edge_label;
+            }
         }
-    }
 
-    for (int i = path.size() - 1; path.at(i) != origin; --i) {
-        std::map<std::pair<model::vertex_t, model::vertex_t>, int> new_result;
-        std::pair<model::vertex_t, model::vertex_t> cur_edge(path.at(i - 1), path.at(i));
-        for (auto& vert_cans : cpi.at(cur_edge)) {
-            for (model::vertex_t const& can : vert_cans.second) {
-                std::pair<model::vertex_t, model::vertex_t> key(path.at(i - 1), vert_cans.first);
-                std::pair<model::vertex_t, model::vertex_t> counted(path.at(i), can);
-                if (new_result.find(key) != new_result.end()) {
-                    new_result[key] += result.at(counted);
-                } else {
-                    new_result.emplace(key, result.at(counted));
+        for (std::size_t i = begin + 1; i < forest_.order.size(); ++i) {
+            model::vertex_t u = forest_.order[i];
+            Assign(u, ChildCandidates(u));
+            for (CsrGraph::Neighbour const& n : query_.neighbours[u]) {
+                if (positions_[n.vertex] <= i && !IsTreeEdge(u, n)) {
+                    Refine(u, n.vertex, n.edge_label);
                 }
             }
         }
-        result = new_result;
-    }
-    int answer = 0;
-    for (auto& values : result) {
-        answer += values.second;
     }
-    return answer;
-}
 
-int CandidatesCardinality(const CPI& cpi, model::vertex_t const& u) {
-    for (auto& edge_cans : cpi) {
-        auto edge = edge_cans.first;
-        if (edge.first == u) {
-            return edge_cans.second.size();
+    void BuildChildren(model::vertex_t u) {
+        std::vector<model::vertex_t> const& candidates = cpi_.candidates[u];
+        std::vector<std::size_t>& offsets = cpi_.offsets[u];
+        std::vector<std::uint32_t>& children = cpi_.children[u];
+        if (forest_.parents[u] == kNone) {
+            offsets = {0, candidates.size()};
+            children.resize(candidates.size());
+            std::iota(children.begin(), children.end(), 0);
+            return;
+        }
+
+        std::vector<model::vertex_t> const& parent_candidates =
+                cpi_.candidates[forest_.parents[u]];
+        offsets.assign(1, 0);
+        for (model::vertex_t v : parent_candidates) {
+            model::vertex_t last = kNone;
+            for (CsrGraph::Neighbour const& n : graph_.GetNeighbours(v, forest_.tree_labels[u])) {
+                if (n.vertex == last || !is_candidate_[u][n.vertex]) continue;
+                last = n.vertex;
+                children.push_back(
+                        std::lower_bound(candidates.begin(), candidates.end(), n.vertex) -
+                        candidates.begin());
+            }
+            offsets.push_back(children.size());
         }
     }
-    return 1;
-}
-
-void BuildOptimalSeq(const CPI& cpi, std::vector<std::vector<model::vertex_t>> const& paths_origin,
-                     std::vector<model::vertex_t> const& NTs,
-                     std::vector<std::vector<model::vertex_t>> const& paths,
-                     std::vector<model::vertex_t>& pi) {
-    auto cmp = [&cpi, &paths_origin, &NTs](std::vector<model::vertex_t> const& a,
-                                           std::vector<model::vertex_t> const& b) {
-        int nta = NTs.at(std::find(paths_origin.begin(), paths_origin.end(), a) -
-                         paths_origin.begin());
-        int ntb = NTs.at(std::find(paths_origin.begin(), paths_origin.end(), b) -
-                         paths_origin.begin());
-        if (nta == 0) {
-            return false;
-        }
-        if (ntb == 0) {
-            return true;
-        }
-        return NumOfEmbeddings(cpi, a, *a.begin()) / nta <
-               NumOfEmbeddings(cpi, b, *b.begin()) / ntb;
-    };
-    pi = *std::min_element(paths.begin(), paths.end(), cmp);
-}
-
-void BuildAccurateOptimalSeq(const CPI& cpi,
-                             std::vector<std::vector<model::vertex_t>> const& paths_origin,
-                             std::vector<model::vertex_t> const& origins,
-                             std::vector<std::vector<model::vertex_t>> const& paths,
-                             std::vector<model::vertex_t>& pi) {
-    auto cmp = [&cpi, &paths_origin, &origins](std::vector<model::vertex_t> const& a,
-                                               std::vector<model::vertex_t> const& b) {
-        int a_origin = origins.at(std::find(paths_origin.begin(), paths_origin.end(), a) -
-                                  paths_origin.begin());
-        int b_origin = origins.at(std::find(paths_origin.begin(), paths_origin.end(), b) -
-                                  paths_origin.begin());
-        return NumOfEmbeddings(cpi, a, a_origin) / CandidatesCardinality(cpi, a_origin) <
-               NumOfEmbeddings(cpi, b, b_origin) / CandidatesCardinality(cpi, b_origin);
-    };
-    pi = *std::min_element(paths.begin(), paths.end(), cmp);
-}
 
-std::vector<model::vertex_t> MatchingOrder(
-        const CPI& cpi, std::vector<std::vector<model::vertex_t>> const& paths_origin,
-        std::vector<model::vertex_t> const& NTs) {
-    std::vector<std::vector<model::vertex_t>> paths;
-    std::copy(paths_origin.begin(), paths_origin.end(), std::back_inserter(paths));
+public:
+    CpiBuilder(CsrGraph const& graph, Query const& query, Forest& forest, CPI& cpi)
+        : graph_(graph),
+          query_(query),
+          forest_(forest),
+          cpi_(cpi),
+          is_candidate_(query.size, std::vector<bool>(graph.NumVertices(), false)),
+          positions_(query.size, kNone),
+          seen_(graph.NumVertices(), false) {}
 
-    std::vector<model::vertex_t> pi;
-    BuildOptimalSeq(cpi, paths_origin, NTs, paths, pi);
-    std::vector<model::vertex_t> origins;
-    for (auto& path : paths_origin) {
-        if (path == pi) {
-            origins.push_back(*path.begin());
-            continue;
-        }
-        std::vector<model::vertex_t>::iterator pi_it = pi.begin();
-        std::vector<model::vertex_t>::const_iterator path_it = path.cbegin();
-        for (; *pi_it == *path_it; ++pi_it, ++path_it) {
-        }
-        origins.push_back(*(--pi_it));
-    }
-    paths.erase(std::remove(paths.begin(), paths.end(), pi), paths.end());
+    // Returns false if some vertex of the pattern has no candidates
+    bool Build() {
+        forest_.parents.assign(query_.size, kNone);
+        forest_.tree_labels.assign(query_.size, CsrGraph::kNoId);
+        cpi_.candidates.assign(query_.size, {});
 
-    std::vector<model::vertex_t> seq;
-    std::copy(pi.begin(), pi.end(), std::back_inserter(seq));
-    while (!paths.empty()) {
-        std::vector<model::vertex_t> pi_new;
-        BuildAccurateOptimalSeq(cpi, paths_origin, origins, paths, pi_new);
-        std::vector<model::vertex_t>::iterator pi_it = pi_new.begin();
-        std::vector<model::vertex_t>::iterator seq_it = seq.begin();
-        for (; *pi_it == *seq_it; ++pi_it, ++seq_it) {
+        std::vector<bool> const core = GetCore(query_);
+        while (forest_.order.size() < query_.size) {
+            AddTree(SelectRoot(core));
         }
-        seq.insert(seq_it, pi_it, pi_new.end());
-        paths.erase(std::remove(paths.begin(), paths.end(), pi_new), paths.end());
-    }
-    return seq;
-}
 
-bool ValidateNt(model::graph_t const& graph, model::vertex_t const& v, model::graph_t const& query,
-                model::vertex_t const& u, std::vector<model::vertex_t> const& seq,
-                std::map<model::vertex_t, model::vertex_t> const& parent, Match match) {
-    int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-    for (int i = 0; i < index; ++i) {
-        if ((seq.at(i) != parent.at(u)) && boost::edge(seq.at(i), u, query).second) {
-            if (!boost::edge(*match.at(i).first, v, graph).second ||
-                graph[boost::edge(*match.at(i).first, v, graph).first].label !=
-                        query[boost::edge(seq.at(i), u, query).first].label) {
-                return false;
+        for (auto it = forest_.order.rbegin(); it != forest_.order.rend(); ++it) {
+            model::vertex_t u = *it;
+            for (CsrGraph::Neighbour const& n : query_.neighbours[u]) {
+                if (positions_[n.vertex] > positions_[u]) {
+                    Refine(u, n.vertex, n.edge_label);
+                }
             }
         }
-    }
-    return true;
-}
 
-std::vector<std::vector<model::vertex_t>> GetPaths(
-        std::set<model::vertex_t> const& indices,
-        std::map<model::vertex_t, model::vertex_t> const& parent_) {
-    std::vector<std::vector<model::vertex_t>> result = {};
-    std::map<model::vertex_t, model::vertex_t> parent(parent_);
-    std::set<model::vertex_t> to_delete = {};
-    for (auto& link : parent) {
-        if (indices.find(link.first) == indices.end()) {
-            to_delete.insert(link.first);
+        for (std::vector<model::vertex_t> const& candidates : cpi_.candidates) {
+            if (candidates.empty()) return false;
         }
-    }
-    for (auto& index : to_delete) {
-        parent.erase(index);
-    }
-    std::set<model::vertex_t> keys = {};
-    std::set<model::vertex_t> values = {};
-    for (auto& kv : parent) {
-        keys.insert(kv.first);
-        values.insert(kv.second);
-    }
-    std::set<model::vertex_t> leaves = {};
-    std::set_difference(keys.begin(), keys.end(), values.begin(), values.end(),
-                        std::inserter(leaves, leaves.begin()));
-    for (model::vertex_t const& leaf : leaves) {
-        std::vector<model::vertex_t> path = {leaf};
-        model::vertex_t cur = leaf;
-        while ((parent.find(cur) != parent.end()) &&
-               (indices.find(parent.at(cur)) != indices.end())) {
-            cur = parent.at(cur);
-            path.push_back(cur);
-        }
-        std::reverse(path.begin(), path.end());
-        result.push_back(path);
-    }
-    return result;
-}
 
-bool Visited(Match const& match, model::vertex_t const& v, std::size_t const& index) {
-    for (std::size_t i = 0; i < match.size(); ++i) {
-        if (i != index) {
-            if ((match.at(i).first != match.at(i).second) && (*match.at(i).first == v)) {
-                return true;
-            }
+        cpi_.offsets.assign(query_.size, {});
+        cpi_.children.assign(query_.size, {});
+        for (model::vertex_t u : forest_.order) {
+            BuildChildren(u);
         }
+        return true;
     }
-    return false;
-}
+};
+
+// Orders the vertices so that every vertex is matched after its parent. Among the vertices
+// whose parents are matched, the one with the most edges to the matched vertices goes first,
+// then the one with fewer candidates per candidate of the parent. Returns false if the premises
+// cannot be satisfied.
+bool MakePlan(CsrGraph const& graph, model::Gfd const& gfd, Query const& query,
+              Forest const& forest, CPI const& cpi, Plan& plan) {
+    std::vector<std::size_t> depths(query.size, kNone);
+    auto back_edges_num = [&query, &forest, &depths](model::vertex_t u) {
+        std::size_t result = 0;
+        for (CsrGraph::Neighbour const& n : query.neighbours[u]) {
+            if (n.vertex == u || depths[n.vertex] != kNone) ++result;
+        }
+        return forest.parents[u] == kNone ? result : result - 1;
+    };
+    auto branching = [&forest, &cpi](model::vertex_t u) {
+        return static_cast<double>(cpi.children[u].size()) /
+               static_cast<double>(cpi.candidates[forest.parents[u]].size());
+    };
 
-bool Satisfied(model::graph_t const& graph, model::graph_t const& query,
-               std::vector<model::vertex_t> const& seq, Match const& match,
-               std::vector<model::Gfd::Literal> const& literals) {
-    for (model::Gfd::Literal const& l : literals) {
-        auto fst_token = l.first;
-        auto snd_token = l.second;
-        std::string fst;
-        std::string snd;
-        if (fst_token.first == -1) {
-            fst = fst_token.second;
-        } else {
-            model::vertex_t v;
-            model::vertex_t u = boost::vertex(fst_token.first, query);
-            int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-            v = *match.at(index).first;
-            auto attrs = graph[v].attributes;
-            if (attrs.find(fst_token.second) == attrs.end()) {
-                return false;
-            }
-            fst = attrs.at(fst_token.second);
-        }
-        if (snd_token.first == -1) {
-            snd = snd_token.second;
-        } else {
-            model::vertex_t v;
-            model::vertex_t u = boost::vertex(snd_token.first, query);
-            int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-            v = *match.at(index).first;
-            auto attrs = graph[v].attributes;
-            if (attrs.find(snd_token.second) == attrs.end()) {
-                return false;
+    while (plan.seq.size() < query.size) {
+        model::vertex_t next = kNone;
+        for (model::vertex_t u = 0; u < query.size; ++u) {
+            if (depths[u] != kNone || forest.parents[u] == kNone ||
+                depths[forest.parents[u]] == kNone) {
+                continue;
             }
-            snd = attrs.at(snd_token.second);
-        }
-        if (fst != snd) {
-            return false;
-        }
-    }
-    return true;
-}
-
-void FullNTs(std::vector<std::vector<model::vertex_t>> const& paths,
-             std::set<model::edge_t> const& nte, model::graph_t const& query,
-             std::vector<model::vertex_t>& NTs) {
-    for (auto& path : paths) {
-        int nt = 0;
-        for (auto& desc : nte) {
-            model::vertex_t source = boost::source(desc, query);
-            model::vertex_t target = boost::target(desc, query);
-            if ((std::find(path.begin(), path.end(), source) != path.end()) ||
-                (std::find(path.begin(), path.end(), target) != path.end())) {
-                nt++;
+            if (next == kNone || back_edges_num(u) > back_edges_num(next) ||
+                (back_edges_num(u) == back_edges_num(next) && branching(u) < branching(next))) {
+                next = u;
             }
         }
-        NTs.push_back(nt);
-    }
-}
-
-void CompleteSeq(CPI& cpi, std::vector<std::set<model::vertex_t>> const& forest,
-                 std::map<model::vertex_t, model::vertex_t> const& parent,
-                 model::graph_t const& query, std::set<model::edge_t> const& nte,
-                 std::vector<model::vertex_t>& seq) {
-    for (auto& tree : forest) {
-        std::vector<std::vector<model::vertex_t>> tree_paths = GetPaths(tree, parent);
-
-        std::vector<model::vertex_t> tree_nts = {};
-        for (auto& path : tree_paths) {
-            int nt = 0;
-            for (auto& desc : nte) {
-                model::vertex_t source = boost::source(desc, query);
-                model::vertex_t target = boost::target(desc, query);
-                if ((std::find(path.begin(), path.end(), source) != path.end()) ||
-                    (std::find(path.begin(), path.end(), target) != path.end())) {
-                    nt++;
+        if (next == kNone) {
+            for (model::vertex_t u = 0; u < query.size; ++u) {
+                if (depths[u] != kNone || forest.parents[u] != kNone) continue;
+                if (next == kNone || cpi.candidates[u].size() < cpi.candidates[next].size()) {
+                    next = u;
                 }
             }
-            tree_nts.push_back(nt);
         }
-        std::vector<model::vertex_t> tree_seq = MatchingOrder(cpi, tree_paths, tree_nts);
-
-        seq.insert(seq.end(), ++tree_seq.begin(), tree_seq.end());
-    }
-}
 
-bool FullMatch(CPI& cpi, Match& match, std::set<model::vertex_t> const& root_candidates,
-               std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-               std::map<model::vertex_t, model::vertex_t> const& parent,
-               model::graph_t const& graph, model::graph_t const& query) {
-    match.emplace_back(root_candidates.begin(), root_candidates.end());
-    for (std::size_t i = 1; i < core.size(); ++i) {
-        std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(i)), seq.at(i));
-        int index = std::find(seq.begin(), seq.end(), parent.at(seq.at(i))) - seq.begin();
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                cpi.at(edge).at(*match.at(index).first).begin(),
-                cpi.at(edge).at(*match.at(index).first).end());
-        match.push_back(its);
+        std::size_t const depth = plan.seq.size();
+        std::size_t const parent = forest.parents[next];
+        plan.parent_depths.push_back(parent == kNone ? kNone : depths[parent]);
+        depths[next] = depth;
+        plan.seq.push_back(next);
 
-        while ((match.at(i).first != match.at(i).second) &&
-               (Visited(match, *match.at(i).first, i) ||
-                !ValidateNt(graph, *match.at(i).first, query, seq.at(i), seq, parent, match))) {
-            match.at(i).first++;
-        }
-        if (match.at(i).first == match.at(i).second) {
-            LOG_DEBUG("Trivially satisfied");
-            return true;
+        std::vector<std::pair<std::size_t, Id>>& back_edges = plan.back_edges.emplace_back();
+        for (CsrGraph::Neighbour const& n : query.neighbours[next]) {
+            bool const is_tree_edge =
+                    n.vertex == parent && n.edge_label == forest.tree_labels[next];
+            if (depths[n.vertex] != kNone && !is_tree_edge) {
+                back_edges.emplace_back(depths[n.vertex], n.edge_label);
+            }
         }
     }
-    for (std::size_t i = core.size(); i < seq.size(); ++i) {
-        match.emplace_back(root_candidates.end(), root_candidates.end());
-    }
-    return false;
-}
-
-void IncrementMatch(int& i, const CPI& cpi, Match& match,
-                    std::map<model::vertex_t, model::vertex_t> const& parent,
-                    std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-                    model::graph_t const& graph, model::graph_t const& query) {
-    while ((i != static_cast<int>(core.size())) && (i != -1)) {
-        if (match.at(i).first == match.at(i).second) {
-            std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(i)), seq.at(i));
-            std::size_t index =
-                    std::find(seq.begin(), seq.end(), parent.at(seq.at(i))) - seq.begin();
-            std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                    cpi.at(edge).at(*match.at(index).first).begin(),
-                    cpi.at(edge).at(*match.at(index).first).end());
-            match[i] = its;
-        } else {
-            match.at(i).first++;
-        }
 
-        while ((match.at(i).first != match.at(i).second) &&
-               (Visited(match, *match.at(i).first, i) ||
-                !ValidateNt(graph, *match.at(i).first, query, seq.at(i), seq, parent, match))) {
-            match.at(i).first++;
+    auto literal_depth = [&depths](CsrGraph::IndexedLiteral const& l) {
+        auto token_depth = [&depths](CsrGraph::IndexedToken const& token) {
+            return token.pattern_vertex == -1 ? 0 : depths[token.pattern_vertex];
         };
+        return std::max(token_depth(l.fst), token_depth(l.snd));
+    };
 
-        if (match.at(i).first == match.at(i).second) {
-            i--;
-            continue;
-        }
-        i++;
-    }
-}
-
-bool CheckTrivially(const CPI& cpi, Match& match,
-                    std::map<model::vertex_t, model::vertex_t> const& parent,
-                    std::set<model::vertex_t> const& core,
-                    std::vector<model::vertex_t> const& seq) {
-    for (std::size_t k = core.size(); k < seq.size(); ++k) {
-        std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(k)), seq.at(k));
-        std::size_t index = std::find(seq.begin(), seq.end(), parent.at(seq.at(k))) - seq.begin();
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                cpi.at(edge).at(*match.at(index).first).begin(),
-                cpi.at(edge).at(*match.at(index).first).end());
-        match[k] = its;
-
-        while ((match.at(k).first != match.at(k).second) && Visited(match, *match.at(k).first, k)) {
-            match.at(k).first++;
-        }
-        if (match.at(k).first == match.at(k).second) {
-            LOG_DEBUG("Trivially satisfied");
-            return true;
-        }
-    }
-    return false;
-}
-
-bool CheckMatch(const CPI& cpi, Match& match,
-                std::map<model::vertex_t, model::vertex_t> const& parent,
-                std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-                model::graph_t const& graph, model::graph_t const& query, model::Gfd const& gfd,
-                int& amount) {
-    while (true) {
-        std::size_t j = seq.size() - 1;
-        while ((j != seq.size()) && (j != core.size() - 1)) {
-            if (match.at(j).first == match.at(j).second) {
-                std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(j)), seq.at(j));
-                std::size_t index =
-                        std::find(seq.begin(), seq.end(), parent.at(seq.at(j))) - seq.begin();
-                std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>
-                        its(cpi.at(edge).at(*match.at(index).first).begin(),
-                            cpi.at(edge).at(*match.at(index).first).end());
-                match[j] = its;
-            } else {
-                match.at(j).first++;
-            }
-
-            while ((match.at(j).first != match.at(j).second) &&
-                   Visited(match, *match.at(j).first, j)) {
-                match.at(j).first++;
-            };
-            if (match.at(j).first == match.at(j).second) {
-                j--;
-                continue;
-            }
-            j++;
-        }
-        if (j == core.size() - 1) {
-            break;
-        }
-
-        amount++;
-        // check
-        if (!Satisfied(graph, query, seq, match, gfd.GetPremises())) {
+    plan.premises.resize(query.size);
+    for (CsrGraph::IndexedLiteral const& l : graph.IndexLiterals(gfd.GetPremises())) {
+        if (l.fst.pattern_vertex == -1 && l.snd.pattern_vertex == -1) {
+            if (!l.constants_equal) return false;
             continue;
         }
-        if (!Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
-            LOG_DEBUG("Checked embeddings: {}", amount);
-            return false;
-        }
+        plan.premises[literal_depth(l)].push_back(l);
     }
+    plan.conclusion = graph.IndexLiterals(gfd.GetConclusion());
     return true;
 }
 
-bool Check(CPI& cpi, model::graph_t const& graph, model::Gfd const& gfd,
-           std::set<model::vertex_t> const& core,
-           std::vector<std::set<model::vertex_t>> const& forest,
-           std::map<model::vertex_t, model::vertex_t> const& parent,
-           std::set<model::edge_t> const& nte) {
-    model::graph_t query = gfd.GetPattern();
-    std::vector<std::vector<model::vertex_t>> paths = GetPaths(core, parent);
-
-    std::vector<model::vertex_t> nts = {};
-    FullNTs(paths, nte, query, nts);
-    std::vector<model::vertex_t> seq = MatchingOrder(cpi, paths, nts);
-
-    CompleteSeq(cpi, forest, parent, query, nte, seq);
-
-    std::set<model::vertex_t> root_candidates = {};
-    std::pair<model::vertex_t, model::vertex_t> edge(*seq.begin(), *(++seq.begin()));
-    for (auto& vertices : cpi.at(edge)) {
-        root_candidates.insert(vertices.first);
-    }
-
-    std::vector<std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>>
-            match = {};
-
-    if (FullMatch(cpi, match, root_candidates, core, seq, parent, graph, query)) {
-        return true;
-    }
-    int amount = 1;
-    // check
-    if (Satisfied(graph, query, seq, match, gfd.GetPremises()) &&
-        !Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
-        LOG_DEBUG("Checked embeddings: {}", amount);
-        return false;
-    }
-
-    while (true) {
-        int i = static_cast<int>(core.size()) - 1;
-        IncrementMatch(i, cpi, match, parent, core, seq, graph, query);
-        if (i == -1) {
-            break;
-        }
-
-        if (forest.empty()) {
-            amount++;
-            // check
-            if (!Satisfied(graph, query, seq, match, gfd.GetPremises())) {
+// Depth-first search over the embeddings that extend a match of the first vertex of the plan
+class Matcher {
+private:
+    CsrGraph const& graph_;
+    CPI const& cpi_;
+    Plan const& plan_;
+    std::vector<model::vertex_t> mapping_;
+    std::vector<std::uint32_t> positions_;
+    std::vector<std::span<std::uint32_t const>> ranges_;
+    std::vector<std::size_t> next_;
+
+    auto Mapping() const {
+        return [this](int pattern_vertex) { return mapping_[pattern_vertex]; };
+    }
+
+    // Matches seq[depth] to its candidate at the position if it is consistent with the vertices
+    // matched before and the premises that can be checked at this depth hold
+    bool Extend(std::size_t depth, std::uint32_t position) {
+        model::vertex_t const u = plan_.seq[depth];
+        model::vertex_t const v = cpi_.candidates[u][position];
+        for (std::size_t j = 0; j < depth; ++j) {
+            if (mapping_[plan_.seq[j]] == v) return false;
+        }
+        mapping_[u] = v;
+        positions_[depth] = position;
+        for (auto const& [j, edge_label] : plan_.back_edges[depth]) {
+            if (!graph_.HasEdge(mapping_[plan_.seq[j]], v, edge_label)) return false;
+        }
+        return graph_.Satisfies(plan_.premises[depth], Mapping());
+    }
+
+    void StartLevel(std::size_t depth) {
+        std::size_t const parent_depth = plan_.parent_depths[depth];
+        std::size_t const parent_position = parent_depth == kNone ? 0 : positions_[parent_depth];
+        ranges_[depth] = cpi_.GetChildren(plan_.seq[depth], parent_position);
+        next_[depth] = 0;
+    }
+
+public:
+    Matcher(CsrGraph const& graph, CPI const& cpi, Plan const& plan)
+        : graph_(graph),
+          cpi_(cpi),
+          plan_(plan),
+          mapping_(plan.seq.size()),
+          positions_(plan.seq.size()),
+          ranges_(plan.seq.size()),
+          next_(plan.seq.size()) {}
+
+    // Returns true if an embedding with the first vertex matched to its candidate at the
+    // position satisfies the premises but not the conclusion. Stops once `stop` is set.
+    bool FindViolation(std::uint32_t root_position, std::atomic<bool> const& stop) {
+        std::size_t const size = plan_.seq.size();
+        if (!Extend(0, root_position)) return false;
+        if (size == 1) return !graph_.Satisfies(plan_.conclusion, Mapping());
+
+        std::size_t depth = 1;
+        StartLevel(depth);
+        while (depth > 0) {
+            if (stop.load(std::memory_order_relaxed)) return false;
+            if (next_[depth] == ranges_[depth].size()) {
+                --depth;
                 continue;
             }
-            if (!Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
-                LOG_DEBUG("Checked embeddings: {}", amount);
-                return false;
+            if (!Extend(depth, ranges_[depth][next_[depth]++])) continue;
+            if (depth + 1 == size) {
+                if (!graph_.Satisfies(plan_.conclusion, Mapping())) return true;
+                continue;
             }
-            continue;
-        }
-
-        if (CheckTrivially(cpi, match, parent, core, seq)) {
-            return true;
-        }
-
-        if (!CheckMatch(cpi, match, parent, core, seq, graph, query, gfd, amount)) {
-            return false;
+            StartLevel(++depth);
         }
+        return false;
     }
-    LOG_DEBUG("total number of embeddings: {}", amount);
-    return true;
-}
+};
 
-bool Validate(model::graph_t const& graph, model::Gfd const& gfd) {
+bool Validate(CsrGraph const& graph, model::Gfd const& gfd, config::ThreadNumType threads_num) {
     auto start_time = std::chrono::system_clock::now();
 
-    model::graph_t pat = gfd.GetPattern();
-    std::set<std::string> graph_labels = {};
-    std::set<std::string> pat_labels = {};
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        graph_labels.insert(graph[*it].attributes.at("label"));
-    }
-    for (boost::tie(it, end) = vertices(pat); it != end; ++it) {
-        pat_labels.insert(pat[*it].attributes.at("label"));
-    }
-    for (auto const& label : pat_labels) {
-        if (graph_labels.find(label) == graph_labels.end()) {
-            return true;
-        }
+    Query query;
+    if (!MakeQuery(graph, gfd.GetPattern(), query) || query.size == 0) {
+        return true;
     }
 
-    std::set<model::vertex_t> core = {};
-    std::vector<std::set<model::vertex_t>> forest = {};
-    CfDecompose(pat, core, forest);
-
-    int root = GetRoot(graph, pat, core);
-    std::vector<std::set<model::vertex_t>> levels = {};
-    std::map<model::vertex_t, model::vertex_t> parent;
-    std::set<model::edge_t> snte = {};
-    std::set<model::edge_t> nte = {};
-    BfsTree(pat, root, levels, parent, nte, snte);
-
-    std::map<model::vertex_t, std::set<model::vertex_t>> candidates;
+    Forest forest;
     CPI cpi;
-    TopDownConstruct(cpi, graph, pat, levels, parent, candidates, snte);
-    BottomUpRefinement(cpi, graph, pat, levels, parent, candidates);
+    Plan plan;
+    if (!CpiBuilder(graph, query, forest, cpi).Build() ||
+        !MakePlan(graph, gfd, query, forest, cpi, plan)) {
+        return true;
+    }
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
-
     LOG_DEBUG("CPI constructed in {}. Matching...", elapsed_milliseconds.count());
-    return Check(cpi, graph, gfd, core, forest, parent, nte);
+
+    // Threads take root candidates one by one, so a thread that is done with a cheap root
+    // proceeds to the next one instead of waiting for the others
+    std::size_t const roots_num = cpi.candidates[plan.seq.front()].size();
+    std::atomic<std::size_t> next_root = 0;
+    std::atomic<bool> violated = false;
+    auto worker = [&](config::ThreadNumType) {
+        Matcher matcher(graph, cpi, plan);
+        while (!violated.load(std::memory_order_relaxed)) {
+            std::size_t const root = next_root.fetch_add(1, std::memory_order_relaxed);
+            if (root >= roots_num) return;
+            if (matcher.FindViolation(root, violated)) {
+                violated = true;
+            }
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num, worker);
+    return !violated;
 }
 
 }  // namespace
 
 namespace algos {
 
+EGfdValidator::EGfdValidator() : GfdHandler() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
 std::vector<model::Gfd> EGfdValidator::GenerateSatisfiedGfds(model::graph_t const& graph,
                                                              std::vector<model::Gfd> const& gfds) {
+    // The index of graph_ is built when it is loaded
+    model::CsrGraph const other_csr_graph =
+            &graph == &graph_ ? model::CsrGraph() : model::CsrGraph(graph);
+    model::CsrGraph const& csr_graph = &graph == &graph_ ? csr_graph_ : other_csr_graph;
+    std::vector<model::Gfd> satisfied;
     for (auto& gfd : gfds) {
-        if (Validate(graph, gfd)) {
-            result_.push_back(gfd);
+        if (Validate(csr_graph, gfd, threads_num_)) {
+            satisfied.push_back(gfd);
         }
     }
-    return result_;
+    return satisfied;
 }
 
 }  // namespace algos
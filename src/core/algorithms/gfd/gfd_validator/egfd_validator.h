@@ -1,23 +1,46 @@
 #pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #include "core/algorithms/gfd/gfd.h"
 #include "core/algorithms/gfd/gfd_validator/gfd_handler.h"
 #include "core/config/names_and_descriptions.h"
+#include "core/config/thread_number/type.h"
 
 namespace algos {
 
 namespace egfd_validator {
 
-using CPI = std::map<std::pair<model::vertex_t, model::vertex_t>,
-                     std::map<model::vertex_t, std::set<model::vertex_t>>>;
+// Compact path index of the candidates of the pattern vertices.
+// candidates[u] is the sorted list of graph vertices that u can be matched to. For every vertex
+// u of the BFS forest of the pattern, the candidates of u adjacent to the i-th candidate of the
+// parent of u are stored in the range [offsets[u][i], offsets[u][i + 1]) of children[u] as
+// positions in candidates[u]. For the roots of the forest the only range holds all candidates.
+struct CPI {
+    std::vector<std::vector<model::vertex_t>> candidates;
+    std::vector<std::vector<std::size_t>> offsets;
+    std::vector<std::vector<std::uint32_t>> children;
+
+    std::span<std::uint32_t const> GetChildren(model::vertex_t u,
+                                               std::size_t parent_position) const noexcept {
+        std::vector<std::uint32_t> const& u_children = children[u];
+        return {u_children.data() + offsets[u][parent_position],
+                u_children.data() + offsets[u][parent_position + 1]};
+    }
+};
 
 }  // namespace egfd_validator
 
 class EGfdValidator : public GfdHandler {
+private:
+    config::ThreadNumType threads_num_ = 1;
+
 public:
     std::vector<model::Gfd> GenerateSatisfiedGfds(model::graph_t const& graph,
                                                   std::vector<model::Gfd> const& gfds);
 
-    EGfdValidator() : GfdHandler() {};
+    EGfdValidator();
 
     EGfdValidator(model::graph_t graph_, std::vector<model::Gfd> gfds_)
         : GfdHandler(graph_, gfds_) {}
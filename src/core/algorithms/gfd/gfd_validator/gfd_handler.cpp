@@ -36,6 +36,7 @@ void GfdHandler::LoadDataInternal() {
     std::ifstream f(graph_path_);
     graph_ = parser::graph_parser::ReadGraph(f);
     f.close();
+    csr_graph_ = model::CsrGraph(graph_);
     for (auto const& path : gfd_paths_) {
         auto gfd_path = path;
         f.open(gfd_path);
@@ -45,7 +46,9 @@ void GfdHandler::LoadDataInternal() {
     }
 }
 
-void GfdHandler::ResetState() {}
+void GfdHandler::ResetState() {
+    result_.clear();
+}
 
 unsigned long long GfdHandler::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
@@ -2,6 +2,7 @@
 #include <vector>
 
 #include "core/algorithms/algorithm.h"
+#include "core/algorithms/gfd/csr_graph.h"
 #include "core/algorithms/gfd/gfd.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/parser/graph_parser/graph_parser.h"
@@ -14,6 +15,8 @@ protected:
     std::vector<std::filesystem::path> gfd_paths_;
 
     model::graph_t graph_;
+    // Read-only index of graph_ used by the matchers, built once the graph is loaded
+    model::CsrGraph csr_graph_;
     std::vector<model::Gfd> gfds_;
     std::vector<model::Gfd> result_;
 
@@ -31,7 +34,7 @@ public:
     GfdHandler();
 
     GfdHandler(model::graph_t graph_, std::vector<model::Gfd> gfds_)
-        : Algorithm(), graph_(graph_), gfds_(gfds_) {
+        : Algorithm(), graph_(graph_), csr_graph_(this->graph_), gfds_(gfds_) {
         ExecutePrepare();
     }
 
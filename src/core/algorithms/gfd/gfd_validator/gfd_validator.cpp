@@ -1,12 +1,15 @@
 #include "core/algorithms/gfd/gfd_validator/gfd_validator.h"
 
+#include <algorithm>
 #include <iostream>
 #include <set>
+#include <span>
 #include <thread>
 
 #include <boost/graph/eccentricity.hpp>
 #include <boost/graph/exterior_property.hpp>
 #include <boost/graph/floyd_warshall_shortest.hpp>
+#include <boost/graph/iteration_macros.hpp>
 #include <boost/graph/vf2_sub_graph_iso.hpp>
 
 #include "core/algorithms/gfd/gfd_validator/balancer.h"
@@ -52,16 +55,10 @@ std::vector<std::vector<model::vertex_t>> GetPartition(
     return result;
 }
 
-std::vector<model::vertex_t> GetCandidates(model::graph_t const& graph, std::string const& label) {
-    std::vector<model::vertex_t> result = {};
-
-    BGL_FORALL_VERTICES_T(v, graph, model::graph_t) {
-        if (graph[v].attributes.at("label") == label) {
-            result.push_back(v);
-        }
-    }
-
-    return result;
+std::vector<model::vertex_t> GetCandidates(model::CsrGraph const& graph, std::string const& label) {
+    std::span<model::vertex_t const> candidates =
+            graph.GetVerticesWithLabel(graph.FindValue(label));
+    return {candidates.begin(), candidates.end()};
 }
 
 model::vertex_t GetCenter(model::graph_t const& pattern, int& radius) {
@@ -106,39 +103,45 @@ model::vertex_t GetCenter(model::graph_t const& pattern, int& radius) {
     return result;
 }
 
-void CalculateMessages(model::graph_t const& graph,
+void CalculateMessages(model::CsrGraph const& graph,
                        std::vector<gfd_validator::Request> const& requests,
                        std::map<int, std::vector<gfd_validator::Message>>& weighted_messages) {
+    std::vector<bool> in_ball(graph.NumVertices(), false);
+    std::vector<model::vertex_t> ball_neighbours;
     for (gfd_validator::Request const& request : requests) {
         int gfd_index = std::get<0>(request);
         model::vertex_t center = std::get<1>(request);
         int radius = std::get<2>(request);
         std::vector<model::vertex_t> candidates = std::get<3>(request);
         for (model::vertex_t const& candidate : candidates) {
-            std::set<model::vertex_t> vertices = {candidate};
-            std::set<model::vertex_t> current = {candidate};
+            std::vector<model::vertex_t> vertices = {candidate};
+            in_ball[candidate] = true;
+            std::size_t level_begin = 0;
             for (int i = 0; i < radius; ++i) {
-                std::set<model::vertex_t> temp = {};
-                for (auto& v : current) {
-                    typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
-                            adjacency_end;
-                    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-                    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-                        if (vertices.find(*adjacency_it) == vertices.end()) {
-                            vertices.insert(*adjacency_it);
-                            temp.insert(*adjacency_it);
+                std::size_t const level_end = vertices.size();
+                for (std::size_t j = level_begin; j < level_end; ++j) {
+                    for (model::CsrGraph::Neighbour const& n : graph.GetNeighbours(vertices[j])) {
+                        if (!in_ball[n.vertex]) {
+                            in_ball[n.vertex] = true;
+                            vertices.push_back(n.vertex);
                         }
                     }
                 }
-                current = temp;
+                level_begin = level_end;
             }
+            // The number of vertices plus the number of ordered pairs of adjacent vertices
             int weight = vertices.size();
-            for (auto& v : vertices) {
-                for (auto& u : vertices) {
-                    if (boost::edge(v, u, graph).second) {
-                        weight++;
-                    }
+            for (model::vertex_t v : vertices) {
+                ball_neighbours.clear();
+                for (model::CsrGraph::Neighbour const& n : graph.GetNeighbours(v)) {
+                    if (in_ball[n.vertex]) ball_neighbours.push_back(n.vertex);
                 }
+                std::sort(ball_neighbours.begin(), ball_neighbours.end());
+                weight += std::unique(ball_neighbours.begin(), ball_neighbours.end()) -
+                          ball_neighbours.begin();
+            }
+            for (model::vertex_t v : vertices) {
+                in_ball[v] = false;
             }
             gfd_validator::Message message(gfd_index, center, candidate);
             if (weighted_messages.find(weight) != weighted_messages.end()) {
@@ -154,64 +157,31 @@ void CalculateMessages(model::graph_t const& graph,
 class CheckCallback {
 private:
     model::graph_t const& query_;
-    model::graph_t const& graph_;
-    std::vector<model::Gfd::Literal> const premises_;
-    std::vector<model::Gfd::Literal> const conclusion_;
+    model::CsrGraph const& graph_;
+    std::vector<model::CsrGraph::IndexedLiteral> const premises_;
+    std::vector<model::CsrGraph::IndexedLiteral> const conclusion_;
     bool& res_;
 
 public:
-    CheckCallback(model::graph_t const& query_, model::graph_t const& graph_,
+    CheckCallback(model::graph_t const& query_, model::CsrGraph const& graph_,
                   std::vector<model::Gfd::Literal> const& premises_,
                   std::vector<model::Gfd::Literal> const& conclusion_, bool& res_)
         : query_(query_),
           graph_(graph_),
-          premises_(premises_),
-          conclusion_(conclusion_),
+          premises_(graph_.IndexLiterals(premises_)),
+          conclusion_(graph_.IndexLiterals(conclusion_)),
           res_(res_) {}
 
     template <typename CorrespondenceMap1To2, typename CorrespondenceMap2To1>
     bool operator()(CorrespondenceMap1To2 f, CorrespondenceMap2To1) const {
-        auto satisfied = [this, &f](std::vector<model::Gfd::Literal> const literals) {
-            for (model::Gfd::Literal const& l : literals) {
-                auto fst_token = l.first;
-                auto snd_token = l.second;
-                std::string fst;
-                std::string snd;
-                if (fst_token.first == -1) {
-                    fst = fst_token.second;
-                } else {
-                    model::vertex_t v;
-                    model::vertex_t u = boost::vertex(fst_token.first, query_);
-                    v = boost::get(f, u);
-                    auto attrs = graph_[v].attributes;
-                    if (attrs.find(fst_token.second) == attrs.end()) {
-                        return false;
-                    }
-                    fst = attrs.at(fst_token.second);
-                }
-                if (snd_token.first == -1) {
-                    snd = snd_token.second;
-                } else {
-                    model::vertex_t v;
-                    model::vertex_t u = boost::vertex(snd_token.first, query_);
-                    v = boost::get(f, u);
-                    auto attrs = graph_[v].attributes;
-                    if (attrs.find(snd_token.second) == attrs.end()) {
-                        return false;
-                    }
-                    snd = attrs.at(snd_token.second);
-                }
-                if (fst != snd) {
-                    return false;
-                }
-            }
-            return true;
+        auto mapping = [this, &f](int pattern_vertex) {
+            return boost::get(f, boost::vertex(pattern_vertex, query_));
         };
 
-        if (!satisfied(premises_)) {
+        if (!graph_.Satisfies(premises_, mapping)) {
             return true;
         }
-        if (!satisfied(conclusion_)) {
+        if (!graph_.Satisfies(conclusion_, mapping)) {
             res_ = false;
             return false;
         }
@@ -220,8 +190,9 @@ public:
 };
 
 struct VCompare {
-    model::graph_t const& pattern;
-    model::graph_t const& graph;
+    // Labels of the pattern vertices as ids of the graph
+    std::vector<model::CsrGraph::Id> const& pattern_labels;
+    model::CsrGraph const& graph;
     model::vertex_t pinted_fr;
     model::vertex_t pinted_to;
 
@@ -232,7 +203,8 @@ struct VCompare {
         if (fr == pinted_fr || to == pinted_to) {
             return false;
         }
-        return pattern[fr].attributes.at("label") == graph[to].attributes.at("label");
+        return pattern_labels[fr] != model::CsrGraph::kNoId &&
+               pattern_labels[fr] == graph.GetLabel(to);
     }
 };
 
@@ -245,7 +217,7 @@ struct ECompare {
     }
 };
 
-void CalculateUnsatisfied(model::graph_t const& graph,
+void CalculateUnsatisfied(model::graph_t const& graph, model::CsrGraph const& csr_graph,
                           std::vector<gfd_validator::Message> const& messages,
                           std::map<int, model::Gfd> const& indexed_gfds,
                           std::set<int>& unsatisfied) {
@@ -261,11 +233,16 @@ void CalculateUnsatisfied(model::graph_t const& graph,
         model::Gfd gfd = indexed_gfds.at(gfd_index);
         model::graph_t pattern = gfd.GetPattern();
 
-        VCompare vcompare{pattern, graph, u, v};
+        std::vector<model::CsrGraph::Id> pattern_labels;
+        BGL_FORALL_VERTICES_T(w, pattern, model::graph_t) {
+            pattern_labels.push_back(csr_graph.FindValue(pattern[w].attributes.at("label")));
+        }
+        VCompare vcompare{pattern_labels, csr_graph, u, v};
         ECompare ecompare{pattern, graph};
 
         bool satisfied = true;
-        CheckCallback callback(pattern, graph, gfd.GetPremises(), gfd.GetConclusion(), satisfied);
+        CheckCallback callback(pattern, csr_graph, gfd.GetPremises(), gfd.GetConclusion(),
+                               satisfied);
 
         boost::vf2_subgraph_iso(pattern, graph, callback, boost::get(boost::vertex_index, pattern),
                                 boost::get(boost::vertex_index, graph),
@@ -287,6 +264,11 @@ GfdValidator::GfdValidator() : GfdHandler() {
 
 std::vector<model::Gfd> GfdValidator::GenerateSatisfiedGfds(model::graph_t const& graph,
                                                             std::vector<model::Gfd> const& gfds) {
+    // The index of graph_ is built when it is loaded
+    model::CsrGraph const other_csr_graph =
+            &graph == &graph_ ? model::CsrGraph() : model::CsrGraph(graph);
+    model::CsrGraph const& csr_graph = &graph == &graph_ ? csr_graph_ : other_csr_graph;
+
     std::vector<std::vector<gfd_validator::Request>> requests = {};
     for (int i = 0; i < threads_num_; ++i) {
         std::vector<gfd_validator::Request> empty = {};
@@ -299,7 +281,7 @@ std::vector<model::Gfd> GfdValidator::GenerateSatisfiedGfds(model::graph_t const
         int radius = 0;
         model::vertex_t center = GetCenter(gfd.GetPattern(), radius);
         std::vector<model::vertex_t> candidates =
-                GetCandidates(graph, gfd.GetPattern()[center].attributes.at("label"));
+                GetCandidates(csr_graph, gfd.GetPattern()[center].attributes.at("label"));
         auto partition = GetPartition(candidates, threads_num_);
         for (std::size_t i = 0; i < partition.size(); ++i) {
             if (!partition.at(i).empty()) {
@@ -319,7 +301,7 @@ std::vector<model::Gfd> GfdValidator::GenerateSatisfiedGfds(model::graph_t const
 
     std::vector<std::thread> threads = {};
     for (int i = 0; i < threads_num_; ++i) {
-        std::thread thrd(CalculateMessages, std::cref(graph), std::cref(requests.at(i)),
+        std::thread thrd(CalculateMessages, std::cref(csr_graph), std::cref(requests.at(i)),
                          std::ref(weighted_messages.at(i)));
         threads.push_back(std::move(thrd));
     }
@@ -366,8 +348,9 @@ std::vector<model::Gfd> GfdValidator::GenerateSatisfiedGfds(model::graph_t const
     // calculate unsatisfied forall processor (vf2)
     threads.clear();
     for (int i = 0; i < threads_num_; ++i) {
-        std::thread thrd(CalculateUnsatisfied, std::cref(graph), std::cref(balanced_messages.at(i)),
-                         std::cref(indexed_gfds), std::ref(unsatisfied.at(i)));
+        std::thread thrd(CalculateUnsatisfied, std::cref(graph), std::cref(csr_graph),
+                         std::cref(balanced_messages.at(i)), std::cref(indexed_gfds),
+                         std::ref(unsatisfied.at(i)));
         threads.push_back(std::move(thrd));
     }
     for (std::thread& thrd : threads) {
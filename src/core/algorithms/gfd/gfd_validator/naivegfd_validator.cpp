@@ -123,12 +123,13 @@ namespace algos {
 
 std::vector<model::Gfd> NaiveGfdValidator::GenerateSatisfiedGfds(
         model::graph_t const& graph, std::vector<model::Gfd> const& gfds) {
+    std::vector<model::Gfd> satisfied;
     for (auto& gfd : gfds) {
         if (Validate(graph, gfd)) {
-            result_.push_back(gfd);
+            satisfied.push_back(gfd);
         }
     }
-    return result_;
+    return satisfied;
 }
 
 }  // namespace algos
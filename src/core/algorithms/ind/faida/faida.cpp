@@ -1,5 +1,9 @@
 #include "core/algorithms/ind/faida/faida.h"
 
+#include <atomic>
+#include <numeric>
+#include <unordered_map>
+
 #include "core/algorithms/ind/faida/candidate_generation/apriori_candidate_generator.h"
 #include "core/algorithms/ind/faida/inclusion_testing/combined_inclusion_tester.h"
 #include "core/config/max_arity/option.h"
@@ -8,6 +12,7 @@
 #include "core/config/thread_number/option.h"
 #include "core/model/table/column.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace algos {
 
@@ -15,13 +20,14 @@ Faida::Faida() : INDAlgorithm() {
     DESBORDANTE_OPTION_USING;
 
     RegisterOption(Option{&sample_size_, kSampleSize, kDSampleSize, 500});
+    RegisterOption(Option{&temp_dir_, kTempDirectory, kDTempDirectory, std::filesystem::path{}});
     RegisterOption(Option{&hll_accuracy_, kHllAccuracy, kDHllAccuracy, 0.001});
     RegisterOption(config::kMaxArityOpt(&max_arity_));
     RegisterOption(Option{&ignore_null_cols_, kIgnoreNullCols, kDIgnoreNullCols, false});
     RegisterOption(Option{&ignore_const_cols_, kIgnoreConstantCols, kDIgnoreConstantCols, false});
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
 
-    MakeOptionsAvailable({kSampleSize});
+    MakeOptionsAvailable({kSampleSize, kTempDirectory});
 }
 
 void Faida::MakeExecuteOptsAvailable() {
@@ -33,7 +39,10 @@ void Faida::MakeExecuteOptsAvailable() {
 void Faida::LoadINDAlgorithmDataInternal() {
     auto start_time = std::chrono::system_clock::now();
 
-    data_ = faida::Preprocessor::CreateHashedStores("Faida", input_tables_, sample_size_);
+    std::filesystem::path const temp_dir =
+            temp_dir_.empty() ? std::filesystem::current_path() / "temp" : temp_dir_;
+    data_ = faida::Preprocessor::CreateHashedStores("Faida", input_tables_, temp_dir,
+                                                    sample_size_);
 
     auto const prep_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -191,11 +200,37 @@ void Faida::InsertRows(faida::IInclusionTester::ActiveColumns const& active_colu
 
 std::vector<faida::SimpleIND> Faida::TestCandidates(std::vector<SimpleIND> const& candidates) {
     auto start_time = std::chrono::system_clock::now();
-    std::vector<SimpleIND> result;
 
-    for (SimpleIND const& candidate_ind : candidates) {
-        if (inclusion_tester_->IsIncludedIn(candidate_ind.Left(), candidate_ind.Right())) {
-            result.emplace_back(candidate_ind);
+    // Candidates with the same dependent combination are tested by the same thread
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<SimpleCC const*, size_t> group_ids;
+    for (size_t i = 0; i != candidates.size(); ++i) {
+        auto const [it, inserted] =
+                group_ids.try_emplace(candidates[i].Left().get(), groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(i);
+    }
+
+    std::vector<char> is_included(candidates.size(), false);
+    std::atomic<size_t> next_group = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (size_t i = next_group++; i < groups.size(); i = next_group++) {
+            for (size_t candidate : groups[i]) {
+                is_included[candidate] = inclusion_tester_->IsIncludedIn(
+                        candidates[candidate].Left(), candidates[candidate].Right());
+            }
+        }
+    };
+    std::vector<config::ThreadNumType> workers(number_of_threads_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), number_of_threads_, worker);
+
+    std::vector<SimpleIND> result;
+    for (size_t i = 0; i != candidates.size(); ++i) {
+        if (is_included[i]) {
+            result.emplace_back(candidates[i]);
         }
     }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <filesystem>
+
 #include "core/algorithms/ind/faida/inclusion_testing/iinclusion_tester.h"
 #include "core/algorithms/ind/faida/preprocessing/preprocessor.h"
 #include "core/algorithms/ind/faida/util/simple_ind.h"
@@ -18,6 +20,7 @@ private:
     using AbstractColumnStore = faida::AbstractColumnStore;
 
     int sample_size_;
+    std::filesystem::path temp_dir_;
     double hll_accuracy_;
     config::MaxArityType max_arity_;
     bool ignore_null_cols_;
@@ -84,14 +84,14 @@ void CombinedInclusionTester::InsertRows(IRowIterator::Block const& hashed_cols,
 #endif
 
                 for (ColumnIndex col_idx : cc->GetColumnIndices()) {
-                    IRowIterator::AlignedVector const& col_hashes_chunk =
-                            hashed_cols[col_idx].value();
+                    std::span<size_t const> const col_hashes_chunk = hashed_cols[col_idx];
 #ifdef __AVX2__
                     for (unsigned int row_offset = 0;
                          row_offset < chunk_size - chunk_size % vect_reg_size;
                          row_offset += vect_reg_size) {
-                        __m256i const hashes_vect =
-                                _mm256_load_si256((__m256i*)(&col_hashes_chunk[row_offset]));
+                        // Column hashes are read from a mapped file and may be unaligned
+                        __m256i const hashes_vect = _mm256_loadu_si256(
+                                (__m256i const*)(&col_hashes_chunk[row_offset]));
                         __m256i const comb_hashes_vect =
                                 _mm256_load_si256((__m256i*)(&combined_hashes[row_offset]));
 
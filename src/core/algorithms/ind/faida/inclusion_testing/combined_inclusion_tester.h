@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <hash_table8.hpp>
 
 #include "core/algorithms/ind/faida/inclusion_testing/hll_data.h"
@@ -17,8 +19,8 @@ private:
             hlls_by_table_;
 
     TableIndex curr_table_idx_;
-    int num_certain_checks_;
-    int num_uncertain_checks_;
+    std::atomic<int> num_certain_checks_;
+    std::atomic<int> num_uncertain_checks_;
     int max_id_;
     double error_;
     unsigned num_threads_;
@@ -45,9 +47,10 @@ private:
         return dep_hll.IsIncludedIn(ref_hll);
     }
 
-    bool TestWithHLLs(std::shared_ptr<SimpleCC> const& dep, std::shared_ptr<SimpleCC> const& ref) {
-        return TestWithHLLs(hlls_by_table_[dep->GetTableIndex()][dep],
-                            hlls_by_table_[ref->GetTableIndex()][ref]);
+    bool TestWithHLLs(std::shared_ptr<SimpleCC> const& dep,
+                      std::shared_ptr<SimpleCC> const& ref) const {
+        return TestWithHLLs(hlls_by_table_.at(dep->GetTableIndex()).find(dep)->second,
+                            hlls_by_table_.at(ref->GetTableIndex()).find(ref)->second);
     }
 
 public:
@@ -37,6 +37,10 @@
 #include <stdexcept>
 #include <vector>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #define HLL_HASH_SEED 313
 
 #if defined(__has_builtin) && (defined(__GNUC__) || defined(__clang__))
@@ -184,7 +188,22 @@ public:
 
     bool is_included_in(HyperLogLog const& other) const {
         assert(m_ == other.m_);
-        for (uint32_t r = 0; r < m_; ++r) {
+        uint32_t r = 0;
+#ifdef __AVX2__
+        // (Faida) Registers are compared 32 at a time: no register is greater than the other
+        // one iff their maximum is equal to the other one.
+        int constexpr vect_reg_size = 32;
+        for (; r + vect_reg_size <= m_; r += vect_reg_size) {
+            __m256i const regs = _mm256_loadu_si256((__m256i const*)(&M_[r]));
+            __m256i const other_regs = _mm256_loadu_si256((__m256i const*)(&other.M_[r]));
+            __m256i const cmp_res =
+                    _mm256_cmpeq_epi8(_mm256_max_epu8(regs, other_regs), other_regs);
+            if (_mm256_movemask_epi8(cmp_res) != -1) {
+                return false;
+            }
+        }
+#endif
+        for (; r < m_; ++r) {
             if (M_[r] > other.M_[r]) {
                 return false;
             }
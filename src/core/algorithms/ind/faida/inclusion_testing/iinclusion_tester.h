@@ -25,6 +25,7 @@ public:
     virtual void FinalizeInsertion() = 0;
     virtual void Initialize(std::vector<HashedTableSample> const& samples) = 0;
 
+    // Can be called from several threads at once after the insertion is finalized
     virtual bool IsIncludedIn(std::shared_ptr<SimpleCC> const& dep,
                               std::shared_ptr<SimpleCC> const& ref) = 0;
 
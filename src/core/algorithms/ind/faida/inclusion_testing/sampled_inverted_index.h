@@ -49,11 +49,12 @@ public:
         return true;
     }
 
-    bool IsCovered(std::shared_ptr<SimpleCC> const& combination) {
+    bool IsCovered(std::shared_ptr<SimpleCC> const& combination) const {
         return !non_covered_cc_indices_.test(combination->GetIndex());
     }
 
-    bool IsIncludedIn(std::shared_ptr<SimpleCC> const& a, std::shared_ptr<SimpleCC> const& b) {
+    bool IsIncludedIn(std::shared_ptr<SimpleCC> const& a,
+                      std::shared_ptr<SimpleCC> const& b) const {
         return !seen_cc_indices_.test(a->GetIndex()) ||
                discovered_inds_.find(SimpleIND(a, b)) != discovered_inds_.end();
     }
@@ -30,8 +30,7 @@ void AbstractColumnStore::LoadData(std::string const& dataset_name, TableIndex t
 std::filesystem::path AbstractColumnStore::PrepareDir(std::string const& dataset_name,
                                                       TableIndex table_idx) {
     namespace fs = std::filesystem;
-    fs::path sample_location_dir =
-            fs::current_path() / dir_name_ / dataset_name / schema_->GetName();
+    fs::path sample_location_dir = temp_dir_ / dataset_name / schema_->GetName();
 
     fs::create_directories(sample_location_dir);
 
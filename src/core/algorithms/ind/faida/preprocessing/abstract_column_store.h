@@ -20,7 +20,7 @@ public:
     using HashedTableSample = std::vector<std::vector<std::size_t>>;
 
 private:
-    std::string const dir_name_ = "temp";
+    std::filesystem::path const temp_dir_;
 
     std::filesystem::path sample_file_;
     unsigned sample_size_ = 0;
@@ -34,8 +34,8 @@ protected:
 
     size_t const null_hash_;
 
-    AbstractColumnStore(int sample_goal, size_t null_hash)
-        : sample_goal_(sample_goal), null_hash_(null_hash){};
+    AbstractColumnStore(std::filesystem::path temp_dir, int sample_goal, size_t null_hash)
+        : temp_dir_(std::move(temp_dir)), sample_goal_(sample_goal), null_hash_(null_hash){};
 
     void LoadData(std::string const& dataset_name, TableIndex table_idx,
                   model::IDatasetStream& input_data);
@@ -1,5 +1,7 @@
 #include "core/algorithms/ind/faida/preprocessing/hashed_column_store.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+
 #include "core/model/table/column.h"
 
 namespace algos::faida {
@@ -92,6 +94,7 @@ void HashedColumnStore::WriteColumnsAndSample(model::IDatasetStream& data_stream
     if (row_counter == 0) {
         throw std::runtime_error("Got an empty file: IND mining is meaningless.");
     }
+    num_rows_ = row_counter;
 
     // Write data from the last buffer
     for (ColumnIndex col_idx = 0; col_idx < schema_->GetNumColumns(); col_idx++) {
@@ -119,53 +122,47 @@ void HashedColumnStore::WriteColumnsAndSample(model::IDatasetStream& data_stream
 
 std::unique_ptr<IRowIterator> HashedColumnStore::GetRows(
         std::unordered_set<ColumnIndex> const& columns) const {
-    std::vector<std::optional<std::ifstream>> hashed_col_streams(schema_->GetNumColumns());
+    namespace bip = boost::interprocess;
+    std::vector<std::optional<bip::mapped_region>> hashed_col_regions(schema_->GetNumColumns());
 
     for (ColumnIndex col_idx : columns) {
-        hashed_col_streams[col_idx] = std::ifstream(column_files_[col_idx], std::ios::binary);
+        if (std::filesystem::file_size(column_files_[col_idx]) != num_rows_ * sizeof(size_t)) {
+            throw std::runtime_error("Hashed column file " + column_files_[col_idx].string() +
+                                     " is corrupted");
+        }
+        bip::file_mapping const file(column_files_[col_idx].string().c_str(), bip::read_only);
+        bip::mapped_region& region = hashed_col_regions[col_idx].emplace(file, bip::read_only);
+        region.advise(bip::mapped_region::advice_sequential);
     }
 
-    return std::make_unique<RowIterator>(std::move(hashed_col_streams));
+    return std::make_unique<RowIterator>(std::move(hashed_col_regions), num_rows_);
 }
 
 std::unique_ptr<AbstractColumnStore> HashedColumnStore::CreateFrom(
         std::string const& dataset_name, TableIndex table_idx, model::IDatasetStream& input_data,
-        int sample_goal, size_t null_hash) {
-    auto store = std::make_unique<HashedColumnStore>(
-            HashedColumnStore(input_data.GetNumberOfColumns(), sample_goal, null_hash));
+        std::filesystem::path const& temp_dir, int sample_goal, size_t null_hash) {
+    auto store = std::make_unique<HashedColumnStore>(HashedColumnStore(
+            input_data.GetNumberOfColumns(), temp_dir, sample_goal, null_hash));
     store->LoadData(dataset_name, table_idx, input_data);
 
     return store;
 }
 
-HashedColumnStore::RowIterator::~RowIterator() {
-    for (std::optional<std::ifstream>& column_stream : hashed_col_streams_) {
-        if (column_stream.has_value()) {
-            column_stream->close();
-        }
-    }
-}
-
 bool HashedColumnStore::RowIterator::HasNextBlock() {
-    if (!has_next_) return false;
+    if (next_row_ == num_rows_) return false;
 
-    curr_block_size_ = default_block_size_;
-    Block row_hashes_inv(hashed_col_streams_.size());
+    curr_block_size_ = std::min(kDefaultBlockSize, num_rows_ - next_row_);
 
     ColumnIndex col_idx = 0;
-    for (std::optional<std::ifstream>& column_stream : hashed_col_streams_) {
-        if (column_stream.has_value()) {
-            row_hashes_inv[col_idx] = AlignedVector(default_block_size_);
-            if (!column_stream->read(reinterpret_cast<char*>(row_hashes_inv[col_idx]->data()),
-                                     default_block_size_ * sizeof(size_t))) {
-                has_next_ = false;
-                curr_block_size_ = column_stream->gcount() / sizeof(size_t);
-            }
+    for (std::optional<boost::interprocess::mapped_region> const& region : hashed_col_regions_) {
+        if (region.has_value()) {
+            auto const* hashes = static_cast<size_t const*>(region->get_address());
+            curr_block_[col_idx] = {hashes + next_row_, curr_block_size_};
         }
         ++col_idx;
     }
 
-    curr_block_ = std::move(row_hashes_inv);
+    next_row_ += curr_block_size_;
     return true;
 }
 
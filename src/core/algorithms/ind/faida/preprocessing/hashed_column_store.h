@@ -1,28 +1,35 @@
 #pragma once
 
+#include <boost/interprocess/mapped_region.hpp>
+
 #include "core/algorithms/ind/faida/preprocessing/abstract_column_store.h"
 
 namespace algos::faida {
 
+// Hashes of the values of every column are stored in a binary file of their own. The files are
+// memory-mapped when rows are requested, so blocks of rows are handed out without copying.
 class HashedColumnStore : public AbstractColumnStore {
 private:
     class RowIterator : public IRowIterator {
     private:
-        int const default_block_size_ = 65536;
-        std::vector<std::optional<std::ifstream>> hashed_col_streams_;
+        static constexpr size_t kDefaultBlockSize = 65536;
+        std::vector<std::optional<boost::interprocess::mapped_region>> hashed_col_regions_;
+        size_t const num_rows_;
+        size_t next_row_;
         Block curr_block_;
         size_t curr_block_size_;
-        bool has_next_;
 
     public:
-        explicit RowIterator(std::vector<std::optional<std::ifstream>>&& hashed_columns)
-            : hashed_col_streams_(std::move(hashed_columns)),
-              curr_block_size_(0),
-              has_next_(true) {}
+        RowIterator(std::vector<std::optional<boost::interprocess::mapped_region>>&& hashed_columns,
+                    size_t num_rows)
+            : hashed_col_regions_(std::move(hashed_columns)),
+              num_rows_(num_rows),
+              next_row_(0),
+              curr_block_(hashed_col_regions_.size()),
+              curr_block_size_(0) {}
 
         RowIterator(RowIterator const& other) = delete;
         RowIterator& operator=(RowIterator const& other) = delete;
-        ~RowIterator() override;
 
         bool HasNextBlock() override;
 
@@ -35,9 +42,12 @@ private:
 
     int const read_buff_size_ = 65536;
     std::vector<std::filesystem::path> column_files_;
+    size_t num_rows_ = 0;
 
-    HashedColumnStore(unsigned num_of_columns, int sample_goal, size_t null_hash)
-        : AbstractColumnStore(sample_goal, null_hash), column_files_(num_of_columns) {}
+    HashedColumnStore(unsigned num_of_columns, std::filesystem::path temp_dir, int sample_goal,
+                      size_t null_hash)
+        : AbstractColumnStore(std::move(temp_dir), sample_goal, null_hash),
+          column_files_(num_of_columns) {}
 
     std::filesystem::path PrepareDirNext(std::filesystem::path dir, TableIndex table_idx) override;
 
@@ -52,6 +62,7 @@ public:
     static std::unique_ptr<AbstractColumnStore> CreateFrom(std::string const& dataset_name,
                                                            TableIndex table_idx,
                                                            model::IDatasetStream& data_stream,
+                                                           std::filesystem::path const& temp_dir,
                                                            int sample_goal, size_t null_hash);
 };
 
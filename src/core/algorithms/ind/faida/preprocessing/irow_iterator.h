@@ -1,7 +1,7 @@
 #pragma once
 
 #include <iterator>
-#include <optional>
+#include <span>
 #include <vector>
 
 #include <boost/align/aligned_allocator.hpp>
@@ -11,7 +11,9 @@ namespace algos::faida {
 class IRowIterator {
 public:
     using AlignedVector = std::vector<size_t, boost::alignment::aligned_allocator<size_t, 32>>;
-    using Block = std::vector<std::optional<AlignedVector>>;
+    // Hashes of the values of a block of rows, column by column. Columns which were not requested
+    // have empty spans. The spans are valid until the next call to HasNextBlock.
+    using Block = std::vector<std::span<size_t const>>;
 
     virtual bool HasNextBlock() = 0;
     virtual size_t GetBlockSize() const = 0;
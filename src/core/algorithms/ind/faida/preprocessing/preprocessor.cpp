@@ -8,7 +8,8 @@ namespace algos::faida {
 
 std::unique_ptr<Preprocessor> Preprocessor::CreateHashedStores(
         std::string const& dataset_name,
-        std::vector<std::shared_ptr<model::IDatasetStream>> const& data_streams, int sample_goal) {
+        std::vector<std::shared_ptr<model::IDatasetStream>> const& data_streams,
+        std::filesystem::path const& temp_dir, int sample_goal) {
     assert(!data_streams.empty());
 
     std::vector<std::unique_ptr<AbstractColumnStore>> stores;
@@ -19,7 +20,7 @@ std::unique_ptr<Preprocessor> Preprocessor::CreateHashedStores(
     TableIndex table_idx = 0;
     for (std::shared_ptr<model::IDatasetStream> const& input_data : data_streams) {
         auto store = HashedColumnStore::CreateFrom(dataset_name, table_idx++, *input_data,
-                                                   sample_goal, null_hash);
+                                                   temp_dir, sample_goal, null_hash);
         stores.emplace_back(std::move(store));
     }
 
@@ -32,7 +32,7 @@ public:
     static std::unique_ptr<Preprocessor> CreateHashedStores(
             std::string const& dataset_name,
             std::vector<std::shared_ptr<model::IDatasetStream>> const& data_streams,
-            int sample_goal);
+            std::filesystem::path const& temp_dir, int sample_goal);
 };
 
 }  // namespace algos::faida
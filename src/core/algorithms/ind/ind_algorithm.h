@@ -10,6 +10,7 @@
 #include "core/config/tabular_data/input_tables_type.h"
 #include "core/model/table/relational_schema.h"
 #include "core/util/primitive_collection.h"
+#include "core/util/primitive_sink.h"
 
 namespace algos {
 
@@ -19,7 +20,6 @@ public:
 
 private:
     util::PrimitiveCollection<IND> ind_collection_;
-    std::shared_ptr<std::vector<std::unique_ptr<RelationalSchema>>> schemas_;
 
     void LoadDataInternal() final;
 
@@ -30,10 +30,15 @@ private:
         ResetINDAlgorithmState();
     }
 
+    void FlushResults() final {
+        ind_collection_.Flush();
+    }
+
     virtual void ResetINDAlgorithmState() = 0;
 
 protected:
     config::InputTables input_tables_;
+    std::shared_ptr<std::vector<std::unique_ptr<RelationalSchema>>> schemas_;
 
     explicit INDAlgorithm();
 
@@ -54,9 +59,14 @@ protected:
     }
 
 public:
-    std::list<IND> const& INDList() const noexcept {
+    std::list<IND> const& INDList() const {
         return ind_collection_.AsList();
     }
+
+    // Found INDs are passed to the sink instead of INDList, nullptr returns to the default
+    void SetIndSink(std::shared_ptr<util::PrimitiveSink<IND>> sink) {
+        ind_collection_.SetSink(std::move(sink));
+    }
 };
 
 }  // namespace algos
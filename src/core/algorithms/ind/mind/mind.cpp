@@ -6,6 +6,9 @@
 #include "core/algorithms/ind/mind/mind.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "core/algorithms/create_algorithm.h"
@@ -15,18 +18,20 @@
 #include "core/config/max_arity/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_combination.h"
-#include "core/model/table/dataset_stream_fixed.h"
-#include "core/model/table/dataset_stream_projection.h"
+#include "core/util/metrics.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos {
 
 Mind::Mind() : INDAlgorithm() {
-    MakeLoadOptsAvailable();
-
     RegisterOption(config::kErrorOpt(&max_ind_error_));
     RegisterOption(config::kMaxArityOpt(&max_arity_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+
+    MakeLoadOptsAvailable();
 }
 
 void Mind::MakeLoadOptsAvailable() {
@@ -35,6 +40,8 @@ void Mind::MakeLoadOptsAvailable() {
      * In the future we should give the user the ability to choose the algorithm.
      */
     auind_algo_ = CreateAlgorithmInstance<INDAlgorithm>(AlgorithmType::spider);
+    /* The option is shared with the unary algorithm, both get the same value. */
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Mind::MakeExecuteOptsAvailable() {
@@ -59,7 +66,21 @@ bool Mind::ExternalOptionIsRequired(std::string_view option_name) const {
 }
 
 void Mind::LoadINDAlgorithmDataInternal() {
-    timings_.load = util::TimedInvoke(&Algorithm::LoadData, auind_algo_);
+    timings_.load = util::TimedInvoke(&Algorithm::LoadData, auind_algo_) +
+                    util::TimedInvoke(&Mind::EncodeTables, this);
+}
+
+/*
+ * Read all the tables once, so that candidates are tested without parsing them again.
+ */
+void Mind::EncodeTables() {
+    DESBORDANTE_METRICS_PHASE("encode_tables");
+    mind::ValueDictionary dictionary;
+    encoded_tables_.clear();
+    for (config::InputTable const& table : input_tables_) {
+        table->Reset();
+        encoded_tables_.push_back(dictionary.Encode(*table));
+    }
 }
 
 void Mind::AddSpecificNeededOptions(std::unordered_set<std::string_view>& previous_options) const {
@@ -143,55 +164,35 @@ std::optional<RawIND> GetCandidateIfValid(model::IND const& p, model::IND const&
     return candidate;
 }
 
-/*
- * Firstly, skip rows with incorrect count of values.
- * Secondly, project stream on the provided column indices.
- */
-using DatasetStreamFixedProjection = model::DatasetStreamProjection<model::DatasetStreamFixed<>>;
-
-using Row = DatasetStreamFixedProjection::Row;
-using HashSet = std::unordered_set<Row, boost::hash<Row>>;
-
-HashSet CreateHashSet(DatasetStreamFixedProjection&& stream) {
-    HashSet hash_container;
-
-    while (stream.HasNextRow()) {
-        hash_container.insert(stream.GetNextRow());
+struct ColumnCombinationHash {
+    size_t operator()(model::ColumnCombination const& cc) const {
+        return cc.GetHash();
     }
-
-    return hash_container;
-}
+};
 
 }  // namespace
 }  // namespace mind
 
-std::optional<config::ErrorType> Mind::TestCandidate(RawIND const& raw_ind) {
-    using namespace mind;
-
-    auto const create_projected_stream = [&](model::ColumnCombination const& cc) {
-        config::InputTable const& table = input_tables_[cc.GetTableIndex()];
-        table->Reset();
-        return DatasetStreamFixedProjection{table, cc.GetColumnIndices()};
-    };
-
-    HashSet const rhs_hash_set{CreateHashSet(create_projected_stream(raw_ind.rhs))};
+std::optional<config::ErrorType> Mind::TestCandidate(
+        RawIND const& raw_ind, mind::ProjectionIndex const& rhs_index) const {
+    mind::EncodedTable const& lhs_table = encoded_tables_[raw_ind.lhs.GetTableIndex()];
+    std::vector<model::ColumnIndex> const& rhs_columns = raw_ind.rhs.GetColumnIndices();
 
     if (max_ind_error_ == 0) {
-        DatasetStreamFixedProjection lhs_stream = create_projected_stream(raw_ind.lhs);
-        while (lhs_stream.HasNextRow()) {
-            if (!rhs_hash_set.contains(lhs_stream.GetNextRow())) {
+        for (model::TupleIndex row = 0; row != lhs_table.rows_num; ++row) {
+            if (!rhs_index.Contains(lhs_table, rhs_columns, row)) {
                 return std::nullopt;
             }
         }
         return config::ErrorType{0.0};
     }
 
-    HashSet const lhs_hash_set{CreateHashSet(create_projected_stream(raw_ind.lhs))};
-    auto const lhs_cardinality = static_cast<model::TupleIndex>(lhs_hash_set.size());
+    mind::ProjectionIndex const lhs_index{lhs_table, raw_ind.lhs.GetColumnIndices()};
+    auto const lhs_cardinality = static_cast<model::TupleIndex>(lhs_index.Size());
     model::TupleIndex const disqualify_row_limit = std::floor(lhs_cardinality * max_ind_error_) + 1;
     model::TupleIndex disqualify_row_count = 0;
-    for (Row const& row : lhs_hash_set) {
-        if (!rhs_hash_set.contains(row)) {
+    for (model::TupleIndex row : lhs_index.GetRepresentatives()) {
+        if (!rhs_index.Contains(lhs_table, rhs_columns, row)) {
             ++disqualify_row_count;
             if (disqualify_row_count == disqualify_row_limit) {
                 assert(static_cast<config::ErrorType>(disqualify_row_count) / lhs_cardinality >
@@ -208,15 +209,48 @@ std::optional<config::ErrorType> Mind::TestCandidate(RawIND const& raw_ind) {
         return std::nullopt;
 }
 
+std::vector<std::optional<config::ErrorType>> Mind::TestCandidates(
+        std::vector<RawIND> const& candidates) const {
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<model::ColumnCombination, size_t, mind::ColumnCombinationHash> group_ids;
+    for (size_t i = 0; i != candidates.size(); ++i) {
+        auto const [it, inserted] = group_ids.try_emplace(candidates[i].rhs, groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(i);
+    }
+
+    std::vector<std::optional<config::ErrorType>> errors(candidates.size());
+    std::atomic<size_t> next_group = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (size_t i = next_group++; i < groups.size(); i = next_group++) {
+            model::ColumnCombination const& rhs = candidates[groups[i].front()].rhs;
+            mind::ProjectionIndex const rhs_index{encoded_tables_[rhs.GetTableIndex()],
+                                                  rhs.GetColumnIndices()};
+            for (size_t candidate : groups[i]) {
+                errors[candidate] = TestCandidate(candidates[candidate], rhs_index);
+            }
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+    return errors;
+}
+
 /*
  * Mine unary INDs.
  *
  * Redirect call to the algorithm for mining unary dependencies, then register dependencies.
  */
 void Mind::MineUnaryINDs() {
+    DESBORDANTE_METRICS_PHASE("compute_uinds");
     auind_algo_->Execute();
+    level_inds_.clear();
     for (const IND& ind : auind_algo_->INDList()) {
         RegisterIND(ind);
+        level_inds_.push_back(ind);
     }
 }
 
@@ -224,15 +258,14 @@ void Mind::MineUnaryINDs() {
  * Mine n-ary INDs.
  */
 void Mind::MineNaryINDs() {
+    DESBORDANTE_METRICS_PHASE("compute_ninds");
     /* Current lattice level candidates. */
     std::vector<RawIND> candidates;
     /*
-     * Iterator to the first element in the `INDList()` with previous level arity.
-     * It's guaranteed (at the start of the loop), that range [`prev_it`, `INDList().end()`)
-     * contains all elements with this arity, so we can avoid going through the entire `INDList()`
-     * with arity check.
+     * INDs found on the current lattice level. `INDList()` is not used for this, since registered
+     * INDs may be passed to a sink instead.
      */
-    auto prev_it = INDList().begin();
+    std::vector<IND> next_level_inds;
     /*
      * Set of raw inds, that were found on the previous lattice level.
      * Note, that we do not populate this set for unary dependencies, since this
@@ -245,9 +278,9 @@ void Mind::MineNaryINDs() {
      * Stop INDs mining if no new dependencies were found at the previous lattice level
      * (from this condition it follows that no more dependencies can be found).
      */
-    while (prev_it != INDList().end() && INDList().back().GetArity() != max_arity_) {
-        for (auto p_it = prev_it; p_it != INDList().end(); ++p_it) {
-            std::for_each(std::next(p_it), INDList().end(), [&](const IND& q) {
+    while (!level_inds_.empty() && level_inds_.back().GetArity() != max_arity_) {
+        for (auto p_it = level_inds_.begin(); p_it != level_inds_.end(); ++p_it) {
+            std::for_each(std::next(p_it), level_inds_.end(), [&](const IND& q) {
                 std::optional<RawIND> candidate_opt =
                         mind::GetCandidateIfValid(*p_it, q, prev_raw_inds);
                 if (candidate_opt) {
@@ -256,18 +289,26 @@ void Mind::MineNaryINDs() {
             });
         }
 
-        prev_it = std::prev(INDList().end()); /*< last element of the previous lattice level */
         prev_raw_inds.clear();
-        for (RawIND const& candidate : candidates) {
-            if (auto error_opt = TestCandidate(candidate)) {
-                RegisterIND(candidate.lhs, candidate.rhs, error_opt.value());
+        DESBORDANTE_METRICS_COUNT("tested_candidates", candidates.size());
+        std::vector<std::optional<config::ErrorType>> const errors = TestCandidates(candidates);
+        for (size_t i = 0; i != candidates.size(); ++i) {
+            RawIND const& candidate = candidates[i];
+            if (std::optional<config::ErrorType> const& error_opt = errors[i]) {
+                IND ind{std::make_shared<model::ColumnCombination>(candidate.lhs),
+                        std::make_shared<model::ColumnCombination>(candidate.rhs),
+                        schemas_, error_opt.value()};
+                RegisterIND(ind);
+                next_level_inds.push_back(std::move(ind));
                 prev_raw_inds.insert(candidate);
             }
         }
         candidates.clear();
 
-        ++prev_it; /*< first element of the current lattice level or `INDList().end()` */
+        level_inds_ = std::move(next_level_inds);
+        next_level_inds.clear();
     };
+    level_inds_.clear();
 }
 
 unsigned long long Mind::ExecuteInternal() {
@@ -7,11 +7,14 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "core/algorithms/ind/ind_algorithm.h"
+#include "core/algorithms/ind/mind/projection_index.h"
 #include "core/algorithms/ind/mind/raw_ind.h"
 #include "core/config/error/type.h"
 #include "core/config/max_arity/type.h"
+#include "core/config/thread_number/type.h"
 
 namespace algos {
 
@@ -33,9 +36,14 @@ private:
     /* configuration stage fields */
     config::ErrorType max_ind_error_ = 0;
     config::MaxArityType max_arity_;
+    config::ThreadNumType threads_num_ = 1;
+
+    /* load stage fields */
+    std::vector<mind::EncodedTable> encoded_tables_; /*< tables with dictionary-encoded values */
 
     /* execution stage fields */
     std::unique_ptr<INDAlgorithm> auind_algo_; /*< algorithm for mining unary approximate INDs*/
+    std::vector<IND> level_inds_;              /*< inds of the last mined lattice level */
     StageTimings timings_{};                   /*< timings info */
 
     void MakeLoadOptsAvailable();
@@ -47,14 +55,25 @@ private:
 
     bool ExternalOptionIsRequired(std::string_view option_name) const override;
     void LoadINDAlgorithmDataInternal() override;
+    void EncodeTables();
 
     ///
     /// Test a given IND candidate to determine if it should be registered.
     ///
+    /// \param rhs_index index of the distinct projections of the candidate's rhs
+    ///
     /// \return `std::nullopt` if the candidate should not be registered,
     ///         otherwise return the error threshold at which AIND holds.
     ///
-    std::optional<config::ErrorType> TestCandidate(RawIND const& raw_ind);
+    std::optional<config::ErrorType> TestCandidate(RawIND const& raw_ind,
+                                                   mind::ProjectionIndex const& rhs_index) const;
+
+    ///
+    /// Test all the candidates of a lattice level in parallel. Candidates with the same rhs
+    /// share the index of its projections.
+    ///
+    std::vector<std::optional<config::ErrorType>> TestCandidates(
+            std::vector<RawIND> const& candidates) const;
 
     void MineUnaryINDs();
     void MineNaryINDs();
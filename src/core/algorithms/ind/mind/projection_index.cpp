@@ -0,0 +1,70 @@
+/** \file
+ * \brief Mind algorithm
+ *
+ * Dictionary-encoded tables and the index of the distinct projections of their rows.
+ */
+#include "core/algorithms/ind/mind/projection_index.h"
+
+#include <cassert>
+
+#include "core/util/logger.h"
+
+namespace algos::mind {
+
+EncodedTable ValueDictionary::Encode(model::IDatasetStream& stream) {
+    size_t const cols_num = stream.GetNumberOfColumns();
+    EncodedTable table;
+    table.columns.resize(cols_num);
+    while (stream.HasNextRow()) {
+        std::vector<std::string> row = stream.GetNextRow();
+        if (row.size() != cols_num) {
+            LOG_WARN("Received row with size {}, but expected {}", row.size(), cols_num);
+            continue;
+        }
+        for (size_t i = 0; i != cols_num; ++i) {
+            auto const [it, inserted] =
+                    codes_.try_emplace(std::move(row[i]), static_cast<ValueCode>(codes_.size()));
+            table.columns[i].push_back(it->second);
+        }
+        ++table.rows_num;
+    }
+    return table;
+}
+
+ProjectionIndex::ProjectionIndex(EncodedTable const& table,
+                                 std::vector<model::ColumnIndex> columns)
+    : columns_(std::move(columns)) {
+    assert(columns_.size() >= 2);
+    std::vector<std::uint32_t> numbers = table.columns[columns_.front()];
+    levels_.resize(columns_.size() - 1);
+    for (size_t j = 0; j != levels_.size(); ++j) {
+        Level& level = levels_[j];
+        std::vector<ValueCode> const& column = table.columns[columns_[j + 1]];
+        bool const last = j + 1 == levels_.size();
+        for (model::TupleIndex row = 0; row != table.rows_num; ++row) {
+            auto const [it, inserted] = level.try_emplace(
+                    MakeKey(numbers[row], column[row]), static_cast<std::uint32_t>(level.size()));
+            if (last && inserted) {
+                representatives_.push_back(row);
+            }
+            numbers[row] = it->second;
+        }
+    }
+}
+
+bool ProjectionIndex::Contains(EncodedTable const& table,
+                               std::vector<model::ColumnIndex> const& columns,
+                               model::TupleIndex row) const {
+    assert(columns.size() == columns_.size());
+    std::uint32_t number = table.columns[columns.front()][row];
+    for (size_t j = 0; j != levels_.size(); ++j) {
+        auto const it = levels_[j].find(MakeKey(number, table.columns[columns[j + 1]][row]));
+        if (it == levels_[j].end()) {
+            return false;
+        }
+        number = it->second;
+    }
+    return true;
+}
+
+}  // namespace algos::mind
@@ -0,0 +1,86 @@
+/** \file
+ * \brief Mind algorithm
+ *
+ * Dictionary-encoded tables and the index of the distinct projections of their rows.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/model/table/column_index.h"
+#include "core/model/table/idataset_stream.h"
+#include "core/model/table/tuple_index.h"
+
+namespace algos::mind {
+
+/// code of a value, equal values of all the tables have equal codes
+using ValueCode = std::uint32_t;
+
+/// table stored as columns of value codes
+struct EncodedTable {
+    std::vector<std::vector<ValueCode>> columns;
+    model::TupleIndex rows_num = 0;
+};
+
+///
+/// \brief assigns codes to the values of several tables
+///
+/// \note rows with incorrect number of values are skipped, as `DatasetStreamFixed` does
+///
+class ValueDictionary {
+private:
+    std::unordered_map<std::string, ValueCode> codes_;
+
+public:
+    EncodedTable Encode(model::IDatasetStream& stream);
+};
+
+///
+/// \brief index of the distinct projections of the rows of an encoded table onto columns
+///
+/// Projections are numbered column by column: the number of a projection onto the first
+/// j + 1 columns is stored in a hash map by the 64-bit key made of the number of its
+/// projection onto the first j columns and the code of the (j + 1)-th value. The number of
+/// a projection onto the first column is the code of its value.
+///
+class ProjectionIndex {
+private:
+    using Level = std::unordered_map<std::uint64_t, std::uint32_t>;
+
+    std::vector<model::ColumnIndex> columns_;
+    std::vector<Level> levels_;
+    std::vector<model::TupleIndex> representatives_; /*< a row for every distinct projection */
+
+    static std::uint64_t MakeKey(std::uint32_t prefix, ValueCode code) noexcept {
+        return (static_cast<std::uint64_t>(prefix) << 32) | code;
+    }
+
+public:
+    ///
+    /// \note at least two columns are expected
+    ///
+    ProjectionIndex(EncodedTable const& table, std::vector<model::ColumnIndex> columns);
+
+    /// number of distinct projections
+    std::size_t Size() const noexcept {
+        return representatives_.size();
+    }
+
+    /// rows having distinct projections
+    std::vector<model::TupleIndex> const& GetRepresentatives() const noexcept {
+        return representatives_;
+    }
+
+    ///
+    /// Check if the projection of the row of a table onto the given columns is in the index.
+    ///
+    bool Contains(EncodedTable const& table, std::vector<model::ColumnIndex> const& columns,
+                  model::TupleIndex row) const;
+};
+
+}  // namespace algos::mind
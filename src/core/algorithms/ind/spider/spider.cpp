@@ -17,6 +17,7 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/thread_number/option.h"
+#include "core/util/metrics.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos {
@@ -44,6 +45,7 @@ void Spider::MakeExecuteOptsAvailable() {
 
 void Spider::LoadINDAlgorithmDataInternal() {
     auto const create_domains = [&] {
+        DESBORDANTE_METRICS_PHASE("create_domains");
         domains_ = model::ColumnDomain::CreateFrom(input_tables_, mem_limit_mb_, threads_num_);
     };
     timings_.load = util::TimedInvoke(create_domains);
@@ -23,7 +23,7 @@ protected:
     }
 
 public:
-    std::list<model::MD> const& MdList() const noexcept {
+    std::list<model::MD> const& MdList() const {
         return md_collection_.AsList();
     }
 };
@@ -26,9 +26,12 @@ using DistanceFunction = std::function<long double(T, T)>;
 template <typename T>
 using CompareFunction = std::function<bool(std::vector<T> const& points)>;
 template <typename T>
-using HighlightFunction = std::function<void(std::vector<T> const& points,
-                                             std::vector<Highlight>&& cluster_highlights)>;
-using ClusterFunction = std::function<bool(model::PLI::Cluster const& cluster)>;
+using HighlightFunction = std::function<std::vector<Highlight>(
+        std::vector<T> const& points, std::vector<Highlight>&& cluster_highlights)>;
+// Returns whether the cluster satisfies the metric FD, otherwise may store its highlights to
+// `cluster_highlights`.
+using ClusterFunction = std::function<bool(model::PLI::Cluster const& cluster,
+                                           std::vector<Highlight>& cluster_highlights)>;
 template <typename T>
 using IndexedPointsFunction =
         std::function<IndexedPointsCalculationResult<T>(model::PLI::Cluster const& cluster)>;
@@ -20,9 +20,9 @@ void UpdateHighlightMap(algos::metric::HighlightMap& highlight_map,
 
 namespace algos::metric {
 
-void HighlightCalculator::CalculateOneDimensionalHighlights(
+std::vector<Highlight> HighlightCalculator::CalculateOneDimensionalHighlights(
         std::vector<IndexedOneDimensionalPoint> const& indexed_points,
-        std::vector<Highlight>&& cluster_highlights) {
+        std::vector<Highlight>&& cluster_highlights) const {
     model::TypedColumnData const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
     auto const& type = static_cast<model::INumericType const&>(col.GetType());
 
@@ -45,13 +45,13 @@ void HighlightCalculator::CalculateOneDimensionalHighlights(
         }
         cluster_highlights.emplace_back(indexed_point.index, furthest_point_index, max_dist);
     }
-    highlights_.push_back(std::move(cluster_highlights));
+    return std::move(cluster_highlights);
 }
 
 template <typename T>
-void HighlightCalculator::BruteCalculateHighlights(
+std::vector<Highlight> HighlightCalculator::BruteCalculateHighlights(
         std::vector<IndexedPoint<T>> const& indexed_points,
-        std::vector<Highlight>&& cluster_highlights, DistanceFunction<T> const& dist_func) {
+        std::vector<Highlight>&& cluster_highlights, DistanceFunction<T> const& dist_func) const {
     HighlightMap highlight_map;
 
     for (size_t i = 0; i + 1 < indexed_points.size(); ++i) {
@@ -75,20 +75,20 @@ void HighlightCalculator::BruteCalculateHighlights(
             cluster_highlights.push_back(pair.second);
         }
     }
-    highlights_.push_back(std::move(cluster_highlights));
+    return std::move(cluster_highlights);
 }
 
-void HighlightCalculator::CalculateHighlightsForStrings(
+std::vector<Highlight> HighlightCalculator::CalculateHighlightsForStrings(
         std::vector<IndexedPoint<std::byte const*>> const& indexed_points,
         std::vector<Highlight>&& cluster_highlights,
-        DistanceFunction<std::byte const*> const& dist_func) {
-    BruteCalculateHighlights(indexed_points, std::move(cluster_highlights), dist_func);
+        DistanceFunction<std::byte const*> const& dist_func) const {
+    return BruteCalculateHighlights(indexed_points, std::move(cluster_highlights), dist_func);
 }
 
-void HighlightCalculator::CalculateMultidimensionalHighlights(
+std::vector<Highlight> HighlightCalculator::CalculateMultidimensionalHighlights(
         std::vector<IndexedPoint<std::vector<long double>>> const& indexed_points,
-        std::vector<Highlight>&& cluster_highlights) {
-    BruteCalculateHighlights<std::vector<long double>>(
+        std::vector<Highlight>&& cluster_highlights) const {
+    return BruteCalculateHighlights<std::vector<long double>>(
             indexed_points, std::move(cluster_highlights), util::EuclideanDistance);
 }
 
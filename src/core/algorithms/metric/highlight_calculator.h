@@ -21,23 +21,30 @@ private:
     }
 
     template <typename T>
-    void BruteCalculateHighlights(std::vector<IndexedPoint<T>> const& indexed_points,
-                                  std::vector<Highlight>&& cluster_highlights,
-                                  DistanceFunction<T> const& dist_func);
+    std::vector<Highlight> BruteCalculateHighlights(
+            std::vector<IndexedPoint<T>> const& indexed_points,
+            std::vector<Highlight>&& cluster_highlights,
+            DistanceFunction<T> const& dist_func) const;
 
 public:
-    void CalculateOneDimensionalHighlights(
+    // The Calculate* methods only compute the highlights of a cluster, so they may be called
+    // concurrently. The result is stored with AddClusterHighlights.
+    std::vector<Highlight> CalculateOneDimensionalHighlights(
             std::vector<IndexedOneDimensionalPoint> const& indexed_points,
-            std::vector<Highlight>&& cluster_highlights);
+            std::vector<Highlight>&& cluster_highlights) const;
 
-    void CalculateHighlightsForStrings(
+    std::vector<Highlight> CalculateHighlightsForStrings(
             std::vector<IndexedPoint<std::byte const*>> const& indexed_points,
             std::vector<Highlight>&& cluster_highlights,
-            DistanceFunction<std::byte const*> const& dist_func);
+            DistanceFunction<std::byte const*> const& dist_func) const;
 
-    void CalculateMultidimensionalHighlights(
+    std::vector<Highlight> CalculateMultidimensionalHighlights(
             std::vector<IndexedPoint<std::vector<long double>>> const& indexed_points,
-            std::vector<Highlight>&& cluster_highlights);
+            std::vector<Highlight>&& cluster_highlights) const;
+
+    void AddClusterHighlights(std::vector<Highlight>&& cluster_highlights) {
+        highlights_.push_back(std::move(cluster_highlights));
+    }
 
     void SortHighlightsByDistanceAscending();
     void SortHighlightsByDistanceDescending();
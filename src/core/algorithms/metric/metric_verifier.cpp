@@ -1,9 +1,14 @@
 #include "core/algorithms/metric/metric_verifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -14,7 +19,9 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace algos::metric {
 
@@ -117,12 +124,13 @@ void MetricVerifier::RegisterOptions() {
                                                 {need_algo_only, {kMetricAlgorithm}}}));
     RegisterOption(Option{&metric_, kMetric, kDMetric}.SetConditionalOpts(
             {{{}, {config::kRhsIndicesOpt.GetName()}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void MetricVerifier::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable(
-            {kDistFromNullIsInfinity, kParameter, kMetric, config::kLhsIndicesOpt.GetName()});
+    MakeOptionsAvailable({kDistFromNullIsInfinity, kParameter, kMetric,
+                          config::kLhsIndicesOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void MetricVerifier::LoadDataInternal() {
@@ -228,15 +236,45 @@ void MetricVerifier::VerifyMetricFD() {
         pli = pli->Intersect(relation_->GetColumnData(lhs_indices_[i]).GetPositionListIndex());
     }
 
-    metric_fd_holds_ = true;
+    std::deque<model::PLI::Cluster> const& clusters = pli->GetIndex();
     auto cluster_func = GetClusterFunction();
-    for (auto const& cluster : pli->GetIndex()) {
-        if (!cluster_func(cluster)) {
-            metric_fd_holds_ = false;
-            if (algo_ == +MetricAlgo::approx) {
-                break;
+    // Approximate verification does not compute highlights, so the first violating cluster
+    // decides the result
+    bool const stop_on_violation = algo_ == +MetricAlgo::approx;
+
+    std::vector<char> cluster_holds(clusters.size(), true);
+    std::vector<std::vector<Highlight>> clusters_highlights(clusters.size());
+    std::atomic<size_t> next_cluster = 0;
+    std::atomic<bool> violation_found = false;
+    // Set when a cluster function throws (e.g. on a too short string for the cosine metric), so
+    // that the other workers stop and ParallelForeach rethrows the exception on this thread
+    std::atomic<bool> failed = false;
+    auto worker = [&](config::ThreadNumType) {
+        size_t i;
+        while (!failed.load(std::memory_order_relaxed) &&
+               !(stop_on_violation && violation_found.load(std::memory_order_relaxed)) &&
+               (i = next_cluster.fetch_add(1, std::memory_order_relaxed)) < clusters.size()) {
+            try {
+                if (!cluster_func(clusters[i], clusters_highlights[i])) {
+                    cluster_holds[i] = false;
+                    violation_found.store(true, std::memory_order_relaxed);
+                }
+            } catch (...) {
+                failed.store(true, std::memory_order_relaxed);
+                throw;
             }
         }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    metric_fd_holds_ = !violation_found.load();
+    if (stop_on_violation) return;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        if (!cluster_holds[i]) {
+            highlight_calculator_->AddClusterHighlights(std::move(clusters_highlights[i]));
+        }
     }
 }
 
@@ -261,13 +299,16 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
 
     std::function<ClusterFunction(DistanceFunction<std::byte const*>)> verify_func;
     if (algo_ == +MetricAlgo::brute) {
-        verify_func = [this](auto dist_func) {
+        // Levenshtein distance is a metric, unlike cosine distance
+        bool const is_metric = metric_ == +Metric::levenshtein;
+        verify_func = [this, is_metric](auto dist_func) {
             return CalculateClusterFunction<IndexedOneDimensionalPoint>(
                     [this](auto const& cluster) {
                         return points_calculator_->CalculateIndexedPoints(cluster);
                     },
-                    [this, dist_func](auto const& points) {
-                        return this->BruteVerifyCluster(points, dist_func);
+                    [this, is_metric, dist_func](auto const& points) {
+                        return is_metric ? this->PivotVerifyCluster(points, dist_func)
+                                         : this->BruteVerifyCluster(points, dist_func);
                     },
                     [this, dist_func](auto const& points,
                                       std::vector<Highlight>&& cluster_highlights) {
@@ -290,15 +331,17 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
                 [&type](std::byte const* l, std::byte const* r) { return type.Dist(l, r); });
     }
 
-    return [this, &type, verify_func](model::PLI::Cluster const& cluster) {
+    return [this, &type, verify_func](model::PLI::Cluster const& cluster,
+                                      std::vector<Highlight>& cluster_highlights) {
         std::unordered_map<std::string, util::QGramVector> q_gram_map;
-        return verify_func(GetCosineDistFunction(type, q_gram_map))(cluster);
+        return verify_func(GetCosineDistFunction(type, q_gram_map))(cluster, cluster_highlights);
     };
 }
 
 ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
     if (algo_ == +MetricAlgo::calipers) {
-        return [this](model::PLI::Cluster const& cluster) {
+        return [this](model::PLI::Cluster const& cluster,
+                      std::vector<Highlight>& cluster_highlights) {
             auto result = points_calculator_->CalculateMultidimensionalPointsForCalipers(cluster);
             if (!CheckMFDFailIfHasNulls(result.has_nulls) &&
                 CalipersCompareNumericValues(result.points)) {
@@ -307,7 +350,7 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
 
             auto result_indexed =
                     points_calculator_->CalculateMultidimensionalIndexedPoints(cluster);
-            highlight_calculator_->CalculateMultidimensionalHighlights(
+            cluster_highlights = highlight_calculator_->CalculateMultidimensionalHighlights(
                     result_indexed.points, std::move(result_indexed.cluster_highlights));
             return false;
         };
@@ -361,12 +404,13 @@ template <typename T>
 ClusterFunction MetricVerifier::CalculateClusterFunction(
         IndexedPointsFunction<T> points_func, CompareFunction<T> compare_func,
         HighlightFunction<T> highlight_func) const {
-    return [this, points_func, compare_func, highlight_func](model::PLI::Cluster const& cluster) {
+    return [this, points_func, compare_func, highlight_func](
+                   model::PLI::Cluster const& cluster, std::vector<Highlight>& cluster_highlights) {
         auto result = points_func(cluster);
         if (!CheckMFDFailIfHasNulls(result.has_nulls) && compare_func(result.points)) {
             return true;
         }
-        highlight_func(result.points, std::move(result.cluster_highlights));
+        cluster_highlights = highlight_func(result.points, std::move(result.cluster_highlights));
         return false;
     };
 }
@@ -374,7 +418,8 @@ ClusterFunction MetricVerifier::CalculateClusterFunction(
 template <typename T>
 ClusterFunction MetricVerifier::CalculateApproxClusterFunction(
         PointsFunction<T> points_func, DistanceFunction<T> dist_func) const {
-    return [points_func, dist_func, this](model::PLI::Cluster const& cluster) {
+    return [points_func, dist_func, this](model::PLI::Cluster const& cluster,
+                                          std::vector<Highlight>&) {
         auto result = points_func(cluster);
         return !CheckMFDFailIfHasNulls(result.has_nulls) &&
                ApproxVerifyCluster(result.points, dist_func);
@@ -429,6 +474,54 @@ bool MetricVerifier::BruteVerifyCluster(std::vector<IndexedPoint<T>> const& poin
     return true;
 }
 
+template <typename T>
+bool MetricVerifier::PivotVerifyCluster(std::vector<IndexedPoint<T>> const& points,
+                                        DistanceFunction<T> const& dist_func) const {
+    size_t const points_num = points.size();
+    if (points_num < 2) {
+        return true;
+    }
+
+    // Pivots are chosen farthest-first: the next pivot is the point farthest from the chosen ones
+    std::vector<std::vector<long double>> pivot_dists;
+    std::vector<long double> dist_to_pivots(points_num, std::numeric_limits<long double>::max());
+    size_t pivot = 0;
+    while (pivot_dists.size() < std::min(kMaxPivots, points_num)) {
+        std::vector<long double>& dists = pivot_dists.emplace_back(points_num);
+        for (size_t i = 0; i < points_num; ++i) {
+            dists[i] = dist_func(points[pivot].point, points[i].point);
+            if (dists[i] > parameter_) {
+                return false;
+            }
+            dist_to_pivots[i] = std::min(dist_to_pivots[i], dists[i]);
+        }
+        pivot = std::max_element(dist_to_pivots.begin(), dist_to_pivots.end()) -
+                dist_to_pivots.begin();
+        if (dist_to_pivots[pivot] == 0) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i + 1 < points_num; ++i) {
+        for (size_t j = i + 1; j < points_num; ++j) {
+            long double lower_bound = 0;
+            long double upper_bound = std::numeric_limits<long double>::max();
+            for (std::vector<long double> const& dists : pivot_dists) {
+                lower_bound = std::max(lower_bound, std::abs(dists[i] - dists[j]));
+                upper_bound = std::min(upper_bound, dists[i] + dists[j]);
+            }
+            if (lower_bound > parameter_) {
+                return false;
+            }
+            if (upper_bound > parameter_ &&
+                dist_func(points[i].point, points[j].point) > parameter_) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool MetricVerifier::CalipersCompareNumericValues(std::vector<util::Point>& points) const {
     auto pairs = util::GetAntipodalPairs(util::CalculateConvexHull(points));
     return std::all_of(pairs.cbegin(), pairs.cend(), [this](auto const& pair) {
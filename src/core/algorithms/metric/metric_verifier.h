@@ -18,6 +18,7 @@
 #include "core/config/equal_nulls/type.h"
 #include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 #include "core/util/convex_hull.h"
@@ -27,6 +28,10 @@ namespace algos::metric {
 
 class MetricVerifier : public Algorithm {
 private:
+    // Number of pivots whose distances to all the points of a cluster bound the distances
+    // between the points in PivotVerifyCluster
+    static constexpr size_t kMaxPivots = 4;
+
     config::InputTable input_table_;
 
     Metric metric_ = Metric::_values()[0];
@@ -37,6 +42,7 @@ private:
     unsigned int q_;
     bool dist_from_null_is_infinity_;
     config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_num_;
 
     bool metric_fd_holds_ = false;
 
@@ -63,6 +69,14 @@ private:
     bool BruteVerifyCluster(std::vector<IndexedPoint<T>> const& points,
                             DistanceFunction<T> const& dist_func) const;
 
+    // Same as BruteVerifyCluster for a distance function satisfying the triangle inequality.
+    // Distances to a few pivot points give lower and upper bounds of the distance between two
+    // points, which is only computed when the bounds do not decide the comparison with the
+    // parameter.
+    template <typename T>
+    bool PivotVerifyCluster(std::vector<IndexedPoint<T>> const& points,
+                            DistanceFunction<T> const& dist_func) const;
+
     bool CalipersCompareNumericValues(std::vector<util::Point>& points) const;
 
     template <typename T>
@@ -1,20 +1,29 @@
 #include "core/algorithms/nar/des/des.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "core/algorithms/nar/value_range.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/types/types.h"
+#include "core/util/parallel_for.h"
 
 namespace algos::des {
 using model::ValueRange;
 
+namespace {
+// Number of mutants evaluated at once by every thread
+constexpr unsigned kMutantsPerThread = 16;
+}  // namespace
+
 DES::DES() : NARAlgorithm() {
     RegisterOptions();
 }
@@ -33,13 +42,15 @@ void DES::RegisterOptions() {
                           kDCrossoverProbability, 0.9});
     RegisterOption(Option{&differential_options_.differential_strategy, kDifferentialStrategy,
                           kDDifferentialStrategy, default_strategy});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void DES::MakeExecuteOptsAvailable() {
     NARAlgorithm::MakeExecuteOptsAvailable();
     using namespace config::names;
     MakeOptionsAvailable({kSeed, kPopulationSize, kMaxFitnessEvaluations, kDifferentialScale,
-                          kCrossoverProbability, kDifferentialStrategy});
+                          kCrossoverProbability, kDifferentialStrategy,
+                          config::kThreadNumberOpt.GetName()});
 }
 
 FeatureDomains DES::FindFeatureDomains(TypedRelation const* typed_relation) {
@@ -50,12 +61,33 @@ FeatureDomains DES::FindFeatureDomains(TypedRelation const* typed_relation) {
     return feature_domains;
 }
 
+void DES::SetQualities(std::vector<NAR>& nars, model::NAREvaluator const& evaluator) const {
+    std::atomic<size_t> next_nar = 0;
+    auto worker = [&](config::ThreadNumType) {
+        for (size_t i = next_nar++; i < nars.size(); i = next_nar++) {
+            nars[i].SetQualities(evaluator);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+}
+
 std::vector<EncodedNAR> DES::GetRandomPopulationInDomains(FeatureDomains const& domains,
+                                                          model::NAREvaluator const& evaluator,
                                                           RNG& rng) const {
     std::vector<EncodedNAR> population;
+    std::vector<NAR> decoded;
     population.reserve(population_size_);
-    std::generate_n(std::back_inserter(population), population_size_,
-                    [&]() { return EncodedNAR(domains, typed_relation_.get(), rng); });
+    decoded.reserve(population_size_);
+    for (unsigned i = 0; i < population_size_; ++i) {
+        population.emplace_back(domains.size(), rng);
+        decoded.push_back(population.back().Decode(domains, rng));
+    }
+    SetQualities(decoded, evaluator);
+    for (unsigned i = 0; i < population_size_; ++i) {
+        population[i].SetQualities(decoded[i].GetQualities());
+    }
     auto compare_by_fitness = [](EncodedNAR const& a, EncodedNAR const& b) {
         return a.GetQualities().fitness > b.GetQualities().fitness;
     };
@@ -70,19 +102,38 @@ EncodedNAR DES::MutatedIndividual(std::vector<EncodedNAR> const& population, siz
     return (*diff_func)(population, at, differential_options_, rng);
 }
 
-unsigned long long DES::ExecuteInternal() {
-    rng_.SetSeed(seed_);
-    auto const start_time = std::chrono::system_clock::now();
-
-    FeatureDomains feature_domains = FindFeatureDomains(typed_relation_.get());
-    std::vector<EncodedNAR> population = GetRandomPopulationInDomains(feature_domains, rng_);
+// The mutants of a batch are made from the population as it is before the batch and evaluated
+// in parallel. Then they are tried in order: every mutant is made again from the current
+// population, and if an earlier replacement has changed it, it is decoded and evaluated anew.
+// So the result is the same as if the mutants were made and evaluated one by one.
+void DES::EvolveBatch(std::vector<EncodedNAR>& population, unsigned batch_begin,
+                      unsigned batch_end, FeatureDomains const& domains,
+                      model::NAREvaluator const& evaluator) {
+    std::vector<EncodedNAR> mutants;
+    std::vector<RNG> decode_states;
+    std::vector<NAR> decoded;
+    RNG rng = rng_;
+    for (unsigned i = batch_begin; i < batch_end; ++i) {
+        mutants.push_back(MutatedIndividual(population, i % population_size_, rng));
+        decode_states.push_back(rng);
+        decoded.push_back(mutants.back().Decode(domains, rng));
+    }
+    SetQualities(decoded, evaluator);
 
-    for (unsigned i = 0; i < num_evaluations_; ++i) {
+    for (unsigned i = batch_begin; i < batch_end; ++i) {
         size_t candidate_i = i % population_size_;
+        size_t const batch_i = i - batch_begin;
         EncodedNAR mutant = MutatedIndividual(population, candidate_i, rng_);
-        NAR mutant_decoded = mutant.SetQualities(feature_domains, typed_relation_.get(), rng_);
-        double candidate_fitness = population[candidate_i].GetQualities().fitness;
+        bool const is_evaluated = rng_ == decode_states[batch_i] && mutant == mutants[batch_i];
+        NAR mutant_decoded = mutant.Decode(domains, rng_);
+        if (is_evaluated) {
+            mutant_decoded = std::move(decoded[batch_i]);
+        } else {
+            mutant_decoded.SetQualities(evaluator);
+        }
         auto mutant_qualities = mutant_decoded.GetQualities();
+        mutant.SetQualities(mutant_qualities);
+        double candidate_fitness = population[candidate_i].GetQualities().fitness;
         if (mutant_qualities.fitness > candidate_fitness) {
             population[candidate_i] = std::move(mutant);
             if (mutant_qualities.support > minsup_ && mutant_qualities.confidence > minconf_) {
@@ -90,6 +141,26 @@ unsigned long long DES::ExecuteInternal() {
             }
         }
     }
+}
+
+unsigned long long DES::ExecuteInternal() {
+    rng_.SetSeed(seed_);
+    auto const start_time = std::chrono::system_clock::now();
+
+    FeatureDomains feature_domains = FindFeatureDomains(typed_relation_.get());
+    model::NAREvaluator const evaluator{*typed_relation_};
+    std::vector<EncodedNAR> population =
+            GetRandomPopulationInDomains(feature_domains, evaluator, rng_);
+
+    // Mutants of a batch are made for distinct candidates
+    unsigned const batch_size =
+            threads_num_ == 1 ? 1
+                              : std::max(1u, std::min(population_size_,
+                                                      threads_num_ * kMutantsPerThread));
+    for (unsigned i = 0; i < num_evaluations_; i += batch_size) {
+        EvolveBatch(population, i, std::min(num_evaluations_, i + batch_size), feature_domains,
+                    evaluator);
+    }
 
     auto compare_by_fitness = [](const NAR& a, const NAR& b) -> bool {
         return a.GetQualities().fitness > b.GetQualities().fitness;
@@ -5,7 +5,9 @@
 #include "core/algorithms/nar/des/enums.h"
 #include "core/algorithms/nar/des/rng.h"
 #include "core/algorithms/nar/nar_algorithm.h"
+#include "core/algorithms/nar/nar_evaluator.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 
 namespace algos::des {
 using FeatureDomains = std::vector<std::shared_ptr<model::ValueRange>> const;
@@ -17,14 +19,20 @@ private:
     unsigned int population_size_;
     unsigned int num_evaluations_;
     DifferentialOptions differential_options_;
+    config::ThreadNumType threads_num_ = 1;
     RNG rng_;
     void RegisterOptions();
 
     static FeatureDomains FindFeatureDomains(TypedRelation const* typed_relation);
+    void SetQualities(std::vector<NAR>& nars, model::NAREvaluator const& evaluator) const;
     std::vector<EncodedNAR> GetRandomPopulationInDomains(FeatureDomains const& domains,
+                                                         model::NAREvaluator const& evaluator,
                                                          RNG& rng) const;
     EncodedNAR MutatedIndividual(std::vector<EncodedNAR> const& population, size_t at,
                                  RNG& rng) const;
+    void EvolveBatch(std::vector<EncodedNAR>& population, unsigned batch_begin,
+                     unsigned batch_end, FeatureDomains const& domains,
+                     model::NAREvaluator const& evaluator);
 
 protected:
     void MakeExecuteOptsAvailable() override;
@@ -37,15 +37,25 @@ double const& EncodedNAR::operator[](size_t index) const {
     return encoded_value_ranges_[feature][feature_field];
 }
 
-NAR EncodedNAR::SetQualities(FeatureDomains& domains, TypedRelation const* typed_relation,
+bool EncodedNAR::operator==(EncodedNAR const& other) const {
+    return implication_sign_pos_ == other.implication_sign_pos_ &&
+           encoded_value_ranges_ == other.encoded_value_ranges_;
+}
+
+NAR EncodedNAR::SetQualities(FeatureDomains& domains, model::NAREvaluator const& evaluator,
                              RNG& rng) {
     NAR this_decoded = Decode(domains, rng);
-    this_decoded.SetQualities(typed_relation);
+    this_decoded.SetQualities(evaluator);
     qualities_ = this_decoded.GetQualities();
     qualities_consistent_ = true;
     return this_decoded;
 }
 
+void EncodedNAR::SetQualities(model::NARQualities const& qualities) {
+    qualities_ = qualities;
+    qualities_consistent_ = true;
+}
+
 model::NARQualities const& EncodedNAR::GetQualities() const {
     if (!qualities_consistent_) {
         throw std::logic_error("Getting uninitialized qualities from NAR.");
@@ -83,15 +93,6 @@ NAR EncodedNAR::Decode(FeatureDomains& domains, RNG& rng) const {
     return resulting_nar;
 }
 
-EncodedNAR::EncodedNAR(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng)
-    : implication_sign_pos_(rng.Next()) {
-    size_t feature_count = domains.size();
-    encoded_value_ranges_.reserve(feature_count);
-    std::generate_n(std::back_inserter(encoded_value_ranges_), feature_count,
-                    [&rng]() { return EncodedValueRange(rng); });
-    SetQualities(domains, typed_relation, rng);
-}
-
 EncodedNAR::EncodedNAR(size_t feature_count, RNG& rng) : implication_sign_pos_(rng.Next()) {
     encoded_value_ranges_.reserve(feature_count);
     std::generate_n(std::back_inserter(encoded_value_ranges_), feature_count,
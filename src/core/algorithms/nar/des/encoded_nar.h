@@ -2,14 +2,13 @@
 
 #include "core/algorithms/nar/des/encoded_value_range.h"
 #include "core/algorithms/nar/nar.h"
-#include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/algorithms/nar/nar_evaluator.h"
 
 namespace algos::des {
 using model::NAR;
 
 class EncodedNAR {
 private:
-    using TypedRelation = model::ColumnLayoutTypedRelationData;
     using FeatureDomains = std::vector<std::shared_ptr<model::ValueRange>> const;
 
     double implication_sign_pos_ = -1;
@@ -23,12 +22,15 @@ public:
     size_t FeatureCount() const;
     double& operator[](size_t index);
     double const& operator[](size_t index) const;
+    // Compares the encodings, not the qualities
+    bool operator==(EncodedNAR const& other) const;
 
     model::NARQualities const& GetQualities() const;
-    NAR SetQualities(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng);
+    NAR SetQualities(FeatureDomains& domains, model::NAREvaluator const& evaluator, RNG& rng);
+    // Sets the qualities of the NAR this one has been decoded into
+    void SetQualities(model::NARQualities const& qualities);
 
     NAR Decode(FeatureDomains& domains, RNG& rng) const;
-    EncodedNAR(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng);
     EncodedNAR(size_t feature_count, RNG& rng);
 };
 
@@ -15,6 +15,7 @@ public:
 
     double& operator[](size_t index);
     double const& operator[](size_t index) const;
+    bool operator==(EncodedValueRange const& other) const = default;
 
     template <typename T, typename RangeT>
     std::shared_ptr<RangeT> DecodeTypedValueRange(
@@ -6,7 +6,7 @@ namespace algos::des {
 
 class RNG {
 private:
-    long unsigned const kDefaultSeed_ = 2;
+    static constexpr long unsigned kDefaultSeed_ = 2;
     // result_type can differ on different STL implementations and data models
     std::mt19937 rng_{static_cast<std::mt19937::result_type>(kDefaultSeed_)};
     std::uniform_real_distribution<double> uni_{0.0, 1.0};
@@ -18,6 +18,8 @@ public:
     double Next() {
         return uni_(rng_);
     }
+    // Equal generators produce equal sequences
+    bool operator==(RNG const& other) const = default;
 };
 
 }  // namespace algos::des
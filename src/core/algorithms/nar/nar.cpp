@@ -72,6 +72,20 @@ void NAR::SetQualities(TypedRelation const* typed_relation) {
     qualities_consistent_ = true;
 }
 
+void NAR::SetQualities(NAREvaluator const& evaluator) {
+    if (ante_.empty() || cons_.empty()) {
+        qualities_ = {0.0, 0.0, 0.0};
+        qualities_consistent_ = true;
+        return;
+    }
+    auto const [num_rows_fit_ante, num_rows_fit_ante_and_cons] = evaluator.CountRows(ante_, cons_);
+
+    qualities_ = CalcQualities(num_rows_fit_ante, num_rows_fit_ante_and_cons,
+                               ante_.size() + cons_.size(), evaluator.GetNumColumns(),
+                               evaluator.GetNumRows());
+    qualities_consistent_ = true;
+}
+
 model::NARQualities const& NAR::GetQualities() const {
     if (!qualities_consistent_) {
         throw std::logic_error("Getting uninitialized qualities from NAR.");
@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include "core/algorithms/nar/nar_evaluator.h"
 #include "core/algorithms/nar/value_range.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 #include "core/model/types/types.h"
@@ -43,6 +44,7 @@ private:
 public:
     std::string ToString() const;
     void SetQualities(TypedRelation const* typed_relation);
+    void SetQualities(NAREvaluator const& evaluator);
     NARQualities const& GetQualities() const;
 
     auto const& GetAnte() const noexcept {
@@ -0,0 +1,144 @@
+#include "core/algorithms/nar/nar_evaluator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace model {
+
+namespace {
+
+template <typename T, typename Values>
+std::vector<T> const& GetValues(Values const& values) {
+    auto const* typed_values = std::get_if<std::vector<T>>(&values);
+    if (typed_values == nullptr) {
+        throw std::invalid_argument("Value range type does not match the type of the column.");
+    }
+    return *typed_values;
+}
+
+}  // namespace
+
+template <typename T>
+NAREvaluator::SortedColumn NAREvaluator::SortColumn(TypedColumnData const& column) {
+    auto get_value = [&column](unsigned row) -> T {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return Type::GetValue<String>(column.GetValue(row));
+        } else {
+            return Type::GetValue<T>(column.GetValue(row));
+        }
+    };
+
+    SortedColumn sorted;
+    for (unsigned row = 0; row < column.GetNumRows(); ++row) {
+        if (column.IsNullOrEmpty(row)) {
+            continue;
+        }
+        if constexpr (std::is_same_v<T, Double>) {
+            // NaN is not in any range and cannot be ordered
+            if (std::isnan(get_value(row))) {
+                continue;
+            }
+        }
+        sorted.rows.push_back(row);
+    }
+    std::ranges::sort(sorted.rows, {}, get_value);
+
+    std::vector<T> values;
+    values.reserve(sorted.rows.size());
+    std::ranges::transform(sorted.rows, std::back_inserter(values), get_value);
+    sorted.values = std::move(values);
+    return sorted;
+}
+
+NAREvaluator::NAREvaluator(ColumnLayoutTypedRelationData const& typed_relation)
+    : num_rows_(typed_relation.GetNumRows()) {
+    columns_.reserve(typed_relation.GetNumColumns());
+    for (TypedColumnData const& column : typed_relation.GetColumnData()) {
+        switch (column.GetTypeId()) {
+            case TypeId::kInt:
+                columns_.push_back(SortColumn<Int>(column));
+                break;
+            case TypeId::kDouble:
+                columns_.push_back(SortColumn<Double>(column));
+                break;
+            case TypeId::kString:
+                columns_.push_back(SortColumn<std::string_view>(column));
+                break;
+            default:
+                // There are no ranges of values of other types
+                columns_.emplace_back();
+                break;
+        }
+    }
+}
+
+void NAREvaluator::SetRangeRows(size_t column_index, ValueRange const& range, Bitmap& rows) const {
+    SortedColumn const& column = columns_.at(column_index);
+    auto set_rows = [&column, &rows](auto const& values, auto first, auto last) {
+        for (; first < last; ++first) {
+            rows.set(column.rows[first - values.begin()]);
+        }
+    };
+    auto set_numeric_rows = [&](auto const& numeric_range) {
+        using T = std::remove_cvref_t<decltype(numeric_range.lower_bound)>;
+        std::vector<T> const& values = GetValues<T>(column.values);
+        // Also true if a bound is NaN, no value fits such a range
+        if (!(numeric_range.lower_bound <= numeric_range.upper_bound)) {
+            return;
+        }
+        set_rows(values, std::ranges::lower_bound(values, numeric_range.lower_bound),
+                 std::ranges::upper_bound(values, numeric_range.upper_bound));
+    };
+
+    switch (range.GetTypeId()) {
+        case TypeId::kInt:
+            set_numeric_rows(static_cast<NumericValueRange<Int> const&>(range));
+            break;
+        case TypeId::kDouble:
+            set_numeric_rows(static_cast<NumericValueRange<Double> const&>(range));
+            break;
+        case TypeId::kString: {
+            std::vector<std::string_view> const& values =
+                    GetValues<std::string_view>(column.values);
+            for (String const& value : static_cast<StringValueRange const&>(range).domain) {
+                auto const [first, last] =
+                        std::ranges::equal_range(values, std::string_view{value});
+                set_rows(values, first, last);
+            }
+            break;
+        }
+        default:
+            throw std::invalid_argument(std::string("ValueRange has invalid type_id: ") +
+                                        range.GetTypeId()._to_string() +
+                                        std::string(" in function: ") + __func__);
+    }
+}
+
+void NAREvaluator::IntersectWithRanges(Ranges const& ranges, Bitmap& rows,
+                                       Bitmap& range_rows) const {
+    for (auto const& [column_index, range] : ranges) {
+        range_rows.reset();
+        SetRangeRows(column_index, *range, range_rows);
+        rows &= range_rows;
+    }
+}
+
+NAREvaluator::RowCounts NAREvaluator::CountRows(Ranges const& ante, Ranges const& cons) const {
+    RowCounts counts;
+    Bitmap rows(num_rows_);
+    Bitmap range_rows(num_rows_);
+    rows.set();
+
+    IntersectWithRanges(ante, rows, range_rows);
+    counts.fit_ante = rows.count();
+    if (counts.fit_ante == 0) {
+        return counts;
+    }
+    IntersectWithRanges(cons, rows, range_rows);
+    counts.fit_ante_and_cons = rows.count();
+    return counts;
+}
+
+}  // namespace model
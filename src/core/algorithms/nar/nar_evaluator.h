@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/algorithms/nar/value_range.h"
+#include "core/model/table/column_layout_typed_relation_data.h"
+
+namespace model {
+
+// Counts the rows of a typed relation that fit the ranges of NARs. Every column is sorted once,
+// so the rows whose values are in a range form a slice of the column's row order that is found
+// with binary search. The rows fitting a conjunction of ranges are the intersection of the
+// bitmaps of their slices. Null and empty values fit no range.
+class NAREvaluator {
+public:
+    using Ranges = std::unordered_map<size_t, std::shared_ptr<ValueRange>>;
+
+    struct RowCounts {
+        size_t fit_ante = 0;
+        size_t fit_ante_and_cons = 0;
+    };
+
+private:
+    using Bitmap = boost::dynamic_bitset<>;
+
+    struct SortedColumn {
+        // rows with values, in the order of their values
+        std::vector<unsigned> rows;
+        std::variant<std::vector<Int>, std::vector<Double>, std::vector<std::string_view>> values;
+    };
+
+    size_t num_rows_;
+    std::vector<SortedColumn> columns_;
+
+    template <typename T>
+    static SortedColumn SortColumn(TypedColumnData const& column);
+
+    void SetRangeRows(size_t column_index, ValueRange const& range, Bitmap& rows) const;
+    void IntersectWithRanges(Ranges const& ranges, Bitmap& rows, Bitmap& range_rows) const;
+
+public:
+    explicit NAREvaluator(ColumnLayoutTypedRelationData const& typed_relation);
+
+    size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    size_t GetNumColumns() const noexcept {
+        return columns_.size();
+    }
+
+    // Can be called from several threads at once
+    RowCounts CountRows(Ranges const& ante, Ranges const& cons) const;
+};
+
+}  // namespace model
@@ -1,13 +1,19 @@
 #include "core/algorithms/od/fastod/fastod.h"
 
+#include <atomic>
+#include <iterator>
 #include <memory>
+#include <numeric>
 
 #include <boost/unordered/unordered_map.hpp>
 
 #include "core/config/error/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/config/time_limit/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos {
@@ -37,6 +43,8 @@ void Fastod::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
     RegisterOption(config::kErrorOpt(&error_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
 }
 
 void Fastod::MakeLoadOptionsAvailable() {
@@ -44,7 +52,8 @@ void Fastod::MakeLoadOptionsAvailable() {
 }
 
 void Fastod::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName(), config::kErrorOpt.GetName()});
+    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName(), config::kErrorOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void Fastod::LoadDataInternal() {
@@ -112,6 +121,7 @@ std::vector<fastod::SimpleCanonicalOD> const& Fastod::GetSimpleDependencies() co
 
 void Fastod::Initialize() {
     timer_.Start();
+    partition_cache_.SetMemoryLimit(static_cast<size_t>(mem_limit_mb_) << 20);
 
     schema_ = AttributeSet(data_.GetColumnCount(), (1 << data_.GetColumnCount()) - 1);
 
@@ -122,67 +132,96 @@ void Fastod::Initialize() {
         context_in_current_level_.emplace(data_.GetColumnCount(), 1 << i);
 }
 
-void Fastod::ComputeODs() {
-    Timer timer(true);
-    std::vector<std::vector<AttributeSet>> deleted_attrs(context_in_current_level_.size());
-    size_t context_ind = 0;
+void Fastod::ComputeContextODs(AttributeSet const& context, ContextResult& result) {
+    std::vector<AttributeSet> del_attrs;
+    del_attrs.reserve(data_.GetColumnCount());
 
-    for (AttributeSet const& context : context_in_current_level_) {
-        auto& del_attrs = deleted_attrs[context_ind++];
-        del_attrs.reserve(data_.GetColumnCount());
+    for (model::ColumnIndex column = 0; column < data_.GetColumnCount(); ++column) {
+        del_attrs.push_back(fastod::DeleteAttribute(context, column));
+    }
 
-        for (model::ColumnIndex column = 0; column < data_.GetColumnCount(); ++column) {
-            del_attrs.push_back(fastod::DeleteAttribute(context, column));
-        }
+    AttributeSet& cc = cc_.at(context);
+    cc = schema_;
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
+    context.Iterate([this, &cc, &del_attrs](model::ColumnIndex attr) {
+        cc = fastod::Intersect(cc, cc_.at(del_attrs[attr]));
+    });
 
-        AttributeSet context_cc = schema_;
+    AddCandidates<od::Ordering::descending>(context, del_attrs);
+    AddCandidates<od::Ordering::ascending>(context, del_attrs);
 
-        context.Iterate([this, &context_cc, &del_attrs](model::ColumnIndex attr) {
-            context_cc = fastod::Intersect(context_cc, CCGet(del_attrs[attr]));
-        });
-
-        CCPut(context, context_cc);
+    AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
 
-        AddCandidates<od::Ordering::descending>(context, del_attrs);
-        AddCandidates<od::Ordering::ascending>(context, del_attrs);
-    }
+    context_intersect_cc_context.Iterate(
+            [this, &context, &del_attrs, &cc, &result](model::ColumnIndex attr) {
+                SimpleCanonicalOD od(del_attrs[attr], attr);
 
-    size_t delete_index = 0;
+                if (od.IsValid(data_, partition_cache_, error_)) {
+                    AddToResult(result, std::move(od));
+                    cc = fastod::DeleteAttribute(cc, attr);
 
-    for (AttributeSet const& context : context_in_current_level_) {
-        auto const& del_attrs = deleted_attrs[delete_index++];
+                    AttributeSet const diff = fastod::Difference(schema_, context);
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
-
-        AttributeSet const& cc = CCGet(context);
-        AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
+                    if (diff.Any()) {
+                        cc = cc & (~diff);
+                    }
+                }
+            });
 
-        context_intersect_cc_context.Iterate(
-                [this, &context, &del_attrs, &cc](model::ColumnIndex attr) {
-                    SimpleCanonicalOD od(del_attrs[attr], attr);
+    CalculateODs<od::Ordering::descending>(context, del_attrs, result);
+    CalculateODs<od::Ordering::ascending>(context, del_attrs, result);
+}
 
-                    if (od.IsValid(data_, partition_cache_, error_)) {
-                        AddToResult(std::move(od));
-                        CCPut(context, fastod::DeleteAttribute(cc, attr));
+void Fastod::ComputeODs() {
+    std::vector<AttributeSet> const contexts(context_in_current_level_.begin(),
+                                             context_in_current_level_.end());
+    std::vector<ContextResult> results(contexts.size());
+    std::vector<char> is_computed(contexts.size(), false);
+
+    // A context only reads the entries of the previous level and writes its own ones, so the
+    // entries are created here and the maps are not modified structurally by the workers.
+    for (AttributeSet const& context : contexts) {
+        cc_[context];
+        cs_asc_[context];
+        cs_desc_[context];
+    }
 
-                        AttributeSet const diff = fastod::Difference(schema_, context);
+    std::atomic<size_t> next_context = 0;
+    std::atomic<bool> is_time_up = false;
+
+    auto worker = [&](config::ThreadNumType) {
+        size_t context_ind;
+        while (!is_time_up.load(std::memory_order_relaxed) &&
+               (context_ind = next_context.fetch_add(1, std::memory_order_relaxed)) <
+                       contexts.size()) {
+            if (IsTimeUp()) {
+                is_time_up.store(true, std::memory_order_relaxed);
+                return;
+            }
 
-                        if (diff.Any()) {
-                            CCPut(context, cc & (~diff));
-                        }
-                    }
-                });
+            ComputeContextODs(contexts[context_ind], results[context_ind]);
+            is_computed[context_ind] = true;
+        }
+    };
+
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (!is_computed[i]) continue;
+
+        auto move_results = [](auto& from, auto& to) {
+            to.insert(to.end(), std::make_move_iterator(from.begin()),
+                      std::make_move_iterator(from.end()));
+        };
+        move_results(results[i].simple, result_simple_);
+        move_results(results[i].desc, result_desc_);
+        move_results(results[i].asc, result_asc_);
+    }
 
-        CalculateODs<od::Ordering::descending>(context, del_attrs);
-        CalculateODs<od::Ordering::ascending>(context, del_attrs);
+    if (is_time_up) {
+        is_complete_ = false;
     }
 }
 
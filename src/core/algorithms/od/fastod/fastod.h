@@ -14,7 +14,9 @@
 #include "core/algorithms/od/fastod/storage/partition_cache.h"
 #include "core/algorithms/od/fastod/util/timer.h"
 #include "core/config/error/type.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/config/time_limit/type.h"
 
 namespace algos {
@@ -43,6 +45,9 @@ private:
     std::unordered_map<AttributeSet, std::unordered_set<AttributePair>> cs_asc_;
     std::unordered_map<AttributeSet, std::unordered_set<AttributePair>> cs_desc_;
 
+    config::ThreadNumType threads_num_ = 1;
+    config::MemLimitMBType mem_limit_mb_ = 0;
+
     Timer timer_;
     PartitionCache partition_cache_;
 
@@ -71,67 +76,74 @@ private:
     void CCPut(AttributeSet const& key, AttributeSet attribute_set);
     AttributeSet const& CCGet(AttributeSet const& key);
 
+    // ODs found in one context, collected separately so that the results of a level do not
+    // depend on the order in which the threads process its contexts
+    struct ContextResult {
+        std::vector<AscCanonicalOD> asc;
+        std::vector<DescCanonicalOD> desc;
+        std::vector<SimpleCanonicalOD> simple;
+    };
+
+    void ComputeContextODs(AttributeSet const& context, ContextResult& result);
+
     template <od::Ordering Ordering>
     [[nodiscard]] static consteval bool IsAscending() {
         return Ordering == +od::Ordering::ascending;
     }
 
     template <od::Ordering Ordering>
-    void CSPut(AttributeSet const& key, AttributePair const& value) {
+    std::unordered_map<AttributeSet, std::unordered_set<AttributePair>>& CSMap() {
         if constexpr (IsAscending<Ordering>()) {
-            cs_asc_[key].emplace(value);
+            return cs_asc_;
         } else {
-            cs_desc_[key].emplace(value);
+            return cs_desc_;
         }
     }
 
     template <od::Ordering Ordering>
-    void CSPut(AttributeSet const& key, AttributePair&& value) {
-        if constexpr (IsAscending<Ordering>()) {
-            cs_asc_[key].emplace(std::move(value));
-        } else {
-            cs_desc_[key].emplace(std::move(value));
-        }
+    std::unordered_set<AttributePair>& CSGet(AttributeSet const& key) {
+        return CSMap<Ordering>()[key];
     }
 
+    // Does not insert missing keys, so it can be called from worker threads
     template <od::Ordering Ordering>
-    std::unordered_set<AttributePair>& CSGet(AttributeSet const& key) {
-        if constexpr (IsAscending<Ordering>()) {
-            return cs_asc_[key];
-        } else {
-            return cs_desc_[key];
-        }
+    std::unordered_set<AttributePair> const& CSFind(AttributeSet const& key) {
+        static std::unordered_set<AttributePair> const kEmpty;
+
+        auto const& cs = CSMap<Ordering>();
+        auto const it = cs.find(key);
+        return it == cs.end() ? kEmpty : it->second;
     }
 
     template <od::Ordering Ordering>
-    void AddToResult(fastod::CanonicalOD<Ordering>&& od) {
+    static void AddToResult(ContextResult& result, fastod::CanonicalOD<Ordering>&& od) {
         if constexpr (IsAscending<Ordering>()) {
-            result_asc_.emplace_back(std::move(od));
+            result.asc.emplace_back(std::move(od));
         } else {
-            result_desc_.emplace_back(std::move(od));
+            result.desc.emplace_back(std::move(od));
         }
     }
 
-    void AddToResult(SimpleCanonicalOD&& od) {
-        result_simple_.emplace_back(std::move(od));
+    static void AddToResult(ContextResult& result, SimpleCanonicalOD&& od) {
+        result.simple.emplace_back(std::move(od));
     }
 
+    // Entries of `context` must be present in cc_, cs_asc_ and cs_desc_ beforehand. Only the
+    // entries of `context` are modified, so contexts of one level can be processed concurrently.
     template <od::Ordering Ordering>
     void AddCandidates(AttributeSet const& context,
                        std::vector<AttributeSet> const& deleted_attrs) {
+        std::unordered_set<AttributePair>& cs_for_con = CSMap<Ordering>().at(context);
+
         if (level_ == 2) {
-            for (model::ColumnIndex i = 0; i < data_.GetColumnCount(); i++) {
-                for (model::ColumnIndex j = 0; j < data_.GetColumnCount(); j++) {
-                    if (i == j) continue;
-                    CSPut<Ordering>(fastod::CreateAttributeSet(
-                                            std::initializer_list<model::ColumnIndex>{i, j},
-                                            data_.GetColumnCount()),
-                                    AttributePair(i, j));
-                }
-            }
+            context.Iterate([&context, &cs_for_con](model::ColumnIndex i) {
+                context.Iterate([i, &cs_for_con](model::ColumnIndex j) {
+                    if (i != j) cs_for_con.emplace(i, j);
+                });
+            });
         } else if (level_ > 2) {
-            context.Iterate([this, &deleted_attrs, &context](model::ColumnIndex attr) {
-                auto const& candidates = CSGet<Ordering>(deleted_attrs[attr]);
+            context.Iterate([this, &deleted_attrs, &cs_for_con](model::ColumnIndex attr) {
+                auto const& candidates = CSFind<Ordering>(deleted_attrs[attr]);
 
                 for (AttributePair const& attribute_pair : candidates) {
                     AttributeSet const context_delete_ab = fastod::DeleteAttribute(
@@ -142,7 +154,7 @@ private:
                     context_delete_ab.Iterate([this, &deleted_attrs, &attribute_pair,
                                                &add_context](model::ColumnIndex attr) {
                         std::unordered_set<AttributePair> const& cs =
-                                CSGet<Ordering>(deleted_attrs[attr]);
+                                CSFind<Ordering>(deleted_attrs[attr]);
 
                         if (cs.find(attribute_pair) == cs.end()) {
                             add_context = false;
@@ -151,7 +163,7 @@ private:
                     });
 
                     if (add_context) {
-                        CSPut<Ordering>(context, attribute_pair);
+                        cs_for_con.emplace(attribute_pair);
                     }
                 }
             });
@@ -159,20 +171,21 @@ private:
     }
 
     template <od::Ordering Ordering>
-    void CalculateODs(AttributeSet const& context, std::vector<AttributeSet> const& deleted_attrs) {
-        auto& cs_for_con = CSGet<Ordering>(context);
+    void CalculateODs(AttributeSet const& context, std::vector<AttributeSet> const& deleted_attrs,
+                      ContextResult& result) {
+        auto& cs_for_con = CSMap<Ordering>().at(context);
 
         for (auto it = cs_for_con.begin(); it != cs_for_con.end();) {
             model::ColumnIndex a = it->left;
             model::ColumnIndex b = it->right;
 
-            if (ContainsAttribute(CCGet(deleted_attrs[b]), a) &&
-                ContainsAttribute(CCGet(deleted_attrs[a]), b)) {
+            if (ContainsAttribute(cc_.at(deleted_attrs[b]), a) &&
+                ContainsAttribute(cc_.at(deleted_attrs[a]), b)) {
                 fastod::CanonicalOD<Ordering> od(fastod::DeleteAttribute(deleted_attrs[a], b), a,
                                                  b);
 
                 if (od.IsValid(data_, partition_cache_, error_)) {
-                    AddToResult(std::move(od));
+                    AddToResult(result, std::move(od));
                     cs_for_con.erase(it++);
                 } else {
                     ++it;
@@ -16,7 +16,7 @@ bool CanonicalOD<Ordering>::IsValid(DataFrame const& data, PartitionCache& cache
                                     config::ErrorType error) const {
     if (error == 0.0) {
         return !cache.GetStrippedPartition(context_, data)
-                        .template Swap<Ordering>(ap_.left, ap_.right);
+                        ->template Swap<Ordering>(ap_.left, ap_.right);
     } else {
         od::RemovalSetAsVec removal_set = CalculateRemovalSet(data, cache);
         return removal_set.size() <= error * data.GetTupleCount();
@@ -27,7 +27,7 @@ template <od::Ordering Ordering>
 od::RemovalSetAsVec CanonicalOD<Ordering>::CalculateRemovalSet(DataFrame const& data,
                                                                PartitionCache& cache) const {
     return cache.GetStrippedPartition(context_, data)
-            .template CalculateSwapRemovalSet<Ordering>(ap_.left, ap_.right);
+            ->template CalculateSwapRemovalSet<Ordering>(ap_.left, ap_.right);
 }
 
 template <od::Ordering Ordering>
@@ -49,7 +49,7 @@ SimpleCanonicalOD::SimpleCanonicalOD(AttributeSet const& context, model::ColumnI
 bool SimpleCanonicalOD::IsValid(DataFrame const& data, PartitionCache& cache,
                                 config::ErrorType error) const {
     if (error == 0.0) {
-        return !cache.GetStrippedPartition(context_, data).Split(right_);
+        return !cache.GetStrippedPartition(context_, data)->Split(right_);
     } else {
         od::RemovalSetAsVec removal_set = CalculateRemovalSet(data, cache);
         return removal_set.size() <= error * data.GetTupleCount();
@@ -58,7 +58,7 @@ bool SimpleCanonicalOD::IsValid(DataFrame const& data, PartitionCache& cache,
 
 od::RemovalSetAsVec SimpleCanonicalOD::CalculateRemovalSet(DataFrame const& data,
                                                            PartitionCache& cache) const {
-    return cache.GetStrippedPartition(context_, data).CalculateSplitRemovalSet(right_);
+    return cache.GetStrippedPartition(context_, data)->CalculateSplitRemovalSet(right_);
 }
 
 std::string SimpleCanonicalOD::ToString() const {
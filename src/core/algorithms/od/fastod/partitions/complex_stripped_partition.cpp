@@ -37,18 +37,21 @@ std::string ComplexStrippedPartition::ToString() const {
     return is_stripped_partition_ ? CommonToString() : RangeBasedToString();
 }
 
-void ComplexStrippedPartition::Product(model::ColumnIndex attribute) {
-    if (is_stripped_partition_) {
-        CommonProduct(attribute);
-    } else {
-        RangeBasedProduct(attribute);
-    }
+ComplexStrippedPartition ComplexStrippedPartition::Product(model::ColumnIndex attribute) const {
+    return is_stripped_partition_ ? CommonProduct(attribute) : RangeBasedProduct(attribute);
 }
 
 bool ComplexStrippedPartition::Split(model::ColumnIndex right) const {
     return is_stripped_partition_ ? CommonSplit(right) : RangeBasedSplit(right);
 }
 
+size_t ComplexStrippedPartition::GetMemoryUsage() const {
+    return sizeof(ComplexStrippedPartition) + sp_indexes_.capacity() * sizeof(size_t) +
+           sp_begins_.capacity() * sizeof(size_t) +
+           rb_indexes_.capacity() * sizeof(DataFrame::Range) +
+           rb_begins_.capacity() * sizeof(size_t);
+}
+
 bool ComplexStrippedPartition::ShouldBeConvertedToStrippedPartition() const {
     return should_be_converted_to_sp_;
 }
@@ -363,9 +366,10 @@ std::string ComplexStrippedPartition::CommonToString() const {
     return result.str();
 }
 
-void ComplexStrippedPartition::CommonProduct(model::ColumnIndex attribute) {
+ComplexStrippedPartition ComplexStrippedPartition::CommonProduct(
+        model::ColumnIndex attribute) const {
     auto new_indexes = std::vector<size_t>();
-    new_indexes.reserve(data_->GetColumnCount());
+    new_indexes.reserve(sp_indexes_.size());
 
     auto new_begins = std::vector<size_t>();
     size_t fill_pointer = 0;
@@ -410,9 +414,9 @@ void ComplexStrippedPartition::CommonProduct(model::ColumnIndex attribute) {
     }
 
     new_begins.push_back(new_indexes.size());
+    new_indexes.shrink_to_fit();
 
-    sp_indexes_ = std::move(new_indexes);
-    sp_begins_ = std::move(new_begins);
+    return ComplexStrippedPartition(*data_, std::move(new_indexes), std::move(new_begins));
 }
 
 bool ComplexStrippedPartition::CommonSplit(model::ColumnIndex right) const {
@@ -461,9 +465,11 @@ std::string ComplexStrippedPartition::RangeBasedToString() const {
     return result.str();
 }
 
-void ComplexStrippedPartition::RangeBasedProduct(model::ColumnIndex attribute) {
+ComplexStrippedPartition ComplexStrippedPartition::RangeBasedProduct(
+        model::ColumnIndex attribute) const {
     auto new_begins = std::vector<size_t>();
     auto new_indexes = std::vector<DataFrame::Range>();
+    bool should_be_converted_to_sp = should_be_converted_to_sp_;
 
     size_t curr_begin = 0;
 
@@ -512,17 +518,18 @@ void ComplexStrippedPartition::RangeBasedProduct(model::ColumnIndex attribute) {
 
         add_group(group_start, intersection_size - 1);
 
-        if (!should_be_converted_to_sp_ && intersection_size > 0 &&
+        if (!should_be_converted_to_sp && intersection_size > 0 &&
             small_ranges_count / static_cast<double>(intersection_size) >=
                     kSmallRangesRatioToConvert) {
-            should_be_converted_to_sp_ = true;
+            should_be_converted_to_sp = true;
         }
     }
 
     new_begins.push_back(new_indexes.size());
 
-    rb_indexes_ = std::move(new_indexes);
-    rb_begins_ = std::move(new_begins);
+    ComplexStrippedPartition result(*data_, std::move(new_indexes), std::move(new_begins));
+    result.should_be_converted_to_sp_ = should_be_converted_to_sp;
+    return result;
 }
 
 bool ComplexStrippedPartition::RangeBasedSplit(model::ColumnIndex right) const {
@@ -547,7 +554,7 @@ bool ComplexStrippedPartition::RangeBasedSplit(model::ColumnIndex right) const {
 }
 
 std::vector<DataFrame::ValueIndices> ComplexStrippedPartition::IntersectWithAttribute(
-        model::ColumnIndex attribute, size_t group_start, size_t group_end) {
+        model::ColumnIndex attribute, size_t group_start, size_t group_end) const {
     std::vector<DataFrame::ValueIndices> result;
 
     std::vector<DataFrame::ValueIndices> const& attr_ranges = data_->GetDataRanges()[attribute];
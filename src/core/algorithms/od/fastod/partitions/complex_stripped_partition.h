@@ -35,18 +35,18 @@ private:
     static constexpr inline size_t kMinMeaningfulRangeSize = static_cast<size_t>(40);
 
     std::string CommonToString() const;
-    void CommonProduct(model::ColumnIndex attribute);
+    ComplexStrippedPartition CommonProduct(model::ColumnIndex attribute) const;
     bool CommonSplit(model::ColumnIndex right) const;
     od::RemovalSetAsVec CommonSplitRemovalSet(model::ColumnIndex right) const;
 
     std::string RangeBasedToString() const;
-    void RangeBasedProduct(model::ColumnIndex attribute);
+    ComplexStrippedPartition RangeBasedProduct(model::ColumnIndex attribute) const;
     bool RangeBasedSplit(model::ColumnIndex right) const;
     od::RemovalSetAsVec RangeBasedSplitRemovalSet(model::ColumnIndex right) const;
 
     std::vector<DataFrame::ValueIndices> IntersectWithAttribute(model::ColumnIndex attribute,
                                                                 size_t group_start,
-                                                                size_t group_end);
+                                                                size_t group_end) const;
 
     ComplexStrippedPartition(DataFrame const& data, std::vector<size_t> indexes,
                              std::vector<size_t> begins);
@@ -62,9 +62,14 @@ public:
     ComplexStrippedPartition();
 
     std::string ToString() const;
-    void Product(model::ColumnIndex attribute);
+    // Returns the product of this partition and the partition of `attribute`, this partition is
+    // left untouched, so it can be shared between threads.
+    ComplexStrippedPartition Product(model::ColumnIndex attribute) const;
     bool Split(model::ColumnIndex right) const;
 
+    // Approximate number of bytes occupied by the partition.
+    size_t GetMemoryUsage() const;
+
     bool ShouldBeConvertedToStrippedPartition() const;
     void ToStrippedPartition();
 
@@ -1,47 +1,111 @@
 #pragma once
 
 #include <cstddef>
-#include <queue>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 namespace algos::fastod {
 
+/* Cache of immutable shared values limited by the total size of the values in bytes.
+ * Eviction follows GreedyDual-Size: an entry gets priority `inflation + cost / size`, where
+ * `cost` is the work needed to recompute the value. The entry with the lowest priority is
+ * evicted first and its priority becomes the new inflation value, so entries that are not used
+ * age relative to the recently inserted or used ones.
+ * Evicted values stay alive while someone holds a pointer to them.
+ */
 template <typename K, typename V>
 class CacheWithLimit {
+public:
+    using ValuePtr = std::shared_ptr<V const>;
+
 private:
-    std::unordered_map<K, V> entries_;
-    std::queue<K> keys_in_order_;
-    const size_t max_size_;
+    struct Entry {
+        ValuePtr value;
+        size_t size;
+        double cost;
+        typename std::multimap<double, K>::iterator priority_it;
+    };
+
+    std::unordered_map<K, Entry> entries_;
+    std::multimap<double, K> keys_by_priority_;
+    size_t max_size_;
+    size_t size_ = 0;
+    double inflation_ = 0;
+
+    double GetPriority(Entry const& entry) const noexcept {
+        return inflation_ + entry.cost / static_cast<double>(entry.size == 0 ? 1 : entry.size);
+    }
+
+    void EvictLowestPriority() {
+        auto const lowest_it = keys_by_priority_.begin();
+        auto const entry_it = entries_.find(lowest_it->second);
+
+        inflation_ = lowest_it->first;
+        size_ -= entry_it->second.size;
+        entries_.erase(entry_it);
+        keys_by_priority_.erase(lowest_it);
+    }
 
 public:
     explicit CacheWithLimit(size_t max_size) : max_size_(max_size){};
 
     void Clear() {
         entries_.clear();
-        keys_in_order_ = {};
+        keys_by_priority_.clear();
+        size_ = 0;
+        inflation_ = 0;
     }
 
-    bool Contains(const K& key) const noexcept {
+    void SetMaxSize(size_t max_size) {
+        max_size_ = max_size;
+        while (size_ > max_size_) {
+            EvictLowestPriority();
+        }
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool Contains(K const& key) const noexcept {
         return entries_.find(key) != entries_.end();
     }
 
-    const V& Get(const K& key) const {
-        return entries_.at(key);
+    // Returns nullptr if there is no such key. A hit renews the priority of the entry.
+    ValuePtr Get(K const& key) {
+        auto const it = entries_.find(key);
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+
+        Entry& entry = it->second;
+        keys_by_priority_.erase(entry.priority_it);
+        entry.priority_it = keys_by_priority_.emplace(GetPriority(entry), key);
+        return entry.value;
     }
 
-    V const& GetOrInsert(K const& key, V const& value) {
-        auto [it, inserted] = entries_.try_emplace(key, value);
-        if (!inserted) {
-            return it->second;
+    // Returns the cached value if the key is already present. Values that do not fit into the
+    // limit at all are returned without being cached.
+    ValuePtr GetOrInsert(K const& key, ValuePtr value, size_t size, double cost) {
+        if (auto cached = Get(key)) {
+            return cached;
+        }
+
+        if (size > max_size_) {
+            return value;
         }
 
-        if (keys_in_order_.size() >= max_size_) {
-            entries_.erase(keys_in_order_.front());
-            keys_in_order_.pop();
+        while (size_ + size > max_size_) {
+            EvictLowestPriority();
         }
 
-        keys_in_order_.push(key);
-        return it->second;
+        Entry entry{value, size, cost, {}};
+        entry.priority_it = keys_by_priority_.emplace(GetPriority(entry), key);
+        entries_.emplace(key, std::move(entry));
+        size_ += size;
+        return value;
     }
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 
 #include "core/algorithms/od/fastod/model/attribute_set.h"
 #include "core/algorithms/od/fastod/partitions/complex_stripped_partition.h"
@@ -8,63 +10,102 @@
 
 namespace algos::fastod {
 
+/* Thread-safe cache of stripped partitions limited by memory usage.
+ * Cached partitions are immutable and shared: a product is computed into a new partition, so
+ * neither a cached partition is copied before a product nor is a partition that is in use freed
+ * on eviction. The cost of a partition is the number of its attributes, i.e. the number of
+ * products needed to compute it from scratch.
+ */
 class PartitionCache {
+public:
+    using PartitionPtr = std::shared_ptr<ComplexStrippedPartition const>;
+
+    static constexpr size_t kDefaultMaxBytes = static_cast<size_t>(2) << 30;
+
 private:
-    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{static_cast<size_t>(1e8)};
+    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{kDefaultMaxBytes};
+    std::mutex mutex_;
 
-    void CallProductWithAttribute(ComplexStrippedPartition& partition, size_t attribute) {
-        partition.Product(attribute);
+    static ComplexStrippedPartition CallProductWithAttribute(
+            ComplexStrippedPartition const& partition, size_t attribute) {
+        ComplexStrippedPartition result = partition.Product(attribute);
 
-        if (partition.ShouldBeConvertedToStrippedPartition()) {
-            partition.ToStrippedPartition();
+        if (result.ShouldBeConvertedToStrippedPartition()) {
+            result.ToStrippedPartition();
         }
+
+        return result;
     }
 
-    bool CallProductWithAttributesInCache(ComplexStrippedPartition& result,
-                                          AttributeSet const& attribute_set) {
-        bool is_product_called = false;
+    // Looks for the smallest cached partition of the attribute set without one attribute.
+    // Must be called with mutex_ locked.
+    PartitionPtr FindParentInCache(AttributeSet const& attribute_set,
+                                   model::ColumnIndex& missing_attr) {
+        PartitionPtr parent;
 
         attribute_set.Iterate(
-                [this, &attribute_set, &result, &is_product_called](model::ColumnIndex attr) {
+                [this, &attribute_set, &parent, &missing_attr](model::ColumnIndex attr) {
                     AttributeSet one_less = DeleteAttribute(attribute_set, attr);
-
-                    if (one_less.Any() && cache_.Contains(one_less)) {
-                        result = cache_.Get(one_less);
-                        CallProductWithAttribute(result, attr);
-                        is_product_called = true;
+                    if (!one_less.Any()) return;
+
+                    PartitionPtr candidate = cache_.Get(one_less);
+                    if (candidate != nullptr &&
+                        (parent == nullptr ||
+                         candidate->GetMemoryUsage() < parent->GetMemoryUsage())) {
+                        parent = std::move(candidate);
+                        missing_attr = attr;
                     }
                 });
 
-        return is_product_called;
+        return parent;
     }
 
 public:
     void Clear() {
+        std::scoped_lock lock(mutex_);
         cache_.Clear();
     }
 
-    ComplexStrippedPartition const& GetStrippedPartition(AttributeSet const& attribute_set,
-                                                         DataFrame const& data) {
-        if (cache_.Contains(attribute_set)) {
-            return cache_.Get(attribute_set);
+    void SetMemoryLimit(size_t max_bytes) {
+        std::scoped_lock lock(mutex_);
+        cache_.SetMaxSize(max_bytes);
+    }
+
+    PartitionPtr GetStrippedPartition(AttributeSet const& attribute_set, DataFrame const& data) {
+        PartitionPtr parent;
+        model::ColumnIndex missing_attr = 0;
+
+        {
+            std::scoped_lock lock(mutex_);
+            if (PartitionPtr cached = cache_.Get(attribute_set)) {
+                return cached;
+            }
+            parent = FindParentInCache(attribute_set, missing_attr);
         }
 
         ComplexStrippedPartition result_partition;
-        bool is_product_called = CallProductWithAttributesInCache(result_partition, attribute_set);
 
-        if (!is_product_called) {
+        if (parent != nullptr) {
+            result_partition = CallProductWithAttribute(*parent, missing_attr);
+        } else {
             result_partition = data.IsAttributesMostlyRangeBased(attribute_set)
                                        ? ComplexStrippedPartition::Create<
                                                  ComplexStrippedPartition::Type::kRangeBased>(data)
                                        : ComplexStrippedPartition::Create<
                                                  ComplexStrippedPartition::Type::kStripped>(data);
 
-            attribute_set.Iterate([this, &result_partition](model::ColumnIndex attr) {
-                CallProductWithAttribute(result_partition, attr);
+            attribute_set.Iterate([&result_partition](model::ColumnIndex attr) {
+                result_partition = CallProductWithAttribute(result_partition, attr);
             });
         }
 
-        return cache_.GetOrInsert(attribute_set, result_partition);
+        size_t const size = result_partition.GetMemoryUsage();
+        auto result = std::make_shared<ComplexStrippedPartition const>(std::move(result_partition));
+
+        // Another thread may have computed the same partition meanwhile, then its copy is used
+        std::scoped_lock lock(mutex_);
+        return cache_.GetOrInsert(attribute_set, std::move(result), size,
+                                  static_cast<double>(attribute_set.Count()));
     }
 };
 
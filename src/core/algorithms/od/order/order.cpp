@@ -1,18 +1,23 @@
 #include "core/algorithms/od/order/order.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include "core/algorithms/od/order/dependency_checker.h"
 #include "core/algorithms/od/order/list_lattice.h"
 #include "core/algorithms/od/order/order_utility.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/tuple_index.h"
 #include "core/model/types/types.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
 
 namespace algos::order {
 
@@ -27,17 +32,31 @@ void Order::RegisterOptions() {
     using config::Option;
 
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
+}
+
+void Order::MakeExecuteOptsAvailable() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void Order::LoadDataInternal() {
     typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, false);
 }
 
-void Order::ResetState() {}
+void Order::ResetState() {
+    sorted_partitions_.Clear();
+    single_attributes_.clear();
+    previous_candidate_sets_.clear();
+    candidate_sets_.clear();
+    valid_.clear();
+    merge_invalidated_.clear();
+    lattice_.reset();
+}
 
 void Order::PruneSingleEqClassPartitions() {
-    for (auto& [attr, partition] : sorted_partitions_) {
-        if (partition.Size() == 1) {
+    for (auto const& [attr, partition] : sorted_partitions_.GetSingletons()) {
+        if (partition->Size() == 1) {
             for (AttributeList other_attr : single_attributes_) {
                 if (other_attr != attr) {
                     valid_[attr].insert(other_attr);
@@ -85,24 +104,13 @@ void Order::CreateSingleColumnSortedPartitions() {
             }
         }
         equivalence_classes.shrink_to_fit();
-        sorted_partitions_.emplace(
+        sorted_partitions_.AddSingleton(
                 AttributeList{i},
                 SortedPartition(std::move(equivalence_classes), typed_relation_->GetNumRows()));
     }
     PruneSingleEqClassPartitions();
 }
 
-void Order::CreateSortedPartitionsFromSingletons(AttributeList const& attr_list) {
-    if (sorted_partitions_.find(attr_list) != sorted_partitions_.end()) {
-        return;
-    }
-    SortedPartition res = sorted_partitions_.at({attr_list[0]});
-    for (size_t i = 1; i < attr_list.size(); ++i) {
-        res.Intersect(sorted_partitions_.at({attr_list[i]}));
-    }
-    sorted_partitions_.emplace(attr_list, res);
-}
-
 bool Order::HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) const {
     bool prefix_valid = false;
     for (AttributeList const& rhs_prefix : GetPrefixes(rhs)) {
@@ -114,7 +122,9 @@ bool Order::HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) c
     return prefix_valid;
 }
 
-ValidityType Order::CheckCandidateValidity(AttributeList const& lhs, AttributeList const& rhs) {
+void Order::CheckCandidateValidity(CandidateCheck& check) {
+    AttributeList const& lhs = check.lhs;
+    AttributeList const& rhs = check.rhs;
     bool is_merge_immediately = false;
     for (AttributeList const& lhs_prefix : GetPrefixes(lhs)) {
         if (InUnorderedMap(merge_invalidated_, lhs_prefix, rhs)) {
@@ -122,18 +132,16 @@ ValidityType Order::CheckCandidateValidity(AttributeList const& lhs, AttributeLi
             break;
         }
     }
-    ValidityType candidate_validity = +ValidityType::merge;
+    check.validity = +ValidityType::merge;
     if (!is_merge_immediately) {
-        CreateSortedPartitionsFromSingletons(lhs);
-        if (sorted_partitions_[lhs].Size() == 1) {
-            candidate_validity = +ValidityType::valid;
-            candidate_sets_[lhs].erase(rhs);
+        SortedPartitionCache::PartitionPtr lhs_partition = sorted_partitions_.Get(lhs);
+        check.lhs_partition_size = lhs_partition->Size();
+        if (check.lhs_partition_size == 1) {
+            check.validity = +ValidityType::valid;
         } else {
-            CreateSortedPartitionsFromSingletons(rhs);
-            candidate_validity = CheckForSwap(sorted_partitions_[lhs], sorted_partitions_[rhs]);
+            check.validity = CheckForSwap(*lhs_partition, *sorted_partitions_.Get(rhs));
         }
     }
-    return candidate_validity;
 }
 
 void Order::ComputeDependencies(ListLattice::LatticeLevel const& lattice_level) {
@@ -141,43 +149,66 @@ void Order::ComputeDependencies(ListLattice::LatticeLevel const& lattice_level)
         return;
     }
     UpdateCandidateSets();
+    /* Candidates of one level are independent: the checks only look at the results for
+     * shorter attribute lists, so they are run in parallel and the results are applied in
+     * the order of the candidates afterwards. */
+    std::vector<CandidateCheck> checks;
     for (Node const& node : lattice_level) {
         CandidatePairs candidate_pairs = lattice_->ObtainCandidates(node);
-        for (auto const& [lhs, rhs] : candidate_pairs) {
+        for (auto& [lhs, rhs] : candidate_pairs) {
             if (!InUnorderedMap(candidate_sets_, lhs, rhs)) {
                 continue;
             }
             if (HasValidPrefix(lhs, rhs)) {
                 continue;
             }
-            ValidityType candidate_validity = CheckCandidateValidity(lhs, rhs);
-            if (candidate_validity == +ValidityType::valid) {
-                bool non_minimal_by_merge = false;
-                for (AttributeList const& merge_lhs : GetPrefixes(lhs)) {
-                    if (InUnorderedMap(merge_invalidated_, merge_lhs, rhs)) {
-                        non_minimal_by_merge = true;
-                        break;
-                    }
-                }
-                if (non_minimal_by_merge) {
-                    continue;
-                }
-                if (valid_.find(lhs) == valid_.end()) {
-                    valid_[lhs] = {};
-                }
-                valid_[lhs].insert(rhs);
-                bool lhs_unique = typed_relation_->GetNumRows() == sorted_partitions_[lhs].Size();
-                if (lhs_unique) {
-                    candidate_sets_[lhs].erase(rhs);
-                }
-            } else if (candidate_validity == +ValidityType::swap) {
+            checks.push_back({std::move(lhs), std::move(rhs)});
+        }
+    }
+
+    std::atomic<std::size_t> next_check = 0;
+    auto worker = [this, &checks, &next_check](config::ThreadNumType) {
+        std::size_t check_ind;
+        while ((check_ind = next_check.fetch_add(1, std::memory_order_relaxed)) < checks.size()) {
+            CheckCandidateValidity(checks[check_ind]);
+        }
+    };
+    std::vector<config::ThreadNumType> workers(threads_num_);
+    std::iota(workers.begin(), workers.end(), 0);
+    util::ParallelForeach(workers.begin(), workers.end(), threads_num_, worker);
+
+    for (CandidateCheck const& check : checks) {
+        AttributeList const& lhs = check.lhs;
+        AttributeList const& rhs = check.rhs;
+        if (check.validity == +ValidityType::valid) {
+            if (check.lhs_partition_size == 1) {
                 candidate_sets_[lhs].erase(rhs);
-            } else if (candidate_validity == +ValidityType::merge) {
-                if (merge_invalidated_.find(lhs) == merge_invalidated_.end()) {
-                    merge_invalidated_[lhs] = {};
+            }
+            bool non_minimal_by_merge = false;
+            for (AttributeList const& merge_lhs : GetPrefixes(lhs)) {
+                if (InUnorderedMap(merge_invalidated_, merge_lhs, rhs)) {
+                    non_minimal_by_merge = true;
+                    break;
                 }
-                merge_invalidated_[lhs].insert(rhs);
             }
+            if (non_minimal_by_merge) {
+                continue;
+            }
+            if (valid_.find(lhs) == valid_.end()) {
+                valid_[lhs] = {};
+            }
+            valid_[lhs].insert(rhs);
+            bool lhs_unique = typed_relation_->GetNumRows() == check.lhs_partition_size;
+            if (lhs_unique) {
+                candidate_sets_[lhs].erase(rhs);
+            }
+        } else if (check.validity == +ValidityType::swap) {
+            candidate_sets_[lhs].erase(rhs);
+        } else if (check.validity == +ValidityType::merge) {
+            if (merge_invalidated_.find(lhs) == merge_invalidated_.end()) {
+                merge_invalidated_[lhs] = {};
+            }
+            merge_invalidated_[lhs].insert(rhs);
         }
     }
     MergePrune();
@@ -358,6 +389,7 @@ void Order::PrintValidOD() {
 
 unsigned long long Order::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
+    sorted_partitions_.SetMemoryLimit(static_cast<std::size_t>(mem_limit_mb_) << 20);
     CreateSingleColumnSortedPartitions();
     lattice_ = std::make_unique<ListLattice>(candidate_sets_, single_attributes_);
     while (!lattice_->IsEmpty()) {
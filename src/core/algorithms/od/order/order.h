@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,20 +9,31 @@
 #include "core/algorithms/od/order/dependency_checker.h"
 #include "core/algorithms/od/order/list_lattice.h"
 #include "core/algorithms/od/order/order_utility.h"
-#include "core/algorithms/od/order/sorted_partitions.h"
+#include "core/algorithms/od/order/sorted_partition_cache.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 
 namespace algos::order {
 
 class Order : public Algorithm {
 public:
-    using SortedPartitions = std::unordered_map<Node, SortedPartition, ListHash>;
     using TypedRelation = model::ColumnLayoutTypedRelationData;
 
+    // Result of checking one candidate of a lattice level
+    struct CandidateCheck {
+        AttributeList lhs;
+        AttributeList rhs;
+        ValidityType validity = ValidityType::valid;
+        std::size_t lhs_partition_size = 0;
+    };
+
     config::InputTable input_table_;
+    config::ThreadNumType threads_num_ = 1;
+    config::MemLimitMBType mem_limit_mb_ = 0;
     std::unique_ptr<TypedRelation> typed_relation_;
-    SortedPartitions sorted_partitions_;
+    SortedPartitionCache sorted_partitions_;
     std::vector<AttributeList> single_attributes_;
     CandidateSets previous_candidate_sets_;
     CandidateSets candidate_sets_;
@@ -30,13 +42,14 @@ public:
     std::unique_ptr<ListLattice> lattice_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailable() override;
     void LoadDataInternal() override;
     void ResetState() override;
     void PruneSingleEqClassPartitions();
     void CreateSingleColumnSortedPartitions();
-    void CreateSortedPartitionsFromSingletons(AttributeList const& attr_list);
     bool HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) const;
-    ValidityType CheckCandidateValidity(AttributeList const& lhs, AttributeList const& rhs);
+    // Only reads the state shared between the candidates of a level
+    void CheckCandidateValidity(CandidateCheck& check);
     void ComputeDependencies(ListLattice::LatticeLevel const& lattice_level);
     std::vector<AttributeList> Extend(AttributeList const& lhs, AttributeList const& rhs) const;
     bool IsMinimal(AttributeList const& a) const;
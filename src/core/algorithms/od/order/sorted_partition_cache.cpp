@@ -0,0 +1,92 @@
+#include "core/algorithms/od/order/sorted_partition_cache.h"
+
+#include <iterator>
+#include <utility>
+
+namespace algos::order {
+
+SortedPartitionCache::PartitionPtr SortedPartitionCache::FindCached(
+        AttributeList const& attr_list) {
+    if (attr_list.size() == 1) {
+        return singletons_.at(attr_list);
+    }
+
+    auto it = partitions_.find(attr_list);
+    if (it == partitions_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+    return it->second.partition;
+}
+
+SortedPartitionCache::PartitionPtr SortedPartitionCache::Insert(AttributeList const& attr_list,
+                                                                PartitionPtr partition) {
+    if (PartitionPtr cached = FindCached(attr_list)) {
+        return cached;
+    }
+
+    std::size_t const size = partition->GetMemoryUsage();
+    if (size > max_bytes_) {
+        return partition;
+    }
+
+    while (size_ + size > max_bytes_) {
+        auto const lru_it = std::prev(lru_.end());
+        auto const entry_it = partitions_.find(*lru_it);
+        size_ -= entry_it->second.size;
+        partitions_.erase(entry_it);
+        lru_.erase(lru_it);
+    }
+
+    lru_.push_front(attr_list);
+    partitions_.emplace(attr_list, Entry{partition, size, lru_.begin()});
+    size_ += size;
+    return partition;
+}
+
+void SortedPartitionCache::Clear() {
+    std::scoped_lock lock(mutex_);
+    singletons_.clear();
+    partitions_.clear();
+    lru_.clear();
+    size_ = 0;
+}
+
+void SortedPartitionCache::SetMemoryLimit(std::size_t max_bytes) {
+    std::scoped_lock lock(mutex_);
+    max_bytes_ = max_bytes;
+}
+
+void SortedPartitionCache::AddSingleton(AttributeList const& attr, SortedPartition partition) {
+    singletons_.emplace(attr, std::make_shared<SortedPartition const>(std::move(partition)));
+}
+
+SortedPartitionCache::PartitionPtr SortedPartitionCache::Get(AttributeList const& attr_list) {
+    PartitionPtr res;
+    std::size_t prefix_size = attr_list.size();
+    {
+        std::scoped_lock lock(mutex_);
+        for (; prefix_size > 1; --prefix_size) {
+            res = FindCached(AttributeList(attr_list.begin(), attr_list.begin() + prefix_size));
+            if (res != nullptr) break;
+        }
+    }
+    if (prefix_size == attr_list.size() && res != nullptr) {
+        return res;
+    }
+    if (res == nullptr) {
+        res = singletons_.at({attr_list.front()});
+    }
+
+    // Every prefix is cached, prefixes of attribute lists are often candidates themselves
+    for (std::size_t i = prefix_size; i < attr_list.size(); ++i) {
+        auto product = std::make_shared<SortedPartition const>(
+                res->Intersect(*singletons_.at({attr_list[i]})));
+        std::scoped_lock lock(mutex_);
+        res = Insert(AttributeList(attr_list.begin(), attr_list.begin() + i + 1),
+                     std::move(product));
+    }
+    return res;
+}
+
+}  // namespace algos::order
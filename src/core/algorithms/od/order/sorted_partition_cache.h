@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/algorithms/od/order/order_utility.h"
+#include "core/algorithms/od/order/sorted_partitions.h"
+
+namespace algos::order {
+
+/* Thread-safe store of sorted partitions shared between candidates.
+ * Partitions of single attributes are kept for the whole run. Partitions of attribute lists are
+ * built from the longest cached prefix and kept in an LRU cache limited by memory usage.
+ * Partitions are immutable, an evicted partition stays alive while a candidate uses it.
+ */
+class SortedPartitionCache {
+public:
+    using PartitionPtr = std::shared_ptr<SortedPartition const>;
+
+    static constexpr std::size_t kDefaultMaxBytes = static_cast<std::size_t>(2) << 30;
+
+private:
+    struct Entry {
+        PartitionPtr partition;
+        std::size_t size;
+        std::list<AttributeList>::iterator lru_it;
+    };
+
+    std::unordered_map<AttributeList, PartitionPtr, ListHash> singletons_;
+    std::unordered_map<AttributeList, Entry, ListHash> partitions_;
+    /* Most recently used attribute lists are at the front */
+    std::list<AttributeList> lru_;
+    std::size_t max_bytes_ = kDefaultMaxBytes;
+    std::size_t size_ = 0;
+    std::mutex mutex_;
+
+    // Must be called with mutex_ locked
+    PartitionPtr FindCached(AttributeList const& attr_list);
+    // Must be called with mutex_ locked
+    PartitionPtr Insert(AttributeList const& attr_list, PartitionPtr partition);
+
+public:
+    void Clear();
+    void SetMemoryLimit(std::size_t max_bytes);
+
+    // Not thread-safe, singletons must be added before the partitions are requested
+    void AddSingleton(AttributeList const& attr, SortedPartition partition);
+
+    std::unordered_map<AttributeList, PartitionPtr, ListHash> const& GetSingletons() const {
+        return singletons_;
+    }
+
+    PartitionPtr Get(AttributeList const& attr_list);
+};
+
+}  // namespace algos::order
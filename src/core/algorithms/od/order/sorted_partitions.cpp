@@ -1,70 +1,103 @@
 #include "core/algorithms/od/order/sorted_partitions.h"
 
-#include <unordered_map>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "core/model/table/tuple_index.h"
 
 namespace algos::order {
 
-void SortedPartition::BuildHashTable() {
-    hash_partition_.reserve(num_rows_);
+namespace {
+
+/* Tables used to intersect partitions. They are kept per thread and only grow, so products
+ * do not allocate hash tables over and over again.
+ */
+struct IntersectScratch {
+    static constexpr SortedPartition::PartitionIndex kNoPosition =
+            std::numeric_limits<SortedPartition::PartitionIndex>::max();
+
+    /* Index of the class of the left partition containing the tuple, or kNoPosition for
+     * tuples from single-tuple classes */
+    std::vector<SortedPartition::PartitionIndex> positions;
+    /* Tuples of every class of the left partition, each tagged with the index of the class of
+     * the right partition containing it. Tags are nondecreasing inside of a bucket */
+    std::vector<std::vector<std::pair<SortedPartition::PartitionIndex, model::TupleIndex>>>
+            buckets;
+};
+
+IntersectScratch& GetScratch() {
+    thread_local IntersectScratch scratch;
+    return scratch;
+}
+
+}  // namespace
+
+SortedPartition SortedPartition::Intersect(SortedPartition const& other) const {
+    IntersectScratch& scratch = GetScratch();
+    std::vector<PartitionIndex>& positions = scratch.positions;
+    auto& buckets = scratch.buckets;
+
+    if (positions.size() < num_rows_) {
+        positions.resize(num_rows_, IntersectScratch::kNoPosition);
+    }
+    if (buckets.size() < sorted_partition_.size()) {
+        buckets.resize(sorted_partition_.size());
+    }
+
     for (PartitionIndex i = 0; i < sorted_partition_.size(); ++i) {
         if (sorted_partition_[i].size() == 1) {
             continue;
         }
         for (model::TupleIndex tuple_index : sorted_partition_[i]) {
-            hash_partition_.emplace(tuple_index, i);
+            positions[tuple_index] = i;
         }
     }
-}
 
-SortedPartition::HashProduct SortedPartition::BuildHashProduct(SortedPartition const& other) {
-    HashProduct hash_product;
-    hash_product.reserve(hash_partition_.size());
-    for (EquivalenceClass const& eq_class : other.sorted_partition_) {
-        if (other.sorted_partition_.size() <= 1) {
-            break;
-        }
-        std::unordered_set<PartitionIndex> visited_positions;
-        for (model::TupleIndex tuple_index : eq_class) {
-            auto it = hash_partition_.find(tuple_index);
-            if (it == hash_partition_.end()) {
-                continue;
+    for (PartitionIndex j = 0; j < other.sorted_partition_.size(); ++j) {
+        for (model::TupleIndex tuple_index : other.sorted_partition_[j]) {
+            PartitionIndex const position = positions[tuple_index];
+            if (position != IntersectScratch::kNoPosition) {
+                buckets[position].emplace_back(j, tuple_index);
             }
-            PartitionIndex position = it->second;
-            visited_positions.insert(position);
-            auto pos_it = hash_product.find(position);
-            if (pos_it == hash_product.end()) {
-                pos_it = hash_product.emplace(position, EquivalenceClasses{{}}).first;
-            }
-            pos_it->second.back().insert(tuple_index);
-        }
-        for (PartitionIndex position : visited_positions) {
-            hash_product[position].emplace_back();
         }
     }
-    return hash_product;
-}
 
-void SortedPartition::Intersect(SortedPartition const& other) {
-    BuildHashTable();
-    HashProduct hash_product = BuildHashProduct(other);
     SortedPartition res(num_rows_);
     res.sorted_partition_.reserve(num_rows_);
-    for (std::size_t i = 0; i < sorted_partition_.size(); ++i) {
-        if (EquivalenceClass const& eq_class = sorted_partition_[i]; eq_class.size() == 1) {
+    for (PartitionIndex i = 0; i < sorted_partition_.size(); ++i) {
+        EquivalenceClass const& eq_class = sorted_partition_[i];
+        if (eq_class.size() == 1) {
             res.sorted_partition_.push_back(eq_class);
-        } else {
-            for (EquivalenceClass& eq_class : hash_product[i]) {
-                if (!eq_class.empty()) {
-                    res.sorted_partition_.push_back(std::move(eq_class));
-                }
+            continue;
+        }
+
+        auto& bucket = buckets[i];
+        for (size_t k = 0; k < bucket.size(); ++k) {
+            if (k == 0 || bucket[k].first != bucket[k - 1].first) {
+                res.sorted_partition_.emplace_back();
             }
+            res.sorted_partition_.back().insert(bucket[k].second);
+        }
+        bucket.clear();
+
+        for (model::TupleIndex tuple_index : eq_class) {
+            positions[tuple_index] = IntersectScratch::kNoPosition;
         }
     }
     res.sorted_partition_.shrink_to_fit();
-    *this = std::move(res);
+    return res;
+}
+
+std::size_t SortedPartition::GetMemoryUsage() const {
+    // Every element of an unordered_set is a separately allocated node with a bucket pointer
+    constexpr std::size_t kElementBytes = sizeof(model::TupleIndex) + 3 * sizeof(void*);
+    std::size_t size =
+            sizeof(SortedPartition) + sorted_partition_.capacity() * sizeof(EquivalenceClass);
+    for (EquivalenceClass const& eq_class : sorted_partition_) {
+        size += eq_class.size() * kElementBytes;
+    }
+    return size;
 }
 
 }  // namespace algos::order
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -13,22 +14,20 @@ public:
     using EquivalenceClass = std::unordered_set<model::TupleIndex>;
     using EquivalenceClasses = std::vector<EquivalenceClass>;
     using PartitionIndex = unsigned long;
-    using HashProduct = std::unordered_map<PartitionIndex, EquivalenceClasses>;
 
 private:
     EquivalenceClasses sorted_partition_;
-    std::unordered_map<model::TupleIndex, PartitionIndex> hash_partition_;
     unsigned long num_rows_ = 0;
 
-    void BuildHashTable();
-    HashProduct BuildHashProduct(SortedPartition const& other);
-
 public:
     SortedPartition() = default;
     explicit SortedPartition(unsigned long num_rows) noexcept : num_rows_(num_rows){};
     SortedPartition(EquivalenceClasses&& eq_classes, unsigned long num_rows)
         : sorted_partition_(std::move(eq_classes)), num_rows_(num_rows){};
-    void Intersect(SortedPartition const& other);
+
+    // Returns the partition refined by `other`, this partition is left untouched.
+    // Uses scratch tables of the calling thread, which are reused between calls.
+    SortedPartition Intersect(SortedPartition const& other) const;
 
     EquivalenceClasses const& GetEqClasses() const {
         return sorted_partition_;
@@ -37,6 +36,9 @@ public:
     std::size_t Size() const {
         return sorted_partition_.size();
     }
+
+    // Approximate number of bytes occupied by the partition.
+    std::size_t GetMemoryUsage() const;
 };
 
 }  // namespace algos::order
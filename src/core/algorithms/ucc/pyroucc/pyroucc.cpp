@@ -88,7 +88,6 @@ unsigned long long PyroUCC::ExecuteInternal() {
 
     LOG_INFO("Init time: {} ms", init_time_millis);
     LOG_INFO("Time: {}  milliseconds", elapsed_milliseconds.count());
-    LOG_INFO("Total intersection time: {} ms", model::PositionListIndex::micros_ / 1000);
     return elapsed_milliseconds.count();
 }
 
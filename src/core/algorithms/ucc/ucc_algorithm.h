@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -9,6 +10,7 @@
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/util/primitive_collection.h"
+#include "core/util/primitive_sink.h"
 
 namespace algos {
 
@@ -20,6 +22,10 @@ private:
         ResetUCCAlgorithmState();
     }
 
+    void FlushResults() final {
+        ucc_collection_.Flush();
+    }
+
     virtual void ResetUCCAlgorithmState() = 0;
 
     void RegisterOptions();
@@ -33,13 +39,18 @@ protected:
 public:
     UCCAlgorithm();
 
-    std::list<model::UCC> const& UCCList() const noexcept {
+    std::list<model::UCC> const& UCCList() const {
         return ucc_collection_.AsList();
     }
 
-    std::list<model::UCC>& UCCList() noexcept {
+    std::list<model::UCC>& UCCList() {
         return ucc_collection_.AsList();
     }
+
+    // Mined UCCs are passed to the sink instead of UCCList, nullptr returns to the default
+    void SetUccSink(std::shared_ptr<util::PrimitiveSink<model::UCC>> sink) {
+        ucc_collection_.SetSink(std::move(sink));
+    }
 };
 
 }  // namespace algos
@@ -147,6 +147,9 @@ constexpr auto kDIgnoreNullCols =
 constexpr auto kDSampleSize =
         "Size of a table sample. Greater value - more correct answers, but higher memory "
         "consumption.\n Applies to all tables";
+constexpr auto kDTempDirectory =
+        "directory for the hashed columns of the tables (if empty, \"temp\" in the current "
+        "working directory is used)";
 // FAIDA, MIND
 constexpr auto kDMaximumArity = "max considered arity";
 // FastADC
@@ -66,6 +66,7 @@ constexpr auto kHllAccuracy = "hll_accuracy";
 constexpr auto kIgnoreConstantCols = "ignore_constant_cols";
 constexpr auto kIgnoreNullCols = "ignore_null_cols";
 constexpr auto kSampleSize = "sample_size";
+constexpr auto kTempDirectory = "temp_dir";
 // FAIDA, MIND
 constexpr auto kMaximumArity = "max_arity";
 // FastADC
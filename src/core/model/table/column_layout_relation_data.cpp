@@ -45,6 +45,10 @@ std::shared_ptr<model::PLIWS const> ColumnLayoutRelationData::CalculatePLIWS(
 
 std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
         model::IDatasetStream& data_stream) {
+    if (auto const* snapshot = dynamic_cast<model::RelationSnapshot const*>(&data_stream)) {
+        return CreateFrom(*snapshot);
+    }
+
     auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
     std::unordered_map<std::string, int> value_dictionary;
     int next_value_id = 0;
@@ -88,3 +92,18 @@ std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
 
     return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
 }
+
+std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
+        model::RelationSnapshot const& snapshot) {
+    auto schema = std::make_unique<RelationalSchema>(snapshot.GetRelationName());
+    size_t const num_columns = snapshot.GetNumberOfColumns();
+
+    std::vector<ColumnData> column_data;
+    for (size_t i = 0; i < num_columns; ++i) {
+        auto column = Column(schema.get(), snapshot.GetColumnName(i), i);
+        schema->AppendColumn(std::move(column));
+        column_data.emplace_back(schema->GetColumn(i), snapshot.LoadPLI(i));
+    }
+
+    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+}
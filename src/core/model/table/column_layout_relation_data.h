@@ -12,6 +12,7 @@
 #include "core/model/table/idataset_stream.h"
 #include "core/model/table/position_list_index_with_singletons.h"
 #include "core/model/table/relation_data.h"
+#include "core/model/table/relation_snapshot.h"
 #include "core/model/table/relational_schema.h"
 
 class ColumnLayoutRelationData final : public RelationData {
@@ -34,4 +35,7 @@ public:
             std::vector<unsigned int> const& indices) const;
 
     static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(model::IDatasetStream& data_stream);
+
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            model::RelationSnapshot const& snapshot);
 };
@@ -18,12 +18,11 @@
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/vertical.h"
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace model {
 
 int const PositionListIndex::kSingletonValueId = 0;
-unsigned long long PositionListIndex::micros_ = 0;
-int PositionListIndex::intersection_count_ = 0;
 
 PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index, unsigned int size,
                                      double entropy, unsigned long long nep,
@@ -147,6 +146,8 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Intersect(
 std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
         std::shared_ptr<std::vector<int> const> probing_table) const {
     assert(this->relation_size_ == probing_table->size());
+    DESBORDANTE_METRICS_PHASE("pli_intersection");
+    DESBORDANTE_METRICS_RECORD("pli_intersection_rows", size_);
     std::deque<std::vector<int>> new_index;
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
@@ -165,7 +166,6 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
             }
             int probing_table_value_id = (*probing_table)[position];
             if (probing_table_value_id == kSingletonValueId) continue;
-            intersection_count_++;
             partial_index[probing_table_value_id].push_back(position);
         }
 
@@ -192,6 +192,8 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
 std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
         Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
     assert(this->relation_size_ == relation_data.GetNumRows());
+    DESBORDANTE_METRICS_PHASE("pli_intersection");
+    DESBORDANTE_METRICS_RECORD("pli_intersection_rows", size_);
     std::deque<std::vector<int>> new_index;
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
@@ -42,8 +42,6 @@ private:
     unsigned int freq_ = 0;
 
 public:
-    static int intersection_count_;
-    static unsigned long long micros_;
     static int const kSingletonValueId;
 
     PositionListIndex(std::deque<Cluster> index, unsigned int size, double entropy,
@@ -68,6 +66,11 @@ public:
         probing_table_cache_ = CalculateAndGetProbingTable();
     };
 
+    // кеширует уже готовую PT (например, загруженную из снимка таблицы), не вычисляя её заново
+    void CacheProbingTable(std::shared_ptr<std::vector<int> const> probing_table) {
+        probing_table_cache_ = std::move(probing_table);
+    }
+
     // Такая структура с кешированием ProbingTable нужна, потому что к PT одиночных колонок
     // происходят частые обращения, чтобы узнать какую-то одну конкретную позицию, тогда как PT
     // наборов колонок обычно используются, чтобы один раз пересечь две партиции, и больше к ним не
@@ -17,6 +17,7 @@
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/vertical.h"
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace model {
 PLIWithSingletons::PLIWithSingletons(std::deque<std::vector<int>> index,
@@ -88,6 +89,8 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
         std::shared_ptr<std::vector<int> const> probing_table) const {
     if (this->relation_size_ != probing_table->size())
         throw std::invalid_argument("received different number of rows");
+    DESBORDANTE_METRICS_PHASE("pli_intersection");
+    DESBORDANTE_METRICS_RECORD("pli_intersection_rows", size_);
     std::deque<std::vector<int>> new_index;
     std::deque<std::vector<int>> singletons(singletons_);
     unsigned int new_size = 0;
@@ -110,7 +113,6 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
                 partial_index[kSingletonValueId].push_back(position);
                 continue;
             }
-            intersection_count_++;
             partial_index[probing_table_value_id].push_back(position);
         }
 
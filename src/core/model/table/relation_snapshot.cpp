@@ -0,0 +1,389 @@
+#include "core/model/table/relation_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "core/util/logger.h"
+
+namespace model {
+
+/* All sections of the file start at a multiple of kAlignment, so that the arrays can be used in
+ * place once the file is mapped. Offsets are counted from the beginning of the file. */
+struct RelationSnapshot::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t num_rows;
+    std::uint64_t num_columns;
+    std::uint64_t relation_name_offset;
+    std::uint64_t relation_name_size;
+    std::uint64_t columns_offset;
+    std::uint64_t file_size;
+};
+
+struct RelationSnapshot::ColumnEntry {
+    std::uint64_t name_offset;
+    std::uint64_t name_size;
+    // dictionary_size + 1 offsets into the concatenated dictionary values
+    std::uint64_t dictionary_size;
+    std::uint64_t dictionary_offsets_offset;
+    std::uint64_t dictionary_values_offset;
+    // num_rows codes
+    std::uint64_t codes_offset;
+    // num_rows values
+    std::uint64_t probing_table_offset;
+    // num_clusters + 1 offsets into the concatenated positions of non-singleton clusters
+    std::uint64_t num_clusters;
+    std::uint64_t cluster_offsets_offset;
+    std::uint64_t cluster_positions_offset;
+    // positions of single-element clusters
+    std::uint64_t num_singletons;
+    std::uint64_t singletons_offset;
+    std::uint64_t pli_size;
+    std::uint64_t nep;
+    double entropy;
+    double inverted_entropy;
+    double gini_impurity;
+};
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'E', 'S', 'B', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::uint64_t kAlignment = 8;
+
+static_assert(std::is_trivially_copyable_v<RelationSnapshot::Header>);
+static_assert(std::is_trivially_copyable_v<RelationSnapshot::ColumnEntry>);
+static_assert(sizeof(RelationSnapshot::Header) % kAlignment == 0);
+static_assert(sizeof(RelationSnapshot::ColumnEntry) % kAlignment == 0);
+
+class SnapshotWriter {
+private:
+    std::ofstream out_;
+    std::uint64_t offset_ = 0;
+
+    void Pad() {
+        static constexpr char kZeros[kAlignment] = {};
+        std::uint64_t const remainder = offset_ % kAlignment;
+        if (remainder == 0) return;
+        out_.write(kZeros, kAlignment - remainder);
+        offset_ += kAlignment - remainder;
+    }
+
+public:
+    explicit SnapshotWriter(std::filesystem::path const& path)
+        : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("Error: couldn't open file " + path.string());
+        }
+    }
+
+    template <typename T>
+    std::uint64_t Append(T const* data, std::size_t count) {
+        Pad();
+        std::uint64_t const start = offset_;
+        out_.write(reinterpret_cast<char const*>(data), count * sizeof(T));
+        offset_ += count * sizeof(T);
+        return start;
+    }
+
+    std::uint64_t Append(std::string_view str) {
+        return Append(str.data(), str.size());
+    }
+
+    template <typename T>
+    void Overwrite(std::uint64_t offset, T const& value) {
+        out_.seekp(offset);
+        out_.write(reinterpret_cast<char const*>(&value), sizeof(T));
+        out_.seekp(offset_);
+    }
+
+    std::uint64_t Finish() {
+        Pad();
+        out_.flush();
+        if (!out_) throw std::runtime_error("Error: couldn't write relation snapshot");
+        return offset_;
+    }
+};
+
+/* Dictionary of a single column. Global ids are assigned exactly like in
+ * ColumnLayoutRelationData::CreateFrom, so that the stored PLIs (and their floating-point
+ * statistics, which depend on the order of hash map traversal) are identical to the ones built
+ * from the original table. */
+struct ColumnDictionary {
+    std::unordered_map<std::string, std::uint32_t> codes;
+    std::vector<std::string> values;
+    std::vector<int> global_ids;
+    std::vector<std::uint32_t> column;
+};
+
+}  // namespace
+
+void RelationSnapshot::Write(IDatasetStream& data_stream, std::filesystem::path const& path) {
+    std::size_t const num_columns = data_stream.GetNumberOfColumns();
+    std::unordered_map<std::string, int> value_dictionary;
+    int next_value_id = 0;
+    std::vector<ColumnDictionary> dictionaries(num_columns);
+
+    while (data_stream.HasNextRow()) {
+        Row row = data_stream.GetNextRow();
+
+        if (row.size() != num_columns) {
+            LOG_WARN(
+                    "Unexpected number of columns for a row, "
+                    "skipping (expected {}, got {})",
+                    num_columns, row.size());
+            continue;
+        }
+
+        for (std::size_t index = 0; index < num_columns; ++index) {
+            ColumnDictionary& dictionary = dictionaries[index];
+            std::string& field = row[index];
+            auto [it, inserted] = dictionary.codes.try_emplace(field, dictionary.values.size());
+            if (inserted) {
+                auto [global_it, global_inserted] =
+                        value_dictionary.try_emplace(field, next_value_id);
+                if (global_inserted) ++next_value_id;
+                dictionary.global_ids.push_back(global_it->second);
+                dictionary.values.push_back(std::move(field));
+            }
+            dictionary.column.push_back(it->second);
+        }
+    }
+    value_dictionary.clear();
+
+    SnapshotWriter writer(path);
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.num_rows = num_columns == 0 ? 0 : dictionaries.front().column.size();
+    header.num_columns = num_columns;
+    writer.Append(&header, 1);
+
+    std::string const relation_name = data_stream.GetRelationName();
+    header.relation_name_offset = writer.Append(relation_name);
+    header.relation_name_size = relation_name.size();
+
+    std::vector<ColumnEntry> entries(num_columns);
+    for (std::size_t index = 0; index < num_columns; ++index) {
+        ColumnDictionary& dictionary = dictionaries[index];
+        ColumnEntry& entry = entries[index];
+
+        std::string const name = data_stream.GetColumnName(index);
+        entry.name_offset = writer.Append(name);
+        entry.name_size = name.size();
+
+        std::vector<std::uint64_t> value_offsets{0};
+        std::string values;
+        for (std::string const& value : dictionary.values) {
+            values += value;
+            value_offsets.push_back(values.size());
+        }
+        entry.dictionary_size = dictionary.values.size();
+        entry.dictionary_offsets_offset = writer.Append(value_offsets.data(), value_offsets.size());
+        entry.dictionary_values_offset = writer.Append(values);
+        entry.codes_offset = writer.Append(dictionary.column.data(), dictionary.column.size());
+
+        std::vector<int> global_column(dictionary.column.size());
+        std::transform(dictionary.column.begin(), dictionary.column.end(), global_column.begin(),
+                       [&dictionary](std::uint32_t code) { return dictionary.global_ids[code]; });
+        dictionary = ColumnDictionary{};
+        auto pli = PLIWithSingletons::CreateFor(global_column);
+
+        std::shared_ptr<std::vector<int> const> probing_table = pli->CalculateAndGetProbingTable();
+        entry.probing_table_offset = writer.Append(probing_table->data(), probing_table->size());
+
+        std::vector<std::uint64_t> cluster_offsets{0};
+        std::vector<int> cluster_positions;
+        for (PLI::Cluster const& cluster : pli->GetIndex()) {
+            cluster_positions.insert(cluster_positions.end(), cluster.begin(), cluster.end());
+            cluster_offsets.push_back(cluster_positions.size());
+        }
+        entry.num_clusters = pli->GetIndex().size();
+        entry.cluster_offsets_offset =
+                writer.Append(cluster_offsets.data(), cluster_offsets.size());
+        entry.cluster_positions_offset =
+                writer.Append(cluster_positions.data(), cluster_positions.size());
+
+        std::vector<int> singletons;
+        for (PLI::Cluster const& cluster : pli->GetSingletons()) {
+            singletons.insert(singletons.end(), cluster.begin(), cluster.end());
+        }
+        entry.num_singletons = singletons.size();
+        entry.singletons_offset = writer.Append(singletons.data(), singletons.size());
+
+        entry.pli_size = pli->GetSize();
+        entry.nep = pli->GetNepAsLong();
+        entry.entropy = pli->GetEntropy();
+        entry.inverted_entropy = pli->GetInvertedEntropy();
+        entry.gini_impurity = pli->GetGiniImpurity();
+    }
+
+    header.columns_offset = writer.Append(entries.data(), entries.size());
+    header.file_size = writer.Finish();
+    writer.Overwrite(0, header);
+    writer.Finish();
+}
+
+RelationSnapshot::RelationSnapshot(std::filesystem::path const& path) {
+    if (!std::filesystem::exists(path)) {
+        throw std::runtime_error("Error: couldn't find file " + path.string());
+    }
+    if (std::filesystem::file_size(path) < sizeof(Header)) {
+        throw std::runtime_error("Error: " + path.string() + " is not a relation snapshot");
+    }
+    file_ = boost::interprocess::file_mapping(path.string().c_str(),
+                                              boost::interprocess::read_only);
+    region_ = boost::interprocess::mapped_region(file_, boost::interprocess::read_only);
+    header_ = static_cast<Header const*>(region_.get_address());
+    Validate();
+    columns_ = GetArray<ColumnEntry>(header_->columns_offset, header_->num_columns).data();
+}
+
+void RelationSnapshot::Validate() const {
+    if (std::memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Error: the file is not a relation snapshot");
+    }
+    if (header_->version != kVersion) {
+        throw std::runtime_error("Error: unsupported relation snapshot version " +
+                                 std::to_string(header_->version));
+    }
+    if (header_->byte_order != kByteOrderMark) {
+        throw std::runtime_error("Error: the relation snapshot was written on a machine with "
+                                 "a different byte order");
+    }
+    if (header_->file_size != region_.get_size()) {
+        throw std::runtime_error("Error: the relation snapshot is truncated");
+    }
+}
+
+std::shared_ptr<RelationSnapshot> RelationSnapshot::Open(std::filesystem::path const& path) {
+    return std::shared_ptr<RelationSnapshot>(new RelationSnapshot(path));
+}
+
+template <typename T>
+std::span<T const> RelationSnapshot::GetArray(std::uint64_t offset, std::uint64_t size) const {
+    std::uint64_t const region_size = region_.get_size();
+    if (offset % alignof(T) != 0 || offset > region_size ||
+        size > (region_size - offset) / sizeof(T)) {
+        throw std::runtime_error("Error: the relation snapshot is corrupted");
+    }
+    auto const* base = static_cast<char const*>(region_.get_address());
+    return {reinterpret_cast<T const*>(base + offset), static_cast<std::size_t>(size)};
+}
+
+void RelationSnapshot::ReleasePages([[maybe_unused]] std::uint64_t offset,
+                                    [[maybe_unused]] std::uint64_t size) const {
+#ifdef __linux__
+    // Only whole pages inside the section, its first and last pages may hold other sections
+    std::uint64_t const page_size = boost::interprocess::mapped_region::get_page_size();
+    std::uint64_t const begin = (offset + page_size - 1) / page_size * page_size;
+    std::uint64_t const end = (offset + size) / page_size * page_size;
+    if (begin >= end) return;
+    // The mapping is read-only and file-backed, so dropped pages are read from the file again if
+    // they are ever accessed
+    auto* base = static_cast<char*>(region_.get_address());
+    ::madvise(base + begin, end - begin, MADV_DONTNEED);
+#endif
+}
+
+std::string_view RelationSnapshot::GetString(std::uint64_t offset, std::uint64_t size) const {
+    std::span<char const> chars = GetArray<char>(offset, size);
+    return {chars.data(), chars.size()};
+}
+
+std::size_t RelationSnapshot::GetNumberOfRows() const {
+    return header_->num_rows;
+}
+
+std::size_t RelationSnapshot::GetNumberOfColumns() const {
+    return header_->num_columns;
+}
+
+std::string RelationSnapshot::GetColumnName(std::size_t index) const {
+    ColumnEntry const& column = columns_[index];
+    return std::string(GetString(column.name_offset, column.name_size));
+}
+
+std::string RelationSnapshot::GetRelationName() const {
+    return std::string(GetString(header_->relation_name_offset, header_->relation_name_size));
+}
+
+std::span<std::uint32_t const> RelationSnapshot::GetCodes(std::size_t column_index) const {
+    return GetArray<std::uint32_t>(columns_[column_index].codes_offset, header_->num_rows);
+}
+
+std::size_t RelationSnapshot::GetDictionarySize(std::size_t column_index) const {
+    return columns_[column_index].dictionary_size;
+}
+
+std::string_view RelationSnapshot::GetDictionaryValue(std::size_t column_index,
+                                                      std::uint32_t code) const {
+    ColumnEntry const& column = columns_[column_index];
+    std::span<std::uint64_t const> offsets =
+            GetArray<std::uint64_t>(column.dictionary_offsets_offset, column.dictionary_size + 1);
+    if (code >= column.dictionary_size) {
+        throw std::out_of_range("Dictionary code is out of range");
+    }
+    std::uint64_t const begin = offsets[code];
+    return GetString(column.dictionary_values_offset + begin, offsets[code + 1] - begin);
+}
+
+std::string_view RelationSnapshot::GetValue(std::size_t column_index, std::size_t row) const {
+    return GetDictionaryValue(column_index, GetCodes(column_index)[row]);
+}
+
+std::unique_ptr<PLIWithSingletons> RelationSnapshot::LoadPLI(std::size_t column_index) const {
+    ColumnEntry const& column = columns_[column_index];
+    std::span<std::uint64_t const> offsets =
+            GetArray<std::uint64_t>(column.cluster_offsets_offset, column.num_clusters + 1);
+    std::span<int const> positions =
+            GetArray<int>(column.cluster_positions_offset, offsets.back());
+
+    std::deque<PLI::Cluster> clusters;
+    for (std::size_t i = 0; i < column.num_clusters; ++i) {
+        clusters.emplace_back(positions.begin() + offsets[i], positions.begin() + offsets[i + 1]);
+    }
+    std::deque<PLI::Cluster> singletons;
+    for (int position : GetArray<int>(column.singletons_offset, column.num_singletons)) {
+        singletons.push_back({position});
+    }
+
+    auto pli = std::make_unique<PLIWithSingletons>(
+            std::move(clusters), std::move(singletons), column.pli_size, column.entropy,
+            column.nep, header_->num_rows, column.inverted_entropy, column.gini_impurity);
+    std::span<int const> probing_table =
+            GetArray<int>(column.probing_table_offset, header_->num_rows);
+    pli->CacheProbingTable(
+            std::make_shared<std::vector<int> const>(probing_table.begin(), probing_table.end()));
+
+    ReleasePages(column.cluster_positions_offset, positions.size_bytes());
+    ReleasePages(column.singletons_offset, column.num_singletons * sizeof(int));
+    ReleasePages(column.probing_table_offset, probing_table.size_bytes());
+    return pli;
+}
+
+IDatasetStream::Row RelationSnapshot::GetNextRow() {
+    std::size_t const num_columns = GetNumberOfColumns();
+    Row row;
+    row.reserve(num_columns);
+    for (std::size_t index = 0; index < num_columns; ++index) {
+        row.emplace_back(GetValue(index, next_row_));
+    }
+    ++next_row_;
+    return row;
+}
+
+}  // namespace model
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+#include "core/util/export.h"
+
+namespace model {
+
+/// A preprocessed table stored in a single versioned binary file.
+///
+/// For every column the snapshot keeps its dictionary, the dictionary codes of all rows, the
+/// probing table and the clusters of the column's PLI together with its statistics, exactly as
+/// ColumnLayoutRelationData::CreateFrom would build them from the original table. The file is
+/// memory-mapped on Open, so PLI-based algorithms get their input model without parsing, hashing
+/// or clustering a single value. Every other consumer sees the snapshot as an ordinary dataset
+/// stream whose rows are reconstructed from the dictionaries.
+class DESBORDANTE_EXPORT RelationSnapshot final : public IDatasetStream {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    struct Header;
+    struct ColumnEntry;
+
+private:
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    Header const* header_;
+    ColumnEntry const* columns_;
+    std::size_t next_row_ = 0;
+
+    explicit RelationSnapshot(std::filesystem::path const& path);
+
+    template <typename T>
+    std::span<T const> GetArray(std::uint64_t offset, std::uint64_t size) const;
+    std::string_view GetString(std::uint64_t offset, std::uint64_t size) const;
+    void Validate() const;
+    // Let the OS drop the mapped pages of a section that has been copied out
+    void ReleasePages(std::uint64_t offset, std::uint64_t size) const;
+
+public:
+    /// Consume the whole stream and store it at path. Rows with an unexpected number of values
+    /// are skipped, as in ColumnLayoutRelationData::CreateFrom.
+    static void Write(IDatasetStream& data_stream, std::filesystem::path const& path);
+
+    static std::shared_ptr<RelationSnapshot> Open(std::filesystem::path const& path);
+
+    [[nodiscard]] std::size_t GetNumberOfRows() const;
+
+    /// Dictionary codes of the column's values, in row order.
+    [[nodiscard]] std::span<std::uint32_t const> GetCodes(std::size_t column_index) const;
+    [[nodiscard]] std::size_t GetDictionarySize(std::size_t column_index) const;
+    [[nodiscard]] std::string_view GetDictionaryValue(std::size_t column_index,
+                                                      std::uint32_t code) const;
+    [[nodiscard]] std::string_view GetValue(std::size_t column_index, std::size_t row) const;
+
+    /// Build the column's PLI from the stored clusters, with the probing table already cached.
+    /// The clusters and the probing table are copied into the PLI: PLIs own their clusters and
+    /// algorithms modify them (e.g. HyFD sorts them in place), so they can't live in the read-only
+    /// mapping. The mapped pages of the copied sections are released afterwards, so the peak
+    /// memory stays close to the one of loading the original table.
+    [[nodiscard]] std::unique_ptr<PLIWithSingletons> LoadPLI(std::size_t column_index) const;
+
+    Row GetNextRow() override;
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return next_row_ < GetNumberOfRows();
+    }
+
+    [[nodiscard]] std::size_t GetNumberOfColumns() const override;
+    [[nodiscard]] std::string GetColumnName(std::size_t index) const override;
+    [[nodiscard]] std::string GetRelationName() const override;
+
+    void Reset() override {
+        next_row_ = 0;
+    }
+};
+
+}  // namespace model
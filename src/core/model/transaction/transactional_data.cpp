@@ -1,17 +1,143 @@
 #include "core/model/transaction/transactional_data.h"
 
+#include <algorithm>
 #include <cassert>
-#include <stdexcept>
+#include <numeric>
 #include <unordered_map>
 
+#include "core/util/parallel_for.h"
+
 namespace model {
 
+namespace {
+
+// Number of transactions processed by one task of a parallel pass
+constexpr size_t kChunkSize = 1 << 16;
+
+// Calls f(begin, end) for all the chunks of [0, size) using up to `threads` threads
+template <typename F>
+void ForEachChunk(size_t size, unsigned threads, F f) {
+    std::vector<size_t> chunk_begins;
+    for (size_t begin = 0; begin < size; begin += kChunkSize) {
+        chunk_begins.push_back(begin);
+    }
+    util::ParallelForeach(chunk_begins.begin(), chunk_begins.end(), threads,
+                          [&](size_t begin) { f(begin, std::min(size, begin + kChunkSize)); });
+}
+
+// Numbers the items in the order of their first appearance
+class ItemDictionary {
+private:
+    std::unordered_map<std::string, unsigned> ids_;
+    std::vector<std::string> names_;
+
+public:
+    unsigned GetId(std::string& item_name) {
+        auto const [it, inserted] = ids_.try_emplace(item_name, names_.size());
+        if (inserted) {
+            names_.push_back(std::move(item_name));
+        }
+        return it->second;
+    }
+
+    std::vector<std::string> ExtractNames() {
+        return std::move(names_);
+    }
+};
+
+}  // namespace
+
+std::unique_ptr<TransactionalData> TransactionalData::Create(
+        std::vector<std::string> item_names, std::vector<size_t> transaction_ids,
+        std::vector<size_t> occurrence_transactions, std::vector<unsigned> occurrence_items,
+        unsigned threads) {
+    size_t const num_occurrences = occurrence_items.size();
+    size_t const num_transactions = transaction_ids.size();
+    assert(occurrence_transactions.size() == num_occurrences);
+
+    // Group the occurrences by transactions, then sort the transactions and drop repeated items
+    std::vector<size_t> offsets(num_transactions + 1, 0);
+    for (size_t transaction : occurrence_transactions) {
+        ++offsets[transaction + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<unsigned> items(num_occurrences);
+    {
+        std::vector<size_t> positions(offsets.begin(), std::prev(offsets.end()));
+        for (size_t i = 0; i < num_occurrences; ++i) {
+            items[positions[occurrence_transactions[i]]++] = occurrence_items[i];
+        }
+    }
+    occurrence_transactions = {};
+    occurrence_items = {};
+
+    std::vector<size_t> sizes(num_transactions);
+    ForEachChunk(num_transactions, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            auto const first = items.begin() + offsets[i];
+            auto const last = items.begin() + offsets[i + 1];
+            std::sort(first, last);
+            sizes[i] = std::distance(first, std::unique(first, last));
+        }
+    });
+
+    std::vector<size_t> supports(item_names.size(), 0);
+    size_t num_items = 0;
+    for (size_t i = 0; i < num_transactions; ++i) {
+        size_t const begin = offsets[i];
+        offsets[i] = num_items;
+        for (size_t j = begin; j < begin + sizes[i]; ++j) {
+            ++supports[items[j]];
+            items[num_items++] = items[j];
+        }
+    }
+    offsets.back() = num_items;
+    items.resize(num_items);
+    items.shrink_to_fit();
+
+    // Renumber the items by descending support, ties are broken by the first appearance
+    std::vector<unsigned> order(item_names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&supports](unsigned a, unsigned b) { return supports[a] > supports[b]; });
+    std::vector<unsigned> new_ids(order.size());
+    std::vector<std::string> item_universe(order.size());
+    for (unsigned new_id = 0; new_id < order.size(); ++new_id) {
+        new_ids[order[new_id]] = new_id;
+        item_universe[new_id] = std::move(item_names[order[new_id]]);
+    }
+    ForEachChunk(num_transactions, threads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i != end; ++i) {
+            auto const first = items.begin() + offsets[i];
+            auto const last = items.begin() + offsets[i + 1];
+            std::for_each(first, last, [&new_ids](unsigned& item) { item = new_ids[item]; });
+            std::sort(first, last);
+        }
+    });
+
+    return std::unique_ptr<TransactionalData>(
+            new TransactionalData(std::move(item_universe), std::move(transaction_ids),
+                                  std::move(offsets), std::move(items)));
+}
+
+std::vector<std::vector<unsigned>> TransactionalData::GetTidLists() const {
+    std::vector<std::vector<unsigned>> tid_lists(GetUniverseSize());
+    for (unsigned index = 0; index < GetNumTransactions(); ++index) {
+        for (unsigned item : GetTransaction(index)) {
+            tid_lists[item].push_back(index);
+        }
+    }
+    return tid_lists;
+}
+
 std::unique_ptr<TransactionalData> TransactionalData::CreateFromSingular(
-        IDatasetStream& data_stream, size_t tid_col_index, size_t item_col_index) {
-    std::vector<std::string> item_universe;
-    std::unordered_map<std::string, size_t> item_universe_set;
-    std::unordered_map<size_t, Itemset> transactions;
-    size_t latest_item_id = 0;
+        IDatasetStream& data_stream, size_t tid_col_index, size_t item_col_index,
+        unsigned threads) {
+    ItemDictionary dictionary;
+    std::vector<size_t> transaction_ids;
+    std::vector<size_t> occurrence_transactions;
+    std::vector<unsigned> occurrence_items;
+    std::unordered_map<size_t, size_t> tid_to_index;
 
     assert(data_stream.GetNumberOfColumns() > std::max(tid_col_index, item_col_index));
 
@@ -22,38 +148,26 @@ std::unique_ptr<TransactionalData> TransactionalData::CreateFromSingular(
         }
 
         size_t const tid = std::stoull(row[tid_col_index]);
-        std::string& item_name = row[item_col_index];
-        size_t item_id = latest_item_id;
-
-        auto const [item_iter, was_inserted] = item_universe_set.try_emplace(item_name, item_id);
-        if (was_inserted) {
-            // TODO(alexandrsmirn) попробовать избежать этого добавления.
-            item_universe.push_back(std::move(item_name));
-            ++latest_item_id;
-        } else {
-            // if this item already exists in the universe, set the old item id
-            item_id = item_iter->second;
+        auto const [it, inserted] = tid_to_index.try_emplace(tid, transaction_ids.size());
+        if (inserted) {
+            transaction_ids.push_back(tid);
         }
-
-        transactions[tid].AddItemId(item_id);
+        occurrence_transactions.push_back(it->second);
+        occurrence_items.push_back(dictionary.GetId(row[item_col_index]));
     }
 
-    // sort items in each transaction
-    for (auto& [tid, items] : transactions) {
-        items.Sort();
-    }
-
-    return std::unique_ptr<TransactionalData>(
-            new TransactionalData(std::move(item_universe), std::move(transactions)));
+    return Create(dictionary.ExtractNames(), std::move(transaction_ids),
+                  std::move(occurrence_transactions), std::move(occurrence_items), threads);
 }
 
 std::unique_ptr<TransactionalData> TransactionalData::CreateFromTabular(IDatasetStream& data_stream,
-                                                                        bool has_tid) {
-    std::vector<std::string> item_universe;
-    std::unordered_map<std::string, size_t> item_universe_set;
-    std::unordered_map<size_t, Itemset> transactions;
-    size_t latest_item_id = 0;
-    size_t tid = 0;
+                                                                        bool has_tid,
+                                                                        unsigned threads) {
+    ItemDictionary dictionary;
+    std::vector<size_t> transaction_ids;
+    std::vector<size_t> occurrence_transactions;
+    std::vector<unsigned> occurrence_items;
+    std::unordered_map<size_t, size_t> tid_to_index;
 
     while (data_stream.HasNextRow()) {
         std::vector<std::string> row = data_stream.GetNextRow();
@@ -63,40 +177,28 @@ std::unique_ptr<TransactionalData> TransactionalData::CreateFromTabular(IDataset
 
         auto row_iter = row.begin();
         if (has_tid) {
-            tid = std::stoull(*row_iter);
+            // only the first row with a given transaction id is taken
+            size_t const tid = std::stoull(*row_iter);
+            if (!tid_to_index.try_emplace(tid, transaction_ids.size()).second) {
+                continue;
+            }
+            transaction_ids.push_back(tid);
             row_iter++;
+        } else {
+            transaction_ids.push_back(transaction_ids.size());
         }
 
-        Itemset items;
         for (; row_iter != row.end(); ++row_iter) {
-            std::string& item_name = *row_iter;
-            if (item_name.empty()) {
+            if (row_iter->empty()) {
                 continue;
             }
-            size_t item_id = latest_item_id;
-
-            auto const [item_iter, was_inserted] =
-                    item_universe_set.try_emplace(item_name, item_id);
-            if (was_inserted) {
-                // TODO(alexandrsmirn) попробовать избежать этого добавления.
-                item_universe.push_back(std::move(item_name));
-                ++latest_item_id;
-            } else {
-                // if this item already exists in the universe, set the old item id
-                item_id = item_iter->second;
-            }
-            items.AddItemId(item_id);
-        }
-
-        items.Sort();
-        transactions.emplace(tid, std::move(items));
-        if (!has_tid) {
-            ++tid;
+            occurrence_transactions.push_back(transaction_ids.size() - 1);
+            occurrence_items.push_back(dictionary.GetId(*row_iter));
         }
     }
 
-    return std::unique_ptr<TransactionalData>(
-            new TransactionalData(std::move(item_universe), std::move(transactions)));
+    return Create(dictionary.ExtractNames(), std::move(transaction_ids),
+                  std::move(occurrence_transactions), std::move(occurrence_items), threads);
 }
 
 }  // namespace model
@@ -1,24 +1,43 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "core/model/table/idataset_stream.h"
-#include "core/model/transaction/itemset.h"
 #include "core/model/transaction/transactional_input_format.h"
 
 namespace model {
 
+/* Transactions are stored in the compressed sparse row format: the sorted distinct item ids of
+ * the i-th transaction are items_[offsets_[i]], ..., items_[offsets_[i + 1] - 1]. Transactions
+ * are numbered in the order their ids first appear in the data. Items are numbered in the order
+ * of descending support, so the most frequent items get the smallest ids.
+ */
 class TransactionalData {
 private:
     std::vector<std::string> item_universe_;
-    std::unordered_map<size_t, Itemset> transactions_;
+    std::vector<size_t> transaction_ids_;
+    std::vector<size_t> offsets_;
+    std::vector<unsigned> items_;
 
-    TransactionalData(std::vector<std::string> item_universe,
-                      std::unordered_map<size_t, Itemset> transactions)
-        : item_universe_(std::move(item_universe)), transactions_(std::move(transactions)) {}
+    TransactionalData(std::vector<std::string> item_universe, std::vector<size_t> transaction_ids,
+                      std::vector<size_t> offsets, std::vector<unsigned> items)
+        : item_universe_(std::move(item_universe)),
+          transaction_ids_(std::move(transaction_ids)),
+          offsets_(std::move(offsets)),
+          items_(std::move(items)) {}
+
+    /* Builds the data from the item occurrences read from a dataset: the i-th occurrence is of the
+     * item occurrence_items[i] (named item_names[occurrence_items[i]]) in the transaction with the
+     * index occurrence_transactions[i].
+     */
+    static std::unique_ptr<TransactionalData> Create(std::vector<std::string> item_names,
+                                                     std::vector<size_t> transaction_ids,
+                                                     std::vector<size_t> occurrence_transactions,
+                                                     std::vector<unsigned> occurrence_items,
+                                                     unsigned threads);
 
 public:
     TransactionalData() = delete;
@@ -33,8 +52,14 @@ public:
         return item_universe_;
     }
 
-    std::unordered_map<size_t, Itemset> const& GetTransactions() const noexcept {
-        return transactions_;
+    // Sorted distinct item ids of the transaction with the given index
+    std::span<unsigned const> GetTransaction(size_t index) const noexcept {
+        return {items_.data() + offsets_[index], items_.data() + offsets_[index + 1]};
+    }
+
+    // Id the transaction with the given index has in the data
+    size_t GetTransactionId(size_t index) const noexcept {
+        return transaction_ids_[index];
     }
 
     size_t GetUniverseSize() const noexcept {
@@ -42,15 +67,20 @@ public:
     }
 
     size_t GetNumTransactions() const noexcept {
-        return transactions_.size();
+        return transaction_ids_.size();
     }
 
+    // Vertical layout of the data: the sorted indices of the transactions containing every item
+    std::vector<std::vector<unsigned>> GetTidLists() const;
+
     static std::unique_ptr<TransactionalData> CreateFromSingular(IDatasetStream& data_stream,
                                                                  size_t tid_col_index = 0,
-                                                                 size_t item_col_index = 1);
+                                                                 size_t item_col_index = 1,
+                                                                 unsigned threads = 1);
 
     static std::unique_ptr<TransactionalData> CreateFromTabular(IDatasetStream& data_stream,
-                                                                bool has_tid);
+                                                                bool has_tid,
+                                                                unsigned threads = 1);
 };
 
 }  // namespace model
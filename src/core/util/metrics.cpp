@@ -0,0 +1,199 @@
+#include "core/util/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace util::metrics {
+
+namespace {
+std::atomic<std::uint64_t> next_registry_id = 1;
+
+#ifdef DESBORDANTE_METRICS
+thread_local MetricsRegistry* current_registry = nullptr;
+#endif
+
+template <typename Map, typename Merge>
+void MergeInto(std::map<std::string, typename Map::mapped_type>& to, Map const& from,
+               Merge merge) {
+    for (auto const& [name, value] : from) {
+        auto [it, inserted] = to.try_emplace(name, value);
+        if (!inserted) merge(it->second, value);
+    }
+}
+
+void WriteJsonString(std::ostream& out, std::string_view str) {
+    out << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+double ToMicroseconds(MetricsRegistry::Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+}  // namespace
+
+void HistogramStats::Add(unsigned long long value) noexcept {
+    min = count == 0 ? value : std::min(min, value);
+    max = std::max(max, value);
+    ++count;
+    sum += value;
+    ++buckets[std::bit_width(value)];
+}
+
+void HistogramStats::Merge(HistogramStats const& other) noexcept {
+    if (other.count == 0) return;
+    min = count == 0 ? other.min : std::min(min, other.min);
+    max = std::max(max, other.max);
+    count += other.count;
+    sum += other.sum;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+MetricsRegistry::MetricsRegistry() : id_(next_registry_id++) {}
+
+MetricsRegistry::Shard& MetricsRegistry::LocalShard() {
+    thread_local std::uint64_t cached_registry_id = 0;
+    thread_local Shard* cached_shard = nullptr;
+    if (cached_registry_id == id_) return *cached_shard;
+
+    std::scoped_lock lock{shards_mutex_};
+    Shard*& shard = thread_shards_[std::this_thread::get_id()];
+    if (shard == nullptr) {
+        shard = shards_.emplace_back(std::make_unique<Shard>(shards_.size())).get();
+    }
+    cached_registry_id = id_;
+    cached_shard = shard;
+    return *shard;
+}
+
+void MetricsRegistry::Count(std::string_view name, unsigned long long delta) {
+    Shard& shard = LocalShard();
+    std::scoped_lock lock{shard.mutex};
+    auto it = shard.counters.find(name);
+    if (it == shard.counters.end()) {
+        it = shard.counters.emplace(name, 0).first;
+    }
+    it->second += delta;
+}
+
+void MetricsRegistry::Record(std::string_view name, unsigned long long value) {
+    Shard& shard = LocalShard();
+    std::scoped_lock lock{shard.mutex};
+    auto it = shard.histograms.find(name);
+    if (it == shard.histograms.end()) {
+        it = shard.histograms.emplace(name, HistogramStats{}).first;
+    }
+    it->second.Add(value);
+}
+
+void MetricsRegistry::AddPhase(std::string_view name, Clock::time_point start,
+                               Clock::time_point end) {
+    Shard& shard = LocalShard();
+    std::scoped_lock lock{shard.mutex};
+    auto it = shard.phases.find(name);
+    if (it == shard.phases.end()) {
+        it = shard.phases.emplace(name, PhaseStats{}).first;
+    }
+    ++it->second.calls;
+    it->second.total += end - start;
+    if (tracing_) {
+        shard.events.push_back({std::string{name}, start, end});
+    }
+}
+
+void MetricsRegistry::SetTracing(bool enabled) {
+    tracing_ = enabled;
+}
+
+Metrics MetricsRegistry::Snapshot() const {
+    Metrics metrics;
+    std::scoped_lock lock{shards_mutex_};
+    for (auto const& shard : shards_) {
+        std::scoped_lock shard_lock{shard->mutex};
+        MergeInto(metrics.counters, shard->counters,
+                  [](unsigned long long& to, unsigned long long from) { to += from; });
+        MergeInto(metrics.histograms, shard->histograms,
+                  [](HistogramStats& to, HistogramStats const& from) { to.Merge(from); });
+        MergeInto(metrics.phases, shard->phases, [](PhaseStats& to, PhaseStats const& from) {
+            to.calls += from.calls;
+            to.total += from.total;
+        });
+    }
+    return metrics;
+}
+
+void MetricsRegistry::Reset() {
+    std::scoped_lock lock{shards_mutex_};
+    // Shards themselves are kept, threads may have cached them
+    for (auto const& shard : shards_) {
+        std::scoped_lock shard_lock{shard->mutex};
+        shard->counters.clear();
+        shard->histograms.clear();
+        shard->phases.clear();
+        shard->events.clear();
+    }
+    origin_ = Clock::now();
+}
+
+void MetricsRegistry::WriteChromeTrace(std::ostream& out) const {
+    Clock::time_point end = origin_;
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    {
+        std::scoped_lock lock{shards_mutex_};
+        for (auto const& shard : shards_) {
+            std::scoped_lock shard_lock{shard->mutex};
+            for (TraceEvent const& event : shard->events) {
+                if (!first) out << ',';
+                first = false;
+                out << "{\"name\":";
+                WriteJsonString(out, event.name);
+                out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << shard->thread_index
+                    << ",\"ts\":" << ToMicroseconds(event.start - origin_)
+                    << ",\"dur\":" << ToMicroseconds(event.end - event.start) << '}';
+                end = std::max(end, event.end);
+            }
+        }
+    }
+    Metrics const metrics = Snapshot();
+    if (!metrics.counters.empty()) {
+        if (!first) out << ',';
+        out << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":"
+            << ToMicroseconds(end - origin_) << ",\"args\":{";
+        bool first_counter = true;
+        for (auto const& [name, value] : metrics.counters) {
+            if (!first_counter) out << ',';
+            first_counter = false;
+            WriteJsonString(out, name);
+            out << ':' << value;
+        }
+        out << "}}";
+    }
+    out << "]}\n";
+}
+
+MetricsRegistry* MetricsRegistry::Current() noexcept {
+#ifdef DESBORDANTE_METRICS
+    return current_registry;
+#else
+    return nullptr;
+#endif
+}
+
+#ifdef DESBORDANTE_METRICS
+MetricsScope::MetricsScope(MetricsRegistry* registry) noexcept : previous_(current_registry) {
+    current_registry = registry;
+}
+
+MetricsScope::~MetricsScope() {
+    current_registry = previous_;
+}
+#endif
+
+}  // namespace util::metrics
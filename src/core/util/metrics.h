@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace util::metrics {
+
+/* Performance metrics of a single algorithm run: counters, histograms and phase timers.
+ * Every algorithm owns a MetricsRegistry, and code running on behalf of the algorithm reports to
+ * the registry of the current thread (see MetricsScope) through the DESBORDANTE_METRICS_* macros.
+ * The macros expand to nothing unless Desbordante is built with DESBORDANTE_METRICS, so the
+ * registry of such a build stays empty.
+ */
+
+struct PhaseStats {
+    std::size_t calls = 0;
+    // Summed over threads, so it may exceed the wall time of a parallel phase
+    std::chrono::nanoseconds total{0};
+};
+
+struct HistogramStats {
+    // Bucket i counts values with std::bit_width(value) == i, i.e. values in [2^(i-1), 2^i)
+    static constexpr std::size_t kBuckets = 65;
+
+    std::size_t count = 0;
+    unsigned long long sum = 0;
+    unsigned long long min = 0;
+    unsigned long long max = 0;
+    std::array<std::size_t, kBuckets> buckets{};
+
+    void Add(unsigned long long value) noexcept;
+    void Merge(HistogramStats const& other) noexcept;
+
+    double Mean() const noexcept {
+        return count == 0 ? 0 : static_cast<double>(sum) / count;
+    }
+};
+
+struct Metrics {
+    std::map<std::string, unsigned long long> counters;
+    std::map<std::string, HistogramStats> histograms;
+    std::map<std::string, PhaseStats> phases;
+};
+
+class MetricsRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct TraceEvent {
+        std::string name;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view str) const noexcept {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // Lookups by std::string_view don't construct a std::string
+    template <typename T>
+    using NameMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+    // Metrics of one thread. Only the owner thread writes to it, so its mutex is contended only
+    // while a snapshot is taken.
+    struct Shard {
+        std::size_t thread_index;
+        mutable std::mutex mutex;
+        NameMap<unsigned long long> counters;
+        NameMap<HistogramStats> histograms;
+        NameMap<PhaseStats> phases;
+        std::vector<TraceEvent> events;
+
+        explicit Shard(std::size_t index) : thread_index(index) {}
+    };
+
+    // Never reused, unlike addresses, so thread-local shard caches can't mistake a new registry
+    // for a destroyed one
+    std::uint64_t const id_;
+    mutable std::mutex shards_mutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::unordered_map<std::thread::id, Shard*> thread_shards_;
+    Clock::time_point origin_ = Clock::now();
+    std::atomic<bool> tracing_ = false;
+
+    Shard& LocalShard();
+
+public:
+    MetricsRegistry();
+    MetricsRegistry(MetricsRegistry const&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry const&) = delete;
+
+    void Count(std::string_view name, unsigned long long delta = 1);
+    void Record(std::string_view name, unsigned long long value);
+    void AddPhase(std::string_view name, Clock::time_point start, Clock::time_point end);
+
+    // Keep every phase as a trace event for WriteChromeTrace. Off by default, because the
+    // events take memory proportional to the number of phase calls.
+    void SetTracing(bool enabled);
+
+    // Merge metrics of all threads
+    Metrics Snapshot() const;
+    void Reset();
+
+    // Trace Event Format (chrome://tracing, Perfetto): a complete event per traced phase and
+    // final counter values
+    void WriteChromeTrace(std::ostream& out) const;
+
+    // Registry of the algorithm the current thread works for, nullptr if there is none
+    static MetricsRegistry* Current() noexcept;
+};
+
+// Makes the registry current for the calling thread until destruction
+class MetricsScope {
+#ifdef DESBORDANTE_METRICS
+    MetricsRegistry* previous_;
+
+public:
+    explicit MetricsScope(MetricsRegistry* registry) noexcept;
+    ~MetricsScope();
+#else
+public:
+    explicit MetricsScope(MetricsRegistry*) noexcept {}
+#endif
+    MetricsScope(MetricsScope const&) = delete;
+    MetricsScope& operator=(MetricsScope const&) = delete;
+};
+
+// Wrap a function to be run on another thread so that it reports to the current registry
+template <typename F>
+auto BindCurrentRegistry(F func) {
+#ifdef DESBORDANTE_METRICS
+    return [registry = MetricsRegistry::Current(),
+            func = std::move(func)](auto&&... args) mutable -> decltype(auto) {
+        MetricsScope scope{registry};
+        return func(std::forward<decltype(args)>(args)...);
+    };
+#else
+    return func;
+#endif
+}
+
+inline void Count(std::string_view name, unsigned long long delta = 1) {
+    if (MetricsRegistry* registry = MetricsRegistry::Current()) registry->Count(name, delta);
+}
+
+inline void Record(std::string_view name, unsigned long long value) {
+    if (MetricsRegistry* registry = MetricsRegistry::Current()) registry->Record(name, value);
+}
+
+// Adds the lifetime of the object to a phase of the current registry
+class ScopedPhase {
+    MetricsRegistry* registry_;
+    std::string_view name_;
+    MetricsRegistry::Clock::time_point start_;
+
+public:
+    explicit ScopedPhase(std::string_view name) noexcept
+        : registry_(MetricsRegistry::Current()), name_(name) {
+        if (registry_ != nullptr) start_ = MetricsRegistry::Clock::now();
+    }
+
+    ScopedPhase(ScopedPhase const&) = delete;
+    ScopedPhase& operator=(ScopedPhase const&) = delete;
+
+    ~ScopedPhase() {
+        if (registry_ != nullptr) {
+            registry_->AddPhase(name_, start_, MetricsRegistry::Clock::now());
+        }
+    }
+};
+
+}  // namespace util::metrics
+
+#define DESBORDANTE_METRICS_CONCAT_IMPL(a, b) a##b
+#define DESBORDANTE_METRICS_CONCAT(a, b) DESBORDANTE_METRICS_CONCAT_IMPL(a, b)
+
+#ifdef DESBORDANTE_METRICS
+// Add delta to a counter
+#define DESBORDANTE_METRICS_COUNT(name, delta) ::util::metrics::Count(name, delta)
+// Add a value to a histogram
+#define DESBORDANTE_METRICS_RECORD(name, value) ::util::metrics::Record(name, value)
+// Time the rest of the enclosing scope as a phase
+#define DESBORDANTE_METRICS_PHASE(name) \
+    ::util::metrics::ScopedPhase DESBORDANTE_METRICS_CONCAT(metrics_phase_, __LINE__) { name }
+#else
+// Arguments are not evaluated, but still count as used
+#define DESBORDANTE_METRICS_COUNT(name, delta) static_cast<void>(sizeof(name) + sizeof(delta))
+#define DESBORDANTE_METRICS_RECORD(name, value) static_cast<void>(sizeof(name) + sizeof(value))
+#define DESBORDANTE_METRICS_PHASE(name) static_cast<void>(sizeof(name))
+#endif
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <mutex>
 #include <system_error>
 #include <thread>
 #include <vector>
 
 #include "core/util/logger.h"
+#include "core/util/metrics.h"
 
 namespace util {
 
@@ -13,6 +17,8 @@ namespace util {
  * If threads_num_max == 1 then behaves like a sequential std::for_each.
  * NOTE: actual number of threads to be used is minimum of the
  *       std::distance(begin, end) and threads_num_max.
+ * If f throws, the remaining elements are skipped, all threads are joined and the first exception
+ * is rethrown on the calling thread.
  */
 template <typename It, typename UnaryFunction>
 inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, UnaryFunction f) {
@@ -27,11 +33,21 @@ inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, Un
     std::vector<std::thread> threads;
     threads.reserve(threads_num_actual);
 
-    auto const task = [&f](It first, It last) {
-        for (; first != last; ++first) {
-            f(*first);
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+    std::atomic<bool> failed = false;
+    auto const run = [&](It first, It last) {
+        try {
+            for (; first != last && !failed.load(std::memory_order_relaxed); ++first) {
+                f(*first);
+            }
+        } catch (...) {
+            std::scoped_lock lock{exception_mutex};
+            if (!exception) exception = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
         }
     };
+    auto const task = metrics::BindCurrentRegistry(run);
 
     It p = begin;
     for (unsigned i = 0; i < threads_num_actual - 1; ++i) {
@@ -49,13 +65,13 @@ inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, Un
         }
     }
 
-    for (; p != end; ++p) {
-        f(*p);
-    }
+    run(p, end);
 
     for (auto& thread : threads) {
         thread.join();
     }
+
+    if (exception) std::rethrow_exception(exception);
 }
 
 }  // namespace util
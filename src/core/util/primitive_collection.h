@@ -1,51 +1,202 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/util/primitive_sink.h"
 
 namespace util {
 
 /* Represents the collection of the primitive instances, guarantees the thread safety of adding
- * new instances
+ * new instances.
+ * Every registering thread fills its own chunk of primitives without locking, the lock is taken
+ * only once per kChunkSize primitives to hand a full chunk over. Chunks are kept in memory or,
+ * if a sink is set, passed to the sink right away, so the results can be consumed while the
+ * algorithm is still running.
  */
 template <typename T>
 class PrimitiveCollection {
+public:
+    static constexpr std::size_t kChunkSize = 1024;
+
 private:
-    std::list<T> collection_;
+    using Chunk = std::vector<T>;
+
+    struct LocalChunkCache {
+        std::uint64_t owner_id = 0;
+        Chunk* chunk = nullptr;
+    };
+
+    // Ids are never reused, so a cache entry of a destroyed or cleared collection never matches
+    // a live one
+    inline static std::atomic<std::uint64_t> next_id_ = 1;
+    std::uint64_t id_ = NextId();
+
     std::mutex mutable mutex_;
+    // Serializes the sink calls. Sinks are called without mutex_ locked, so they may read the
+    // collection (e.g. a Python callback calling get_fds())
+    std::mutex sink_mutex_;
+    // Registering threads cache pointers to their chunks, so chunks are only destroyed in Clear(),
+    // which also takes a new id_ to invalidate these caches
+    std::unordered_map<std::thread::id, std::unique_ptr<Chunk>> mutable local_chunks_;
+    std::vector<Chunk> mutable full_chunks_;
+    std::list<T> mutable collection_;
+    std::shared_ptr<PrimitiveSink<T>> sink_;
+
+    static std::uint64_t NextId() noexcept {
+        return next_id_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Chunk& GetLocalChunk() {
+        static thread_local LocalChunkCache cache;
+        if (cache.owner_id == id_) return *cache.chunk;
+
+        std::scoped_lock lock(mutex_);
+        std::unique_ptr<Chunk>& chunk = local_chunks_[std::this_thread::get_id()];
+        if (chunk == nullptr) {
+            chunk = std::make_unique<Chunk>();
+            chunk->reserve(kChunkSize);
+        }
+        cache = {id_, chunk.get()};
+        return *chunk;
+    }
+
+    // Must be called with mutex_ locked. Without a sink the chunk is kept in full_chunks_,
+    // otherwise it is returned to be passed to the sink after unlocking
+    Chunk HandOver(Chunk& chunk) {
+        Chunk to_sink;
+        if (chunk.empty()) return to_sink;
+        if (sink_ != nullptr) {
+            to_sink.swap(chunk);
+        } else {
+            full_chunks_.push_back(std::move(chunk));
+            chunk = Chunk();
+        }
+        chunk.reserve(kChunkSize);
+        return to_sink;
+    }
+
+    void AfterRegister(Chunk& chunk) {
+        if (chunk.size() < kChunkSize) return;
+        std::shared_ptr<PrimitiveSink<T>> sink;
+        Chunk to_sink;
+        {
+            std::scoped_lock lock(mutex_);
+            sink = sink_;
+            to_sink = HandOver(chunk);
+        }
+        if (to_sink.empty()) return;
+        std::scoped_lock sink_lock(sink_mutex_);
+        sink->Consume(to_sink);
+    }
+
+    // Moves everything to collection_, calling code must guarantee no primitives are registered
+    void Gather() const {
+        std::scoped_lock lock(mutex_);
+        auto append = [this](Chunk& chunk) {
+            collection_.insert(collection_.end(), std::make_move_iterator(chunk.begin()),
+                               std::make_move_iterator(chunk.end()));
+            chunk.clear();
+        };
+        for (Chunk& chunk : full_chunks_) append(chunk);
+        full_chunks_.clear();
+        for (auto& [_, chunk] : local_chunks_) append(*chunk);
+    }
 
 public:
     void Register(T primitive) {
-        std::scoped_lock lock(mutex_);
-        collection_.push_back(std::move(primitive));
+        Chunk& chunk = GetLocalChunk();
+        chunk.push_back(std::move(primitive));
+        AfterRegister(chunk);
     }
 
     template <typename... Args>
     void Register(Args&&... args) {
+        Chunk& chunk = GetLocalChunk();
+        chunk.emplace_back(std::forward<Args>(args)...);
+        AfterRegister(chunk);
+    }
+
+    /* Sets the sink all primitives registered from now on are passed to. With nullptr the
+     * primitives are kept in the collection (the default)
+     */
+    void SetSink(std::shared_ptr<PrimitiveSink<T>> sink) {
         std::scoped_lock lock(mutex_);
-        collection_.emplace_back(std::forward<Args>(args)...);
+        sink_ = std::move(sink);
     }
 
+    /* Hands the partially filled chunks over and flushes the sink. Should be called after
+     * algorithm is finished its execution
+     */
+    void Flush() {
+        std::shared_ptr<PrimitiveSink<T>> sink;
+        std::vector<Chunk> to_sink;
+        {
+            std::scoped_lock lock(mutex_);
+            if (sink_ == nullptr) return;
+            sink = sink_;
+            for (auto& [_, chunk] : local_chunks_) {
+                if (!chunk->empty()) to_sink.push_back(HandOver(*chunk));
+            }
+        }
+        std::scoped_lock sink_lock(sink_mutex_);
+        for (Chunk& chunk : to_sink) sink->Consume(chunk);
+        sink->Flush();
+    }
+
+    /* Removes all primitives and frees the chunks of the registering threads. Calling code must
+     * guarantee no primitives are registered concurrently
+     */
     void Clear() noexcept {
         std::scoped_lock lock(mutex_);
         collection_.clear();
+        full_chunks_.clear();
+        local_chunks_.clear();
+        id_ = NextId();
     }
 
     size_t Size() const noexcept {
         std::scoped_lock lock(mutex_);
-        return collection_.size();
+        size_t size = collection_.size();
+        for (Chunk const& chunk : full_chunks_) size += chunk.size();
+        for (auto const& [_, chunk] : local_chunks_) size += chunk->size();
+        return size;
     }
 
     /* Calling code MUST guarantee that methods below won't interfere with the registering of
      * new primitive instances or clearing (for the entire time the returned reference is held).
      * Practically this means that these methods should be called only after algorithm is finished
      * its execution.
+     * Primitives passed to a sink are not in the collection.
      */
-    std::list<T> const& AsList() const noexcept {
+    template <typename Function>
+    void ForEach(Function&& function) const {
+        std::scoped_lock lock(mutex_);
+        for (T const& primitive : collection_) function(primitive);
+        for (Chunk const& chunk : full_chunks_) {
+            for (T const& primitive : chunk) function(primitive);
+        }
+        for (auto const& [_, chunk] : local_chunks_) {
+            for (T const& primitive : *chunk) function(primitive);
+        }
+    }
+
+    std::list<T> const& AsList() const {
+        Gather();
         return collection_;
     }
 
-    std::list<T>& AsList() noexcept {
+    std::list<T>& AsList() {
+        Gather();
         return collection_;
     }
 };
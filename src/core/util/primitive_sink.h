@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/* Receives primitives while an algorithm is still running. PrimitiveCollection hands over whole
+ * chunks of primitives and serializes the calls, so implementations don't need to be thread safe.
+ * The primitives in the chunk may be moved from.
+ */
+template <typename T>
+class PrimitiveSink {
+public:
+    virtual void Consume(std::vector<T>& chunk) = 0;
+
+    // Called once the algorithm has finished its execution
+    virtual void Flush() {}
+
+    virtual ~PrimitiveSink() = default;
+};
+
+/* Passes every primitive to the given function */
+template <typename T>
+class CallbackSink final : public PrimitiveSink<T> {
+private:
+    std::function<void(T)> callback_;
+
+public:
+    explicit CallbackSink(std::function<void(T)> callback) : callback_(std::move(callback)) {}
+
+    void Consume(std::vector<T>& chunk) final {
+        for (T& primitive : chunk) {
+            callback_(std::move(primitive));
+        }
+    }
+};
+
+/* Writes every primitive to a file as a separate line, e.g. FD::ToJSONString gives JSON Lines */
+template <typename T>
+class LineFileSink final : public PrimitiveSink<T> {
+private:
+    std::ofstream out_;
+    std::function<std::string(T const&)> format_;
+
+public:
+    LineFileSink(std::filesystem::path const& path, std::function<std::string(T const&)> format)
+        : out_(path), format_(std::move(format)) {
+        if (!out_) {
+            throw std::runtime_error("Cannot open file " + path.string() + " for writing");
+        }
+    }
+
+    void Consume(std::vector<T>& chunk) final {
+        for (T const& primitive : chunk) {
+            out_ << format_(primitive) << '\n';
+        }
+    }
+
+    void Flush() final {
+        out_.flush();
+    }
+};
+
+}  // namespace util
@@ -3,29 +3,55 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <numeric>
 
 namespace util {
 
+QGramVector::QGramId QGramVector::GetQGramId(std::string_view q_gram) {
+    if (q_gram.size() > sizeof(QGramId)) {
+        return std::hash<std::string_view>{}(q_gram);
+    }
+    QGramId id = 0;
+    std::memcpy(&id, q_gram.data(), q_gram.size());
+    return id;
+}
+
 QGramVector::QGramVector(std::string_view string, unsigned q) {
     assert(string.size() >= q);
+    std::vector<QGramId> ids;
+    ids.reserve(string.size() - q + 1);
     for (size_t i = 0; i < string.size() - q + 1; ++i) {
-        q_grams_[std::string(string.substr(i, q))]++;
+        ids.push_back(GetQGramId(string.substr(i, q)));
+    }
+    std::sort(ids.begin(), ids.end());
+
+    for (QGramId id : ids) {
+        if (q_grams_.empty() || q_grams_.back().first != id) {
+            q_grams_.emplace_back(id, 0);
+        }
+        q_grams_.back().second++;
     }
     CalculateLength();
 }
 
 long double QGramVector::InnerProduct(QGramVector const& other) const {
-    auto const& q_grams_pair =
-            std::minmax(q_grams_, other.q_grams_,
-                        [](auto const& a, auto const& b) { return a.size() < b.size(); });
-    auto const& l = q_grams_pair.first;
-    auto const& r = q_grams_pair.second;
-    return std::accumulate(l.cbegin(), l.cend(), 0.0, [&r](double a, auto const& b) {
-        auto r_pair = r.find(b.first);
-        if (r_pair == r.end()) return a;
-        return a + b.second * r_pair->second;
-    });
+    double result = 0.0;
+    auto l = q_grams_.cbegin();
+    auto r = other.q_grams_.cbegin();
+    while (l != q_grams_.cend() && r != other.q_grams_.cend()) {
+        if (l->first < r->first) {
+            ++l;
+        } else if (r->first < l->first) {
+            ++r;
+        } else {
+            result += l->second * r->second;
+            ++l;
+            ++r;
+        }
+    }
+    return result;
 }
 
 void QGramVector::CalculateLength() {
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace util {
 
@@ -14,12 +16,17 @@ namespace util {
  * has 1 occurrence of "ab" and "bc" and 0 occurrences of "cd". Second string has 0 occurrences of
  * "ab" and 1 occurrence of "bc" and "cd". Cosine similarity between "abc" and "bcd" is equal to
  * (1*0 + 1*1 + 0*1) / (sqrt(1^2 + 1^2 + 0^2) * sqrt(1^2 + 1^2 + 0^2)) = 0.5.
- * Cosine distance between "abc" and "bcd" is equal to 1 - 0.5 = 0.5. */
+ * Cosine distance between "abc" and "bcd" is equal to 1 - 0.5 = 0.5.
+ * The vector is stored sparsely as (q-gram id, count) pairs sorted by id. A q-gram of at most 8
+ * characters is packed into its id as is, longer q-grams are identified by their hash. */
 class QGramVector {
 private:
+    using QGramId = std::uint64_t;
+
     long double length_ = -1;
-    std::unordered_map<std::string, unsigned> q_grams_;
+    std::vector<std::pair<QGramId, unsigned>> q_grams_;
 
+    static QGramId GetQGramId(std::string_view q_gram);
     void CalculateLength();
 
 public:
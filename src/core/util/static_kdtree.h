@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "core/util/kdtree.h"
+
+namespace util {
+
+// @brief k-dimensional tree built at once from a set of points.
+// The tree is implicit: points are stored in one array, every subtree occupies a contiguous
+// range of it and the median of the range is its root. Ranges of at most kLeafSize points are
+// not split further and are scanned linearly. Unlike KDTree, the shape of the tree does not
+// depend on the order of the points, and the tree is immutable, so it can be queried from
+// several threads at once.
+template <SubscriptableOrder PointType>
+class StaticKDTree {
+private:
+    static constexpr size_t kLeafSize = 16;
+
+    std::vector<PointType> points_;
+
+    void Build(size_t begin, size_t end, size_t depth) {
+        if (end - begin <= kLeafSize) return;
+
+        size_t const axis = depth % points_[begin].GetDim();
+        size_t const mid = begin + (end - begin) / 2;
+        std::nth_element(points_.begin() + begin, points_.begin() + mid, points_.begin() + end,
+                         [axis](PointType const& l, PointType const& r) {
+                             return l[axis] < r[axis];
+                         });
+        Build(begin, mid, depth + 1);
+        Build(mid + 1, end, depth + 1);
+    }
+
+    template <typename Callback>
+    bool SearchRange(size_t begin, size_t end, size_t depth, Rect<PointType> const& box,
+                     Callback& callback) const {
+        if (end - begin <= kLeafSize) {
+            for (size_t i = begin; i < end; ++i) {
+                if (box.Fits(points_[i]) && !callback(points_[i])) return false;
+            }
+            return true;
+        }
+
+        size_t const axis = depth % points_[begin].GetDim();
+        size_t const mid = begin + (end - begin) / 2;
+        auto const mid_val = points_[mid][axis];
+
+        if (box.Fits(points_[mid]) && !callback(points_[mid])) return false;
+
+        if (box.lower_bound_[axis] <= mid_val &&
+            !SearchRange(begin, mid, depth + 1, box, callback)) {
+            return false;
+        }
+
+        if (mid_val <= box.upper_bound_[axis] &&
+            !SearchRange(mid + 1, end, depth + 1, box, callback)) {
+            return false;
+        }
+
+        return true;
+    }
+
+public:
+    StaticKDTree() = default;
+
+    explicit StaticKDTree(std::vector<PointType> points) : points_(std::move(points)) {
+        if (!points_.empty() && points_.front().GetDim() != 0) Build(0, points_.size(), 0);
+    }
+
+    size_t Size() const noexcept {
+        return points_.size();
+    }
+
+    std::vector<PointType> const& AsVector() const noexcept {
+        return points_;
+    }
+
+    // Calls `callback` for every point inside of `box` until the callback returns false.
+    // Returns false if the search was stopped by the callback.
+    template <typename Callback>
+    bool Search(Rect<PointType> const& box, Callback callback) const {
+        if (points_.empty()) return true;
+        if (points_.front().GetDim() == 0) {
+            for (PointType const& point : points_) {
+                if (!callback(point)) return false;
+            }
+            return true;
+        }
+        return SearchRange(0, points_.size(), 0, box, callback);
+    }
+
+    std::vector<PointType> QuerySearch(Rect<PointType> const& box) const {
+        std::vector<PointType> res;
+        Search(box, [&res](PointType const& point) {
+            res.push_back(point);
+            return true;
+        });
+        return res;
+    }
+};
+
+}  // namespace util
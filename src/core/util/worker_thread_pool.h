@@ -14,6 +14,7 @@
 #include "core/util/auto_join_thread.h"
 #include "core/util/barrier.h"
 #include "core/util/desbordante_assume.h"
+#include "core/util/metrics.h"
 
 namespace util {
 class WorkerThreadPool {
@@ -122,9 +123,9 @@ public:
     // Return Waiter object to force user to wait on pool.
     template <typename FunctionType>
     [[nodiscard]] Waiter SubmitSingleTask(FunctionType task) {
-        SetWork([task, flag = std::make_shared<std::once_flag>()]() {
+        SetWork(metrics::BindCurrentRegistry([task, flag = std::make_shared<std::once_flag>()]() {
             std::call_once(*flag, task);
-        });
+        }));
         return {*this};
     }
 
@@ -141,7 +142,7 @@ public:
             }
             finish(std::move(resource));
         };
-        SetWork(work);
+        SetWork(metrics::BindCurrentRegistry(std::move(work)));
         Wait();
     }
 
@@ -2,8 +2,13 @@
 
 #include <pybind11/pybind11.h>
 
+#include <boost/any.hpp>
+#include <pybind11/stl.h>
+
 #include "core/algorithms/fd/afd_metric/afd_metric_calculator.h"
+#include "core/algorithms/fd/afd_metric/afd_metric_matrix_calculator.h"
 #include "python_bindings/py_util/bind_primitive.h"
+#include "python_bindings/py_util/py_to_any.h"
 
 namespace {
 namespace py = pybind11;
@@ -19,5 +24,15 @@ void BindAfdMetricCalculation(py::module_& main_module) {
     auto afd_metric_module = main_module.def_submodule("afd_metric_calculation");
     BindPrimitiveNoBase<AFDMetricCalculator>(afd_metric_module, "AFDMetricCalculator")
             .def("get_result", &AFDMetricCalculator::GetResult);
+    // Registered without BindPrimitiveNoBase, which would make it the Default algorithm
+    detail::RegisterAlgorithm<AFDMetricMatrixCalculator, Algorithm>(
+            afd_metric_module.def_submodule("algorithms"), "AFDMetricMatrixCalculator")
+            .def(
+                    "get_matrix",
+                    [](AFDMetricMatrixCalculator const& calculator, py::handle metric) {
+                        return calculator.GetMatrix(boost::any_cast<AFDMetric>(
+                                PyToAny("metric", typeid(AFDMetric), metric)));
+                    },
+                    "metric"_a);
 }
 }  // namespace python_bindings
@@ -78,6 +78,7 @@ void BindAr(py::module_& main_module) {
     auto algos_module = ar_module.def_submodule("algorithms");
     auto default_algorithm =
             detail::RegisterAlgorithm<Apriori, ARAlgorithm>(algos_module, "Apriori");
+    detail::RegisterAlgorithm<Eclat, ARAlgorithm>(algos_module, "Eclat");
     algos_module.attr("Default") = default_algorithm;
 
     // Perhaps in the future there will be a need for:
@@ -2,6 +2,10 @@
 
 #include <pybind11/pybind11.h>
 
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 #include <typeindex>
 #include <typeinfo>
 
@@ -11,6 +15,7 @@
 #include "core/algorithms/algorithm.h"
 #include "core/config/exceptions.h"
 #include "core/config/names.h"
+#include "core/util/metrics.h"
 #include "python_bindings/py_util/get_py_type.h"
 #include "python_bindings/py_util/opt_to_py.h"
 #include "python_bindings/py_util/py_to_any.h"
@@ -31,6 +36,24 @@ void ConfigureAlgo(Algorithm& algorithm, py::kwargs const& kwargs) {
                                : boost::any{};
             });
 }
+
+py::dict MetricsToPy(util::metrics::Metrics const& metrics) {
+    using namespace pybind11::literals;
+    py::dict histograms;
+    for (auto const& [name, stats] : metrics.histograms) {
+        histograms[py::str(name)] = py::dict("count"_a = stats.count, "sum"_a = stats.sum,
+                                             "min"_a = stats.min, "max"_a = stats.max,
+                                             "mean"_a = stats.Mean());
+    }
+    py::dict phases;
+    for (auto const& [name, stats] : metrics.phases) {
+        phases[py::str(name)] = py::dict(
+                "calls"_a = stats.calls,
+                "seconds"_a = std::chrono::duration<double>(stats.total).count());
+    }
+    return py::dict("counters"_a = metrics.counters, "histograms"_a = std::move(histograms),
+                    "phases"_a = std::move(phases));
+}
 }  // namespace
 
 namespace python_bindings {
@@ -109,7 +132,25 @@ void BindMainClasses(py::module_& main_module) {
                         ConfigureAlgo(algo, kwargs);
                         algo.Execute();
                     },
-                    "Process data.");
+                    "Process data.")
+            .def(
+                    "get_metrics",
+                    [](Algorithm const& algo) { return MetricsToPy(algo.GetMetrics()); },
+                    "Get performance metrics collected since the last load_data call: counters, "
+                    "histograms and phase timings. Empty if Desbordante was built without "
+                    "metrics.")
+            .def("reset_metrics", &Algorithm::ResetMetrics, "Clear collected metrics.")
+            .def("set_tracing", &Algorithm::SetTracing, "enabled"_a,
+                 "Record every timed phase, so that it can be written by write_trace.")
+            .def(
+                    "write_trace",
+                    [](Algorithm const& algo, std::string const& path) {
+                        std::ofstream out{path};
+                        if (!out) throw std::runtime_error{"Cannot open " + path};
+                        algo.WriteTrace(out);
+                    },
+                    "path"_a,
+                    "Write recorded phases and counters to a file in Chrome trace event format.");
 #undef CERTAIN_SCRIPTS_ONLY
 }
 }  // namespace python_bindings
@@ -2,10 +2,16 @@
 
 #include <pybind11/pybind11.h>
 
+#include <filesystem>
+
+#include <boost/any.hpp>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/model/table/column_combination.h"
+#include "core/model/table/relation_snapshot.h"
+#include "python_bindings/py_util/py_to_any.h"
 
 namespace {
 namespace py = pybind11;
@@ -21,6 +27,31 @@ void BindDataTypes(py::module_& main_module) {
     )doc";
     py::class_<config::InputTable>(data_module, "Table");
 
+    data_module.def(
+            "write_snapshot",
+            [](py::handle table, std::filesystem::path const& path) {
+                auto input_table = boost::any_cast<config::InputTable>(
+                        PyToAny("table", typeid(config::InputTable), table));
+                model::RelationSnapshot::Write(*input_table, path);
+            },
+            py::arg("table"), py::arg("path"),
+            R"doc(
+        Preprocess a table once and store it in a binary snapshot file.
+
+        Accepts the same objects as the "table" option of algorithms.
+    )doc");
+    data_module.def(
+            "open_snapshot",
+            [](std::filesystem::path const& path) -> config::InputTable {
+                return model::RelationSnapshot::Open(path);
+            },
+            py::arg("path"),
+            R"doc(
+        Memory-map a snapshot written by write_snapshot.
+
+        The result can be passed as the "table" option of any algorithm.
+    )doc");
+
     using namespace model;
     py::class_<ColumnCombination>(data_module, "ColumnCombination")
             .def("__str__", &ColumnCombination::ToString)
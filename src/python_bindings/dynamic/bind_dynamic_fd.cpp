@@ -0,0 +1,24 @@
+#include "python_bindings/dynamic/bind_dynamic_fd.h"
+
+#include <pybind11/pybind11.h>
+
+#include <pybind11/stl.h>
+
+#include "core/algorithms/fd/dynfd/dynfd.h"
+#include "python_bindings/py_util/bind_primitive.h"
+
+namespace {
+namespace py = pybind11;
+}  // namespace
+
+namespace python_bindings {
+void BindDynamicFd(pybind11::module_& main_module) {
+    using namespace algos;
+    using namespace algos::dynfd;
+
+    auto dynamic_fd_module = main_module.def_submodule("dynamic_fd");
+    BindPrimitiveNoBase<DynFD>(dynamic_fd_module, "DynFD")
+            .def("get_fds", &FDAlgorithm::SortedFdList)
+            .def("get_num_rows", &DynFD::GetNumRows);
+}
+}  // namespace python_bindings
@@ -10,6 +10,7 @@
 #include "core/config/indices/type.h"
 #include "core/util/bitset_utils.h"
 #include "python_bindings/py_util/bind_primitive.h"
+#include "python_bindings/py_util/bind_result_sink.h"
 #include "python_bindings/py_util/table_serialization.h"
 
 namespace {
@@ -85,6 +86,7 @@ void BindFd(py::module_& main_module) {
             fd_module, &FDAlgorithm::SortedFdList, "FdAlgorithm", "get_fds",
             {"HyFD", "Aid", "EulerFD", "Depminer", "DFD", "FastFDs", "FDep", "FdMine", "FUN",
              kPyroName, kTaneName, kPFDTaneName});
+    BindResultSink(fd_module, "FdAlgorithm", &FDAlgorithm::SetFdSink, &FD::ToJSONString);
 
     auto define_submodule = [&fd_algos_module, &main_module](char const* name,
                                                              std::vector<char const*> algorithms) {
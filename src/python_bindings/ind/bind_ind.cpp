@@ -8,6 +8,7 @@
 #include "core/algorithms/ind/ind_algorithm.h"
 #include "core/algorithms/ind/mining_algorithms.h"
 #include "python_bindings/py_util/bind_primitive.h"
+#include "python_bindings/py_util/bind_result_sink.h"
 
 namespace py = pybind11;
 
@@ -82,6 +83,7 @@ void BindInd(py::module_& main_module) {
     auto ind_algos_module =
             BindPrimitive<Spider, Faida, Mind>(ind_module, &INDAlgorithm::INDList, "IndAlgorithm",
                                                "get_inds", {kSpiderName, "Faida", kMindName});
+    BindResultSink(ind_module, "IndAlgorithm", &INDAlgorithm::SetIndSink, &IND::ToShortString);
     auto define_submodule = [&ind_algos_module, &main_module](char const* name,
                                                               std::vector<char const*> algorithms) {
         auto algos_module = main_module.def_submodule(name).def_submodule("algorithms");
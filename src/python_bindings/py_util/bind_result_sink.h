@@ -0,0 +1,93 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pybind11/stl/filesystem.h>
+
+#include "core/util/primitive_sink.h"
+
+namespace python_bindings {
+
+namespace detail {
+/* Calls a Python function for every primitive. Only the thread holding the GIL may call it, so
+ * chunks handed over by worker threads are kept until the thread that called execute registers
+ * something or the execution ends.
+ */
+template <typename T>
+class PyCallbackSink final : public util::PrimitiveSink<T> {
+private:
+    pybind11::function callback_;
+    std::vector<T> pending_;
+
+    void DeliverPending() {
+        std::vector<T> pending = std::move(pending_);
+        pending_.clear();
+        for (T& primitive : pending) callback_(std::move(primitive));
+    }
+
+public:
+    explicit PyCallbackSink(pybind11::function callback) : callback_(std::move(callback)) {}
+
+    void Consume(std::vector<T>& chunk) final {
+        if (!PyGILState_Check()) {
+            pending_.insert(pending_.end(), std::make_move_iterator(chunk.begin()),
+                            std::make_move_iterator(chunk.end()));
+            return;
+        }
+        DeliverPending();
+        for (T& primitive : chunk) callback_(std::move(primitive));
+    }
+
+    void Flush() final {
+        if (PyGILState_Check()) DeliverPending();
+    }
+};
+}  // namespace detail
+
+/* Adds methods that choose where the results of the algorithms derived from Base go to the
+ * already bound class base_name
+ */
+template <typename Base, typename T>
+void BindResultSink(pybind11::module_& module, char const* base_name,
+                    void (Base::*set_sink)(std::shared_ptr<util::PrimitiveSink<T>>),
+                    std::type_identity_t<std::function<std::string(T const&)>> format) {
+    namespace py = pybind11;
+
+    py::object cls = module.attr(base_name);
+    auto def = [&cls](char const* name, auto&& function, char const* doc) {
+        cls.attr(name) = py::cpp_function(std::forward<decltype(function)>(function),
+                                          py::name(name), py::is_method(cls),
+                                          py::sibling(py::getattr(cls, name, py::none())), doc);
+    };
+
+    def(
+            "set_result_callback",
+            [set_sink](Base& algorithm, py::function callback) {
+                (algorithm.*set_sink)(
+                        std::make_shared<detail::PyCallbackSink<T>>(std::move(callback)));
+            },
+            "Pass every dependency to the callback as soon as it is found instead of collecting "
+            "them.");
+    def(
+            "stream_results_to",
+            [set_sink, format](Base& algorithm, std::filesystem::path const& path) {
+                (algorithm.*set_sink)(std::make_shared<util::LineFileSink<T>>(path, format));
+            },
+            "Write every dependency to the file as a separate line as soon as it is found instead "
+            "of collecting them.");
+    def(
+            "collect_results",
+            [set_sink](Base& algorithm) { (algorithm.*set_sink)(nullptr); },
+            "Collect the dependencies found, this is the default.");
+}
+
+}  // namespace python_bindings
@@ -57,6 +57,9 @@ config::InputTable CreateCsvParser(std::string_view option_name, py::tuple const
 }
 
 config::InputTable PythonObjToInputTable(std::string_view option_name, py::handle obj) {
+    if (py::isinstance<config::InputTable>(obj)) {
+        return py::cast<config::InputTable>(obj);
+    }
     if (py::isinstance<py::tuple>(obj)) {
         return CreateCsvParser(option_name, py::cast<py::tuple>(obj));
     }
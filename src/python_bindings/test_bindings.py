@@ -83,6 +83,12 @@ ALGO_CORRECT_OPTIONS_INFO = [
             {"minconf": 0.00312, "minsup": 0.2321},
         ),
     ]),
+    (desb.ar.algorithms.Eclat, [
+        get_apriori_load_container({"input_format": "tabular", "has_tid": False}),
+        get_apriori_load_container(
+            {"input_format": "singular", "tid_column_index": 0, "item_column_index": 2}
+        ),
+    ]),
     (desb.mfd_verification.algorithms.MetricVerifier, [
         OptionContainer(
             "TestLong.csv",
@@ -195,6 +201,19 @@ class TestPythonBindings(unittest.TestCase):
             with self.subTest(msg=f"metric_verifier_load: {load}"):
                 with self.assertRaises(desb.ConfigurationError):
                     check_metric_verifier_failure(load.path, load.options)
+
+    def test_metrics(self):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        algo.execute()
+        metrics = algo.get_metrics()
+        self.assertEqual(set(metrics), {"counters", "histograms", "phases"})
+        # Empty if the module is built without metrics
+        if metrics["phases"]:
+            self.assertEqual(metrics["phases"]["execute"]["calls"], 1)
+            self.assertGreater(metrics["counters"]["fd_validations"], 0)
+        algo.reset_metrics()
+        self.assertFalse(algo.get_metrics()["phases"])
                 
 
 
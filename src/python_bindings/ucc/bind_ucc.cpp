@@ -13,6 +13,7 @@
 #include "core/model/table/column.h"
 #include "core/util/bitset_utils.h"
 #include "python_bindings/py_util/bind_primitive.h"
+#include "python_bindings/py_util/bind_result_sink.h"
 #include "python_bindings/py_util/table_serialization.h"
 
 namespace {
@@ -65,5 +66,6 @@ void BindUcc(py::module_& main_module) {
     BindPrimitive<HPIValid, HyUCC, PyroUCC>(
             ucc_module, py::overload_cast<>(&UCCAlgorithm::UCCList, py::const_), "UccAlgorithm",
             "get_uccs", {"HPIValid", "HyUCC", "PyroUCC"});
+    BindResultSink(ucc_module, "UccAlgorithm", &UCCAlgorithm::SetUccSink, &UCC::ToIndicesString);
 }
 }  // namespace python_bindings
@@ -1,7 +1,12 @@
 #include "tests/benchmark/benchmark_cli.h"
 
+#include <string>
+#include <vector>
+
 #include <boost/program_options.hpp>
 
+#include "core/config/thread_number/type.h"
+
 namespace po = boost::program_options;
 
 namespace benchmark {
@@ -10,7 +15,17 @@ BenchmarkCLI::BenchmarkCLI() {
 	description_.add_options()
 		(kHelpOption, "print help message")
 		(kBaselineOption, po::value<std::string>(), "JSON with baseline benchmark results")
-		(kOutputOption, po::value<std::string>(), "filename to save benchmark results");
+		(kOutputOption, po::value<std::string>(), "filename to save benchmark results")
+		(kWarmupOption, po::value<unsigned>()->default_value(0),
+		 "number of unmeasured runs of every benchmark")
+		(kRepetitionsOption, po::value<unsigned>()->default_value(1),
+		 "number of measured runs of every benchmark, median time is reported")
+		(kThreadsOption, po::value<std::vector<config::ThreadNumType>>()->multitoken(),
+		 "additionally run simple benchmarks that accept threads option with these thread "
+		 "numbers")
+		(kAlphaOption, po::value<double>()->default_value(0.05),
+		 "significance level of slowdown test, used if both runs have several repetitions")
+		(kCountAllocationsOption, "count allocations, slows down allocation-heavy benchmarks");
     // clang-format on
 }
 }  // namespace benchmark
@@ -14,13 +14,24 @@ constexpr static auto kBaselineOption = "baseline,b";
 constexpr static auto kBaselineLongOption = "baseline";
 constexpr static auto kOutputOption = "output,o";
 constexpr static auto kOutputLongOption = "output";
+constexpr static auto kWarmupOption = "warmup,w";
+constexpr static auto kWarmupLongOption = "warmup";
+constexpr static auto kRepetitionsOption = "repetitions,r";
+constexpr static auto kRepetitionsLongOption = "repetitions";
+constexpr static auto kThreadsOption = "threads,t";
+constexpr static auto kThreadsLongOption = "threads";
+constexpr static auto kAlphaOption = "alpha";
+constexpr static auto kAlphaLongOption = "alpha";
+constexpr static auto kCountAllocationsOption = "count-allocations";
+constexpr static auto kCountAllocationsLongOption = "count-allocations";
 
 class BenchmarkCLI {
 private:
     constexpr static auto kHelpMsg =
             "Benchmark runner and comparer\n"
             "Usage: Desbordante_benchmark [--baseline <baseline filename>] [--output <output "
-            "filename>]\n"
+            "filename>] [--warmup <runs>] [--repetitions <runs>] [--threads <n>...] "
+            "[--alpha <level>] [--count-allocations]\n"
             "Available options";
 
     boost::program_options::options_description description_{kHelpMsg};
@@ -32,6 +43,7 @@ public:
     void ParseOptions(int argc, char* argv[]) {
         boost::program_options::store(
                 boost::program_options::parse_command_line(argc, argv, description_), var_map_);
+        boost::program_options::notify(var_map_);
     }
 
     boost::program_options::variables_map const& GetVariablesMap() const {
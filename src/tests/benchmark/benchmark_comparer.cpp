@@ -1,31 +1,44 @@
 #include "tests/benchmark/benchmark_comparer.h"
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
-#include <unordered_map>
+
+#include "tests/benchmark/benchmark_statistics.h"
 
 namespace benchmark {
-bool BenchmarkComparer::Compare(
-        std::unordered_map<std::string, long long> const& old_results,
-        std::unordered_map<std::string, long long> const& new_results) const {
+bool BenchmarkComparer::Compare(BenchmarkResults const& old_results,
+                                BenchmarkResults const& new_results) const {
     auto all_succeeded = true;
     for (auto const& [name, new_res] : new_results) {
         std::cout << "** " << name << ": ";
-        // Assume benchmark cannot run 0ms
         auto const it = old_results.find(name);
-        if (it != old_results.end() && it->second != 0) {
+        // Assume benchmark cannot run 0ms
+        if (it != old_results.end() && it->second.MedianTime() != 0) {
             auto threshold = kDefaultThreshold;
             auto const threshold_it = thresholds_.find(name);
             if (threshold_it != thresholds_.end()) {
                 threshold = threshold_it->second;
             }
 
-            auto const prev_res = it->second;
-            auto const overhead = static_cast<double>(new_res - prev_res) / prev_res * 100;
-            auto const success = overhead <= threshold;
+            auto const prev_time = it->second.MedianTime();
+            auto const overhead =
+                    static_cast<double>(new_res.MedianTime() - prev_time) / prev_time * 100;
+            auto success = overhead <= threshold;
+            auto const has_samples = it->second.times.size() > 1 && new_res.times.size() > 1;
+            double p_value = 0;
+            if (has_samples) {
+                p_value = util::MannWhitneyGreaterPValue(it->second.times, new_res.times);
+                // Slowdown may be caused by noise
+                success = success || p_value >= alpha_;
+            }
             std::cout << (success ? "SUCCESS" : "FAIL") << ": " << std::setprecision(3)
                       << std::abs(overhead) << "% " << (overhead > 0 ? "slower" : "faster")
-                      << " than previous run **\n";
+                      << " than previous run";
+            if (has_samples) {
+                std::cout << " (p-value of slowdown: " << p_value << ")";
+            }
+            std::cout << " **\n";
             all_succeeded = all_succeeded && success;
         } else {
             std::cout << "WARNING: hasn't been run before **\n";
@@ -3,21 +3,31 @@
 #include <string>
 #include <unordered_map>
 
+#include "tests/benchmark/benchmark_result.h"
+
 namespace benchmark {
-/// @brief Compares results of benchmark runs
+/// @brief Compares results of benchmark runs.
+/// If both runs have several repetitions, a benchmark fails only if its median time got worse by
+/// more than the threshold and the one-sided Mann-Whitney U test considers the slowdown
+/// significant. Otherwise only the threshold is checked.
 class BenchmarkComparer {
 private:
-    using Results = std::unordered_map<std::string, long long>;
-
     constexpr static unsigned char kDefaultThreshold = 15;
+    constexpr static double kDefaultAlpha = 0.05;
 
     std::unordered_map<std::string, unsigned char> thresholds_;
+    double alpha_ = kDefaultAlpha;
 
 public:
     void SetThreshold(std::string const& name, unsigned char threshold) {
         thresholds_.emplace(name, threshold);
     }
 
-    bool Compare(Results const& old_results, Results const& new_results) const;
+    /// @brief Set significance level of the slowdown test
+    void SetAlpha(double alpha) {
+        alpha_ = alpha;
+    }
+
+    bool Compare(BenchmarkResults const& old_results, BenchmarkResults const& new_results) const;
 };
 }  // namespace benchmark
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tests/benchmark/benchmark_statistics.h"
+
+namespace benchmark {
+
+/// @brief Measurements of all repetitions of one benchmark
+struct BenchmarkResult {
+    /// Wall time of every measured repetition, in milliseconds
+    std::vector<long long> times;
+    /// Phase name -> wall time of the phase in every repetition, in milliseconds
+    std::map<std::string, std::vector<long long>> phase_times;
+    /// Maximum over repetitions, if the peak could be reset before each one
+    std::optional<long long> peak_rss_kb;
+    /// Medians over repetitions, if allocation counting is enabled
+    std::optional<unsigned long long> allocations;
+    std::optional<unsigned long long> allocated_bytes;
+    /// Hardware counter name -> median over repetitions
+    std::map<std::string, unsigned long long> counters;
+
+    long long MedianTime() const {
+        return util::Median(times);
+    }
+
+    double TimeMad() const {
+        return util::MedianAbsoluteDeviation(times);
+    }
+};
+
+using BenchmarkResults = std::unordered_map<std::string, BenchmarkResult>;
+
+}  // namespace benchmark
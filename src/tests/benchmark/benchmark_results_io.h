@@ -11,6 +11,8 @@
 
 #include <boost/json/src.hpp>
 
+#include "tests/benchmark/benchmark_result.h"
+
 namespace benchmark::util {
 
 /* Results-v2 format:
@@ -19,7 +21,15 @@ namespace benchmark::util {
        "results": [
            {
                "name": "Algo, dataset[, other]",
-               "time": milliseconds,
+               "time": milliseconds (median of "times"),
+               // Optional fields:
+               "times": [milliseconds of every repetition],
+               "time_mad": median absolute deviation of "times",
+               "phases": {"phase name": median milliseconds},
+               "peak_rss_kb": kilobytes,
+               "allocations": count,
+               "allocated_bytes": bytes,
+               "counters": {"hardware counter name": count}
            }
        ]
    }
@@ -30,7 +40,8 @@ public:
     /// @brief Load benchmark results saved with @c Save().
     /// @param filename must point to a @b valid JSON of Results-v2 format.
     /// @note Some checks are performed, but don't expect too much.
-    static std::unordered_map<std::string, long long> Load(std::string_view filename) {
+    /// Only names and times are read.
+    static BenchmarkResults Load(std::string_view filename) {
         std::filesystem::path file_path{filename};
         std::ifstream file{file_path};
 
@@ -48,7 +59,7 @@ public:
 
         // Date is ignored here
         auto results_array = top_level_obj["results"].as_array();
-        std::unordered_map<std::string, long long> results;
+        BenchmarkResults results;
         for (auto const& bm_res : results_array) {
             auto bm_res_obj = bm_res.as_object();
             auto name_it = bm_res_obj.find("name");
@@ -60,25 +71,27 @@ public:
                 throw std::logic_error("Load: Benchmark result doesn't have time");
             }
             auto name = name_it->value();
-            auto time = time_it->value();
-
             auto name_val = name.as_string();
 
-            long long time_val;
-            if (time.is_int64()) {
-                time_val = time.as_int64();
-            } else if (time.is_uint64()) {
-                time_val = time.as_uint64();
+            BenchmarkResult result;
+            // Results saved before repetitions were introduced have only the time
+            auto times_it = bm_res_obj.find("times");
+            if (times_it != bm_res_obj.end()) {
+                for (auto const& time : times_it->value().as_array()) {
+                    result.times.push_back(time.to_number<long long>());
+                }
             }
-            results.emplace(name_val, time_val);
+            if (result.times.empty()) {
+                result.times.push_back(time_it->value().to_number<long long>());
+            }
+            results.emplace(name_val, std::move(result));
         }
         return results;
     }
 
     /// @brief Save benchmark results in Results-v2 format to be read with Load() later.
     /// @note Some checks are performed, but don't expect too much.
-    static void Save(std::unordered_map<std::string, long long> const& results,
-                     std::string_view filename) {
+    static void Save(BenchmarkResults const& results, std::string_view filename) {
         std::filesystem::path file_path{filename};
         std::ofstream file{file_path};
 
@@ -103,7 +116,28 @@ public:
 
         boost::json::array results_arr;
         for (auto const& [name, bm_res] : results) {
-            boost::json::object bm_obj({{"name", name}, {"time", bm_res}});
+            boost::json::object bm_obj({{"name", name}, {"time", bm_res.MedianTime()}});
+            if (bm_res.times.size() > 1) {
+                bm_obj["times"] = boost::json::value_from(bm_res.times);
+                bm_obj["time_mad"] = bm_res.TimeMad();
+            }
+            if (!bm_res.phase_times.empty()) {
+                boost::json::object phases;
+                for (auto const& [phase, times] : bm_res.phase_times) {
+                    phases[phase] = Median(times);
+                }
+                bm_obj["phases"] = std::move(phases);
+            }
+            if (bm_res.peak_rss_kb.has_value()) {
+                bm_obj["peak_rss_kb"] = *bm_res.peak_rss_kb;
+            }
+            if (bm_res.allocations.has_value()) {
+                bm_obj["allocations"] = *bm_res.allocations;
+                bm_obj["allocated_bytes"] = bm_res.allocated_bytes.value_or(0);
+            }
+            if (!bm_res.counters.empty()) {
+                bm_obj["counters"] = boost::json::value_from(bm_res.counters);
+            }
             results_arr.push_back(std::move(bm_obj));
         }
         top_level_obj["results"] = std::move(results_arr);
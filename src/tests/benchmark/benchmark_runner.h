@@ -1,26 +1,74 @@
 #pragma once
 
+#include <algorithm>
+#include <any>
 #include <chrono>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/core/demangle.hpp>
 
 #include "core/algorithms/algo_factory.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "core/parser/csv_parser/csv_parser.h"
+#include "tests/benchmark/benchmark_result.h"
+#include "tests/benchmark/benchmark_statistics.h"
+#include "tests/benchmark/resource_usage.h"
 
 namespace benchmark {
+/// @brief Measures named phases of a single benchmark run
+class PhaseTimer {
+private:
+    std::map<std::string, long long> phase_times_;
+
+public:
+    /// @brief Call @c func and add its wall time to phase @c phase
+    template <typename F>
+    decltype(auto) Measure(std::string const& phase, F&& func) {
+        auto const start = std::chrono::steady_clock::now();
+        struct AddElapsed {
+            PhaseTimer& timer;
+            std::string const& phase;
+            std::chrono::steady_clock::time_point start;
+
+            ~AddElapsed() {
+                timer.phase_times_[phase] +=
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+            }
+        } add_elapsed{*this, phase, start};
+        return std::forward<F>(func)();
+    }
+
+    std::map<std::string, long long> const& PhaseTimes() const {
+        return phase_times_;
+    }
+};
+
 using BenchmarkBody = std::function<void()>;
+using PhasedBenchmarkBody = std::function<void(PhaseTimer&)>;
 
-/// @brief Runs benchmarks and tracks their execution time
+/// @brief Runs benchmarks and tracks their execution time and resource usage.
+/// Every benchmark is run @c warmup_runs_ times without measuring, then @c repetitions_ times
+/// with measuring; reported time is the median of measured runs.
 class BenchmarkRunner {
 private:
-    std::unordered_map<std::string, BenchmarkBody> benchmarks_;
-    std::unordered_map<std::string, long long> bm_results_;
+    std::unordered_map<std::string, PhasedBenchmarkBody> benchmarks_;
+    BenchmarkResults bm_results_;
+
+    unsigned warmup_runs_ = 0;
+    unsigned repetitions_ = 1;
+    // Extra thread numbers to run simple benchmarks with
+    std::vector<config::ThreadNumType> thread_sweep_;
 
     /// @brief Demangle name and take only class name (without namespaces).
     std::string GetAlgoName(std::string const& mangled_name) {
@@ -32,17 +80,100 @@ private:
         return demangled_name.substr(colon_pos + 1);
     }
 
+    template <typename Algo>
+    void RegisterLoadExecuteBenchmark(std::string const& name, algos::StdParamsMap params) {
+        auto bm_body = [params = std::move(params)](PhaseTimer& timer) {
+            auto algo = timer.Measure(
+                    "load", [&params] { return algos::CreateAndLoadAlgorithm<Algo>(params); });
+            timer.Measure("execute", [&algo] { algo->Execute(); });
+        };
+        RegisterBenchmark(name, std::move(bm_body));
+    }
+
+    BenchmarkResult Run(PhasedBenchmarkBody const& benchmark_body) {
+        BenchmarkResult result;
+        for (unsigned i = 0; i != warmup_runs_; ++i) {
+            PhaseTimer timer;
+            benchmark_body(timer);
+        }
+
+        util::HardwareCounters hardware_counters;
+        bool const count_allocations = util::IsAllocationCountingEnabled();
+        std::vector<unsigned long long> allocations;
+        std::vector<unsigned long long> allocated_bytes;
+        std::map<std::string, std::vector<unsigned long long>> counters;
+        bool peak_rss_resettable = true;
+        for (unsigned i = 0; i != repetitions_; ++i) {
+            PhaseTimer timer;
+            peak_rss_resettable = util::ResetPeakRss() && peak_rss_resettable;
+            util::TakeAllocationStats();
+            hardware_counters.Start();
+            auto const start = std::chrono::steady_clock::now();
+            benchmark_body(timer);
+            auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         std::chrono::steady_clock::now() - start)
+                                         .count();
+            for (auto const& [counter, value] : hardware_counters.Stop()) {
+                counters[counter].push_back(value);
+            }
+            util::AllocationStats const allocation_stats = util::TakeAllocationStats();
+            auto const peak_rss = util::GetPeakRssKb();
+
+            result.times.push_back(elapsed);
+            for (auto const& [phase, phase_time] : timer.PhaseTimes()) {
+                result.phase_times[phase].push_back(phase_time);
+            }
+            if (peak_rss.has_value()) {
+                result.peak_rss_kb = std::max(result.peak_rss_kb.value_or(0), *peak_rss);
+            }
+            allocations.push_back(allocation_stats.allocations);
+            allocated_bytes.push_back(allocation_stats.allocated_bytes);
+        }
+
+        // Without a reset the peak is the maximum over the whole process lifetime
+        if (!peak_rss_resettable) result.peak_rss_kb.reset();
+        if (count_allocations) {
+            result.allocations = util::Median(std::move(allocations));
+            result.allocated_bytes = util::Median(std::move(allocated_bytes));
+        }
+        for (auto& [counter, values] : counters) {
+            result.counters.emplace(counter, util::Median(std::move(values)));
+        }
+        return result;
+    }
+
 public:
-    /// @brief Register a benchmark that simply calls and measures Algo.Execute().
+    /// @brief Set number of unmeasured runs before measured ones
+    void SetWarmupRuns(unsigned warmup_runs) {
+        warmup_runs_ = warmup_runs;
+    }
+
+    /// @brief Set number of measured runs, must be positive
+    void SetRepetitions(unsigned repetitions) {
+        repetitions_ = std::max(repetitions, 1u);
+    }
+
+    /// @brief Set thread numbers that simple benchmarks accepting @c kThreads will additionally
+    /// be run with. Must be called before benchmarks are registered.
+    void SetThreadSweep(std::vector<config::ThreadNumType> thread_sweep) {
+        thread_sweep_ = std::move(thread_sweep);
+    }
+
+    /// @brief Register a benchmark that creates and loads Algo, then calls Algo.Execute().
+    /// Loading and execution are reported as "load" and "execute" phases.
     /// @param csv -- @c CSVConfig to run algo on
     /// @param other_params -- @c StdParamsMap with other algo options.
     /// It may or may not contain @c CSVConfig -- @c csv will be used anyway
     /// @param name_suffix -- suffix that will be added to benchmark name.
     /// Can be used to distinguish different runs of a single algo
+    /// @note If @c other_params contains @c kThreads, a copy of the benchmark named
+    /// "<name>, sweep N threads" is registered for every thread number of the sweep
     template <typename Algo>
     std::string RegisterSimpleBenchmark(CSVConfig const& csv,
                                         algos::StdParamsMap&& other_params = {},
                                         std::string const& name_suffix = "") {
+        using config::names::kThreads;
+
         std::ostringstream name;
         name << GetAlgoName(typeid(Algo).name()) << ", " << csv.path.stem().string();
         if (!name_suffix.empty()) {
@@ -51,12 +182,20 @@ public:
 
         other_params[config::names::kCsvConfig] = csv;
 
-        auto bm_body = [other_params] {
-            auto algo = algos::CreateAndLoadAlgorithm<Algo>(other_params);
-            algo->Execute();
-        };
+        auto const threads_it = other_params.find(kThreads);
+        if (threads_it != other_params.end()) {
+            auto const threads = std::any_cast<config::ThreadNumType>(threads_it->second);
+            for (config::ThreadNumType sweep_threads : thread_sweep_) {
+                if (sweep_threads == threads) continue;
+                algos::StdParamsMap sweep_params = other_params;
+                sweep_params[kThreads] = sweep_threads;
+                RegisterLoadExecuteBenchmark<Algo>(
+                        name.str() + ", sweep " + std::to_string(sweep_threads) + " threads",
+                        std::move(sweep_params));
+            }
+        }
 
-        RegisterBenchmark(name.str(), bm_body);
+        RegisterLoadExecuteBenchmark<Algo>(name.str(), std::move(other_params));
         return name.str();
     }
 
@@ -64,6 +203,13 @@ public:
     /// @param name -- benchmark name
     /// @param body -- custom function to be measured
     void RegisterBenchmark(std::string const& name, BenchmarkBody&& body) {
+        RegisterBenchmark(name, [body = std::move(body)](PhaseTimer&) { body(); });
+    }
+
+    /// @brief Register a custom benchmark that reports time of its phases
+    /// @param name -- benchmark name
+    /// @param body -- custom function to be measured, wraps phases in @c PhaseTimer::Measure
+    void RegisterBenchmark(std::string const& name, PhasedBenchmarkBody&& body) {
         benchmarks_.emplace(name, std::move(body));
     }
 
@@ -77,18 +223,20 @@ public:
     void ExecuteAll() {
         for (auto& [name, benchmark_body] : benchmarks_) {
             std::cout << "** " << name << "... **\n";
-            auto start = std::chrono::steady_clock::now();
-            benchmark_body();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                   std::chrono::steady_clock::now() - start)
-                                   .count();
-            std::cout << "** " << name << ": " << elapsed / 1000 << "s **\n";
-            bm_results_.emplace(name, elapsed);
+            BenchmarkResult result = Run(benchmark_body);
+            std::cout << "** " << name << ": " << std::fixed << std::setprecision(3)
+                      << result.MedianTime() / 1000.0 << "s";
+            if (result.times.size() > 1) {
+                std::cout << " (median of " << result.times.size()
+                          << ", MAD: " << result.TimeMad() / 1000.0 << "s)";
+            }
+            std::cout << " **\n" << std::defaultfloat;
+            bm_results_.insert_or_assign(name, std::move(result));
         }
     }
 
     /// @brief Get results of all benchmarks that've been already executed
-    std::unordered_map<std::string, long long> const& BenchmarkResults() const {
+    BenchmarkResults const& GetBenchmarkResults() const {
         return bm_results_;
     }
 };
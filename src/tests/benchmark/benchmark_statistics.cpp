@@ -0,0 +1,91 @@
+#include "tests/benchmark/benchmark_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace benchmark::util {
+
+namespace {
+// Larger samples use the normal approximation, which is accurate enough for them
+constexpr std::size_t kMaxExactSampleSize = 20;
+}  // namespace
+
+double ExactGreaterPValue(std::size_t n1, std::size_t n2, std::size_t u_obs) {
+    // counts[i][j][u] is the number of orderings of i first-sample and j second-sample elements
+    // with U = u. Placing the greatest element last gives the recurrence below.
+    std::size_t const max_u = n1 * n2;
+    std::vector<std::vector<std::vector<double>>> counts(
+            n1 + 1, std::vector<std::vector<double>>(n2 + 1, std::vector<double>(max_u + 1)));
+    for (std::size_t i = 0; i <= n1; ++i) {
+        for (std::size_t j = 0; j <= n2; ++j) {
+            if (i == 0 || j == 0) {
+                counts[i][j][0] = 1;
+                continue;
+            }
+            for (std::size_t u = 0; u <= i * j; ++u) {
+                // The greatest element is from the first sample: it adds no pairs
+                double count = counts[i - 1][j][u];
+                // The greatest element is from the second sample: it is greater than all i
+                if (u >= i) count += counts[i][j - 1][u - i];
+                counts[i][j][u] = count;
+            }
+        }
+    }
+
+    double total = 0;
+    double greater_or_equal = 0;
+    for (std::size_t u = 0; u <= max_u; ++u) {
+        total += counts[n1][n2][u];
+        if (u >= u_obs) greater_or_equal += counts[n1][n2][u];
+    }
+    return greater_or_equal / total;
+}
+
+double MannWhitneyGreaterPValue(std::vector<long long> const& old_sample,
+                                std::vector<long long> const& new_sample) {
+    std::size_t const n1 = old_sample.size();
+    std::size_t const n2 = new_sample.size();
+    if (n1 == 0 || n2 == 0) return 1;
+
+    // Values paired with "belongs to the new sample", sorted to assign ranks
+    std::vector<std::pair<long long, bool>> values;
+    values.reserve(n1 + n2);
+    for (long long value : old_sample) values.emplace_back(value, false);
+    for (long long value : new_sample) values.emplace_back(value, true);
+    std::sort(values.begin(), values.end());
+
+    double new_rank_sum = 0;
+    // Sum of t^3 - t over groups of t tied values
+    double tie_term = 0;
+    for (std::size_t begin = 0; begin < values.size();) {
+        std::size_t end = begin;
+        while (end < values.size() && values[end].first == values[begin].first) ++end;
+        double const tied = static_cast<double>(end - begin);
+        // Tied values get the mean of their ranks, ranks are counted from 1
+        double const mid_rank = (static_cast<double>(begin + end) + 1) / 2;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (values[i].second) new_rank_sum += mid_rank;
+        }
+        tie_term += tied * tied * tied - tied;
+        begin = end;
+    }
+    double const u = new_rank_sum - static_cast<double>(n2 * (n2 + 1)) / 2;
+
+    if (tie_term == 0 && n1 <= kMaxExactSampleSize && n2 <= kMaxExactSampleSize) {
+        return ExactGreaterPValue(n1, n2, static_cast<std::size_t>(u));
+    }
+
+    double const n = static_cast<double>(n1 + n2);
+    double const mean = static_cast<double>(n1 * n2) / 2;
+    double const variance =
+            static_cast<double>(n1 * n2) / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+    if (variance <= 0) return 1;
+    // Continuity correction
+    double const z = (u - mean - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0)) / 2;
+}
+
+}  // namespace benchmark::util
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace benchmark::util {
+
+/// @brief Median of the sample, mean of the two middle elements for even sizes.
+/// @param sample must not be empty
+template <typename T>
+T Median(std::vector<T> sample) {
+    auto const middle = sample.begin() + sample.size() / 2;
+    std::nth_element(sample.begin(), middle, sample.end());
+    if (sample.size() % 2 != 0) {
+        return *middle;
+    }
+    auto const lower_middle = *std::max_element(sample.begin(), middle);
+    return lower_middle + (*middle - lower_middle) / 2;
+}
+
+/// @brief Median absolute deviation from the median, a spread measure robust to outliers.
+/// @param sample must not be empty
+template <typename T>
+double MedianAbsoluteDeviation(std::vector<T> const& sample) {
+    double const median = Median(std::vector<double>(sample.begin(), sample.end()));
+    std::vector<double> deviations;
+    deviations.reserve(sample.size());
+    for (T const value : sample) {
+        deviations.push_back(std::abs(static_cast<double>(value) - median));
+    }
+    return Median(std::move(deviations));
+}
+
+/// @brief Exact distribution of the Mann-Whitney U statistic for samples without ties.
+/// @return P(U >= @c u_obs) for samples of sizes @c n1 and @c n2, where U is the number of pairs
+/// in which the element of the second sample is greater.
+double ExactGreaterPValue(std::size_t n1, std::size_t n2, std::size_t u_obs);
+
+/// @brief One-sided Mann-Whitney U test.
+/// @return p-value of the hypothesis that values of @c new_sample tend to be greater than values
+/// of @c old_sample. The exact distribution is used for small samples without ties, the normal
+/// approximation with tie correction otherwise.
+double MannWhitneyGreaterPValue(std::vector<long long> const& old_sample,
+                                std::vector<long long> const& new_sample);
+
+}  // namespace benchmark::util
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/algorithms/algo_factory.h"
+#include "core/algorithms/gfd/gfd_validator/egfd_validator.h"
+#include "core/algorithms/gfd/gfd_validator/gfd_validator.h"
+#include "core/algorithms/gfd/gfd_validator/naivegfd_validator.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "tests/benchmark/benchmark_comparer.h"
+#include "tests/benchmark/benchmark_runner.h"
+#include "tests/unit/all_gfd_paths.h"
+
+namespace benchmark {
+
+namespace gfd {
+
+// The test graphs are small, so every graph is validated many times, each time by a freshly
+// loaded algorithm
+constexpr int kRepetitions = 500;
+
+template <typename Validator>
+void RegisterValidatorBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer,
+                                std::string const& algo_name, config::ThreadNumType threads) {
+    using namespace config::names;
+    using Paths = std::vector<std::filesystem::path>;
+
+    std::vector<std::pair<std::filesystem::path, Paths>> const inputs = {
+            {tests::kGfdTestBlogsGraph, {tests::kGfdTestBlogsGfd}},
+            {tests::kGfdTestChannelsGraph, {tests::kGfdTestChannelsGfd}},
+            {tests::kGfdTestSymbolsGraph, {tests::kGfdTestSymbolsGfd1, tests::kGfdTestSymbolsGfd2}},
+            {tests::kGfdTestShapesGraph, {tests::kGfdTestShapesGfd1, tests::kGfdTestShapesGfd2}},
+            {tests::kGfdTestQuadrangleGraph, {tests::kGfdTestQuadrangleGfd}},
+            {tests::kGfdTestDirectorsGraph, {tests::kGfdTestDirectorsGfd}}};
+
+    auto body = [inputs, threads] {
+        for (auto const& [graph_path, gfd_paths] : inputs) {
+            for (int i = 0; i < kRepetitions; ++i) {
+                auto algo = algos::CreateAndLoadAlgorithm<Validator>(
+                        {{kGraphData, graph_path}, {kGfdData, gfd_paths}, {kThreads, threads}});
+                algo->Execute();
+            }
+        }
+    };
+
+    std::string const name = algo_name + ", gfd test graphs, " + std::to_string(threads) +
+                             (threads == 1 ? " thread" : " threads");
+    runner.RegisterBenchmark(name, std::move(body));
+    // Parallel runs are less stable
+    comparer.SetThreshold(name, threads == 1 ? 20 : 35);
+}
+
+}  // namespace gfd
+
+inline void GFDBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
+    gfd::RegisterValidatorBenchmark<algos::NaiveGfdValidator>(runner, comparer,
+                                                              "NaiveGfdValidator", 1);
+    for (config::ThreadNumType threads : {1, 4}) {
+        gfd::RegisterValidatorBenchmark<algos::GfdValidator>(runner, comparer, "GfdValidator",
+                                                             threads);
+        gfd::RegisterValidatorBenchmark<algos::EGfdValidator>(runner, comparer, "EGfdValidator",
+                                                              threads);
+    }
+}
+
+}  // namespace benchmark
@@ -1,12 +1,13 @@
 #include <cstdlib>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
 #include <boost/program_options.hpp>
 #include <boost/program_options/errors.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include "core/config/thread_number/type.h"
 #include "core/util/logger.h"
 #include "tests/benchmark/adc_benchmark.h"
 #include "tests/benchmark/benchmark_cli.h"
@@ -15,9 +16,12 @@
 #include "tests/benchmark/benchmark_runner.h"
 #include "tests/benchmark/dd_benchmark.h"
 #include "tests/benchmark/fd_benchmark.h"
+#include "tests/benchmark/gfd_benchmark.h"
 #include "tests/benchmark/ind_benchmark.h"
 #include "tests/benchmark/md_benchmark.h"
 #include "tests/benchmark/nar_benchmark.h"
+#include "tests/benchmark/od_benchmark.h"
+#include "tests/benchmark/resource_usage.h"
 
 namespace po = boost::program_options;
 
@@ -26,16 +30,6 @@ int main(int argc, char* argv[]) {
 
     ::util::logging::Initialize();
 
-    BenchmarkRunner bm_runner;
-    BenchmarkComparer bm_comparer;
-    for (auto test_register_func :
-         {ADCBenchmark, DDBenchmark, INDBenchmark, FDBenchmark, MDBenchmark, NARBenchmark}) {
-        test_register_func(bm_runner, bm_comparer);
-    }
-    bm_runner.ExecuteAll();
-
-    auto results = bm_runner.BenchmarkResults();
-
     BenchmarkCLI benchmark_cli;
     try {
         benchmark_cli.ParseOptions(argc, argv);
@@ -49,6 +43,26 @@ int main(int argc, char* argv[]) {
         return EXIT_SUCCESS;
     }
 
+    BenchmarkRunner bm_runner;
+    BenchmarkComparer bm_comparer;
+    bm_runner.SetWarmupRuns(var_map[kWarmupLongOption].as<unsigned>());
+    bm_runner.SetRepetitions(var_map[kRepetitionsLongOption].as<unsigned>());
+    if (var_map.contains(kThreadsLongOption)) {
+        bm_runner.SetThreadSweep(
+                var_map[kThreadsLongOption].as<std::vector<config::ThreadNumType>>());
+    }
+    bm_comparer.SetAlpha(var_map[kAlphaLongOption].as<double>());
+    benchmark::util::SetAllocationCounting(var_map.contains(kCountAllocationsLongOption));
+
+    for (auto test_register_func :
+         {ADCBenchmark, DDBenchmark, INDBenchmark, FDBenchmark, GFDBenchmark, MDBenchmark,
+          NARBenchmark, ODBenchmark}) {
+        test_register_func(bm_runner, bm_comparer);
+    }
+    bm_runner.ExecuteAll();
+
+    auto const& results = bm_runner.GetBenchmarkResults();
+
     // Succeed if there's nothing to compare
     auto success = true;
     if (var_map.contains(kBaselineLongOption)) {
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+#include "core/algorithms/od/order/order.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "tests/benchmark/benchmark_comparer.h"
+#include "tests/benchmark/benchmark_runner.h"
+#include "tests/common/all_csv_configs.h"
+
+namespace benchmark {
+
+inline void ODBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
+    using namespace config::names;
+
+    for (config::ThreadNumType threads : {1, 4}) {
+        for (auto const& csv_config : {tests::kEpicMeds, tests::kNeighbors100k}) {
+            auto order_name = runner.RegisterSimpleBenchmark<algos::order::Order>(
+                    csv_config, {{kThreads, threads}}, std::to_string(threads) + " threads");
+            // Parallel runs are less stable
+            comparer.SetThreshold(order_name, threads == 1 ? 20 : 35);
+        }
+    }
+}
+
+}  // namespace benchmark
@@ -0,0 +1,149 @@
+#include "tests/benchmark/resource_usage.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::atomic<bool> count_allocations = false;
+std::atomic<unsigned long long> allocations = 0;
+std::atomic<unsigned long long> allocated_bytes = 0;
+}  // namespace
+
+// Replaceable global allocation functions. Array and nothrow forms call this one by default.
+// They are not inlined, otherwise GCC reports free() of memory returned by operator new.
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    if (count_allocations.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* ptr = std::malloc(size)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace benchmark::util {
+
+bool ResetPeakRss() {
+#if defined(__linux__)
+    // Writing 5 resets VmHWM to the current RSS (Linux 4.0+)
+    std::ofstream clear_refs{"/proc/self/clear_refs"};
+    clear_refs << "5";
+    clear_refs.flush();
+    return static_cast<bool>(clear_refs);
+#else
+    return false;
+#endif
+}
+
+std::optional<long long> GetPeakRssKb() {
+    std::ifstream status{"/proc/self/status"};
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            long long value;
+            if (status >> value) return value;
+            return std::nullopt;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return std::nullopt;
+}
+
+void SetAllocationCounting(bool enabled) {
+    count_allocations.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsAllocationCountingEnabled() {
+    return count_allocations.load(std::memory_order_relaxed);
+}
+
+AllocationStats TakeAllocationStats() {
+    return {allocations.exchange(0, std::memory_order_relaxed),
+            allocated_bytes.exchange(0, std::memory_order_relaxed)};
+}
+
+#if defined(__linux__)
+HardwareCounters::HardwareCounters() {
+    struct Event {
+        char const* name;
+        std::uint64_t config;
+    };
+
+    for (auto [name, config] : {Event{"cycles", PERF_COUNT_HW_CPU_CYCLES},
+                                Event{"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+                                Event{"cache_misses", PERF_COUNT_HW_CACHE_MISSES},
+                                Event{"branch_misses", PERF_COUNT_HW_BRANCH_MISSES}}) {
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        // Count threads spawned by the algorithm too
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        long const fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd != -1) counters_.push_back({name, static_cast<int>(fd)});
+    }
+}
+
+HardwareCounters::~HardwareCounters() {
+    for (Counter const& counter : counters_) close(counter.fd);
+}
+
+void HardwareCounters::Start() {
+    for (Counter const& counter : counters_) {
+        ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+std::map<std::string, unsigned long long> HardwareCounters::Stop() {
+    std::map<std::string, unsigned long long> values;
+    for (Counter const& counter : counters_) {
+        ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t value;
+        if (read(counter.fd, &value, sizeof(value)) == sizeof(value)) {
+            values.emplace(counter.name, value);
+        }
+    }
+    return values;
+}
+#else
+HardwareCounters::HardwareCounters() = default;
+
+HardwareCounters::~HardwareCounters() = default;
+
+void HardwareCounters::Start() {}
+
+std::map<std::string, unsigned long long> HardwareCounters::Stop() {
+    return {};
+}
+#endif
+
+}  // namespace benchmark::util
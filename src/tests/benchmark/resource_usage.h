@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace benchmark::util {
+
+/// @brief Reset the peak resident set size of the process to its current RSS.
+/// @return false if the kernel doesn't support it, then @c GetPeakRssKb() is meaningless for
+/// everything but the first benchmark.
+bool ResetPeakRss();
+
+/// @brief Peak resident set size (VmHWM) of the process in kilobytes, if available.
+std::optional<long long> GetPeakRssKb();
+
+struct AllocationStats {
+    unsigned long long allocations = 0;
+    unsigned long long allocated_bytes = 0;
+};
+
+/// @brief Enable or disable counting of global @c operator @c new calls.
+/// @note Counting is off by default, because updating shared counters slows down
+/// allocation-heavy multithreaded algorithms. Over-aligned allocations are not counted.
+void SetAllocationCounting(bool enabled);
+
+bool IsAllocationCountingEnabled();
+
+/// @brief Number and total size of allocations since the previous call.
+AllocationStats TakeAllocationStats();
+
+/// @brief Hardware performance counters (cycles, instructions, cache and branch misses) of the
+/// process and of the threads it creates while counting, read with perf_event_open.
+/// @note Counters that can't be opened (not Linux, perf_event_paranoid, no PMU in a VM) are
+/// silently omitted, so the result may be empty.
+class HardwareCounters {
+private:
+    struct Counter {
+        std::string name;
+        int fd;
+    };
+
+    std::vector<Counter> counters_;
+
+public:
+    HardwareCounters();
+    HardwareCounters(HardwareCounters const&) = delete;
+    HardwareCounters& operator=(HardwareCounters const&) = delete;
+    ~HardwareCounters();
+
+    bool Available() const {
+        return !counters_.empty();
+    }
+
+    void Start();
+    /// @return counter name -> value since the last @c Start()
+    std::map<std::string, unsigned long long> Stop();
+};
+
+}  // namespace benchmark::util
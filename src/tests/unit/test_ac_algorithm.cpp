@@ -4,6 +4,7 @@
 #include "core/algorithms/algebraic_constraints/bin_operation_enum.h"
 #include "core/algorithms/algo_factory.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/types/types.h"
 #include "tests/common/all_csv_configs.h"
 
@@ -41,14 +42,15 @@ namespace tests {
 
 namespace fs = std::filesystem;
 
-class ACAlgorithmTest : public ::testing::Test {
+// Parametrized by the number of threads
+class ACAlgorithmTest : public ::testing::TestWithParam<config::ThreadNumType> {
 public:
     using ACExceptions = std::vector<algos::ACException>;
 
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, algos::Binop bin_operation,
                                            double fuzziness, double p_fuzz, double weight,
                                            size_t bumps_limit, size_t iterations_limit,
-                                           double seed) {
+                                           double seed, config::ThreadNumType threads = 1) {
         using namespace config::names;
         return {{kCsvConfig, csv_config},
                 {kBinaryOperation, bin_operation},
@@ -57,20 +59,21 @@ public:
                 {kWeight, weight},
                 {kBumpsLimit, bumps_limit},
                 {kIterationsLimit, iterations_limit},
-                {kACSeed, seed}};
+                {kACSeed, seed},
+                {kThreads, threads}};
     }
 
-    static std::unique_ptr<algos::ACAlgorithm> CreateACAlgorithmInstance(
+    std::unique_ptr<algos::ACAlgorithm> CreateACAlgorithmInstance(
             CSVConfig const& csv_config, algos::Binop bin_operation = algos::Binop::Addition,
             double fuzziness = 0.1, double p_fuzz = 0.9, double weight = 0.1,
             size_t bumps_limit = 0, size_t iterations_limit = 10, double seed = 0) {
         return algos::CreateAndLoadAlgorithm<algos::ACAlgorithm>(
                 GetParamMap(csv_config, bin_operation, fuzziness, p_fuzz, weight, bumps_limit,
-                            iterations_limit, seed));
+                            iterations_limit, seed, GetParam()));
     }
 };
 
-TEST_F(ACAlgorithmTest, NonFuzzyBumpsDetection1) {
+TEST_P(ACAlgorithmTest, NonFuzzyBumpsDetection1) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Addition, 0.0, 0.9, 0.05);
     a->Execute();
     auto& ranges_collection = a->GetRangesByColumns(0, 2);
@@ -80,7 +83,7 @@ TEST_F(ACAlgorithmTest, NonFuzzyBumpsDetection1) {
     AssertRanges(expected_ranges, ranges_collection);
 }
 
-TEST_F(ACAlgorithmTest, NonFuzzyBumpsDetection2) {
+TEST_P(ACAlgorithmTest, NonFuzzyBumpsDetection2) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Addition, 0.0, 0.9, 0.05);
     a->Execute();
     auto& ranges_collection = a->GetRangesByColumns(2, 3);
@@ -90,7 +93,7 @@ TEST_F(ACAlgorithmTest, NonFuzzyBumpsDetection2) {
     AssertRanges(expected_ranges, ranges_collection);
 }
 
-TEST_F(ACAlgorithmTest, SampleSizeCalculation) {
+TEST_P(ACAlgorithmTest, SampleSizeCalculation) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Addition, 0.1, 0.8, 0.05);
     ASSERT_EQ(28, a->CalculateSampleSize(1));
     /* Sample size can't be greater than number of rows in the table */
@@ -98,7 +101,7 @@ TEST_F(ACAlgorithmTest, SampleSizeCalculation) {
     ASSERT_EQ(150, a->CalculateSampleSize(28));
 }
 
-TEST_F(ACAlgorithmTest, SubNonFuzzy) {
+TEST_P(ACAlgorithmTest, SubNonFuzzy) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Subtraction, 0.0);
     a->Execute();
     auto& ranges_collection = a->GetRangesByColumns(1, 3);
@@ -108,7 +111,7 @@ TEST_F(ACAlgorithmTest, SubNonFuzzy) {
     AssertRanges(expected_ranges, ranges_collection);
 }
 
-TEST_F(ACAlgorithmTest, MulNonFuzzy) {
+TEST_P(ACAlgorithmTest, MulNonFuzzy) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Multiplication, 0.0);
     a->Execute();
     auto& ranges_collection = a->GetRangesByColumns(2, 3);
@@ -118,7 +121,7 @@ TEST_F(ACAlgorithmTest, MulNonFuzzy) {
     AssertRanges(expected_ranges, ranges_collection);
 }
 
-TEST_F(ACAlgorithmTest, DivNonFuzzy) {
+TEST_P(ACAlgorithmTest, DivNonFuzzy) {
     auto a = CreateACAlgorithmInstance(kTestZeros, algos::Binop::Division, 0.0);
     a->Execute();
     auto& ranges_collection01 = a->GetRangesByColumns(0, 1);
@@ -140,7 +143,7 @@ TEST_F(ACAlgorithmTest, DivNonFuzzy) {
     AssertRanges(expected_ranges20, ranges_collection20);
 }
 
-TEST_F(ACAlgorithmTest, FuzzyBumpsDetection) {
+TEST_P(ACAlgorithmTest, FuzzyBumpsDetection) {
     auto a = CreateACAlgorithmInstance(kTestLong, algos::Binop::Addition, 0.55, 0.41, 0.1);
     a->Execute();
     auto& ranges_collection01 = a->GetRangesByColumns(0, 1);
@@ -156,7 +159,7 @@ TEST_F(ACAlgorithmTest, FuzzyBumpsDetection) {
     AssertRanges(expected_ranges12, ranges_collection12);
 }
 
-TEST_F(ACAlgorithmTest, NullAndEmptyIgnoring) {
+TEST_P(ACAlgorithmTest, NullAndEmptyIgnoring) {
     auto a = CreateACAlgorithmInstance(kNullEmpty, algos::Binop::Addition, 0.0);
     a->Execute();
     auto& ranges = a->GetRangesCollections();
@@ -174,14 +177,14 @@ TEST_F(ACAlgorithmTest, NullAndEmptyIgnoring) {
     AssertRanges(expected_ranges03, ranges_collection12);
 }
 
-TEST_F(ACAlgorithmTest, ColumnTypesPairing) {
+TEST_P(ACAlgorithmTest, ColumnTypesPairing) {
     auto a = CreateACAlgorithmInstance(kSimpleTypes, algos::Binop::Addition, 0.0);
     a->Execute();
     auto& ranges = a->GetRangesCollections();
     EXPECT_EQ(ranges.size(), 2);
 }
 
-TEST_F(ACAlgorithmTest, CollectingACExceptions) {
+TEST_P(ACAlgorithmTest, CollectingACExceptions) {
     auto a = CreateACAlgorithmInstance(kTestLong, algos::Binop::Addition, 0.55, 0.41, 0.1);
     a->Execute();
     a->CollectACExceptions();
@@ -195,7 +198,7 @@ TEST_F(ACAlgorithmTest, CollectingACExceptions) {
     AssertACExceptions(expected, a->GetACExceptions());
 }
 
-TEST_F(ACAlgorithmTest, RangesReconstruction) {
+TEST_P(ACAlgorithmTest, RangesReconstruction) {
     auto a = CreateACAlgorithmInstance(kIris, algos::Binop::Subtraction, 0.0);
     a->Execute();
     auto ranges_collection = a->ReconstructRangesByColumns(1, 3, 1);
@@ -203,4 +206,7 @@ TEST_F(ACAlgorithmTest, RangesReconstruction) {
 
     AssertRanges(expected_ranges, ranges_collection);
 }
+
+INSTANTIATE_TEST_SUITE_P(ACAlgorithmTestSuite, ACAlgorithmTest,
+                         ::testing::Values<config::ThreadNumType>(1, 4));
 }  // namespace tests
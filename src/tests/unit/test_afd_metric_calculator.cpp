@@ -3,6 +3,7 @@
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/fd/afd_metric/afd_metric.h"
 #include "core/algorithms/fd/afd_metric/afd_metric_calculator.h"
+#include "core/algorithms/fd/afd_metric/afd_metric_matrix_calculator.h"
 #include "core/config/indices/type.h"
 #include "tests/common/all_csv_configs.h"
 
@@ -51,4 +52,32 @@ INSTANTIATE_TEST_SUITE_P(
             ));
 // clang-format on
 
+TEST(TestAFDMetricMatrix, MatchesSinglePairCalculator) {
+    for (config::ThreadNumType threads : {1, 4}) {
+        auto matrix_calculator = algos::CreateAndLoadAlgorithm<AFDMetricMatrixCalculator>(
+                algos::StdParamsMap{{kCsvConfig, kTestFD}, {kThreads, threads}});
+        matrix_calculator->Execute();
+
+        for (AFDMetric metric : AFDMetric::_values()) {
+            auto const& matrix = matrix_calculator->GetMatrix(metric);
+            ASSERT_EQ(matrix.size(), 6);
+            for (unsigned lhs = 0; lhs < matrix.size(); ++lhs) {
+                ASSERT_EQ(matrix[lhs].size(), 6);
+                for (unsigned rhs = 0; rhs < matrix.size(); ++rhs) {
+                    auto calculator = algos::CreateAndLoadAlgorithm<AFDMetricCalculator>(
+                            algos::StdParamsMap{{kCsvConfig, kTestFD},
+                                                {kLhsIndices, config::IndicesType{lhs}},
+                                                {kRhsIndices, config::IndicesType{rhs}},
+                                                {kMetric, metric}});
+                    calculator->Execute();
+                    EXPECT_NEAR(matrix[lhs][rhs], calculator->GetResult(), 1e-12)
+                            << metric._to_string() << ": " << lhs << " -> " << rhs;
+                }
+            }
+        }
+        EXPECT_DOUBLE_EQ(matrix_calculator->GetMatrix(AFDMetric::tau)[4][3], 78.L / 90);
+        EXPECT_DOUBLE_EQ(matrix_calculator->GetMatrix(AFDMetric::g2)[3][4], 5.L / 6);
+    }
+}
+
 }  // namespace tests
@@ -2,8 +2,11 @@
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/association_rules/apriori.h"
+#include "core/algorithms/association_rules/eclat.h"
 #include "core/config/names.h"
+#include "core/model/transaction/transactional_data.h"
 #include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
 
 namespace tests {
 
@@ -95,6 +98,14 @@ protected:
         return algos::CreateAndLoadAlgorithm<algos::Apriori>(
                 GetParamMap(std::forward<Args>(args)...));
     }
+
+    template <typename... Args>
+    static std::unique_ptr<algos::ARAlgorithm> CreateEclatInstance(config::ThreadNumType threads,
+                                                                   Args&&... args) {
+        algos::StdParamsMap params = GetParamMap(std::forward<Args>(args)...);
+        params.emplace(config::names::kThreads, threads);
+        return algos::CreateAndLoadAlgorithm<algos::Eclat>(params);
+    }
 };
 
 TEST_F(ARAlgorithmTest, BookDataset) {
@@ -362,4 +373,69 @@ TEST_F(ARAlgorithmTest, SupportAndConfidenceTabular) {
     CheckSupportAndConfidence(result, {"Milk", "Bread"}, {"Eggs"}, 0.2, 0.5);
 }
 
+TEST(TransactionalDataTest, CompactLayout) {
+    auto table = MakeInputTable(kRulesBook);
+    auto data = model::TransactionalData::CreateFromSingular(*table, 0, 1, 4);
+
+    // Items are numbered by descending support
+    std::vector<std::string> const expected_universe = {"Milk",  "Eggs",   "Yogurt",
+                                                        "Bread", "Cheese", "Butter"};
+    ASSERT_EQ(data->GetItemUniverse(), expected_universe);
+
+    // Transactions follow the first appearance of their ids
+    std::vector<std::pair<size_t, std::vector<unsigned>>> const expected_transactions = {
+            {1, {0, 3, 5}}, {3, {0, 1, 3, 4}}, {2, {0, 1, 2}}, {4, {0, 1, 2}}, {5, {0, 2, 4}}};
+    ASSERT_EQ(data->GetNumTransactions(), expected_transactions.size());
+    for (size_t i = 0; i < expected_transactions.size(); ++i) {
+        auto const& [tid, items] = expected_transactions[i];
+        std::span<unsigned const> const transaction = data->GetTransaction(i);
+        EXPECT_EQ(data->GetTransactionId(i), tid);
+        EXPECT_EQ(std::vector<unsigned>(transaction.begin(), transaction.end()), items);
+    }
+
+    std::vector<std::vector<unsigned>> const expected_tid_lists = {
+            {0, 1, 2, 3, 4}, {1, 2, 3}, {2, 3, 4}, {0, 1}, {1, 4}, {0}};
+    EXPECT_EQ(data->GetTidLists(), expected_tid_lists);
+}
+
+static std::set<std::set<std::string>> ToSet(std::list<std::set<std::string>> const& itemsets) {
+    return {itemsets.begin(), itemsets.end()};
+}
+
+TEST_F(ARAlgorithmTest, EclatMatchesApriori) {
+    for (double minsup : {0.05, 0.1, 0.3}) {
+        auto apriori = CreateAlgorithmInstance(kRulesKaggleRows, minsup, 0.5, true);
+        apriori->Execute();
+        auto const expected_frequent = ToSet(apriori->GetFrequentList());
+        auto const expected_rules = apriori->GetArStringsList();
+        for (config::ThreadNumType threads : {1, 4}) {
+            auto eclat = CreateEclatInstance(threads, kRulesKaggleRows, minsup, 0.5, true);
+            eclat->Execute();
+            CheckFrequentListsEquality(eclat->GetFrequentList(), expected_frequent);
+            auto const actual_rules = eclat->GetArStringsList();
+            CheckAssociationRulesListsEquality(actual_rules, ToSet(expected_rules));
+            for (auto const& rule : expected_rules) {
+                CheckSupportAndConfidence(actual_rules, {rule.left.begin(), rule.left.end()},
+                                          {rule.right.begin(), rule.right.end()}, rule.support,
+                                          rule.confidence);
+            }
+        }
+    }
+}
+
+TEST_F(ARAlgorithmTest, EclatSyntheticDatasetWithPruning) {
+    auto algorithm = CreateEclatInstance(4, kRulesSynthetic2, 0.13, 1.00001, 0, 1);
+    algorithm->Execute();
+
+    auto const actual = algorithm->GetFrequentList();
+    std::set<std::set<std::string>> const expected = {
+            {"a"},           {"b"},           {"c"},           {"d"},           {"e"},
+            {"f"},           {"a", "b"},      {"a", "c"},      {"a", "d"},      {"a", "f"},
+            {"b", "c"},      {"c", "d"},      {"c", "f"},      {"d", "f"},      {"a", "c", "d"},
+            {"a", "c", "f"}, {"a", "d", "f"}, {"c", "d", "f"}, {"a", "c", "d", "f"}};
+
+    CheckFrequentListsEquality(actual, expected);
+    EXPECT_TRUE(algorithm->GetArStringsList().empty());
+}
+
 }  // namespace tests
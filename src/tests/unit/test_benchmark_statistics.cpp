@@ -0,0 +1,51 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "tests/benchmark/benchmark_statistics.h"
+
+namespace tests {
+
+using benchmark::util::ExactGreaterPValue;
+using benchmark::util::MannWhitneyGreaterPValue;
+
+// Expected values are P(U <= k) from the tables of the exact Mann-Whitney distribution,
+// the distribution is symmetric: P(U >= n1 * n2 - k) = P(U <= k)
+TEST(BenchmarkStatisticsTest, ExactPValue) {
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(3, 3, 9), 1.0 / 20);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(4, 4, 14), 4.0 / 70);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(4, 4, 13), 7.0 / 70);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(5, 5, 25), 1.0 / 252);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(5, 5, 21), 12.0 / 252);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(3, 5, 15), 1.0 / 56);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(5, 3, 13), 4.0 / 56);
+    EXPECT_DOUBLE_EQ(ExactGreaterPValue(5, 5, 0), 1);
+}
+
+TEST(BenchmarkStatisticsTest, MannWhitneyWithoutTies) {
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({1, 2, 3}, {4, 5, 6}), 1.0 / 20);
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}), 1.0 / 252);
+    // U = 24
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({1, 2, 3, 4, 6}, {5, 7, 8, 9, 10}), 2.0 / 252);
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({6, 7, 8, 9, 10}, {1, 2, 3, 4, 5}), 1);
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({}, {1, 2, 3}), 1);
+}
+
+TEST(BenchmarkStatisticsTest, MannWhitneyNormalApproximation) {
+    // U = 20.5, mean 12.5, variance 25 / 12 * (11 - 18 / 90) = 22.5 with three pairs of ties,
+    // z = (20.5 - 12.5 - 0.5) / sqrt(22.5) = 1.5811
+    EXPECT_NEAR(MannWhitneyGreaterPValue({1, 2, 3, 4, 5}, {3, 4, 5, 6, 7}), 0.056923, 1e-6);
+    // Samples of 21 values without ties: U = 231, mean 220.5, variance 441 * 43 / 12,
+    // z = 0.2516
+    std::vector<long long> odd;
+    std::vector<long long> even;
+    for (long long i = 1; i <= 41; i += 2) {
+        odd.push_back(i);
+        even.push_back(i + 1);
+    }
+    EXPECT_NEAR(MannWhitneyGreaterPValue(odd, even), 0.400692, 1e-6);
+    // All values are tied, the variance is 0
+    EXPECT_DOUBLE_EQ(MannWhitneyGreaterPValue({5, 5, 5}, {5, 5, 5}), 1);
+}
+
+}  // namespace tests
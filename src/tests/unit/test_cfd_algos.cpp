@@ -7,6 +7,7 @@
 #include "core/algorithms/cfd/enums.h"
 #include "core/algorithms/cfd/fd_first_algorithm.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 
 namespace tests {
@@ -28,7 +29,8 @@ class CFDAlgorithmTest : public ::testing::Test {
 protected:
     static std::unique_ptr<algos::cfd::FDFirstAlgorithm> CreateAlgorithmInstance(
             CSVConfig const& csv_config, unsigned minsup, double minconf, char const* substrategy,
-            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0) {
+            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0,
+            config::ThreadNumType threads = 1) {
         using namespace config::names;
 
         algos::StdParamsMap params{
@@ -38,7 +40,8 @@ protected:
                 {kCfdMaximumLhs, max_lhs},
                 {kCfdSubstrategy, algos::cfd::Substrategy::_from_string(substrategy)},
                 {kCfdTuplesNumber, tuples_number},
-                {kCfdColumnsNumber, columns_number}};
+                {kCfdColumnsNumber, columns_number},
+                {kThreads, threads}};
         return algos::CreateAndLoadAlgorithm<algos::cfd::FDFirstAlgorithm>(params);
     }
 };
@@ -118,4 +121,16 @@ TEST_F(CFDAlgorithmTest, PartialMushroomDataset) {
 
     CheckCfdSetsEquality(actual_cfds, expected_cfds);
 }
+
+TEST_F(CFDAlgorithmTest, ThreadsDoNotChangeResult) {
+    for (char const* substrategy : {"dfs", "bfs"}) {
+        auto algorithm = CreateAlgorithmInstance(kMushroom, 50, 0.9, substrategy, 3, 8, 1000);
+        algorithm->Execute();
+        auto parallel_algorithm =
+                CreateAlgorithmInstance(kMushroom, 50, 0.9, substrategy, 3, 8, 1000, 4);
+        parallel_algorithm->Execute();
+        EXPECT_FALSE(algorithm->GetItemsetCfds().empty());
+        EXPECT_EQ(algorithm->GetItemsetCfds(), parallel_algorithm->GetItemsetCfds());
+    }
+}
 }  // namespace tests
@@ -0,0 +1,126 @@
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/algorithms/gfd/csr_graph.h"
+#include "core/algorithms/gfd/gfd.h"
+#include "core/algorithms/gfd/graph_descriptor.h"
+
+namespace tests {
+
+using model::CsrGraph;
+using ::testing::ElementsAre;
+
+namespace {
+
+/* 0 (person) -knows- 1 (person) -works_at- 2 (company)
+ *            -knows- 3 (person, no name)
+ * 1 -likes- 1 (self-loop), 4 has no attributes
+ */
+model::graph_t MakeGraph() {
+    model::graph_t graph;
+    auto add_vertex = [&graph](std::unordered_map<std::string, std::string> attributes) {
+        return boost::add_vertex({static_cast<int>(boost::num_vertices(graph)), attributes},
+                                 graph);
+    };
+    model::vertex_t const alice = add_vertex({{"label", "person"}, {"name", "Alice"}});
+    model::vertex_t const bob = add_vertex({{"label", "person"}, {"name", "Bob"}});
+    model::vertex_t const acme = add_vertex({{"label", "company"}, {"name", "Acme"}});
+    model::vertex_t const anonymous = add_vertex({{"label", "person"}});
+    add_vertex({});
+    boost::add_edge(alice, bob, {"knows"}, graph);
+    boost::add_edge(bob, acme, {"works_at"}, graph);
+    boost::add_edge(alice, anonymous, {"knows"}, graph);
+    boost::add_edge(bob, bob, {"likes"}, graph);
+    return graph;
+}
+
+std::vector<model::vertex_t> GetVertices(std::span<CsrGraph::Neighbour const> neighbours) {
+    std::vector<model::vertex_t> vertices;
+    for (CsrGraph::Neighbour const& neighbour : neighbours) vertices.push_back(neighbour.vertex);
+    return vertices;
+}
+
+}  // namespace
+
+TEST(CsrGraphTest, Adjacency) {
+    CsrGraph const graph(MakeGraph());
+    CsrGraph::Id const knows = graph.FindEdgeLabel("knows");
+    CsrGraph::Id const works_at = graph.FindEdgeLabel("works_at");
+    CsrGraph::Id const likes = graph.FindEdgeLabel("likes");
+    ASSERT_NE(knows, CsrGraph::kNoId);
+    ASSERT_NE(works_at, CsrGraph::kNoId);
+    ASSERT_NE(likes, CsrGraph::kNoId);
+    EXPECT_EQ(graph.FindEdgeLabel("owns"), CsrGraph::kNoId);
+    EXPECT_EQ(graph.GetEdgeLabel(works_at), "works_at");
+
+    ASSERT_EQ(graph.NumVertices(), 5);
+    // Edges are undirected, a self-loop is stored once
+    EXPECT_EQ(graph.Degree(0), 2);
+    EXPECT_EQ(graph.Degree(1), 3);
+    EXPECT_EQ(graph.Degree(2), 1);
+    EXPECT_EQ(graph.Degree(3), 1);
+    EXPECT_EQ(graph.Degree(4), 0);
+
+    EXPECT_THAT(GetVertices(graph.GetNeighbours(0)), ElementsAre(1, 3));
+    EXPECT_THAT(GetVertices(graph.GetNeighbours(1, knows)), ElementsAre(0));
+    EXPECT_THAT(GetVertices(graph.GetNeighbours(1, works_at)), ElementsAre(2));
+    EXPECT_THAT(GetVertices(graph.GetNeighbours(1, likes)), ElementsAre(1));
+    EXPECT_TRUE(graph.GetNeighbours(2, knows).empty());
+    EXPECT_TRUE(graph.GetNeighbours(4).empty());
+
+    EXPECT_TRUE(graph.HasEdge(0, 1, knows));
+    EXPECT_TRUE(graph.HasEdge(1, 0, knows));
+    EXPECT_TRUE(graph.HasEdge(2, 1, works_at));
+    EXPECT_TRUE(graph.HasEdge(1, 1, likes));
+    EXPECT_FALSE(graph.HasEdge(0, 1, works_at));
+    EXPECT_FALSE(graph.HasEdge(0, 2, knows));
+}
+
+TEST(CsrGraphTest, Labels) {
+    CsrGraph const graph(MakeGraph());
+    CsrGraph::Id const person = graph.FindValue("person");
+    CsrGraph::Id const company = graph.FindValue("company");
+    ASSERT_NE(person, CsrGraph::kNoId);
+    ASSERT_NE(company, CsrGraph::kNoId);
+    EXPECT_EQ(graph.GetValue(company), "company");
+
+    EXPECT_EQ(graph.GetLabel(0), person);
+    EXPECT_EQ(graph.GetLabel(2), company);
+    EXPECT_EQ(graph.GetLabel(4), CsrGraph::kNoId);
+    EXPECT_THAT(graph.GetVerticesWithLabel(person), ElementsAre(0, 1, 3));
+    EXPECT_THAT(graph.GetVerticesWithLabel(company), ElementsAre(2));
+    EXPECT_TRUE(graph.GetVerticesWithLabel(graph.FindValue("Alice")).empty());
+    EXPECT_TRUE(graph.GetVerticesWithLabel(CsrGraph::kNoId).empty());
+
+    CsrGraph::Id const name = graph.FindAttributeName("name");
+    ASSERT_NE(name, CsrGraph::kNoId);
+    EXPECT_EQ(graph.GetValue(graph.GetAttribute(1, name)), "Bob");
+    EXPECT_EQ(graph.GetAttribute(3, name), CsrGraph::kNoId);
+    EXPECT_EQ(graph.GetAttribute(0, graph.FindAttributeName("age")), CsrGraph::kNoId);
+}
+
+TEST(CsrGraphTest, Literals) {
+    CsrGraph const graph(MakeGraph());
+    // Pattern vertices 0 and 1 are matched to graph vertices 0 and 1
+    auto mapping = [](int pattern_vertex) { return static_cast<model::vertex_t>(pattern_vertex); };
+    auto satisfies = [&](model::Gfd::Literal const& literal) {
+        return graph.Satisfies(graph.IndexLiteral(literal), mapping);
+    };
+
+    EXPECT_TRUE(satisfies({{0, "label"}, {1, "label"}}));
+    EXPECT_FALSE(satisfies({{0, "name"}, {1, "name"}}));
+    EXPECT_TRUE(satisfies({{0, "name"}, {-1, "Alice"}}));
+    // A constant that does not occur in the graph is not equal to any value
+    EXPECT_FALSE(satisfies({{0, "name"}, {-1, "Carol"}}));
+    // Absent attributes are not equal to each other
+    EXPECT_FALSE(satisfies({{0, "age"}, {1, "age"}}));
+    EXPECT_TRUE(satisfies({{-1, "Carol"}, {-1, "Carol"}}));
+    EXPECT_FALSE(satisfies({{-1, "Alice"}, {-1, "Bob"}}));
+}
+
+}  // namespace tests
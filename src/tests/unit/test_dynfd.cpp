@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/algorithms/algo_factory.h"
+#include "core/algorithms/fd/dynfd/dynfd.h"
+#include "core/algorithms/fd/hyfd/hyfd.h"
+#include "core/config/exceptions.h"
+#include "core/config/names.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+namespace onam = config::names;
+
+namespace {
+
+using Row = model::IDatasetStream::Row;
+
+/* Plain copy of a table that follows the same CRUD statements as the algorithm */
+class TableMirror {
+private:
+    std::vector<std::string> column_names_;
+    std::vector<Row> rows_;
+    std::unordered_set<size_t> deleted_;
+
+public:
+    explicit TableMirror(CSVConfig const& csv_config) {
+        auto input_table = MakeInputTable(csv_config);
+        for (size_t i = 0; i < input_table->GetNumberOfColumns(); ++i) {
+            column_names_.push_back(input_table->GetColumnName(i));
+        }
+        while (input_table->HasNextRow()) rows_.push_back(input_table->GetNextRow());
+    }
+
+    std::vector<size_t> LiveIds() const {
+        std::vector<size_t> ids;
+        for (size_t id = 0; id < rows_.size(); ++id) {
+            if (!deleted_.contains(id)) ids.push_back(id);
+        }
+        return ids;
+    }
+
+    Row const& GetRow(size_t id) const {
+        return rows_[id];
+    }
+
+    void Delete(size_t id) {
+        deleted_.insert(id);
+    }
+
+    void Insert(Row row) {
+        rows_.push_back(std::move(row));
+    }
+
+    void Update(size_t id, Row row) {
+        rows_[id] = std::move(row);
+    }
+
+    static void WriteCsv(std::filesystem::path const& path, std::vector<std::string> const& header,
+                         std::vector<Row> const& rows) {
+        std::ofstream out(path);
+        auto write_row = [&out](Row const& row) {
+            for (size_t i = 0; i < row.size(); ++i) {
+                bool const quote = row[i].find(',') != std::string::npos;
+                out << (i == 0 ? "" : ",") << (quote ? "\"" : "") << row[i] << (quote ? "\"" : "");
+            }
+            out << '\n';
+        };
+        write_row(header);
+        for (Row const& row : rows) write_row(row);
+    }
+
+    std::vector<std::string> const& GetColumnNames() const {
+        return column_names_;
+    }
+
+    /* FDs of the current table found by HyFD */
+    std::string MineFds() const {
+        std::vector<Row> live_rows;
+        for (size_t id : LiveIds()) live_rows.push_back(rows_[id]);
+        auto path = std::filesystem::temp_directory_path() / "dynfd_mirror.csv";
+        WriteCsv(path, column_names_, live_rows);
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(
+                {{onam::kCsvConfig, CSVConfig{path, ',', true}}});
+        algorithm->Execute();
+        std::filesystem::remove(path);
+        return algorithm->GetJsonFDs();
+    }
+};
+
+/* A batch of statements in the form accepted by DynFD */
+struct Batch {
+    std::vector<Row> inserts;
+    std::vector<std::pair<size_t, Row>> updates;
+    std::unordered_set<size_t> deletes;
+};
+
+void ApplyBatch(algos::dynfd::DynFD& algorithm, TableMirror& mirror, Batch const& batch) {
+    algos::StdParamsMap params;
+    auto const& names = mirror.GetColumnNames();
+    auto insert_path = std::filesystem::temp_directory_path() / "dynfd_insert.csv";
+    auto update_path = std::filesystem::temp_directory_path() / "dynfd_update.csv";
+    if (!batch.inserts.empty()) {
+        TableMirror::WriteCsv(insert_path, names, batch.inserts);
+        params[onam::kInsertStatements] = MakeInputTable({insert_path, ',', true});
+    }
+    if (!batch.updates.empty()) {
+        std::vector<std::string> update_names{"_id"};
+        update_names.insert(update_names.end(), names.begin(), names.end());
+        std::vector<Row> update_rows;
+        for (auto const& [id, row] : batch.updates) {
+            update_rows.push_back({std::to_string(id)});
+            update_rows.back().insert(update_rows.back().end(), row.begin(), row.end());
+        }
+        TableMirror::WriteCsv(update_path, update_names, update_rows);
+        params[onam::kUpdateStatements] = MakeInputTable({update_path, ',', true});
+    }
+    if (!batch.deletes.empty()) {
+        params[onam::kDeleteStatements] = batch.deletes;
+    }
+    algos::ConfigureFromMap(algorithm, params);
+    algorithm.Execute();
+    std::filesystem::remove(insert_path);
+    std::filesystem::remove(update_path);
+
+    for (size_t id : batch.deletes) mirror.Delete(id);
+    for (Row const& row : batch.inserts) mirror.Insert(row);
+    for (auto const& [id, row] : batch.updates) mirror.Update(id, row);
+}
+
+}  // namespace
+
+class TestDynFDInit : public ::testing::TestWithParam<CSVConfig> {};
+
+TEST_P(TestDynFDInit, MatchesHyFD) {
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kCsvConfig, GetParam()}});
+    algorithm->Execute();
+    EXPECT_EQ(algorithm->GetJsonFDs(), TableMirror(GetParam()).MineFds());
+}
+
+INSTANTIATE_TEST_SUITE_P(DynFDTestSuite, TestDynFDInit,
+                         ::testing::Values(kTestFD, kCIPublicHighway700, kTestDynamicFDInit,
+                                           kBernoulliRelation, kWdcAstronomical));
+
+TEST(DynFDTest, StatementFilesMatchHyFD) {
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kCsvConfig, kTestDynamicFDInit}});
+    algorithm->Execute();
+    TableMirror mirror(kTestDynamicFDInit);
+
+    Batch batch;
+    TableMirror inserts(kTestDynamicFDInsert);
+    for (size_t id : inserts.LiveIds()) batch.inserts.push_back(inserts.GetRow(id));
+    batch.deletes = {1, 6, 3};
+    ApplyBatch(*algorithm, mirror, batch);
+    EXPECT_EQ(algorithm->GetJsonFDs(), mirror.MineFds());
+    EXPECT_EQ(algorithm->GetNumRows(), mirror.LiveIds().size());
+
+    Batch update_batch;
+    update_batch.updates = {{0, {"2", "1", "1", "999", "-", "10"}},
+                            {4, {"1", "2", "2", "hjkl", "444", "5"}}};
+    ApplyBatch(*algorithm, mirror, update_batch);
+    EXPECT_EQ(algorithm->GetJsonFDs(), mirror.MineFds());
+}
+
+TEST(DynFDTest, RandomBatchesMatchHyFD) {
+    TableMirror source(kCIPublicHighway700);
+    std::vector<size_t> source_ids = source.LiveIds();
+    size_t const initial_rows = source_ids.size() / 2;
+
+    auto initial_path = std::filesystem::temp_directory_path() / "dynfd_initial.csv";
+    std::vector<Row> initial;
+    for (size_t i = 0; i < initial_rows; ++i) initial.push_back(source.GetRow(i));
+    TableMirror::WriteCsv(initial_path, source.GetColumnNames(), initial);
+    CSVConfig const initial_config{initial_path, ',', true};
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kCsvConfig, initial_config}});
+    algorithm->Execute();
+    TableMirror mirror(initial_config);
+    std::filesystem::remove(initial_path);
+    ASSERT_EQ(algorithm->GetJsonFDs(), mirror.MineFds());
+
+    std::mt19937 gen(47);
+    size_t next_source_row = initial_rows;
+    for (int round = 0; round < 6; ++round) {
+        Batch batch;
+        std::vector<size_t> live = mirror.LiveIds();
+        std::shuffle(live.begin(), live.end(), gen);
+        size_t const num_deletes = live.size() / 20;
+        size_t const num_updates = live.size() / 50;
+        for (size_t i = 0; i < num_deletes; ++i) batch.deletes.insert(live[i]);
+        for (size_t i = num_deletes; i < num_deletes + num_updates; ++i) {
+            // Take the row of another tuple, but keep a few of the old values
+            Row row = mirror.GetRow(live[live.size() - 1 - i]);
+            Row const& old_row = mirror.GetRow(live[i]);
+            for (size_t j = 0; j < row.size(); j += 3) row[j] = old_row[j];
+            batch.updates.emplace_back(live[i], std::move(row));
+        }
+        for (int i = 0; i < 40 && next_source_row < source_ids.size(); ++i) {
+            batch.inserts.push_back(source.GetRow(next_source_row++));
+        }
+        ApplyBatch(*algorithm, mirror, batch);
+        ASSERT_EQ(algorithm->GetJsonFDs(), mirror.MineFds()) << "Round " << round;
+        ASSERT_EQ(algorithm->GetNumRows(), mirror.LiveIds().size()) << "Round " << round;
+    }
+}
+
+class TestDynFDExceptions : public ::testing::TestWithParam<algos::StdParamsMap> {};
+
+TEST_P(TestDynFDExceptions, ExceptionsTest) {
+    auto const& params = GetParam();
+    auto load_and_execute = [&params]() {
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(params);
+        algorithm->Execute();
+    };
+    ASSERT_THROW(load_and_execute(), config::ConfigurationError);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        DynFDTestSuite, TestDynFDExceptions,
+        ::testing::Values(
+                algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDInit},
+                                    {onam::kInsertStatements,
+                                     MakeInputTable(kTestDynamicFDInsertBad1)}},
+                algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDInit},
+                                    {onam::kUpdateStatements,
+                                     MakeInputTable(kTestDynamicFDUpdateBad1)}},
+                algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDInit},
+                                    {onam::kDeleteStatements, std::unordered_set<size_t>{100000}}},
+                algos::StdParamsMap{{onam::kCsvConfig, kTestDynamicFDInit},
+                                    {onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate)},
+                                    {onam::kDeleteStatements, std::unordered_set<size_t>{4}}}));
+
+}  // namespace tests
@@ -1,3 +1,5 @@
+#include <filesystem>
+
 #include <gtest/gtest.h>
 
 #include "core/algorithms/algo_factory.h"
@@ -58,4 +60,21 @@ TEST_F(FaidaINDAlgorithmTest, TestTwoTables) {
             expected_inds_subset, 47);
 }
 
+TEST_F(FaidaINDAlgorithmTest, TempDirectory) {
+    using namespace config::names;
+    std::filesystem::path const temp_dir =
+            std::filesystem::temp_directory_path() / "desbordante_faida_test";
+    std::filesystem::remove_all(temp_dir);
+    auto const& [csv_configs, expected_inds] = kINDEqualityTestConfigs.front();
+
+    CheckINDsListsEqualityTest(algos::CreateAndLoadAlgorithm<algos::Faida>(algos::StdParamsMap{
+                                       {kCsvConfigs, csv_configs},
+                                       {kTempDirectory, temp_dir},
+                                       {kThreads, parallel_test_config.num_threads},
+                               }),
+                               expected_inds);
+    EXPECT_FALSE(std::filesystem::is_empty(temp_dir));
+    std::filesystem::remove_all(temp_dir);
+}
+
 }  // namespace tests
@@ -6,7 +6,9 @@
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/od/fastod/fastod.h"
 #include "core/algorithms/od/fastod/hashing/hashing.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -54,6 +56,16 @@ TEST_P(ExactFastodResultHashTest, CorrectnessTest) {
     EXPECT_EQ(actual_hash, csv_config_hash.hash);
 }
 
+TEST_P(ExactFastodResultHashTest, ParallelLowMemoryTest) {
+    using namespace config::names;
+    CSVConfigHash csv_config_hash = GetParam();
+    algos::StdParamsMap params{{kCsvConfig, csv_config_hash.config},
+                               {kThreads, config::ThreadNumType{4}},
+                               {kMemLimitMB, config::MemLimitMBType{16}}};
+    size_t actual_hash = RunFastod(params);
+    EXPECT_EQ(actual_hash, csv_config_hash.hash);
+}
+
 TEST_P(ApproximateFastodResultHashTest, CorrectnessTest) {
     using namespace config::names;
     CSVConfigHash csv_config_hash = GetParam();
@@ -12,7 +12,10 @@
 #include "core/algorithms/fd/pyro/pyro.h"
 #include "core/algorithms/fd/tane/pfdtane.h"
 #include "core/algorithms/fd/tane/tane.h"
+#include "core/config/mem_limit/type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/relational_schema.h"
+#include "core/util/primitive_sink.h"
 #include "tests/unit/test_fd_util.h"
 
 using std::string, std::vector;
@@ -151,14 +154,45 @@ TYPED_TEST_P(AlgorithmTest, MaxLHSOptionWork) {
     MaxLhsTestFun(kCIPublicHighway700, algo_large->FdList(), max_lhs);
 }
 
+TYPED_TEST_P(AlgorithmTest, PassesFdsToSink) {
+    auto algorithm = TestFixture::CreateAlgorithmInstance(kCIPublicHighway700);
+    algorithm->Execute();
+    auto const expected = FDsToSet(algorithm->FdList());
+
+    std::list<FD> streamed;
+    algorithm->SetFdSink(std::make_shared<util::CallbackSink<FD>>(
+            [&streamed](FD fd) { streamed.push_back(std::move(fd)); }));
+    algos::ConfigureFromMap(*algorithm, TestFixture::GetParamMap(kCIPublicHighway700));
+    algorithm->Execute();
+    ASSERT_TRUE(algorithm->FdList().empty());
+    ASSERT_EQ(FDsToSet(streamed), expected);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(AlgorithmTest, ThrowsOnEmpty, ReturnsEmptyOnSingleNonKey,
                             WorksOnLongDataset, WorksOnWideDataset, LightDatasetsConsistentHash,
                             HeavyDatasetsConsistentHash, ConsistentRepeatedExecution,
-                            MaxLHSOptionWork);
+                            MaxLHSOptionWork, PassesFdsToSink);
 
 using Algorithms =
         ::testing::Types<algos::Tane, algos::Pyro, algos::FastFDs, algos::DFD, algos::Depminer,
                          algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
+TEST(FDepTest, ParallelNegativeCoverMatchesSequential) {
+    using namespace config::names;
+    auto get_fds = [](CSVConfig const& csv_config, config::ThreadNumType threads) {
+        algos::StdParamsMap params = {{kCsvConfig, csv_config},
+                                      {kThreads, threads},
+                                      {kMemLimitMB, config::MemLimitMBType{16}}};
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::FDep>(params);
+        algorithm->Execute();
+        return FDsToSet(algorithm->FdList());
+    };
+
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700, kWdcAstronomical}) {
+        auto const expected = get_fds(csv_config, 1);
+        ASSERT_EQ(get_fds(csv_config, 4), expected) << csv_config.path.filename();
+    }
+}
+
 }  // namespace tests
@@ -3,7 +3,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "core/algorithms/fd/aidfd/aid.h"
 #include "core/algorithms/fd/eulerfd/eulerfd.h"
+#include "core/config/thread_number/type.h"
 #include "core/util/bitset_utils.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/unit/test_fd_util.h"
@@ -99,4 +101,30 @@ REGISTER_TYPED_TEST_SUITE_P(ApproximateFDTest, ThrowsOnEmpty, ReturnsEmptyOnSing
 
 using Algorithms = ::testing::Types<algos::EulerFD>;
 INSTANTIATE_TYPED_TEST_SUITE_P(ApproximateFDTest, ApproximateFDTest, Algorithms);
+
+template <typename T>
+class ApproximateFDThreadsTest : public ::testing::Test {};
+
+using ThreadedAlgorithms = ::testing::Types<algos::Aid, algos::EulerFD>;
+TYPED_TEST_SUITE(ApproximateFDThreadsTest, ThreadedAlgorithms);
+
+TYPED_TEST(ApproximateFDThreadsTest, ResultDoesNotDependOnThreadNumber) {
+    using namespace config::names;
+    for (CSVConfig const& csv_config : {kWdcAstronomical, kWdcAppearances, kCIPublicHighway700}) {
+        std::optional<unsigned int> expected_hash;
+        for (config::ThreadNumType threads : {1, 2, 4}) {
+            algos::StdParamsMap params{{kCsvConfig, csv_config},
+                                       {kCustomRandom, std::optional<int>{47}},
+                                       {kThreads, threads}};
+            auto algorithm = algos::CreateAndLoadAlgorithm<TypeParam>(params);
+            algorithm->Execute();
+            if (!expected_hash.has_value()) {
+                expected_hash = algorithm->Fletcher16();
+            } else {
+                EXPECT_EQ(algorithm->Fletcher16(), *expected_hash)
+                        << csv_config.path.filename() << ", threads: " << threads;
+            }
+        }
+    }
+}
 }  // namespace tests
@@ -53,6 +53,17 @@ TEST_P(GfdMinerTest, CompareResultTest) {
     ASSERT_THAT(algorithm->GfdList(), ::testing::ElementsAreArray(GetExpectedGfds()));
 }
 
+TEST(GfdMinerParallelTest, CompareResultTest) {
+    algos::StdParamsMap params = {{config::names::kGraphData, kGfdTestShapesGraph},
+                                  {config::names::kGfdK, std::size_t{3}},
+                                  {config::names::kGfdSigma, std::size_t{10}},
+                                  {config::names::kThreads, config::ThreadNumType{4}}};
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::GfdMiner>(params);
+    algorithm->Execute();
+    ASSERT_THAT(algorithm->GfdList(), ::testing::ElementsAre(MakeGfd(kGfdTestShapesGfd1),
+                                                             MakeGfd(kGfdTestShapesGfd2)));
+}
+
 INSTANTIATE_TEST_SUITE_P(
         GfdMinerTestSuite, GfdMinerTest,
         ::testing::Values(
@@ -4,6 +4,7 @@
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/gfd/gfd_validator/gfd_validator.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/unit/all_gfd_paths.h"
 
 using namespace algos;
@@ -45,13 +46,43 @@ TYPED_TEST_P(GfdValidatorTest, TestExistingMatches) {
     ASSERT_EQ(expected_size, gfd_list.size());
 }
 
-REGISTER_TYPED_TEST_SUITE_P(GfdValidatorTest, TestTrivially, TestExistingMatches);
+TYPED_TEST_P(GfdValidatorTest, TestRepeatedExecution) {
+    std::vector<std::filesystem::path> gfd_paths = {kGfdTestQuadrangleGfd};
+    auto algorithm = TestFixture::CreateGfdValidatorInstance(kGfdTestQuadrangleGraph, gfd_paths);
+    int expected_size = 1;
+    for (int i = 0; i < 2; ++i) {
+        algos::ConfigureFromMap(*algorithm, StdParamsMap{});
+        algorithm->Execute();
+        ASSERT_EQ(expected_size, algorithm->GfdList().size());
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(GfdValidatorTest, TestTrivially, TestExistingMatches,
+                            TestRepeatedExecution);
 
 using GfdAlgorithms =
         ::testing::Types<algos::NaiveGfdValidator, algos::GfdValidator, algos::EGfdValidator>;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GfdValidatorTest, GfdValidatorTest, GfdAlgorithms);
 
+TEST(EGfdValidatorTest, TestParallel) {
+    std::vector<std::filesystem::path> gfd_paths = {kGfdTestSymbolsGfd1, kGfdTestSymbolsGfd2};
+    StdParamsMap option_map = {{config::names::kGraphData, kGfdTestSymbolsGraph},
+                               {config::names::kGfdData, gfd_paths},
+                               {config::names::kThreads, static_cast<config::ThreadNumType>(4)}};
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::EGfdValidator>(option_map);
+    algorithm->Execute();
+    ASSERT_EQ(2, algorithm->GfdList().size());
+
+    gfd_paths = {kGfdTestDirectorsGfd};
+    option_map = {{config::names::kGraphData, kGfdTestDirectorsGraph},
+                  {config::names::kGfdData, gfd_paths},
+                  {config::names::kThreads, static_cast<config::ThreadNumType>(4)}};
+    algorithm = algos::CreateAndLoadAlgorithm<algos::EGfdValidator>(option_map);
+    algorithm->Execute();
+    ASSERT_EQ(0, algorithm->GfdList().size());
+}
+
 }  // namespace
 
 }  // namespace tests
@@ -362,6 +362,26 @@ TEST_F(GSpanTest, MaxEdgesConstraint) {
     EXPECT_GE(large_subgraphs.size(), small_subgraphs.size());
 }
 
+TEST_F(GSpanTest, ParallelMatchesSequential) {
+    for (double support : {0.2, 0.6}) {
+        algos::StdParamsMap params = CreateGSpanParams(kGSpanTestTriangle, support);
+        auto sequential = algos::CreateAndLoadAlgorithm<algos::GSpan>(params);
+        sequential->Execute();
+
+        params[config::names::kThreads] = static_cast<config::ThreadNumType>(4);
+        auto parallel = algos::CreateAndLoadAlgorithm<algos::GSpan>(params);
+        parallel->Execute();
+
+        auto const& expected = sequential->GetFrequentSubgraphs();
+        auto const& actual = parallel->GetFrequentSubgraphs();
+        ASSERT_EQ(actual.size(), expected.size()) << "With support=" << support;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].id, expected[i].id);
+            EXPECT_EQ(actual[i], expected[i]);
+        }
+    }
+}
+
 struct GSpanTestParams {
     std::filesystem::path graph_path;
     double min_support;
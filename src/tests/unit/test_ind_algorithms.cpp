@@ -197,10 +197,12 @@ namespace {
 template <typename Algorithm>
 class NaryINDAlgorithmTest : public ::testing::Test {
 protected:
-    static std::unique_ptr<Algorithm> CreateAlgorithmInstance(CSVConfigs const& csv_configs) {
+    static std::unique_ptr<Algorithm> CreateAlgorithmInstance(CSVConfigs const& csv_configs,
+                                                              config::ThreadNumType threads = 1) {
         using namespace config::names;
         return algos::CreateAndLoadAlgorithm<Algorithm>(algos::StdParamsMap{
                 {kCsvConfigs, csv_configs},
+                {kThreads, threads},
         });
     }
 };
@@ -219,4 +221,11 @@ TYPED_TEST(NaryINDAlgorithmTest, EqualityTest) {
     }
 }
 
+TYPED_TEST(NaryINDAlgorithmTest, EqualityTestParallel) {
+    for (auto& [csv_configs, expected_inds] : kINDEqualityTestConfigs) {
+        CheckINDsListsEqualityTest(TestFixture::CreateAlgorithmInstance(csv_configs, 4),
+                                   expected_inds);
+    }
+}
+
 }  // namespace tests
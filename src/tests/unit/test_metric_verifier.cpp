@@ -1,5 +1,7 @@
 #include <limits>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -59,9 +61,20 @@ struct HighlightTestParams {
           highlight_distances(std::move(highlight_distances)) {}
 };
 
-class TestMetricVerifying : public ::testing::TestWithParam<MetricVerifyingParams> {};
+// Every test case is run with each number of threads
+class TestMetricVerifying
+    : public ::testing::TestWithParam<std::tuple<MetricVerifyingParams, config::ThreadNumType>> {};
 
-class TestHighlights : public ::testing::TestWithParam<HighlightTestParams> {};
+class TestHighlights
+    : public ::testing::TestWithParam<std::tuple<HighlightTestParams, config::ThreadNumType>> {};
+
+template <typename TestParams>
+static algos::StdParamsMap GetParamsWithThreads(
+        std::tuple<TestParams, config::ThreadNumType> const& test_params) {
+    auto params = std::get<0>(test_params).params;
+    params.emplace(onam::kThreads, std::get<1>(test_params));
+    return params;
+}
 
 static std::unique_ptr<algos::metric::MetricVerifier> CreateMetricVerifier(
         algos::StdParamsMap const& map) {
@@ -81,10 +94,10 @@ static std::vector<std::vector<algos::metric::Highlight>> GetHighlights(
 }
 
 TEST_P(TestMetricVerifying, DefaultTest) {
-    auto const& params = GetParam().params;
+    auto const params = GetParamsWithThreads(GetParam());
     auto verifier = CreateMetricVerifier(params);
 
-    if (!GetParam().expected) {
+    if (!std::get<0>(GetParam()).expected) {
         ASSERT_FALSE(GetResult(*verifier));
         return;
     }
@@ -99,17 +112,29 @@ TEST_P(TestMetricVerifying, DefaultTest) {
 }
 
 TEST_P(TestMetricVerifying, ConsistentRepeatedExecution) {
-    auto const& params = GetParam().params;
+    auto const params = GetParamsWithThreads(GetParam());
     auto verifier = CreateMetricVerifier(params);
     for (int i = 0; i < 5; ++i) {
         algos::ConfigureFromMap(*verifier, algos::StdParamsMap{params});
-        ASSERT_EQ(GetResult(*verifier), GetParam().expected);
+        ASSERT_EQ(GetResult(*verifier), std::get<0>(GetParam()).expected);
+    }
+}
+
+TEST(MetricVerifierTest, ParallelExceptionIsRethrown) {
+    // q-gram length exceeds the length of strings in the column
+    MetricVerifyingParams const test_params(kTestMetric, Metric::cosine, 0.5, {0}, {7},
+                                            MetricAlgo::brute, false, true, 100);
+    for (config::ThreadNumType threads : {1, 4}) {
+        auto params = test_params.params;
+        params.emplace(onam::kThreads, threads);
+        auto verifier = CreateMetricVerifier(params);
+        ASSERT_THROW(verifier->Execute(), std::runtime_error);
     }
 }
 
 TEST_P(TestHighlights, DefaultTest) {  // Assumes that highlights are sorted by distance in reverse
-    auto const& params = GetParam().params;
-    auto const& highlight_distances = GetParam().highlight_distances;
+    auto const params = GetParamsWithThreads(GetParam());
+    auto const& highlight_distances = std::get<0>(GetParam()).highlight_distances;
     auto verifier = CreateMetricVerifier(params);
     auto const& highlights = GetHighlights(*verifier);
 
@@ -124,96 +149,105 @@ TEST_P(TestHighlights, DefaultTest) {  // Assumes that highlights are sorted by
     }
 }
 
-INSTANTIATE_TEST_SUITE_P(
-        MetricVerifierTestSuite, TestMetricVerifying,
-        ::testing::Values(
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 2, {0, 1}, {2}),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 1, {0}, {1}),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 4, {1}, {0}),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 5, {0}, {2}),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 0, {2}, {1}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 20500, {0}, {4}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 1059, {1}, {4}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 1, {1, 0}, {4}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5724231, {0}, {2}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 7.53, {0}, {3}),
-                MetricVerifyingParams(kTestMetric, Metric::levenshtein, 2, {0}, {5}),
-                MetricVerifyingParams(kTestMetric, Metric::levenshtein, 3, {1}, {5}),
-                MetricVerifyingParams(kTestMetric, Metric::levenshtein, 4, {0}, {6}),
-                MetricVerifyingParams(kTestMetric, Metric::levenshtein, 10, {0}, {6},
-                                      MetricAlgo::brute, true, false),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.661938299, {0}, {7},
-                                      MetricAlgo::brute, false, true, 2),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.5, {1}, {7}, MetricAlgo::brute,
-                                      false, true, 2),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.75, {1}, {6},
-                                      MetricAlgo::brute, false, true, 2),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.0298575, {1}, {5},
-                                      MetricAlgo::brute, false, true, 1),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.661938299, {0}, {8},
-                                      MetricAlgo::brute, false, true, 3),
-                MetricVerifyingParams(kTestMetric, Metric::cosine, 0.525658351, {1}, {8},
-                                      MetricAlgo::brute, false, true, 3),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 5.0990195135928, {0}, {1, 2}),
-                MetricVerifyingParams(kTestLong, Metric::euclidean, 5.0990195135928, {0}, {1, 2},
-                                      MetricAlgo::calipers),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 3.081374600094, {0}, {9, 10}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 3.081374600094, {0}, {9, 10},
-                                      MetricAlgo::calipers),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5, {0}, {11, 12}),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5, {0}, {12, 11},
-                                      MetricAlgo::calipers),
-                MetricVerifyingParams(kTestMetric, Metric::euclidean, 6.0091679956547, {0},
-                                      {13, 14, 15})));
+// Not a global, as the CSV configs may be initialized after the globals of this file
+std::vector<MetricVerifyingParams> GetMetricVerifyingParams() {
+    return {
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 2, {0, 1}, {2}),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 1, {0}, {1}),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 4, {1}, {0}),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 5, {0}, {2}),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 0, {2}, {1}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 20500, {0}, {4}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 1059, {1}, {4}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 1, {1, 0}, {4}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5724231, {0}, {2}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 7.53, {0}, {3}),
+            MetricVerifyingParams(kTestMetric, Metric::levenshtein, 2, {0}, {5}),
+            MetricVerifyingParams(kTestMetric, Metric::levenshtein, 3, {1}, {5}),
+            MetricVerifyingParams(kTestMetric, Metric::levenshtein, 4, {0}, {6}),
+            MetricVerifyingParams(kTestMetric, Metric::levenshtein, 10, {0}, {6},
+                                  MetricAlgo::brute, true, false),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.661938299, {0}, {7},
+                                  MetricAlgo::brute, false, true, 2),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.5, {1}, {7}, MetricAlgo::brute,
+                                  false, true, 2),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.75, {1}, {6},
+                                  MetricAlgo::brute, false, true, 2),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.0298575, {1}, {5},
+                                  MetricAlgo::brute, false, true, 1),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.661938299, {0}, {8},
+                                  MetricAlgo::brute, false, true, 3),
+            MetricVerifyingParams(kTestMetric, Metric::cosine, 0.525658351, {1}, {8},
+                                  MetricAlgo::brute, false, true, 3),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 5.0990195135928, {0}, {1, 2}),
+            MetricVerifyingParams(kTestLong, Metric::euclidean, 5.0990195135928, {0}, {1, 2},
+                                  MetricAlgo::calipers),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 3.081374600094, {0}, {9, 10}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 3.081374600094, {0}, {9, 10},
+                                  MetricAlgo::calipers),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5, {0}, {11, 12}),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 4.5, {0}, {12, 11},
+                                  MetricAlgo::calipers),
+            MetricVerifyingParams(kTestMetric, Metric::euclidean, 6.0091679956547, {0},
+                                  {13, 14, 15})};
+}
+
+INSTANTIATE_TEST_SUITE_P(MetricVerifierTestSuite, TestMetricVerifying,
+                         ::testing::Combine(::testing::ValuesIn(GetMetricVerifyingParams()),
+                                            ::testing::Values<config::ThreadNumType>(1, 4)));
 
 constexpr long double kInf = std::numeric_limits<long double>::infinity();
 
-INSTANTIATE_TEST_SUITE_P(
-        HighlightTestSuite, TestHighlights,
-        ::testing::Values(
-                HighlightTestParams(kTestMetric,
-                                    {{125, 125, 110, 79, 78, 68},
-                                     {20500, 20500, 20000, 19997, 19991, 18900}},
-                                    Metric::euclidean, {0}, {4}),
-                HighlightTestParams(kTestMetric,
-                                    {{4.572423, 4.572423, 4.217, 3.663899, 3.217, 3.21},
-                                     {4.0331, 4.0331, 3.1101, 3.03, 2.3311, 2.3101}},
-                                    Metric::euclidean, {0}, {2}),
-                HighlightTestParams(kTestMetric, {{3.9, 3.9, 2.07, 0, 0}}, Metric::euclidean, {16},
-                                    {13}),
-                HighlightTestParams(kTestMetric, {{kInf, 3.9, 3.9, 2.07, 0}}, Metric::euclidean,
-                                    {16}, {13}, MetricAlgo::brute, true),
-                HighlightTestParams(kTestMetric, {{2, 2, 2, 2, 2, 1}, {2, 2, 2, 2, 2, 2}},
-                                    Metric::levenshtein, {0}, {5}),
-                HighlightTestParams(kTestMetric, {{4, 4, 4, 3, 3, 3}}, Metric::levenshtein, {0},
-                                    {6}),
-                HighlightTestParams(kTestMetric,
-                                    {{0.661938, 0.661938, 0.661938, 0.6, 0.552786, 0.525658}},
-                                    Metric::cosine, {0}, {7}),
-                HighlightTestParams(kTestMetric, {{0.5, 0.5, 0.410744}}, Metric::cosine, {1}, {7}),
-                HighlightTestParams(kTestMetric,
-                                    {{0.661938, 0.661938, 0.53709, 0.525658, 0.428571, 0.316237},
-                                     {kInf, kInf, kInf, 0, 0, 0}},
-                                    Metric::cosine, {0}, {8}, MetricAlgo::brute, true, 3),
-                HighlightTestParams(kTestMetric, {{0.525658, 0.525658, 0.483602}}, Metric::cosine,
-                                    {1}, {8}, MetricAlgo::brute, true, 3),
-                HighlightTestParams(kTestMetric, {{4.574986, 4.574986, 2.540827, 0, 0}},
-                                    Metric::euclidean, {16}, {13, 14, 15}),
-                HighlightTestParams(kTestMetric, {{kInf, 4.574986, 4.574986, 2.540827, 0}},
-                                    Metric::euclidean, {16}, {13, 14, 15}, MetricAlgo::brute, true),
-                HighlightTestParams(kTestMetric, {{4.543006, 4.54301, 2.41814, 0, 0}},
-                                    Metric::euclidean, {16}, {13, 14}),
-                HighlightTestParams(kTestMetric, {{kInf, 4.543006, 4.54301, 2.41814, 0}},
-                                    Metric::euclidean, {16}, {13, 14}, MetricAlgo::brute, true),
-                HighlightTestParams(kTestMetric, {{4.543006, 4.54301, 2.41814, 0, 0}},
-                                    Metric::euclidean, {16}, {13, 14}, MetricAlgo::calipers),
-                HighlightTestParams(kTestMetric, {{kInf, 4.543006, 4.54301, 2.41814, 0}},
-                                    Metric::euclidean, {16}, {13, 14}, MetricAlgo::calipers, true),
-                HighlightTestParams(kTestMetric,
-                                    {{3.08137, 3.08137, 2.43892, 2.15623, 2.15421, 1.86557}},
-                                    Metric::euclidean, {0}, {9, 10}),
-                HighlightTestParams(kTestMetric,
-                                    {{3.08137, 3.08137, 2.43892, 2.15623, 2.15421, 1.86557}},
-                                    Metric::euclidean, {0}, {9, 10}, MetricAlgo::calipers)));
+std::vector<HighlightTestParams> GetHighlightTestParams() {
+    return {
+            HighlightTestParams(kTestMetric,
+                                {{125, 125, 110, 79, 78, 68},
+                                 {20500, 20500, 20000, 19997, 19991, 18900}},
+                                Metric::euclidean, {0}, {4}),
+            HighlightTestParams(kTestMetric,
+                                {{4.572423, 4.572423, 4.217, 3.663899, 3.217, 3.21},
+                                 {4.0331, 4.0331, 3.1101, 3.03, 2.3311, 2.3101}},
+                                Metric::euclidean, {0}, {2}),
+            HighlightTestParams(kTestMetric, {{3.9, 3.9, 2.07, 0, 0}}, Metric::euclidean, {16},
+                                {13}),
+            HighlightTestParams(kTestMetric, {{kInf, 3.9, 3.9, 2.07, 0}}, Metric::euclidean,
+                                {16}, {13}, MetricAlgo::brute, true),
+            HighlightTestParams(kTestMetric, {{2, 2, 2, 2, 2, 1}, {2, 2, 2, 2, 2, 2}},
+                                Metric::levenshtein, {0}, {5}),
+            HighlightTestParams(kTestMetric, {{4, 4, 4, 3, 3, 3}}, Metric::levenshtein, {0},
+                                {6}),
+            HighlightTestParams(kTestMetric,
+                                {{0.661938, 0.661938, 0.661938, 0.6, 0.552786, 0.525658}},
+                                Metric::cosine, {0}, {7}),
+            HighlightTestParams(kTestMetric, {{0.5, 0.5, 0.410744}}, Metric::cosine, {1}, {7}),
+            HighlightTestParams(kTestMetric,
+                                {{0.661938, 0.661938, 0.53709, 0.525658, 0.428571, 0.316237},
+                                 {kInf, kInf, kInf, 0, 0, 0}},
+                                Metric::cosine, {0}, {8}, MetricAlgo::brute, true, 3),
+            HighlightTestParams(kTestMetric, {{0.525658, 0.525658, 0.483602}}, Metric::cosine,
+                                {1}, {8}, MetricAlgo::brute, true, 3),
+            HighlightTestParams(kTestMetric, {{4.574986, 4.574986, 2.540827, 0, 0}},
+                                Metric::euclidean, {16}, {13, 14, 15}),
+            HighlightTestParams(kTestMetric, {{kInf, 4.574986, 4.574986, 2.540827, 0}},
+                                Metric::euclidean, {16}, {13, 14, 15}, MetricAlgo::brute, true),
+            HighlightTestParams(kTestMetric, {{4.543006, 4.54301, 2.41814, 0, 0}},
+                                Metric::euclidean, {16}, {13, 14}),
+            HighlightTestParams(kTestMetric, {{kInf, 4.543006, 4.54301, 2.41814, 0}},
+                                Metric::euclidean, {16}, {13, 14}, MetricAlgo::brute, true),
+            HighlightTestParams(kTestMetric, {{4.543006, 4.54301, 2.41814, 0, 0}},
+                                Metric::euclidean, {16}, {13, 14}, MetricAlgo::calipers),
+            HighlightTestParams(kTestMetric, {{kInf, 4.543006, 4.54301, 2.41814, 0}},
+                                Metric::euclidean, {16}, {13, 14}, MetricAlgo::calipers, true),
+            HighlightTestParams(kTestMetric,
+                                {{3.08137, 3.08137, 2.43892, 2.15623, 2.15421, 1.86557}},
+                                Metric::euclidean, {0}, {9, 10}),
+            HighlightTestParams(kTestMetric,
+                                {{3.08137, 3.08137, 2.43892, 2.15623, 2.15421, 1.86557}},
+                                Metric::euclidean, {0}, {9, 10}, MetricAlgo::calipers)};
+}
+
+INSTANTIATE_TEST_SUITE_P(HighlightTestSuite, TestHighlights,
+                         ::testing::Combine(::testing::ValuesIn(GetHighlightTestParams()),
+                                            ::testing::Values<config::ThreadNumType>(1, 4)));
 
 }  // namespace tests
@@ -7,7 +7,9 @@
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/od/order/order.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -21,6 +23,13 @@ public:
         using namespace config::names;
         return algos::CreateAndLoadAlgorithm<algos::order::Order>({{kCsvConfig, info}});
     }
+
+    static OD GetValidODs(algos::StdParamsMap params) {
+        params.emplace(config::names::kCsvConfig, kODnorm6);
+        auto a = algos::CreateAndLoadAlgorithm<algos::order::Order>(params);
+        a->Execute();
+        return a->GetValidODs();
+    }
 };
 
 TEST_F(OrderTest, SmallDataset) {
@@ -54,6 +63,15 @@ TEST_F(OrderTest, SmallDataset) {
     EXPECT_EQ(expected, actual);
 }
 
+TEST_F(OrderTest, ResultDoesNotDependOnThreadsAndMemLimit) {
+    using namespace config::names;
+    OD expected = GetValidODs({{kThreads, config::ThreadNumType{1}}});
+    OD actual = GetValidODs(
+            {{kThreads, config::ThreadNumType{4}}, {kMemLimitMB, config::MemLimitMBType{16}}});
+
+    EXPECT_EQ(expected, actual);
+}
+
 TEST_F(OrderTest, BigWithDifferentTypes) {
     auto a = CreateOrderInstance(kNeighbors10k);
     a->Execute();
@@ -0,0 +1,110 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/relation_snapshot.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+namespace mo = model;
+
+class TestRelationSnapshot : public ::testing::TestWithParam<CSVConfig> {
+protected:
+    std::filesystem::path snapshot_path_;
+
+    void SetUp() override {
+        snapshot_path_ = std::filesystem::temp_directory_path() /
+                         (GetParam().path.stem().string() + ".desbordante_snapshot");
+        auto input_table = MakeInputTable(GetParam());
+        mo::RelationSnapshot::Write(*input_table, snapshot_path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(snapshot_path_);
+    }
+};
+
+TEST_P(TestRelationSnapshot, RowsMatchSource) {
+    auto input_table = MakeInputTable(GetParam());
+    auto snapshot = mo::RelationSnapshot::Open(snapshot_path_);
+
+    ASSERT_EQ(snapshot->GetRelationName(), input_table->GetRelationName());
+    ASSERT_EQ(snapshot->GetNumberOfColumns(), input_table->GetNumberOfColumns());
+    for (size_t i = 0; i < snapshot->GetNumberOfColumns(); ++i) {
+        EXPECT_EQ(snapshot->GetColumnName(i), input_table->GetColumnName(i));
+    }
+
+    size_t row_index = 0;
+    while (input_table->HasNextRow()) {
+        ASSERT_TRUE(snapshot->HasNextRow()) << "Row index: " << row_index;
+        EXPECT_EQ(snapshot->GetNextRow(), input_table->GetNextRow()) << "Row index: " << row_index;
+        ++row_index;
+    }
+    EXPECT_FALSE(snapshot->HasNextRow());
+    EXPECT_EQ(snapshot->GetNumberOfRows(), row_index);
+
+    snapshot->Reset();
+    EXPECT_EQ(snapshot->HasNextRow(), row_index != 0);
+}
+
+TEST_P(TestRelationSnapshot, PLIsMatchSource) {
+    auto input_table = MakeInputTable(GetParam());
+    auto snapshot = mo::RelationSnapshot::Open(snapshot_path_);
+    auto expected = ColumnLayoutRelationData::CreateFrom(*input_table);
+    auto actual = ColumnLayoutRelationData::CreateFrom(*snapshot);
+
+    ASSERT_EQ(actual->GetNumRows(), expected->GetNumRows());
+    ASSERT_EQ(actual->GetNumColumns(), expected->GetNumColumns());
+    for (size_t i = 0; i < expected->GetNumColumns(); ++i) {
+        mo::PLIWS const* expected_pli = expected->GetColumnData(i).GetPLWSIndex();
+        mo::PLIWS const* actual_pli = actual->GetColumnData(i).GetPLWSIndex();
+        EXPECT_EQ(actual_pli->GetIndex(), expected_pli->GetIndex()) << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetSingletons(), expected_pli->GetSingletons())
+                << "Column index: " << i;
+        EXPECT_EQ(actual->GetColumnData(i).GetProbingTable(),
+                  expected->GetColumnData(i).GetProbingTable())
+                << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetSize(), expected_pli->GetSize()) << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetNepAsLong(), expected_pli->GetNepAsLong())
+                << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetEntropy(), expected_pli->GetEntropy()) << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetInvertedEntropy(), expected_pli->GetInvertedEntropy())
+                << "Column index: " << i;
+        EXPECT_EQ(actual_pli->GetGiniImpurity(), expected_pli->GetGiniImpurity())
+                << "Column index: " << i;
+    }
+}
+
+TEST_P(TestRelationSnapshot, ReloadAfterPagesAreReleased) {
+    auto snapshot = mo::RelationSnapshot::Open(snapshot_path_);
+    // Loading releases the mapped pages of the copied sections, they have to be read again
+    auto first = ColumnLayoutRelationData::CreateFrom(*snapshot);
+    auto second = ColumnLayoutRelationData::CreateFrom(*snapshot);
+    for (size_t i = 0; i < first->GetNumColumns(); ++i) {
+        EXPECT_EQ(second->GetColumnData(i).GetPLWSIndex()->GetIndex(),
+                  first->GetColumnData(i).GetPLWSIndex()->GetIndex())
+                << "Column index: " << i;
+        EXPECT_EQ(second->GetColumnData(i).GetProbingTable(),
+                  first->GetColumnData(i).GetProbingTable())
+                << "Column index: " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(RelationSnapshot, TestRelationSnapshot,
+                         ::testing::Values(kTestFD, kCIPublicHighway700, kWdcAstronomical,
+                                           kBernoulliRelation));
+
+TEST(TestRelationSnapshotFormat, RejectsOtherFiles) {
+    EXPECT_THROW(mo::RelationSnapshot::Open(kTestDataDir / "missing.desbordante_snapshot"),
+                 std::runtime_error);
+    EXPECT_THROW(mo::RelationSnapshot::Open(kTestFD.path), std::runtime_error);
+}
+
+}  // namespace tests
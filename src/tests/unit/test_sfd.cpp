@@ -10,6 +10,7 @@
 #include "core/config/equal_nulls/option.h"
 #include "core/config/max_lhs/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
@@ -113,7 +114,8 @@ TEST(TestCordsUtils, SampleSize) {
     ASSERT_EQ(algos::Sample::CalculateSampleSize(319, 4, 0.0181818, 0.16), 485);
 }
 
-class CordsAlgorithmTest : public ::testing::Test {
+// Parametrized by the number of threads
+class CordsAlgorithmTest : public ::testing::TestWithParam<config::ThreadNumType> {
 public:
     struct Config {
         bool is_null_equal_null;
@@ -130,7 +132,8 @@ public:
         config::MaxLhsType max_lhs;
     };
 
-    static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, Config const& test_config) {
+    static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, Config const& test_config,
+                                           config::ThreadNumType threads) {
         using namespace config::names;
         return {{kCsvConfig, csv_config},
                 {kEqualNulls, test_config.is_null_equal_null},
@@ -147,12 +150,14 @@ public:
                 {kDelta, test_config.delta},
                 {kMaxAmountOfCategories, test_config.max_amount_of_categories},
                 {kMaximumLhs, test_config.max_lhs},
-                {kFixedSample, test_config.fixed_sample}};
+                {kFixedSample, test_config.fixed_sample},
+                {kThreads, threads}};
     }
 
-    static std::unique_ptr<algos::Cords> CreateCordsInstance(CSVConfig const& csv_config,
-                                                             Config const& test_config) {
-        return algos::CreateAndLoadAlgorithm<algos::Cords>(GetParamMap(csv_config, test_config));
+    std::unique_ptr<algos::Cords> CreateCordsInstance(CSVConfig const& csv_config,
+                                                      Config const& test_config) {
+        return algos::CreateAndLoadAlgorithm<algos::Cords>(
+                GetParamMap(csv_config, test_config, GetParam()));
     }
 };
 
@@ -172,7 +177,7 @@ TestConfig const kTestConfigDefault{
         .max_lhs = 1,
 };
 
-TEST_F(CordsAlgorithmTest, LineItem) {
+TEST_P(CordsAlgorithmTest, LineItem) {
     auto a = CreateCordsInstance(kLineItem, kTestConfigDefault);
     a->Execute();
     AssertVectors(a->GetSoftKeys(), {1, 2, 5, 15});
@@ -181,9 +186,13 @@ TEST_F(CordsAlgorithmTest, LineItem) {
                   {{0, 8},  {0, 9},  {10, 3},  {11, 3},  {12, 3},  {10, 6},  {11, 6},  {12, 6},
                    {10, 7}, {11, 7}, {12, 7},  {8, 9},   {10, 8},  {11, 8},  {12, 8},  {10, 9},
                    {11, 9}, {12, 9}, {10, 13}, {10, 14}, {11, 13}, {11, 14}, {12, 13}, {12, 14}});
+    AssertCorrsList(a->GetCorrelations(),
+                    {{0, 3},   {0, 4},   {0, 6},   {0, 7},   {10, 0},  {11, 0},  {12, 0},  {0, 13},
+                     {0, 14},  {4, 3},   {4, 6},   {4, 7},   {4, 8},   {4, 9},   {10, 4},  {11, 4},
+                     {12, 4},  {4, 13},  {4, 14},  {11, 10}, {12, 10}, {12, 11}});
 }
 
-TEST_F(CordsAlgorithmTest, iris) {
+TEST_P(CordsAlgorithmTest, iris) {
     auto a = CreateCordsInstance(kIris, kTestConfigDefault);
 
     a->Execute();
@@ -194,7 +203,7 @@ TEST_F(CordsAlgorithmTest, iris) {
                     {{0, 1}, {2, 0}, {0, 3}, {0, 4}, {2, 1}, {1, 3}, {1, 4}, {2, 3}});
 }
 
-TEST_F(CordsAlgorithmTest, CIPublicHighway10k) {
+TEST_P(CordsAlgorithmTest, CIPublicHighway10k) {
     auto a = CreateCordsInstance(kCIPublicHighway10k, kTestConfigDefault);
     a->Execute();
     AssertVectors(a->GetSoftKeys(), {0, 2});
@@ -218,4 +227,7 @@ TEST_F(CordsAlgorithmTest, CIPublicHighway10k) {
                                            {13, 12}});
 }
 
+INSTANTIATE_TEST_SUITE_P(CordsAlgorithmTestSuite, CordsAlgorithmTest,
+                         ::testing::Values<config::ThreadNumType>(1, 4));
+
 }  // namespace tests
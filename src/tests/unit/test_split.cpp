@@ -2,11 +2,13 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "core/algorithms/algo_factory.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -30,20 +32,23 @@ void CompareDDStringLists(std::set<std::pair<std::set<model::DFStringConstraint>
 class SplitAlgorithmTest : public ::testing::Test {
 public:
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config,
-                                           std::optional<CSVConfig> const& dif_table_csv_config) {
+                                           std::optional<CSVConfig> const& dif_table_csv_config,
+                                           config::ThreadNumType threads) {
         using namespace config::names;
         if (dif_table_csv_config == std::nullopt) {
-            return {{kCsvConfig, csv_config}};
+            return {{kCsvConfig, csv_config}, {kThreads, threads}};
         }
         return {{kCsvConfig, csv_config},
-                {kDifferenceTable, MakeInputTable(dif_table_csv_config.value())}};
+                {kDifferenceTable, MakeInputTable(dif_table_csv_config.value())},
+                {kThreads, threads}};
     }
 
     static std::unique_ptr<algos::dd::Split> CreateSplitAlgorithmInstance(
             CSVConfig const& csv_config,
-            std::optional<CSVConfig> const& dif_table_csv_config = std::nullopt) {
+            std::optional<CSVConfig> const& dif_table_csv_config = std::nullopt,
+            config::ThreadNumType threads = 1) {
         return algos::CreateAndLoadAlgorithm<algos::dd::Split>(
-                GetParamMap(csv_config, dif_table_csv_config));
+                GetParamMap(csv_config, dif_table_csv_config, threads));
     }
 };
 
@@ -174,4 +179,22 @@ TEST_F(SplitAlgorithmTest, TestDoubleCompare) {
     CompareDDStringLists(expected_results, actual_results);
 }
 
+TEST_F(SplitAlgorithmTest, ThreadsDoNotChangeResult) {
+    auto get_results = [](config::ThreadNumType threads) {
+        auto algo = CreateSplitAlgorithmInstance(kTestDD4, kTestDif4, threads);
+        algo->Execute();
+        std::vector<std::string> results;
+        for (auto const& dd : algo->GetDDStringList()) {
+            results.push_back(dd.ToString());
+        }
+        return results;
+    };
+
+    std::vector<std::string> const expected_results = get_results(1);
+    ASSERT_FALSE(expected_results.empty());
+    for (config::ThreadNumType threads : {2, 4}) {
+        EXPECT_EQ(get_results(threads), expected_results) << "threads: " << threads;
+    }
+}
+
 }  // namespace tests
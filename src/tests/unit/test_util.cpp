@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <sstream>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -9,6 +12,9 @@
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/identifier_set.h"
 #include "core/util/levenshtein_distance.h"
+#include "core/util/metrics.h"
+#include "core/util/primitive_collection.h"
+#include "core/util/primitive_sink.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -293,4 +299,163 @@ INSTANTIATE_TEST_SUITE_P(TestLevenshteinSuite, TestLevenshtein,
                                            TestLevenshteinParam("", "book", 4),
                                            TestLevenshteinParam("randomstring", "juststring", 6)));
 
+TEST(PrimitiveCollectionTest, ConcurrentRegistration) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    util::PrimitiveCollection<int> collection;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; ++thread) {
+        threads.emplace_back([&collection, thread]() {
+            for (int i = 0; i < kPerThread; ++i) collection.Register(thread * kPerThread + i);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    ASSERT_EQ(collection.Size(), kThreads * kPerThread);
+    vector<int> registered(collection.AsList().begin(), collection.AsList().end());
+    std::sort(registered.begin(), registered.end());
+    vector<int> expected(kThreads * kPerThread);
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_THAT(registered, ContainerEq(expected));
+
+    collection.Clear();
+    ASSERT_EQ(collection.Size(), 0);
+    collection.Register(42);
+    ASSERT_THAT(collection.AsList(), ContainerEq(std::list<int>{42}));
+}
+
+TEST(PrimitiveCollectionTest, RegisterAfterClear) {
+    util::PrimitiveCollection<int> collection;
+    for (int i = 0; i < 10; ++i) collection.Register(i);
+    // Clear frees the chunk this thread has cached, the next Register must allocate a new one
+    collection.Clear();
+    ASSERT_EQ(collection.Size(), 0);
+    collection.Register(42);
+    collection.Register(43);
+    ASSERT_THAT(collection.AsList(), ContainerEq(std::list<int>{42, 43}));
+}
+
+TEST(PrimitiveCollectionTest, PassesChunksToSink) {
+    constexpr int kThreads = 3;
+    constexpr int kPerThread = 2500;
+    util::PrimitiveCollection<int> collection;
+    vector<int> consumed;
+    collection.SetSink(std::make_shared<util::CallbackSink<int>>(
+            [&consumed](int value) { consumed.push_back(value); }));
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; ++thread) {
+        threads.emplace_back([&collection, thread]() {
+            for (int i = 0; i < kPerThread; ++i) collection.Register(thread * kPerThread + i);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    // Only the full chunks are handed over before Flush
+    constexpr size_t kFullChunks = kPerThread / util::PrimitiveCollection<int>::kChunkSize;
+    ASSERT_EQ(consumed.size(), kThreads * kFullChunks * util::PrimitiveCollection<int>::kChunkSize);
+    collection.Flush();
+    ASSERT_EQ(collection.Size(), 0);
+    std::sort(consumed.begin(), consumed.end());
+    vector<int> expected(kThreads * kPerThread);
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_THAT(consumed, ContainerEq(expected));
+}
+
+TEST(PrimitiveCollectionTest, SinkMayReadCollection) {
+    constexpr size_t kChunkSize = util::PrimitiveCollection<int>::kChunkSize;
+    util::PrimitiveCollection<int> collection;
+    size_t consumed = 0;
+    // The collection isn't locked while the sink runs, so reading it doesn't deadlock
+    collection.SetSink(std::make_shared<util::CallbackSink<int>>([&collection, &consumed](int) {
+        ASSERT_EQ(collection.Size(), 0);
+        ++consumed;
+    }));
+    for (size_t i = 0; i < 2 * kChunkSize + 5; ++i) collection.Register(static_cast<int>(i));
+    ASSERT_EQ(consumed, 2 * kChunkSize);
+    collection.Flush();
+    ASSERT_EQ(consumed, 2 * kChunkSize + 5);
+}
+
+TEST(MetricsRegistryTest, MergesThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+    util::metrics::MetricsRegistry registry;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; ++thread) {
+        threads.emplace_back([&registry]() {
+            auto const now = util::metrics::MetricsRegistry::Clock::now();
+            for (int i = 0; i < kPerThread; ++i) {
+                registry.Count("pairs", 2);
+                registry.AddPhase("phase", now, now + std::chrono::nanoseconds{10});
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    util::metrics::Metrics const metrics = registry.Snapshot();
+    ASSERT_EQ(metrics.counters.at("pairs"), 2 * kThreads * kPerThread);
+    ASSERT_EQ(metrics.phases.at("phase").calls, kThreads * kPerThread);
+    ASSERT_EQ(metrics.phases.at("phase").total,
+              std::chrono::nanoseconds{10 * kThreads * kPerThread});
+
+    registry.Reset();
+    ASSERT_TRUE(registry.Snapshot().counters.empty());
+    registry.Count("pairs");
+    ASSERT_EQ(registry.Snapshot().counters.at("pairs"), 1);
+}
+
+TEST(MetricsRegistryTest, Histogram) {
+    util::metrics::MetricsRegistry registry;
+    for (unsigned long long value : {0, 1, 5, 6, 7, 100}) registry.Record("rows", value);
+
+    util::metrics::HistogramStats const stats = registry.Snapshot().histograms.at("rows");
+    ASSERT_EQ(stats.count, 6);
+    ASSERT_EQ(stats.sum, 119);
+    ASSERT_EQ(stats.min, 0);
+    ASSERT_EQ(stats.max, 100);
+    ASSERT_DOUBLE_EQ(stats.Mean(), 119.0 / 6);
+    ASSERT_EQ(stats.buckets[0], 1);
+    ASSERT_EQ(stats.buckets[1], 1);
+    ASSERT_EQ(stats.buckets[3], 3);
+    ASSERT_EQ(stats.buckets[7], 1);
+}
+
+TEST(MetricsRegistryTest, ChromeTrace) {
+    util::metrics::MetricsRegistry registry;
+    auto const now = util::metrics::MetricsRegistry::Clock::now();
+    registry.AddPhase("untraced", now, now);
+    registry.SetTracing(true);
+    registry.AddPhase("traced \"phase\"", now, now + std::chrono::microseconds{3});
+    registry.Count("hits", 7);
+
+    std::ostringstream trace;
+    registry.WriteChromeTrace(trace);
+    std::string const json = trace.str();
+    ASSERT_EQ(json.rfind("{\"traceEvents\":[", 0), 0);
+    ASSERT_EQ(json.find("untraced"), std::string::npos);
+    ASSERT_NE(json.find("\"name\":\"traced \\\"phase\\\"\",\"ph\":\"X\""), std::string::npos);
+    ASSERT_NE(json.find("\"dur\":3"), std::string::npos);
+    ASSERT_NE(json.find("\"args\":{\"hits\":7}"), std::string::npos);
+}
+
+#ifdef DESBORDANTE_METRICS
+TEST(MetricsRegistryTest, ScopeRoutesMacros) {
+    util::metrics::MetricsRegistry registry;
+    {
+        util::metrics::MetricsScope scope{&registry};
+        DESBORDANTE_METRICS_COUNT("outer", 1);
+        std::thread worker{util::metrics::BindCurrentRegistry(
+                []() { DESBORDANTE_METRICS_RECORD("inner", 42); })};
+        worker.join();
+        DESBORDANTE_METRICS_PHASE("phase");
+    }
+    DESBORDANTE_METRICS_COUNT("outer", 1);
+
+    util::metrics::Metrics const metrics = registry.Snapshot();
+    ASSERT_EQ(metrics.counters.at("outer"), 1);
+    ASSERT_EQ(metrics.histograms.at("inner").max, 42);
+    ASSERT_EQ(metrics.phases.at("phase").calls, 1);
+}
+#endif
+
 }  // namespace tests